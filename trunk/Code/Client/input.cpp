@@ -0,0 +1,131 @@
+#include "input.h"
+
+/**
+ * @param[in] port The USB port on the driver station.
+ */
+SnapshotJoystick::SnapshotJoystick(UINT32 port) :
+		Joystick(port)
+{
+	mPort = port;
+	Clear();
+}
+
+/**
+ * @brief Constructor for joysticks with their own axis and button
+ * layout (see XboxController).
+ */
+SnapshotJoystick::SnapshotJoystick(UINT32 port, UINT32 numAxisTypes, UINT32 numButtonTypes) :
+		Joystick(port, numAxisTypes, numButtonTypes)
+{
+	mPort = port;
+	Clear();
+}
+
+void SnapshotJoystick::Clear()
+{
+	for (UINT32 i=0; i<=kNumAxes; i++) {
+		mAxes[i] = 0.0;
+	}
+	mButtons = 0;
+	mPressed = 0;
+	mReleased = 0;
+}
+
+UINT16 SnapshotJoystick::Mask(UINT32 button)
+{
+	if ((button < 1) or (button > kNumButtons)) {
+		return 0;
+	}
+	return (UINT16) (1 << (button - 1));
+}
+
+/**
+ * @brief Reads every axis and button from the driver station.
+ */
+void SnapshotJoystick::Update()
+{
+	DriverStation *ds = DriverStation::GetInstance();
+	for (UINT32 i=1; i<=kNumAxes; i++) {
+		mAxes[i] = ds->GetStickAxis(mPort, i);
+	}
+	UINT16 buttons = (UINT16) ds->GetStickButtons(mPort);
+	mPressed |= (UINT16) (buttons & ~mButtons);
+	mReleased |= (UINT16) (~buttons & mButtons);
+	mButtons = buttons;
+}
+
+/**
+ * @brief The value of an axis as of the last Update.
+ */
+float SnapshotJoystick::GetRawAxis(UINT32 axis)
+{
+	if ((axis < 1) or (axis > kNumAxes)) {
+		return 0.0;
+	}
+	return mAxes[axis];
+}
+
+/**
+ * @brief Whether a button was down as of the last Update.
+ */
+bool SnapshotJoystick::GetRawButton(UINT32 button)
+{
+	return (mButtons & Mask(button)) != 0;
+}
+
+/**
+ * @brief Whether the button has gone down since the last time this
+ * was asked, even if it has come back up since.
+ */
+bool SnapshotJoystick::WasPressed(UINT32 button)
+{
+	UINT16 mask = Mask(button);
+	bool wasPressed = (mPressed & mask) != 0;
+	mPressed &= (UINT16) ~mask;
+	return wasPressed;
+}
+
+/**
+ * @brief Whether the button has come back up since the last time
+ * this was asked.
+ */
+bool SnapshotJoystick::WasReleased(UINT32 button)
+{
+	UINT16 mask = Mask(button);
+	bool wasReleased = (mReleased & mask) != 0;
+	mReleased &= (UINT16) ~mask;
+	return wasReleased;
+}
+
+/**
+ * @brief Forgets every press and release not yet asked about.
+ */
+void SnapshotJoystick::ClearEdges()
+{
+	mPressed = 0;
+	mReleased = 0;
+}
+
+
+
+DriverInput::DriverInput()
+{
+	// Empty
+}
+
+void DriverInput::Add(SnapshotJoystick *joystick)
+{
+	mJoysticks.push_back(joystick);
+}
+
+/**
+ * @brief Takes a new snapshot of every joystick.  Call once per
+ * loop, before running any controllers.
+ */
+void DriverInput::Update()
+{
+	int size = (int) mJoysticks.size();
+	for (int i=0; i<size; i++) {
+		mJoysticks[i]->Update();
+	}
+}
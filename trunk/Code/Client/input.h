@@ -0,0 +1,93 @@
+/**
+ * @file input.h
+ *
+ * @brief Reads the driver station once per loop.
+ *
+ * @details
+ * Every call to Joystick::GetRawButton or Joystick::GetRawAxis
+ * goes back to the driver station, so controllers that check the
+ * same buttons several times per Run (TankJoysticks,
+ * ShooterController, etc.) were paying for it each time.
+ * Joysticks created as a SnapshotJoystick instead remember what
+ * every axis and button was at the start of the loop, and answer
+ * all reads from that copy.
+ *
+ * They also notice every time a button goes down or comes up, and
+ * hold on to it until it's asked about, so a controller that only
+ * runs every few loops (see ControllerScheduler::Add) doesn't miss
+ * a press that came and went between its turns.
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+// System libraries
+#include <vector>
+
+// 3rd party libraries
+#include "WPILib.h"
+
+/**
+ * @brief A joystick that returns the values captured by the last
+ * call to SnapshotJoystick::Update.
+ *
+ * @details
+ * All the usual Joystick getters (GetY, GetTrigger, GetRawButton...)
+ * work as before, since they all go through GetRawAxis and
+ * GetRawButton.  Nothing changes until Update is called, which
+ * DriverInput does at the start of every scheduler tick.
+ * 
+ * WasPressed and WasReleased answer true once per press or release:
+ * asking clears it.  So each button's presses should only be asked
+ * about by one controller.  A controller that may be switched out
+ * (see ControllerSwitcher) should call ClearEdges in its Enter, so
+ * presses made while another controller was driving don't count.
+ */
+class SnapshotJoystick : public Joystick
+{
+public:
+	static const UINT32 kNumAxes = 6;
+	static const UINT32 kNumButtons = 16;
+
+	SnapshotJoystick(UINT32);
+	SnapshotJoystick(UINT32, UINT32, UINT32);
+
+	void Update();
+
+	float GetRawAxis(UINT32);
+	bool GetRawButton(UINT32);
+	bool WasPressed(UINT32);
+	bool WasReleased(UINT32);
+	void ClearEdges();
+
+protected:
+	UINT32 mPort;
+	float mAxes[kNumAxes + 1];	// 1-based, like the driver station
+	UINT16 mButtons;
+	UINT16 mPressed;		// Since each button was last asked about
+	UINT16 mReleased;
+
+	void Clear();
+	static UINT16 Mask(UINT32);
+};
+
+/**
+ * @brief Every SnapshotJoystick the robot uses, so they can be
+ * updated together.
+ *
+ * @details
+ * Give it to ControllerScheduler::SetInput and each tick will
+ * start with a fresh snapshot, taken before any controller runs.
+ */
+class DriverInput
+{
+protected:
+	std::vector<SnapshotJoystick *> mJoysticks;
+
+public:
+	DriverInput();
+	void Add(SnapshotJoystick *);
+	void Update();
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "xbox.h"
 
 XboxController::XboxController(UINT32 port) : 
-		Joystick(port, numAxisTypes, numButtonTypes)
+		SnapshotJoystick(port, numAxisTypes, numButtonTypes)
 {
 	// Empty
 }
@@ -30,7 +30,7 @@ XboxTest::XboxTest(XboxController *xboxController) :
 
 void XboxTest::Run()
 {
-	SmartDashboard *s = SmartDashboard::GetInstance();
+	Telemetry *s = Telemetry::GetInstance();
 	s->Log(mXboxController->GetAxis(mXboxController->LeftX), "Left stick X");
 	s->Log(mXboxController->GetAxis(mXboxController->LeftY), "Left stick Y");
 	s->Log(mXboxController->GetAxis(mXboxController->Bumper), "Bumper");
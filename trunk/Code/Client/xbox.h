@@ -3,8 +3,10 @@
 
 #include "WPILib.h"
 #include "../Definitions/components.h"
+#include "input.h"
+#include "../telemetry.h"
 
-class XboxController : public Joystick
+class XboxController : public SnapshotJoystick
 {
 public:
 	enum Axis {
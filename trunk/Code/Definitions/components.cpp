@@ -19,3 +19,21 @@ BaseController::~BaseController()
 {
 	
 }
+
+/**
+ * @brief Called when the controller is switched to.  Does nothing
+ * by default.
+ */
+void BaseController::Enter()
+{
+	// Empty
+}
+
+/**
+ * @brief Called when the controller is switched away from.  Does 
+ * nothing by default.
+ */
+void BaseController::Exit()
+{
+	// Empty
+}
@@ -52,6 +52,12 @@
  * a robot, multiple Run methods from different classes
  * will be repeatedly called in a loop until the robot is 
  * disabled.
+ * 
+ * Controllers that can be switched in and out (see 
+ * ControllerSwitcher) may also override 'Enter' and 'Exit', 
+ * which are called when they are switched to and away from.
+ * A controller that drives motors should stop them in 'Exit',
+ * since nothing will call its 'Run' method afterwards.
  */
 class BaseController
 {
@@ -59,6 +65,8 @@ public:
 	BaseController();
 	virtual ~BaseController();
 	virtual void Run() = 0;
+	virtual void Enter();
+	virtual void Exit();
 };
 
 /**
@@ -6,18 +6,21 @@ MainRobot::MainRobot(void)
 	InitializeInputDevices();
 	InitializeComponents();
 	InitializeControllers();
+	FlightRecorder::GetInstance()->Start();
 }
 
 /**
  * @brief Initializes all hardware, input devices, and software 
  * for the entire robot.
  * 
- * @details This class will also enable the watchdog.
+ * @details This class will also enable the watchdog and
+ * start the vision task.
  */
 void MainRobot::RobotInit(void)
 {
 	GetWatchdog().SetExpiration(kWatchdogExpiration);
 	SmartDashboard::GetInstance()->PutString("Autonomous? <<", "0.0");
+	mMultithreadedTargetFinder->StartTask();
 	return;
 }
 
@@ -46,7 +49,7 @@ void MainRobot::InitializeHardware(void)
 			Ports::Crio::Module1,
 			Ports::DigitalSidecar::Pwm4);
 	
-	mRobotDrive = new RobotDrive(
+	mRobotDrive = new RecordingRobotDrive(
 			mLeftFrontDrive,
 			mLeftBackDrive,
 			mRightFrontDrive,
@@ -77,6 +80,9 @@ void MainRobot::InitializeHardware(void)
 	mUltrasoundSensor = new AnalogChannel(
 			Ports::Crio::Module1,
 			Ports::Crio::AnalogChannel1);
+	mGyro = new Gyro(
+			Ports::Crio::Module1,
+			Ports::Crio::AnalogChannel2);
 	
 	
 	// The camera is technically a hardware component, but WPILib's
@@ -106,16 +112,22 @@ void MainRobot::InitializeHardware(void)
  */
 void MainRobot::InitializeInputDevices(void)
 {
-	mLeftJoystick = new Joystick(
+	mLeftJoystick = new SnapshotJoystick(
 			Ports::Usb2);
-	mRightJoystick = new Joystick(
+	mRightJoystick = new SnapshotJoystick(
 			Ports::Usb3);
 	
-	mTwistJoystick = new Joystick(
+	mTwistJoystick = new SnapshotJoystick(
 			Ports::Usb4);
 	
 	mXboxController = new XboxController(
 			Ports::Usb1);
+	
+	mDriverInput = new DriverInput();
+	mDriverInput->Add(mLeftJoystick);
+	mDriverInput->Add(mRightJoystick);
+	mDriverInput->Add(mTwistJoystick);
+	mDriverInput->Add(mXboxController);
 	/*
 	mKinect = Kinect::GetInstance();
 	mLeftKinectStick = new KinectStick::KinectStick(1);
@@ -149,6 +161,9 @@ void MainRobot::InitializeComponents(void)
 	//mArm = new SimpleArm(mArmSpeedController);
 	//mArm = new SingleGuardedArm(mArmSpeedController, mElevatorBottomLimitSwitch);
 	mArm = new GuardedArm(mArmSpeedController, mTopLimit, mBottomLimit);
+	
+	mTargetFinder = new TargetFinder();
+	mMultithreadedTargetFinder = new MultithreadedTargetFinder(mTargetFinder);
 }
 
 /**
@@ -157,11 +172,15 @@ void MainRobot::InitializeComponents(void)
  * periodically during operator control
  * 
  * @details Each object initialized in this file must inherit 
- * BaseController.  They are assigned to the heap, and appended 
- * to the end of MainRobot::mControllerCollection, 
+ * BaseController.  They are assigned to the heap, and added 
+ * to MainRobot::mScheduler along with how often they should
+ * run (see ControllerScheduler::Add).
  */
 void MainRobot::InitializeControllers(void)
 {
+	mScheduler = new ControllerScheduler(kLoopPeriod);
+	mScheduler->SetInput(mDriverInput);
+	
 	vector<BaseController *> controllers;
 	controllers.push_back(new TankJoysticks(
 			mRobotDrive, 
@@ -190,24 +209,41 @@ void MainRobot::InitializeControllers(void)
 	controllers.push_back(new XboxDriveSingle(
 			mRobotDrive,
 			mXboxController));
-	mControllerCollection.push_back(new ControllerSwitcher(controllers));
+	mScheduler->Add(new ControllerSwitcher(controllers), "ControllerSwitcher");
+	
+	// After the drive controllers, so that while the right joystick's
+	// button 2 is held, the turn to the target is what the motors get.
+	mScheduler->Add(new TargetSnapshotController(
+			mRobotDrive,
+			mMultithreadedTargetFinder,
+			mRightJoystick,
+			mGyro), "TargetSnapshotController");
+	
+	// The camera's settings follow how busy the control loop is.
+	mMultithreadedTargetFinder->SetGovernor(new CameraGovernor(
+			&mTargetFinder->GetCamera(),
+			mScheduler));
 	
-	//mControllerCollection.push_back(new TankJoysticks(mRobotDrive, mLeftJoystick, mRightJoystick));
-	//mControllerCollection.push_back(new SingleJoystick(mRobotDrive, mTwistJoystick));
-	//mControllerCollection.push_back(new MinimalistDrive(mRobotDrive));
-	//mControllerCollection.push_back(new XboxDrive(mRobotDrive, mXboxController));
+	//mScheduler->Add(new TankJoysticks(mRobotDrive, mLeftJoystick, mRightJoystick), "TankJoysticks");
+	//mScheduler->Add(new SingleJoystick(mRobotDrive, mTwistJoystick), "SingleJoystick");
+	//mScheduler->Add(new MinimalistDrive(mRobotDrive), "MinimalistDrive");
+	//mScheduler->Add(new XboxDrive(mRobotDrive, mXboxController), "XboxDrive");
 	
-	//mControllerCollection.push_back(new CalibratedShooterController(mShooter, mTwistJoystick));
-	mControllerCollection.push_back(new ShooterController(mShooter, mTwistJoystick));
-	mControllerCollection.push_back(new ElevatorController(mElevator, mTwistJoystick));
-	//mControllerCollection.push_back(new ShooterXboxController(mShooter, mElevator, mXboxController));
+	//mScheduler->Add(new CalibratedShooterController(mShooter, mTwistJoystick), "CalibratedShooterController");
+	mScheduler->Add(new ShooterController(mShooter, mTwistJoystick), "ShooterController");
+	mScheduler->Add(new ElevatorController(mElevator, mTwistJoystick), "ElevatorController");
+	//mScheduler->Add(new ShooterXboxController(mShooter, mElevator, mXboxController), "ShooterXboxController");
 	//TODO: enable the above after testing.
 	
-	mControllerCollection.push_back(new ArmController(mArm, mLeftJoystick));
-	mControllerCollection.push_back(new TableTest());
+	mScheduler->Add(new ArmController(mArm, mLeftJoystick), "ArmController");
+	mScheduler->Add(new TableTest(), "TableTest", 5);
 	
+	SensorRecorder *sensorRecorder = new SensorRecorder();
+	sensorRecorder->AddRangeFinder(mRangeFinder, "RangeFinder");
+	mScheduler->Add(sensorRecorder, "SensorRecorder", 2);
 	
-	//mControllerCollection.push_back(new XboxTest(mXboxController));
+	
+	//mScheduler->Add(new XboxTest(mXboxController), "XboxTest");
 	return;
 }
 
@@ -244,13 +280,13 @@ void MainRobot::Autonomous(void)
 	//for(int i=0; i<300; i++) {
 	//	mShooter->SetSpeedManually(shootSpeed);
 	//	GetWatchdog().Feed();
-	//	Wait(kMotorWait);
+	//	Wait(kLoopPeriod);
 	//}
 	while (IsAutonomous()) {
 	//	mShooter->SetSpeedManually(shootSpeed);
 	//	mElevator->MoveUp();
 		GetWatchdog().Feed();
-		Wait(kMotorWait);
+		Wait(kLoopPeriod);
 	}
 }
 
@@ -264,21 +300,19 @@ void MainRobot::Autonomous(void)
  * 
  * This method will repeatedly call the 'Run' methods of any
  * class (that inherited BaseController) that has been 
- * added to mControllerCollection.  
+ * added to mScheduler, once every kLoopPeriod seconds.
  */
 void MainRobot::OperatorControl(void) 
 {
 	GetWatchdog().SetEnabled(true);
 	
-	int collectionSize = (int) mControllerCollection.size();
-	SmartDashboard::GetInstance()->Log("Test", "Test");
+	Telemetry::GetInstance()->Log("Test", "Test");
+	mScheduler->Start();
 	while (IsOperatorControl())
 	{
-		for(int i=0; i<collectionSize; i++) {
-			mControllerCollection.at(i)->Run();
-			GetWatchdog().Feed();
-			Wait(kMotorWait);
-		}
+		mScheduler->Tick();
+		GetWatchdog().Feed();
+		mScheduler->WaitForNextTick();
 	}
 	return;
 }
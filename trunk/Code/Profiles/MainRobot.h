@@ -32,11 +32,14 @@
 #include "../sensors.h"
 #include "../Subsystems/driving.h"
 #include "../Definitions/components.h"
+#include "../scheduler.h"
 #include "../Definitions/ports.h"
 #include "../Subsystems/shooter.h"
 #include "../Subsystems/elevator.h"
 #include "../Client/xbox.h"
 #include "../communication.h"
+#include "../Tracking/track_silver.h"
+#include "../Tracking/governor.h"
 
 /**
  * @brief This class bundles together everything to ultimately
@@ -63,13 +66,14 @@ class MainRobot : public SimpleRobot
 {
 private:
 	// Safety constants
-	static const double kMotorWait = 0.01;		// In seconds
+	static const double kLoopPeriod = 0.01;		// In seconds
 	static const double kWatchdogExpiration = 1;	// In seconds
 	
 protected:
 	// Hardware
 	RobotDrive *mRobotDrive;
 	AnalogChannel *mUltrasoundSensor;	// For ultrasound
+	Gyro *mGyro;				// Which way the robot faces, for aiming
 	
 	SpeedController *mLeftFrontDrive;
 	SpeedController *mLeftBackDrive;
@@ -89,9 +93,10 @@ protected:
 	DigitalInput *mBottomLimit;
 	
 	// Input devices
-	Joystick *mLeftJoystick;
-	Joystick *mRightJoystick;
-	Joystick *mTwistJoystick;
+	SnapshotJoystick *mLeftJoystick;
+	SnapshotJoystick *mRightJoystick;
+	SnapshotJoystick *mTwistJoystick;
+	DriverInput *mDriverInput;
 	Kinect *mKinect;
 	XboxController *mXboxController;
 	
@@ -102,10 +107,11 @@ protected:
 	KinectStick *mLeftKinectStick;
 	KinectStick *mRightKinectStick;
 	TargetFinder *mTargetFinder;
+	MultithreadedTargetFinder *mMultithreadedTargetFinder;
 	BaseMotorArmComponent *mArm;
 	
-	// Controller -- see controller.h
-	vector<BaseController*> mControllerCollection;
+	// Controllers -- see scheduler.h
+	ControllerScheduler *mScheduler;
 
 public:
 	MainRobot();
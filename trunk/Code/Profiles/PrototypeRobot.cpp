@@ -7,6 +7,7 @@ PrototypeRobot::PrototypeRobot(void)
 	InitializeInputDevices();
 	InitializeComponents();
 	InitializeControllers();
+	FlightRecorder::GetInstance()->Start();
 }
 
 /**
@@ -51,7 +52,7 @@ void PrototypeRobot::InitializeHardware(void)
 			Ports::Crio::Module1,
 			Ports::DigitalSidecar::Pwm5);
 	
-	mRobotDrive = new RobotDrive(
+	mRobotDrive = new RecordingRobotDrive(
 			mLeftFrontDrive,
 			mLeftBackDrive,
 			mRightFrontDrive,
@@ -87,14 +88,19 @@ void PrototypeRobot::InitializeHardware(void)
  */
 void PrototypeRobot::InitializeInputDevices(void)
 {
-	mLeftJoystick = new Joystick(
+	mLeftJoystick = new SnapshotJoystick(
 			Ports::Usb1);
-	mRightJoystick = new Joystick(
+	mRightJoystick = new SnapshotJoystick(
 			Ports::Usb2);
 	
-	mTwistJoystick = new Joystick(
+	mTwistJoystick = new SnapshotJoystick(
 			Ports::Usb3);
 	
+	mDriverInput = new DriverInput();
+	mDriverInput->Add(mLeftJoystick);
+	mDriverInput->Add(mRightJoystick);
+	mDriverInput->Add(mTwistJoystick);
+	
 	//mKinect = Kinect::GetInstance();
 	//mLeftKinectStick = new KinectStick::KinectStick(1);
 	//mRightKinectStick = new KinectStick::KinectStick(2);
@@ -124,11 +130,14 @@ void PrototypeRobot::InitializeComponents(void)
  * periodically during operator control
  * 
  * @details Each object initialized in this file must inherit 
- * BaseController.  They are assigned to the heap, and appended 
- * to the end of PrototypeRobot::mControllerCollection, 
+ * BaseController.  They are assigned to the heap, and added 
+ * to PrototypeRobot::mScheduler along with how often they 
+ * should run (see ControllerScheduler::Add).
  */
 void PrototypeRobot::InitializeControllers(void)
 {
+	mScheduler = new ControllerScheduler(kLoopPeriod);
+	mScheduler->SetInput(mDriverInput);
 	
 	vector<BaseController *> controllers;
 	controllers.push_back(new TankJoysticks(
@@ -140,20 +149,24 @@ void PrototypeRobot::InitializeControllers(void)
 			mTwistJoystick));
 	controllers.push_back(new MinimalistDrive(
 			mRobotDrive));
-	mControllerCollection.push_back(new ControllerSwitcher(controllers));
+	mScheduler->Add(new ControllerSwitcher(controllers), "ControllerSwitcher");
 	
 	 
-	//mControllerCollection.push_back(new ArcadeJoystick(mRobotDrive, mLeftJoystick));
+	//mScheduler->Add(new ArcadeJoystick(mRobotDrive, mLeftJoystick), "ArcadeJoystick");
+	
+	//mScheduler->Add(new TankJoysticks(mRobotDrive, mLeftJoystick, mRightJoystick, mPitchGyro, GetWatchdog()), "TankJoysticks");
+	//mScheduler->Add(new SingleJoystick(mRobotDrive, mTwistJoystick), "SingleJoystick");
+	//mScheduler->Add(new MinimalistDrive(mRobotDrive), "MinimalistDrive");
 	
-	//mControllerCollection.push_back(new TankJoysticks(mRobotDrive, mLeftJoystick, mRightJoystick, mPitchGyro, GetWatchdog()));
-	//mControllerCollection.push_back(new SingleJoystick(mRobotDrive, mTwistJoystick));
-	//mControllerCollection.push_back(new MinimalistDrive(mRobotDrive));
+	//mScheduler->Add(new ArmController(mPneumaticArm, mLeftJoystick), "ArmController");
+	//mScheduler->Add(new ServoController(mServo), "ServoController");
+	mScheduler->Add(new ElevatorController(mElevator, mTwistJoystick), "ElevatorController");
 	
-	//mControllerCollection.push_back(new ArmController(mPneumaticArm, mLeftJoystick));
-	//mControllerCollection.push_back(new ServoController(mServo));
-	mControllerCollection.push_back(new ElevatorController(mElevator, mTwistJoystick));
+	mScheduler->Add(new EncoderTestController(mEncoder), "EncoderTestController", 5);
 	
-	mControllerCollection.push_back(new EncoderTestController(mEncoder));
+	SensorRecorder *sensorRecorder = new SensorRecorder();
+	sensorRecorder->AddEncoder(mEncoder, "Encoder");
+	mScheduler->Add(sensorRecorder, "SensorRecorder", 2);
 	return;
 }
 
@@ -188,7 +201,7 @@ void PrototypeRobot::Autonomous(void)
 	GetWatchdog().SetEnabled(true);
 	while (IsAutonomous()) {
 		GetWatchdog().Feed();
-		Wait(kMotorWait);
+		Wait(kLoopPeriod);
 	}
 }
 
@@ -202,21 +215,18 @@ void PrototypeRobot::Autonomous(void)
  * 
  * This method will repeatedly call the 'Run' methods of any
  * class (that inherited BaseController) that has been 
- * added to mControllerCollection.  
+ * added to mScheduler, once every kLoopPeriod seconds.
  */
 void PrototypeRobot::OperatorControl(void) 
 {
 	GetWatchdog().SetEnabled(true);
 	
-	int collectionSize = (int) mControllerCollection.size();
-	
+	mScheduler->Start();
 	while (IsOperatorControl())
 	{
-		for(int i=0; i<collectionSize; i++) {
-			mControllerCollection.at(i)->Run();
-			GetWatchdog().Feed();
-			Wait(kMotorWait);
-		}
+		mScheduler->Tick();
+		GetWatchdog().Feed();
+		mScheduler->WaitForNextTick();
 	}
 	return;
 }
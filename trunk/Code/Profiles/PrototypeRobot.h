@@ -33,6 +33,7 @@
 #include "../Subsystems/elevator.h"
 #include "../testing.h"
 #include "../Definitions/components.h"
+#include "../scheduler.h"
 #include "../Definitions/ports.h"
 
 /**
@@ -60,7 +61,7 @@ class PrototypeRobot : public SimpleRobot
 {
 private:
 	// Safety constants
-	static const double kMotorWait = 0.01;		// In seconds
+	static const double kLoopPeriod = 0.01;		// In seconds
 	static const double kWatchdogExpiration = 1;	// In seconds
 	
 protected:
@@ -81,17 +82,18 @@ protected:
 	Encoder *mEncoder;
 	
 	// Input devices
-	Joystick *mLeftJoystick;
-	Joystick *mRightJoystick;
-	Joystick *mTwistJoystick;
+	SnapshotJoystick *mLeftJoystick;
+	SnapshotJoystick *mRightJoystick;
+	SnapshotJoystick *mTwistJoystick;
+	DriverInput *mDriverInput;
 	
 	// Components
 	BaseMotorArmComponent *mArm;
 	Elevator *mElevator;
 	PneumaticArm *mPneumaticArm;
 	
-	// Controller -- see controller.h
-	vector<BaseController*> mControllerCollection;
+	// Controllers -- see scheduler.h
+	ControllerScheduler *mScheduler;
 
 public:
 	PrototypeRobot();
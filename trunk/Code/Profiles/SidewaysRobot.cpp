@@ -7,6 +7,7 @@ SidewaysRobot::SidewaysRobot(void) :
 	InitializeInputDevices();
 	InitializeComponents();
 	InitializeControllers();
+	FlightRecorder::GetInstance()->Start();
 }
 
 void SidewaysRobot::RobotInit(void)
@@ -30,7 +31,7 @@ void SidewaysRobot::InitializeHardware(void)
 			Ports::Crio::Module1,
 			Ports::DigitalSidecar::Pwm4);
 	
-	mRobotDrive = new RobotDrive(
+	mRobotDrive = new RecordingRobotDrive(
 			mLeftFrontDrive,
 			mLeftBackDrive,
 			mRightFrontDrive,
@@ -44,17 +45,22 @@ void SidewaysRobot::InitializeHardware(void)
 
 void SidewaysRobot::InitializeInputDevices(void)
 {
-	mLeftJoystick = new Joystick(
+	mLeftJoystick = new SnapshotJoystick(
 			Ports::Usb2);
-	mRightJoystick = new Joystick(
+	mRightJoystick = new SnapshotJoystick(
 			Ports::Usb3);
 	
-	mTwistJoystick = new Joystick(
+	mTwistJoystick = new SnapshotJoystick(
 			Ports::Usb4);
 	
 	mXboxController = new XboxController(
 			Ports::Usb1);
 	
+	mDriverInput = new DriverInput();
+	mDriverInput->Add(mLeftJoystick);
+	mDriverInput->Add(mRightJoystick);
+	mDriverInput->Add(mTwistJoystick);
+	mDriverInput->Add(mXboxController);
 }
 
 void SidewaysRobot::InitializeComponents(void)
@@ -76,6 +82,9 @@ void SidewaysRobot::InitializeComponents(void)
 
 void SidewaysRobot::InitializeControllers(void)
 {
+	mScheduler = new ControllerScheduler(kLoopPeriod);
+	mScheduler->SetInput(mDriverInput);
+	
 	vector<BaseController *> controllers;
 	//controllers.push_back(new TankJoysticks(
 	//		mRobotDrive, 
@@ -87,9 +96,14 @@ void SidewaysRobot::InitializeControllers(void)
 	controllers.push_back(new XboxTankDrive(
 			mRobotDrive,
 			mXboxController));
-	mControllerCollection.push_back(new ControllerSwitcher(controllers));
+	mScheduler->Add(new ControllerSwitcher(controllers), "ControllerSwitcher");
+	
+	SensorRecorder *sensorRecorder = new SensorRecorder();
+	sensorRecorder->AddEncoder(mLeftEncoder, "LeftEncoder");
+	sensorRecorder->AddEncoder(mRightEncoder, "RightEncoder");
+	mScheduler->Add(sensorRecorder, "SensorRecorder", 2);
 	
-	//mControllerCollection.push_back(new SimpleEncoderTest(mLeftEncoder, mRightEncoder));
+	//mScheduler->Add(new SimpleEncoderTest(mLeftEncoder, mRightEncoder), "SimpleEncoderTest");
 	return;
 }
 
@@ -103,7 +117,7 @@ void SidewaysRobot::Autonomous(void)
 	GetWatchdog().SetEnabled(true);
 	while (IsAutonomous()) {
 		GetWatchdog().Feed();
-		Wait(kMotorWait);
+		Wait(kLoopPeriod);
 	}
 }
 
@@ -111,14 +125,12 @@ void SidewaysRobot::OperatorControl(void)
 {
 	GetWatchdog().SetEnabled(true);
 	
-	int collectionSize = (int) mControllerCollection.size();
+	mScheduler->Start();
 	while (IsOperatorControl())
 	{
-		for(int i=0; i<collectionSize; i++) {
-			mControllerCollection.at(i)->Run();
-			GetWatchdog().Feed();
-			Wait(kMotorWait);
-		}
+		mScheduler->Tick();
+		GetWatchdog().Feed();
+		mScheduler->WaitForNextTick();
 	}
 	return;
 }
@@ -10,6 +10,7 @@
 // Program modules
 #include "../Subsystems/driving.h"
 #include "../Definitions/components.h"
+#include "../scheduler.h"
 #include "../Definitions/ports.h"
 #include "../Client/xbox.h"
 
@@ -17,7 +18,7 @@ class SidewaysRobot : public SimpleRobot
 {
 private:
 	// Safety constants
-	static const double kMotorWait = 0.01;		// In seconds
+	static const double kLoopPeriod = 0.01;		// In seconds
 	static const double kWatchdogExpiration = 1;	// In seconds
 	
 protected:
@@ -33,13 +34,14 @@ protected:
 	Encoder *mRightEncoder;
 	
 	// Input devices
-	Joystick *mLeftJoystick;
-	Joystick *mRightJoystick;
-	Joystick *mTwistJoystick;
+	SnapshotJoystick *mLeftJoystick;
+	SnapshotJoystick *mRightJoystick;
+	SnapshotJoystick *mTwistJoystick;
+	DriverInput *mDriverInput;
 	XboxController *mXboxController;
 	
-	// Controller -- see controller.h
-	vector<BaseController*> mControllerCollection;
+	// Controllers -- see scheduler.h
+	ControllerScheduler *mScheduler;
 
 public:
 	SidewaysRobot();
@@ -202,7 +202,7 @@ void SingleGuardedArm::Set(float value) {
  */
 void SingleGuardedArm::SafeSet(float value)
 {
-	if (mSpeedController < 0 && mLimit->Get()) {
+	if (value < 0 && mLimit->Get()) {
 		mSpeedController->Set(0);
 	} else {
 		mSpeedController->Set(value);
@@ -365,7 +365,7 @@ void PneumaticArm::Stop()
  * @param[in] arm Pointer to the arm.
  * @param[in] joystick Pointer to the joystick.
  */
-ArmController::ArmController(BaseArmComponent *arm, Joystick *joystick)
+ArmController::ArmController(BaseArmComponent *arm, SnapshotJoystick *joystick)
 {
 	mArm = arm;
 	mJoystick = joystick;
@@ -394,11 +394,10 @@ void ArmController::Run() {
  * @param[in] arm Pointer to the arm.
  * @param[in] joystick Pointer to the joystick.
  */
-MotorArmController::MotorArmController (BaseMotorArmComponent *arm, Joystick *joystick) {
+MotorArmController::MotorArmController (BaseMotorArmComponent *arm, SnapshotJoystick *joystick) {
 	mArm = arm;
 	mJoystick = joystick;
-	mRawPower = 0.0;
-	SmartDashboard::GetInstance()->PutString("(ARM) Raw power <<", Tools::FloatToString(mRawPower));
+	mRawPower = Parameters::GetInstance()->AddFloat("(ARM) Raw power <<", 0.0);
 }
 
 /**
@@ -414,8 +413,7 @@ void MotorArmController::Run() {
 		mArm->GoDown();
 	} else {
 		if (mJoystick->GetRawButton(10) and mJoystick->GetRawButton(11)) {
-			float speed = Tools::StringToFloat(SmartDashboard::GetInstance()->GetString("(ARM) Raw power <<"));
-			mArm->SafeSet(speed);
+			mArm->SafeSet(mRawPower->Get());
 		} else {
 			mArm->Set(0);
 		}
@@ -9,7 +9,9 @@
 
 #include "WPILib.h"
 #include "../Definitions/components.h"
+#include "../Client/input.h"
 #include "../tools.h"
+#include "../parameters.h"
 
 class BaseArmComponent : public BaseComponent
 {
@@ -145,10 +147,10 @@ class ArmController : public BaseController
 {
 protected:
 	BaseArmComponent *mArm;
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 	
 public:
-	ArmController(BaseArmComponent *, Joystick *);
+	ArmController(BaseArmComponent *, SnapshotJoystick *);
 	void Run(void);
 };
 
@@ -159,10 +161,10 @@ class MotorArmController : public BaseController
 {
 protected:
 	BaseMotorArmComponent *mArm;
-	Joystick *mJoystick;
-	float mRawPower;
+	SnapshotJoystick *mJoystick;
+	FloatParameter *mRawPower;
 public:
-	MotorArmController(BaseMotorArmComponent *, Joystick *);
+	MotorArmController(BaseMotorArmComponent *, SnapshotJoystick *);
 	void Run(void);
 };
 
@@ -20,7 +20,7 @@ BaseJoystickController::BaseJoystickController():
  * @returns A number between BaseJoystickController::kSpeedFactorMin 
  * BaseJoystickController::kSpeedFactorMax. 
  */
-float BaseJoystickController::GetSpeedFactor(Joystick *joystick)
+float BaseJoystickController::GetSpeedFactor(SnapshotJoystick *joystick)
 {
 	float rawFactor = -joystick->GetThrottle();
 	float normalizedFactor = Tools::Coerce(
@@ -60,7 +60,12 @@ ControllerSwitcher::ControllerSwitcher(
 	
 	mLabel = "(CONTROLLER) << ";
 	
+	mRequested = 0;
+	mCurrent = -1;
+	mActive = NULL;
+	
 	SmartDashboard::GetInstance()->PutString(mLabel, "0");
+	NetworkTable::GetTable("SmartDashboard")->AddChangeListener(mLabel, this);
 }
 
 /**
@@ -70,7 +75,7 @@ ControllerSwitcher::ControllerSwitcher(
  */
 ControllerSwitcher::~ControllerSwitcher()
 {
-	// Empty
+	NetworkTable::GetTable("SmartDashboard")->RemoveChangeListener(mLabel, this);
 }
 
 /**
@@ -81,15 +86,62 @@ ControllerSwitcher::~ControllerSwitcher()
  */
 void ControllerSwitcher::Run()
 {
-	int current = (int) Tools::StringToFloat(SmartDashboard::GetInstance()->GetString(mLabel));
-	
-	mControllers.at(current)->Run();
+	if (mRequested != mCurrent) {
+		Switch(mRequested);
+	}
+	if (mActive != NULL) {
+		mActive->Run();
+	}
+}
+
+/**
+ * @brief Exits the current controller and enters a new one.
+ * 
+ * @param[in] index Which controller to switch to.  Already 
+ * checked by ValueChanged.
+ */
+void ControllerSwitcher::Switch(int index)
+{
+	if (mActive != NULL) {
+		mActive->Exit();
+	}
+	mCurrent = index;
+	mActive = (index < mControllerSize) ? mControllers[index] : NULL;
+	if (mActive != NULL) {
+		mActive->Enter();
+	}
+	Telemetry::GetInstance()->Log(mCurrent, "(CONTROLLER) Current ");
+}
+
+/**
+ * @brief Called by the NetworkTable whenever the selection on the
+ * dashboard changes.
+ * 
+ * @details
+ * Out-of-range or unreadable values are ignored, and the current
+ * controller keeps running.
+ */
+void ControllerSwitcher::ValueChanged(NetworkTable *table, const char *name, NetworkTables_Types type)
+{
+	float value = Tools::StringToFloat(table->GetString(name));
+	int index = (int) value;
+	if ((value != (float) index) or (index < 0) or (index >= mControllerSize)) {
+		Telemetry::GetInstance()->Log("ignored bad selection", "(CONTROLLER) Status ");
+		return;
+	}
+	Telemetry::GetInstance()->Log("ok", "(CONTROLLER) Status ");
+	mRequested = index;
+}
+
+void ControllerSwitcher::ValueConfirmed(NetworkTable *table, const char *name, NetworkTables_Types type)
+{
+	// Empty
 }
 
 /**
  * @brief The constructor.
  */
-TestMotor::TestMotor(Joystick *joystick, SpeedController *speedController, const char* name)
+TestMotor::TestMotor(SnapshotJoystick *joystick, SpeedController *speedController, const char* name)
 {
 	mJoystick = joystick;
 	mSpeedController = speedController;
@@ -102,7 +154,7 @@ TestMotor::TestMotor(Joystick *joystick, SpeedController *speedController, const
 void TestMotor::Run()
 {
 	float speed = mJoystick->GetY();
-	SmartDashboard::GetInstance()->Log(speed, mName);
+	Telemetry::GetInstance()->Log(speed, mName);
 	mSpeedController->Set(speed);
 }
 
@@ -140,8 +192,8 @@ void MinimalistDrive::Run()
  */
 TankJoysticks::TankJoysticks(
 			RobotDrive *robotDrive,
-			Joystick *leftJoystick, 
-			Joystick *rightJoystick):
+			SnapshotJoystick *leftJoystick, 
+			SnapshotJoystick *rightJoystick):
 		BaseJoystickController()
 {
 	mRobotDrive = robotDrive;
@@ -162,23 +214,23 @@ void TankJoysticks::Run(void)
 {
 	DriveSpeed driveSpeed(mLeftJoystick->GetY(), mRightJoystick->GetY());
 	
-	SmartDashboard *s = SmartDashboard::GetInstance();
+	Telemetry *s = Telemetry::GetInstance();
 	
 	driveSpeed = Filter::SquareInput(driveSpeed);
 	
 	s->Log(driveSpeed.Left, "SquareInputLeft");
 	
-	if (mRightJoystick->GetRawButton(6)) {
+	if (mRightJoystick->WasPressed(6)) {
 		mAreValuesSwapped = false;
-	} else if (mRightJoystick->GetRawButton(7)) {
+	} else if (mRightJoystick->WasPressed(7)) {
 		mAreValuesSwapped = true;
 	}
 	
 	if (mAreValuesSwapped) {
 		driveSpeed = Filter::ReverseDirection(driveSpeed);
-		SmartDashboard::GetInstance()->Log("reversed", "(TANK DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("reversed", "(TANK DRIVE) Driving orientation: ");
 	} else {
-		SmartDashboard::GetInstance()->Log("normal", "(TANK DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("normal", "(TANK DRIVE) Driving orientation: ");
 	}
 	
 	driveSpeed = Filter::AddSpeedFactor(driveSpeed, GetSpeedFactor(mLeftJoystick));
@@ -191,13 +243,30 @@ void TankJoysticks::Run(void)
 	s->Log(driveSpeed.Left, "StraightenLeft");
 	driveSpeed = Filter::AddTruncation(driveSpeed);
 	
-	SmartDashboard::GetInstance()->Log(driveSpeed.Left, "(TANK DRIVE) Left speed ");
-	SmartDashboard::GetInstance()->Log(driveSpeed.Right, "(TANK DRIVE) Right speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Left, "(TANK DRIVE) Left speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Right, "(TANK DRIVE) Right speed ");
 	
 	mRobotDrive->TankDrive(driveSpeed.Left, driveSpeed.Right);
 }
 
-ArcadeJoystick::ArcadeJoystick(RobotDrive *robotDrive, Joystick *joystick) :
+/**
+ * @brief Ignores the presses made while another controller was
+ * driving.
+ */
+void TankJoysticks::Enter()
+{
+	mRightJoystick->ClearEdges();
+}
+
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void TankJoysticks::Exit()
+{
+	Stop(mRobotDrive);
+}
+
+ArcadeJoystick::ArcadeJoystick(RobotDrive *robotDrive, SnapshotJoystick *joystick) :
 		BaseJoystickController()
 {
 	mRobotDrive = robotDrive;
@@ -215,29 +284,46 @@ void ArcadeJoystick::Run()
 	DriveSpeed driveSpeed = GetLeftAndRight(magnitude, rotation);
 	driveSpeed = Filter::SquareInput(driveSpeed);
 	
-	if (mJoystick->GetRawButton(6)) {
+	if (mJoystick->WasPressed(6)) {
 		mAreValuesSwapped = false;
-	} else if (mJoystick->GetRawButton(7)) {
+	} else if (mJoystick->WasPressed(7)) {
 		mAreValuesSwapped = true;
 	}
 	
 	if (mAreValuesSwapped) {
 		driveSpeed = Filter::ReverseDirection(driveSpeed);
-		SmartDashboard::GetInstance()->Log("reversed", "(ARCADE DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("reversed", "(ARCADE DRIVE) Driving orientation: ");
 	} else {
-		SmartDashboard::GetInstance()->Log("normal", "(ARCADE DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("normal", "(ARCADE DRIVE) Driving orientation: ");
 	}
 	
 	driveSpeed = Filter::AddSpeedFactor(driveSpeed, GetSpeedFactor(mJoystick));
 	
 	driveSpeed = Filter::AddTruncation(driveSpeed);
 		
-	SmartDashboard::GetInstance()->Log(driveSpeed.Left, "(ARCADE DRIVE) Left speed ");
-	SmartDashboard::GetInstance()->Log(driveSpeed.Right, "(ARCADE DRIVE) Right speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Left, "(ARCADE DRIVE) Left speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Right, "(ARCADE DRIVE) Right speed ");
 	
 	mRobotDrive->TankDrive(driveSpeed.Left, driveSpeed.Right);
 }
 
+/**
+ * @brief Ignores the presses made while another controller was
+ * driving.
+ */
+void ArcadeJoystick::Enter()
+{
+	mJoystick->ClearEdges();
+}
+
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void ArcadeJoystick::Exit()
+{
+	Stop(mRobotDrive);
+}
+
 /**
  * This is copied directly from FIRST's source code for ArcadeDrive.
  */
@@ -290,7 +376,7 @@ DriveSpeed ArcadeJoystick::GetLeftAndRight(float moveValue, float rotateValue)
  * @param[in] joystick A pointer to the joystick (use the Extreme
  * 3d Pro joystick)
  */
-SingleJoystick::SingleJoystick(RobotDrive *robotDrive, Joystick *joystick)
+SingleJoystick::SingleJoystick(RobotDrive *robotDrive, SnapshotJoystick *joystick)
 {
 	mRobotDrive = robotDrive;
 	mJoystick = joystick;
@@ -314,13 +400,21 @@ void SingleJoystick::Run()
 	rotate *= speedFactor;
 	speed *= speedFactor;
 	
-	SmartDashboard::GetInstance()->Log(-rotate, "(ARCADE DRIVE) Rotate ");
-	SmartDashboard::GetInstance()->Log(-speed, "(ARCADE DRIVE) Speed ");
-	SmartDashboard::GetInstance()->Log(speedFactor, "(ARCADE DRIVE) Speed factor ");
+	Telemetry::GetInstance()->Log(-rotate, "(ARCADE DRIVE) Rotate ");
+	Telemetry::GetInstance()->Log(-speed, "(ARCADE DRIVE) Speed ");
+	Telemetry::GetInstance()->Log(speedFactor, "(ARCADE DRIVE) Speed factor ");
 		
 	mRobotDrive->ArcadeDrive(speed, rotate);
 }
 
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void SingleJoystick::Exit()
+{
+	Stop(mRobotDrive);
+}
+
 /**
  * @brief Temporary.
  */
@@ -337,13 +431,13 @@ float SingleJoystick::GetSpeedDecreaseFactor(void)
 	return normalizedFactor;
 }
 
-SafetyMode::SafetyMode(RobotDrive *robotdrive, Joystick *leftJoystick, Joystick *rightJoystick, Joystick *safetyJoystick)
+SafetyMode::SafetyMode(RobotDrive *robotdrive, SnapshotJoystick *leftJoystick, SnapshotJoystick *rightJoystick, SnapshotJoystick *safetyJoystick)
 {
 	mRobotDrive = robotdrive;
 	mLeftJoystick = leftJoystick;
 	mRightJoystick = rightJoystick;
 	mSafetyJoystick = safetyJoystick;
-	SmartDashboard::GetInstance()->PutString("(SAFETY) Speed << ", "0.3");
+	mSpeedFactor = Parameters::GetInstance()->AddFloat("(SAFETY) Speed << ", 0.3);
 }
 
 void SafetyMode::Run()
@@ -355,17 +449,17 @@ void SafetyMode::Run()
 	}
 	
 	
-	if (mRightJoystick->GetRawButton(6)) {
+	if (mRightJoystick->WasPressed(6)) {
 		mAreValuesSwapped = false;
-	} else if (mRightJoystick->GetRawButton(7)) {
+	} else if (mRightJoystick->WasPressed(7)) {
 		mAreValuesSwapped = true;
 	}
 	
 	if (mAreValuesSwapped) {
 		driveSpeed = Filter::ReverseDirection(driveSpeed);
-		SmartDashboard::GetInstance()->Log("reversed", "(TANK DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("reversed", "(TANK DRIVE) Driving orientation: ");
 	} else {
-		SmartDashboard::GetInstance()->Log("normal", "(TANK DRIVE) Driving orientation: ");
+		Telemetry::GetInstance()->Log("normal", "(TANK DRIVE) Driving orientation: ");
 	}
 	
 	driveSpeed = Filter::SquareInput(driveSpeed);
@@ -375,17 +469,33 @@ void SafetyMode::Run()
 		driveSpeed = Filter::Straighten(driveSpeed);	// Check both joysticks if the appropriate button is being pressed.
 	}
 
-	float speedFactor = Tools::StringToFloat(SmartDashboard::GetInstance()->GetString("(SAFETY) Speed << "));
-	driveSpeed = Filter::AddSpeedFactor(driveSpeed, speedFactor);
+	driveSpeed = Filter::AddSpeedFactor(driveSpeed, mSpeedFactor->Get());
 	
 	driveSpeed = Filter::AddTruncation(driveSpeed);
 	
-	SmartDashboard::GetInstance()->Log(driveSpeed.Left, "(SAFETY DRIVE) Left speed ");
-	SmartDashboard::GetInstance()->Log(driveSpeed.Right, "(SAFETY DRIVE) Right speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Left, "(SAFETY DRIVE) Left speed ");
+	Telemetry::GetInstance()->Log(driveSpeed.Right, "(SAFETY DRIVE) Right speed ");
 	
 	mRobotDrive->TankDrive(driveSpeed.Left, driveSpeed.Right);
 }
 
+/**
+ * @brief Ignores the presses made while another controller was
+ * driving.
+ */
+void SafetyMode::Enter()
+{
+	mRightJoystick->ClearEdges();
+}
+
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void SafetyMode::Exit()
+{
+	Stop(mRobotDrive);
+}
+
 
 /**
  * @brief A way to control the robot during Hybrid mode,
@@ -439,6 +549,14 @@ void BaseKinectController::HaltRobot(void)
 	mRobotDrive->TankDrive(0.0, 0.0);
 }
 
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void BaseKinectController::Exit()
+{
+	HaltRobot();
+}
+
 /**
  * @brief A way to control the robot by using the Kinect during
  * Hybrid mode, using the z-distance of the hands to control 
@@ -475,21 +593,21 @@ KinectController::KinectController(RobotDrive *robotDrive, Kinect *kinect):
 void KinectController::Run(void)
 {
 	bool isPlayerReady = IsPlayerReady();
-	SmartDashboard::GetInstance()->Log(isPlayerReady, "(KINECT) Player is ready ");
+	Telemetry::GetInstance()->Log(isPlayerReady, "(KINECT) Player is ready ");
 	
 	if (isPlayerReady) {
 		float left = GetLeftArmDistance();
 		float right = GetRightArmDistance();
 		mRobotDrive->TankDrive(left, right);
 			
-		SmartDashboard::GetInstance()->Log(left, "(KINECT) Left speed ");
-		SmartDashboard::GetInstance()->Log(right, "(KINECT) Right speed ");
+		Telemetry::GetInstance()->Log(left, "(KINECT) Left speed ");
+		Telemetry::GetInstance()->Log(right, "(KINECT) Right speed ");
 	} else {
 		HaltRobot();		
 	}
 	
 	bool isShooting = IsPlayerShooting();
-	SmartDashboard::GetInstance()->Log(isShooting, "(KINECT) Player is shooting ");
+	Telemetry::GetInstance()->Log(isShooting, "(KINECT) Player is shooting ");
 }
 
 /**
@@ -646,7 +764,7 @@ bool KinectAngleController::IsRaisingArm(void)
 	
 	float headDelta = headMoving - headOrigin;
 	
-	SmartDashboard::GetInstance()->Log(headDelta, "(KINECT) Head delta ");
+	Telemetry::GetInstance()->Log(headDelta, "(KINECT) Head delta ");
 	
 	if (fabs(headDelta) < kArmThreshold) {
 		return true;
@@ -679,13 +797,13 @@ bool KinectAngleController::IsRaisingArm(void)
 void KinectAngleController::Run(void)
 {
 	bool isPlayerReady = IsPlayerReady();
-	SmartDashboard::GetInstance()->Log(isPlayerReady, "(KINECT) Player is ready ");
+	Telemetry::GetInstance()->Log(isPlayerReady, "(KINECT) Player is ready ");
 	
 	if ( isPlayerReady ) {
 		float rightY = mRightKinectStick->GetY();
 		float leftY = mLeftKinectStick->GetY();
-		SmartDashboard::GetInstance()->Log(rightY, "(KINECT) Right speed ");
-		SmartDashboard::GetInstance()->Log(leftY, "(KINECT) Left speed ");
+		Telemetry::GetInstance()->Log(rightY, "(KINECT) Right speed ");
+		Telemetry::GetInstance()->Log(leftY, "(KINECT) Left speed ");
 		mRobotDrive->TankDrive(leftY * kSpeedDecreaseFactor * -1, rightY * kSpeedDecreaseFactor * -1);
 	} else {
 		HaltRobot();
@@ -695,9 +813,9 @@ void KinectAngleController::Run(void)
 	//bool isAutomaticallyShooting = IsAutomaticallyShooting();
 	bool isAutomaticallyShooting = false;
 	
-	SmartDashboard::GetInstance()->Log(isManuallyShooting, "(KINECT) Player is shooting manually ");
-	//SmartDashboard::GetInstance()->Log(isAutomaticallyShooting, "(KINECT) Player is shooting automatically ");
-	//SmartDashboard::GetInstance()->Log((isManuallyShooting && isAutomaticallyShooting), "(KINECT) Player is being stupid ");
+	Telemetry::GetInstance()->Log(isManuallyShooting, "(KINECT) Player is shooting manually ");
+	//Telemetry::GetInstance()->Log(isAutomaticallyShooting, "(KINECT) Player is shooting automatically ");
+	//Telemetry::GetInstance()->Log((isManuallyShooting && isAutomaticallyShooting), "(KINECT) Player is being stupid ");
 	
 	if (isManuallyShooting && !isAutomaticallyShooting) {
 		mShooter->SetSpeed(1.0);
@@ -710,8 +828,8 @@ void KinectAngleController::Run(void)
 	bool isRaisingArm = IsRaisingArm();
 	bool isLoweringArm = IsLoweringArm();
 	
-	SmartDashboard::GetInstance()->Log(isRaisingArm, "(KINECT) Player is raising arm ");
-	SmartDashboard::GetInstance()->Log(isLoweringArm, "(KINECT) Player is lowering arm ");
+	Telemetry::GetInstance()->Log(isRaisingArm, "(KINECT) Player is raising arm ");
+	Telemetry::GetInstance()->Log(isLoweringArm, "(KINECT) Player is lowering arm ");
 	
 	if (isRaisingArm) {
 		mArm->GoUp();
@@ -723,7 +841,7 @@ void KinectAngleController::Run(void)
 }
 
 XboxDrive::XboxDrive(RobotDrive *robotDrive, XboxController *xboxController) :
-	BaseController() 
+	BaseJoystickController() 
 {
 	mRobotDrive = robotDrive;
 	mXboxController = xboxController;
@@ -740,9 +858,17 @@ void XboxDrive::Run() {
 	mRobotDrive->ArcadeDrive(movement, rotation, true);
 }
 
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void XboxDrive::Exit()
+{
+	Stop(mRobotDrive);
+}
+
 
 XboxDriveSingle::XboxDriveSingle(RobotDrive *robotDrive, XboxController *xboxController) :
-	BaseController() 
+	BaseJoystickController() 
 {
 	mRobotDrive = robotDrive;
 	mXboxController = xboxController;
@@ -760,9 +886,9 @@ void XboxDriveSingle::Run() {
 		rotation = mXboxController->GetAxis(mXboxController->LeftX);
 	}
 	
-	if (mXboxController->GetButton(mXboxController->B)) {
+	if (mXboxController->WasPressed(mXboxController->B)) {
 		isRight = true;
-	} else if (mXboxController->GetButton(mXboxController->X)) {
+	} else if (mXboxController->WasPressed(mXboxController->X)) {
 		isRight = false;
 	}
 	
@@ -773,8 +899,25 @@ void XboxDriveSingle::Run() {
 	mRobotDrive->ArcadeDrive(movement, rotation, true);
 }
 
+/**
+ * @brief Ignores the presses made while another controller was
+ * driving.
+ */
+void XboxDriveSingle::Enter()
+{
+	mXboxController->ClearEdges();
+}
+
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void XboxDriveSingle::Exit()
+{
+	Stop(mRobotDrive);
+}
+
 XboxTankDrive::XboxTankDrive(RobotDrive *robotDrive, XboxController *xboxController) :
-	BaseController() 
+	BaseJoystickController() 
 {
 	mRobotDrive = robotDrive;
 	mXboxController = xboxController;
@@ -787,3 +930,11 @@ void XboxTankDrive::Run() {
 	
 	mRobotDrive->TankDrive(left, right);
 }
+
+/**
+ * @brief Stops the robot when switching to another controller.
+ */
+void XboxTankDrive::Exit()
+{
+	Stop(mRobotDrive);
+}
@@ -18,6 +18,7 @@
 
 // 3rd-party libraries
 #include "WPILib.h"
+#include "NetworkTables/NetworkTable.h"
 
 // Our code
 #include "../Definitions/components.h"
@@ -42,7 +43,7 @@ protected:
 	static const float kSpeedFactorMin = 0.3;
 	static const float kSpeedFactorMax = 1.0;
 	
-	float GetSpeedFactor(Joystick *);
+	float GetSpeedFactor(SnapshotJoystick *);
 	bool mAreValuesSwapped;
 
 	/**
@@ -65,13 +66,15 @@ class ArcadeJoystick : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 
 	DriveSpeed GetLeftAndRight(float, float);
 	
 public:
-	ArcadeJoystick(RobotDrive*, Joystick*);
+	ArcadeJoystick(RobotDrive*, SnapshotJoystick*);
 	void Run();
+	void Enter();
+	void Exit();
 	
 };
 
@@ -80,18 +83,36 @@ public:
  * @brief A container class to hold a series of
  * controllers to allow a user to switch between
  * them via the smart dashboard.
+ * 
+ * @details
+ * The dashboard value is only read when it changes (the
+ * switcher listens to the table), and is checked against
+ * the number of controllers at that point.  Run then only
+ * has to compare two ints before calling the current 
+ * controller.
+ * 
+ * When the selection changes, the old controller's Exit and
+ * the new controller's Enter are called from inside Run, so
+ * they happen on the same thread as every other Run.
  */
-class ControllerSwitcher : public BaseController
+class ControllerSwitcher : public BaseController, public NetworkTableChangeListener
 {
 protected:
 	vector <BaseController*> mControllers;
 	int mControllerSize;
 	const char *mLabel;
+	volatile int mRequested;	// Written by the NetworkTable thread
+	int mCurrent;
+	BaseController *mActive;
+	
+	void Switch(int);
 	
 public:
 	ControllerSwitcher(vector<BaseController*>);
 	virtual ~ControllerSwitcher();
 	void Run();
+	void ValueChanged(NetworkTable *, const char *, NetworkTables_Types);
+	void ValueConfirmed(NetworkTable *, const char *, NetworkTables_Types);
 };
 
 
@@ -106,12 +127,12 @@ public:
 class TestMotor : public BaseJoystickController
 {
 protected:
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 	SpeedController *mSpeedController;
 	const char *mName;
 	
 public:
-	TestMotor(Joystick *, SpeedController *, const char *);
+	TestMotor(SnapshotJoystick *, SpeedController *, const char *);
 	void Run();
 };
 
@@ -138,16 +159,18 @@ public:
 class TankJoysticks : public BaseJoystickController
 {
 protected:
-	Joystick *mLeftJoystick;
-	Joystick *mRightJoystick;
+	SnapshotJoystick *mLeftJoystick;
+	SnapshotJoystick *mRightJoystick;
 	RobotDrive *mRobotDrive;
 	
 	static const float kSpeedFactorMin = 0.3;
 	static const float kSpeedFactorMax = 1.0;
 	
 public:
-	TankJoysticks(RobotDrive *, Joystick *, Joystick *);
+	TankJoysticks(RobotDrive *, SnapshotJoystick *, SnapshotJoystick *);
 	void Run(void);
+	void Enter();
+	void Exit();
 };
 
 /**
@@ -162,12 +185,13 @@ class SingleJoystick : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 		
 public:
-	SingleJoystick(RobotDrive *, Joystick *);
+	SingleJoystick(RobotDrive *, SnapshotJoystick *);
 	float GetSpeedDecreaseFactor();
 	void Run(void);
+	void Exit();
 };
 
 /**
@@ -179,13 +203,16 @@ class SafetyMode : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
-	Joystick *mLeftJoystick;
-	Joystick *mRightJoystick;
-	Joystick *mSafetyJoystick;
+	SnapshotJoystick *mLeftJoystick;
+	SnapshotJoystick *mRightJoystick;
+	SnapshotJoystick *mSafetyJoystick;
+	FloatParameter *mSpeedFactor;
 
 public:
-	SafetyMode(RobotDrive *, Joystick *, Joystick *, Joystick *);
+	SafetyMode(RobotDrive *, SnapshotJoystick *, SnapshotJoystick *, SnapshotJoystick *);
 	void Run();
+	void Enter();
+	void Exit();
 };
 
 /**
@@ -200,6 +227,7 @@ protected:
 public:
 	BaseKinectController(RobotDrive *, Kinect *);
 	virtual void Run(void) = 0;
+	void Exit();
 	
 protected:
 	bool IsPlayerReady(void);
@@ -262,7 +290,7 @@ protected:
 	
 };
 
-class XboxDrive : public BaseController
+class XboxDrive : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
@@ -270,9 +298,10 @@ protected:
 public:
 	XboxDrive(RobotDrive *, XboxController *);
 	void Run();	
+	void Exit();
 };
 
-class XboxDriveSingle : public BaseController
+class XboxDriveSingle : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
@@ -281,9 +310,11 @@ protected:
 public:
 	XboxDriveSingle(RobotDrive *, XboxController *);
 	void Run();	
+	void Enter();
+	void Exit();
 };
 
-class XboxTankDrive : public BaseController
+class XboxTankDrive : public BaseJoystickController
 {
 protected:
 	RobotDrive *mRobotDrive;
@@ -291,6 +322,7 @@ protected:
 public:
 	XboxTankDrive(RobotDrive *, XboxController*);
 	void Run();
+	void Exit();
 };
 
 #endif
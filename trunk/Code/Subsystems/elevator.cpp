@@ -65,7 +65,7 @@ void Elevator::MoveDown(void)
  * @param[in] elevator Pointer to Elevator object.
  * @param[in] joystick Pointer to joystick.
  */
-ElevatorController::ElevatorController(Elevator *elevator, Joystick *joystick)
+ElevatorController::ElevatorController(Elevator *elevator, SnapshotJoystick *joystick)
 {
 	mElevator = elevator;
 	mJoystick = joystick;
@@ -104,6 +104,6 @@ void ElevatorController::Run(void) {
 		mElevator->Stop();
 	}
 	
-	//SmartDashboard::GetInstance()->Log(mElevator->IsBallAtTop(), "(ELEVATOR) Ball at top ");
-    //SmartDashboard::GetInstance()->Log(mElevator->IsBallAtBottom(), "(ELEVATOR) Ball at bottom ");
+	//Telemetry::GetInstance()->Log(mElevator->IsBallAtTop(), "(ELEVATOR) Ball at top ");
+    //Telemetry::GetInstance()->Log(mElevator->IsBallAtBottom(), "(ELEVATOR) Ball at bottom ");
 }
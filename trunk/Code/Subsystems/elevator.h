@@ -13,6 +13,8 @@
 
 // Our code
 #include "../Definitions/components.h"
+#include "../Client/input.h"
+#include "../telemetry.h"
 
 /**
  * @brief Transfers the ball from the floor to the top of the elevator.
@@ -40,10 +42,10 @@ class ElevatorController : public BaseController
 {
 protected:
 	Elevator *mElevator;
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 	
 public:
-	ElevatorController (Elevator *, Joystick* );
+	ElevatorController (Elevator *, SnapshotJoystick* );
 	void Run();
 };
 
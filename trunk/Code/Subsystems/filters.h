@@ -6,7 +6,7 @@
 #include <math.h>
 #include <algorithm>
 
-#include "../Definitions/Components.h"
+#include "../Definitions/components.h"
 #include "../tools.h"
 
 struct DriveSpeed
@@ -19,6 +19,7 @@ Shooter::Shooter(
 	mTopRightSpeedController = topRightSpeedController;
 	mBottomLeftSpeedController = bottomLeftSpeedController;
 	mBottomRightSpeedController = bottomRightSpeedController;
+	mRecorderChannel = FlightRecorder::GetInstance()->AddChannel("Shooter", "top", "bottom");
 }
 
 /**
@@ -37,6 +38,7 @@ Shooter::Shooter(
 void Shooter::SetSpeed(float speed)
 {
 	float slowSpeed = speed * kReductionFactor;
+	FlightRecorder::GetInstance()->Record(mRecorderChannel, slowSpeed, speed);
 	
 	mTopLeftSpeedController->Set(slowSpeed);
 	mTopRightSpeedController->Set(-1 * slowSpeed);
@@ -56,6 +58,7 @@ void Shooter::SetSpeed(float speed)
  */
 void Shooter::SetSpeed(float topSpeed, float bottomSpeed)
 {
+	FlightRecorder::GetInstance()->Record(mRecorderChannel, topSpeed, bottomSpeed);
 	mTopLeftSpeedController->Set(topSpeed);
 	mTopRightSpeedController->Set(topSpeed * -1);
 	mBottomLeftSpeedController->Set(bottomSpeed * -1);
@@ -64,7 +67,7 @@ void Shooter::SetSpeed(float topSpeed, float bottomSpeed)
 
 
 
-AutomaticShooterController::AutomaticShooterController(Shooter *shooter, Joystick *joystick, RangeFinder *rangeFinder) :
+AutomaticShooterController::AutomaticShooterController(Shooter *shooter, SnapshotJoystick *joystick, RangeFinder *rangeFinder) :
 		BaseController()
 {
 	mShooter = shooter;
@@ -78,7 +81,7 @@ void AutomaticShooterController::Run()
 	if (mJoystick->GetTrigger()) {
 		float calculatedSpeed = SetSpeedAutomatically();
 		mShooter->SetSpeed(calculatedSpeed);
-		SmartDashboard::GetInstance()->Log(calculatedSpeed, "(SHOOTER) Calculated ");
+		Telemetry::GetInstance()->Log(calculatedSpeed, "(SHOOTER) Calculated ");
 	}
 }
 
@@ -103,7 +106,7 @@ float AutomaticShooterController::SetSpeedAutomatically()
 	
 	float coercedSpeed = Tools::Coerce(speed, kMinSpeed, kMaxSpeed, 0, 1);
 	
-	SmartDashboard::GetInstance()->Log(coercedSpeed, "(SHOOTER) Auto speed ");
+	Telemetry::GetInstance()->Log(coercedSpeed, "(SHOOTER) Auto speed ");
 	
 	return coercedSpeed;
 }
@@ -162,20 +165,18 @@ float AutomaticShooterController::CalculateDistance()
  * @param[in] shooter Pointer to shooter.
  * @param[in] joystick Pointer to joystick.
  */
-ShooterController::ShooterController(Shooter *shooter, Joystick *joystick) :
+ShooterController::ShooterController(Shooter *shooter, SnapshotJoystick *joystick) :
 		BaseController()
 {
 	mShooter = shooter;
 	mJoystick = joystick;
-	mPresetOne = 0.24;
-	mPresetTwo = 0.39;
-	mPresetThree = 0.5;
 	
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	s->PutString("(SHOOTER) Preset 1 <<", Tools::FloatToString(mPresetOne).c_str());
-	s->PutString("(SHOOTER) Preset 2 <<", Tools::FloatToString(mPresetTwo).c_str());
-	s->PutString("(SHOOTER) Preset 3 <<", Tools::FloatToString(mPresetThree).c_str());
+	Parameters *p = Parameters::GetInstance();
+	mPresetOne = p->AddFloat("(SHOOTER) Preset 1 <<", 0.24);
+	mPresetTwo = p->AddFloat("(SHOOTER) Preset 2 <<", 0.39);
+	mPresetThree = p->AddFloat("(SHOOTER) Preset 3 <<", 0.5);
 	
+	Telemetry *s = Telemetry::GetInstance();
 	s->Log(0, "(SHOOTER) Manual ");
 	s->Log(0, "(SHOOTER) Calculated ");
 	s->Log(0, "(SHOOTER) Preset ");
@@ -190,7 +191,7 @@ ShooterController::ShooterController(Shooter *shooter, Joystick *joystick) :
  */
 void ShooterController::Run(void)
 {
-	SmartDashboard *s = SmartDashboard::GetInstance();
+	Telemetry *s = Telemetry::GetInstance();
 	
 	float raw_throttle = -mJoystick->GetTwist();
 	float throttle = Tools::Coerce(
@@ -201,7 +202,6 @@ void ShooterController::Run(void)
 			1.0);
 	s->Log(throttle, "(SHOOTER) Speed Factor ");
 	
-	UpdatePresets();
 	if (IsPressingPreset()) {
 		float out = GetPreset();
 		if (out >= 0) {
@@ -216,18 +216,6 @@ void ShooterController::Run(void)
 	}
 }
 
-/*
- * @brief Updates preset speeds for shooter buttons 
- * by taking user-entered input from SmartDashboard.
- */
-void ShooterController::UpdatePresets(void) 
-{
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	mPresetOne = Tools::StringToFloat(s->GetString("(SHOOTER) Preset 1 <<"));
-	mPresetTwo = Tools::StringToFloat(s->GetString("(SHOOTER) Preset 2 <<"));
-	mPresetThree = Tools::StringToFloat(s->GetString("(SHOOTER) Preset 3 <<"));
-}
-
 /*
  * @brief Finds out whether the user is pressing a preset button.
  */
@@ -243,11 +231,11 @@ bool ShooterController::IsPressingPreset()
 float ShooterController::GetPreset()
 {
 	if (mJoystick->GetRawButton(11)) {
-		return mPresetOne;
+		return mPresetOne->Get();
 	} else if (mJoystick->GetRawButton(9)) {
-		return mPresetTwo;
+		return mPresetTwo->Get();
 	} else if (mJoystick->GetRawButton(7)) {
-		return mPresetThree;
+		return mPresetThree->Get();
 	}
 	return -0.1;
 }
@@ -262,23 +250,19 @@ ShooterXboxController::ShooterXboxController(Shooter *shooter, Elevator *elevato
 	mElevator = elevator;
 	mXbox = xboxController;
 	
-	mPresetOne = 0.24;
-	mPresetTwo = 0.39;
-	mPresetThree = 0.5;
-	
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	s->PutString("(XBOX SHOOTER) Preset 1 <<", Tools::FloatToString(mPresetOne).c_str());
-	s->PutString("(XBOX SHOOTER) Preset 2 <<", Tools::FloatToString(mPresetTwo).c_str());
-	s->PutString("(XBOX SHOOTER) Preset 3 <<", Tools::FloatToString(mPresetThree).c_str());
+	Parameters *p = Parameters::GetInstance();
+	mPresetOne = p->AddFloat("(XBOX SHOOTER) Preset 1 <<", 0.24);
+	mPresetTwo = p->AddFloat("(XBOX SHOOTER) Preset 2 <<", 0.39);
+	mPresetThree = p->AddFloat("(XBOX SHOOTER) Preset 3 <<", 0.5);
 	
+	Telemetry *s = Telemetry::GetInstance();
 	s->Log(0, "(XBOX SHOOTER) Preset ");
 }
 
 void ShooterXboxController::Run(void)
 {
-	SmartDashboard *s = SmartDashboard::GetInstance();
+	Telemetry *s = Telemetry::GetInstance();
 	
-	UpdatePresets();
 	if (IsPressingPreset()) {
 		float out = GetPreset();
 		if (out >= 0) {
@@ -295,14 +279,6 @@ void ShooterXboxController::Run(void)
 	}
 }
 
-void ShooterXboxController::UpdatePresets(void) 
-{
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	mPresetOne = Tools::StringToFloat(s->GetString("(XBOX SHOOTER) Preset 1 <<"));
-	mPresetTwo = Tools::StringToFloat(s->GetString("(XBOX SHOOTER) Preset 2 <<"));
-	mPresetThree = Tools::StringToFloat(s->GetString("(XBOX SHOOTER) Preset 3 <<"));
-}
-
 bool ShooterXboxController::IsPressingPreset()
 {
 	return mXbox->GetButton(mXbox->A) or mXbox->GetButton(mXbox->X) or mXbox->GetButton(mXbox->Y);
@@ -311,11 +287,11 @@ bool ShooterXboxController::IsPressingPreset()
 float ShooterXboxController::GetPreset()
 {
 	if (mXbox->GetButton(mXbox->A)) {
-		return mPresetOne;
+		return mPresetOne->Get();
 	} else if (mXbox->GetButton(mXbox->X)) {
-		return mPresetTwo;
+		return mPresetTwo->Get();
 	} else if (mXbox->GetButton(mXbox->Y)) {
-		return mPresetThree;
+		return mPresetThree->Get();
 	}
 	return -0.1;
 }
@@ -332,31 +308,15 @@ float ShooterXboxController::GetPreset()
  * @param[in] shooter Pointer to the shooter
  * @param[in] joystick Pointer to a joystick
  */
-CalibratedShooterController::CalibratedShooterController(Shooter *shooter, Joystick *joystick) :
+CalibratedShooterController::CalibratedShooterController(Shooter *shooter, SnapshotJoystick *joystick) :
 		BaseController()
 {
 	mShooter = shooter;
 	mJoystick = joystick;
 	
-	mTopSpeed = 0.5;
-	mBottomSpeed = 0.5;
-	
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	
-	s->PutString("(SHOOTER) Top Speed <<", Tools::FloatToString(mTopSpeed).c_str());
-	s->PutString("(SHOOTER) Bottom Speed <<", Tools::FloatToString(mBottomSpeed).c_str());
-}
-
-/**
- * @brief Updates the speeds of the top and bottom speeds based on the 
- * values found in the SmartDashboard.
- */
-void CalibratedShooterController::UpdatePresets()
-{
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	
-	mTopSpeed = Tools::StringToFloat(s->GetString("(SHOOTER) Top Speed <<"));
-	mBottomSpeed = Tools::StringToFloat(s->GetString("(SHOOTER) Bottom Speed <<"));
+	Parameters *p = Parameters::GetInstance();
+	mTopSpeed = p->AddFloat("(SHOOTER) Top Speed <<", 0.5);
+	mBottomSpeed = p->AddFloat("(SHOOTER) Bottom Speed <<", 0.5);
 }
 
 /**
@@ -366,10 +326,8 @@ void CalibratedShooterController::UpdatePresets()
  */
 void CalibratedShooterController::Run()
 {
-	UpdatePresets();
-	
 	if (mJoystick->GetTrigger()) {
-		mShooter->SetSpeed(mTopSpeed, mBottomSpeed);
+		mShooter->SetSpeed(mTopSpeed->Get(), mBottomSpeed->Get());
 	} else {
 		mShooter->SetSpeed(0);
 	}
@@ -27,6 +27,7 @@
 #include "../Client/xbox.h"
 #include "elevator.h"
 #include "../tools.h"
+#include "../parameters.h"
 
 /**
  * @brief Controls the shooter.
@@ -44,6 +45,8 @@ protected:
 	SpeedController *mBottomRightSpeedController;
 	
 	static const float kReductionFactor = 0.9;
+	
+	int mRecorderChannel;
 
 public:
     Shooter(SpeedController*, SpeedController*, SpeedController*, SpeedController*);
@@ -59,7 +62,7 @@ class AutomaticShooterController : public BaseController
 {
 protected:
 	Shooter *mShooter;
-	Joystick *mJoystick;
+	SnapshotJoystick *mJoystick;
 	RangeFinder *mRangeFinder;
 	static const float kShooterAngle = 45;
 	static const float kShooterHeight = 50;
@@ -71,7 +74,7 @@ protected:
 	static const float kMaxInitialVelocity = 336;
 
 public:
-    AutomaticShooterController(Shooter*, Joystick*, RangeFinder*);
+    AutomaticShooterController(Shooter*, SnapshotJoystick*, RangeFinder*);
     void Run();
     float SetSpeedAutomatically();
     float CalculateSpeed(float);
@@ -90,14 +93,12 @@ class CalibratedShooterController : public BaseController
 {
 protected:
 	Shooter *mShooter;
-	Joystick *mJoystick;
-	float mTopSpeed;
-	float mBottomSpeed;
-	
-	void UpdatePresets();
+	SnapshotJoystick *mJoystick;
+	FloatParameter *mTopSpeed;
+	FloatParameter *mBottomSpeed;
 	
 public:
-	CalibratedShooterController(Shooter *, Joystick *);
+	CalibratedShooterController(Shooter *, SnapshotJoystick *);
 	void Run();
 };
 
@@ -108,16 +109,15 @@ class ShooterController : public BaseController
 {
 protected:
 	Shooter *mShooter;
-	Joystick *mJoystick;
-	float mPresetOne;
-	float mPresetTwo;
-	float mPresetThree;
-	void UpdatePresets();
+	SnapshotJoystick *mJoystick;
+	FloatParameter *mPresetOne;
+	FloatParameter *mPresetTwo;
+	FloatParameter *mPresetThree;
 	bool IsPressingPreset();
 	float GetPreset();
 	
 public:
-	ShooterController(Shooter *, Joystick *);
+	ShooterController(Shooter *, SnapshotJoystick *);
 	void Run();
 };
 
@@ -127,10 +127,9 @@ protected:
 	Shooter *mShooter;
 	XboxController *mXbox;
 	Elevator *mElevator;
-	float mPresetOne;
-	float mPresetTwo;
-	float mPresetThree;
-	void UpdatePresets();
+	FloatParameter *mPresetOne;
+	FloatParameter *mPresetTwo;
+	FloatParameter *mPresetThree;
 	bool IsPressingPreset();
 	float GetPreset();
 	
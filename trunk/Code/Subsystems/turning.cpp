@@ -0,0 +1,148 @@
+#include "turning.h"
+
+HeadingTurn::HeadingTurn(RobotDrive *robotDrive, Gyro *gyro) :
+		BaseComponent()
+{
+	mRobotDrive = robotDrive;
+	mGyro = gyro;
+	mState = kIdle;
+	mHeading = 0;
+	mError = 0;
+	mStartTime = 0;
+	mSettledTime = -1;
+	mLastAngle = 0;
+	mLastTime = 0;
+}
+
+/**
+ * @brief Starts turning towards a heading.  Restarts the timeout
+ * if a turn is already going.
+ * 
+ * @param[in] heading The gyro angle to turn to, in degrees.
+ */
+void HeadingTurn::Start(float heading)
+{
+	mState = kTurning;
+	mHeading = heading;
+	mStartTime = Timer::GetFPGATimestamp();
+	mSettledTime = -1;
+	mLastAngle = mGyro->GetAngle();
+	mLastTime = mStartTime;
+	mError = mHeading - mLastAngle;
+}
+
+/**
+ * @brief Moves the heading of a turn that is already going,
+ * without restarting the timeout (for example, when a newer
+ * picture of the target arrives).  Does nothing otherwise.
+ */
+void HeadingTurn::SetHeading(float heading)
+{
+	if (mState != kTurning) {
+		return;
+	}
+	if (fabs(heading - mHeading) > kTolerance) {
+		mSettledTime = -1;
+	}
+	mHeading = heading;
+}
+
+/**
+ * @brief Stops the turn where it is.
+ */
+void HeadingTurn::Cancel()
+{
+	if (mState == kTurning) {
+		Finish(kCancelled);
+	}
+}
+
+/**
+ * @brief Sets the motors for this tick.  Call once per tick while
+ * turning; does nothing once the turn is over.
+ * 
+ * @returns The state after this step.
+ */
+HeadingTurn::State HeadingTurn::Step()
+{
+	if (mState != kTurning) {
+		return mState;
+	}
+	
+	double now = Timer::GetFPGATimestamp();
+	float angle = mGyro->GetAngle();
+	double rate = 0;
+	if (now > mLastTime) {
+		rate = (angle - mLastAngle) / (now - mLastTime);
+	}
+	mLastAngle = angle;
+	mLastTime = now;
+	mError = mHeading - angle;
+	
+	if (now - mStartTime > kTimeout) {
+		Finish(kTimedOut);
+		return mState;
+	}
+	if (fabs(mError) <= kTolerance) {
+		if (mSettledTime < 0) {
+			mSettledTime = now;
+		}
+		if (now - mSettledTime >= kSettleTime) {
+			Finish(kDone);
+		} else {
+			mRobotDrive->TankDrive(0.0, 0.0);
+		}
+		return mState;
+	}
+	mSettledTime = -1;
+	
+	double power = kProportional * mError - kDerivative * rate;
+	if (power > kMaxPower) {
+		power = kMaxPower;
+	} else if (power < -kMaxPower) {
+		power = -kMaxPower;
+	}
+	if ((fabs(power) < kMinPower) and (fabs(rate) < kStallRate)) {
+		power = (mError > 0) ? kMinPower : -kMinPower;
+	}
+	
+	// Driving the left side backwards turns the robot
+	// anticlockwise, which makes the gyro's angle go up.  The
+	// inputs aren't squared, or the gains would depend on the power.
+	mRobotDrive->TankDrive((float) -power, (float) power, false);
+	return mState;
+}
+
+void HeadingTurn::Finish(State state)
+{
+	mState = state;
+	mSettledTime = -1;
+	mRobotDrive->TankDrive(0.0, 0.0);
+}
+
+HeadingTurn::State HeadingTurn::GetState()
+{
+	return mState;
+}
+
+bool HeadingTurn::IsTurning()
+{
+	return mState == kTurning;
+}
+
+/**
+ * @brief The gyro angle being turned to, in degrees.
+ */
+float HeadingTurn::GetHeading()
+{
+	return mHeading;
+}
+
+/**
+ * @brief How far the robot was from the heading at the last step,
+ * in degrees.
+ */
+float HeadingTurn::GetError()
+{
+	return mError;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file turning.h
+ * 
+ * @brief Turns the robot in place to a gyro heading, a little at
+ * a time, so the turn never holds up the control loop.
+ * 
+ * @details
+ * Usage:
+ * @code
+ * // Once
+ * turn.Start(heading);
+ * 
+ * // In a controller's Run, every tick
+ * if (turn.Step() == HeadingTurn::kDone) {
+ *     // facing the heading
+ * }
+ * @endcode
+ */
+
+#ifndef TURNING_H_
+#define TURNING_H_
+
+// System libraries
+#include <math.h>
+
+// 3rd-party libraries
+#include "WPILib.h"
+
+// Our code
+#include "../Definitions/components.h"
+
+/**
+ * @brief Turns the robot to a gyro angle with a PD loop, one step
+ * per call to Step.
+ * 
+ * @details
+ * The motor power is kProportional times the error, less
+ * kDerivative times the rate the robot is turning at, so it slows
+ * down as it closes in.  The power is at most kMaxPower.  While
+ * the robot is turning slower than kStallRate it is at least
+ * kMinPower, as anything less doesn't get the robot moving.
+ * 
+ * A turn is done once the gyro has stayed within kTolerance of the
+ * heading for kSettleTime, and gives up after kTimeout.  Either
+ * way, or if it's cancelled, the motors are stopped.
+ * 
+ * Headings are in degrees, in the gyro's own terms (which, as the
+ * gyro is mounted upside-down, go down as the robot turns
+ * clockwise).
+ */
+class HeadingTurn : public BaseComponent
+{
+public:
+	enum State
+	{
+		kIdle,			// Never started
+		kTurning,
+		kDone,
+		kTimedOut,
+		kCancelled
+	};
+	
+	static const double kTolerance = 0.5;		// In degrees
+	static const double kSettleTime = 0.1;		// In seconds
+	static const double kTimeout = 2.0;			// In seconds
+	static const double kProportional = 0.02;	// Power per degree
+	static const double kDerivative = 0.002;	// Power per degree per second
+	static const double kMinPower = 0.15;
+	static const double kStallRate = 10;		// In degrees per second
+	static const double kMaxPower = 0.6;
+	
+	HeadingTurn(RobotDrive *, Gyro *);
+	void Start(float);
+	void SetHeading(float);
+	void Cancel();
+	State Step();
+	
+	State GetState();
+	bool IsTurning();
+	float GetHeading();
+	float GetError();
+	
+protected:
+	RobotDrive *mRobotDrive;
+	Gyro *mGyro;
+	State mState;
+	float mHeading;
+	float mError;
+	double mStartTime;
+	double mSettledTime;	// When the gyro came within tolerance, or -1 if it isn't
+	float mLastAngle;
+	double mLastTime;
+	
+	void Finish(State);
+};
+
+#endif
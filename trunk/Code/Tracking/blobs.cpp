@@ -0,0 +1,448 @@
+#include "blobs.h"
+
+// Standard library
+#include <math.h>
+#include <stdlib.h>
+
+namespace
+{
+	const int kInitialLabels = 256;
+	const int kInitialRuns = 1024;
+	
+	/**
+	 * The score of a pixel for each corner: the top left corner is
+	 * the pixel with the smallest x + y, and so on.
+	 */
+	inline int CornerScore(int corner, int x, int y)
+	{
+		switch (corner) {
+		case 0:
+			return -(x + y);	// Top left
+		case 1:
+			return x - y;		// Top right
+		case 2:
+			return x + y;		// Bottom right
+		default:
+			return y - x;		// Bottom left
+		}
+	}
+	
+	/**
+	 * 0 + 1 + 4 + ... + n * n
+	 */
+	inline double SumOfSquares(int n)
+	{
+		return (double) n * (n + 1) * (2 * n + 1) / 6;
+	}
+	
+	int GreatestCommonDivisor(int a, int b)
+	{
+		a = abs(a);
+		b = abs(b);
+		while (b != 0) {
+			int t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+	
+	double Distance(float x1, float y1, float x2, float y2)
+	{
+		double dx = x2 - x1;
+		double dy = y2 - y1;
+		return sqrt(dx * dx + dy * dy);
+	}
+}
+
+/**
+ * @brief The options a new BlobFinder starts with, sized for a
+ * 640x480 picture.
+ */
+BlobFinder::Options BlobFinder::DefaultOptions()
+{
+	Options options;
+	options.MinThickness = 3;
+	options.MinWidth = 10;
+	options.MaxWidth = 400;
+	options.MinHeight = 10;
+	options.MaxHeight = 400;
+	options.MinScore = 0;
+	return options;
+}
+
+BlobFinder::BlobFinder()
+{
+	mOptions = DefaultOptions();
+	mLabelCount = 0;
+	mParents.reserve(kInitialLabels);
+	mTotals.reserve(kInitialLabels);
+	mRunLabels.reserve(kInitialRuns);
+	mRootRuns.reserve(kInitialRuns);
+}
+
+void BlobFinder::SetOptions(const Options &options)
+{
+	mOptions = options;
+}
+
+const BlobFinder::Options &BlobFinder::GetOptions()
+{
+	return mOptions;
+}
+
+/**
+ * @brief How many labels the last Find handed out, before any were
+ * joined.  A rough measure of how much work it did.
+ */
+int BlobFinder::GetLabelCount()
+{
+	return mLabelCount;
+}
+
+/**
+ * @brief Finds every blob in the mask that passes the options.
+ * 
+ * @param[in] runs The mask to search.
+ * @param[out] blobs Emptied, then filled in top-to-bottom order of
+ * each blob's first pixel.
+ */
+void BlobFinder::Find(const RunMask &runs, std::vector<Blob> &blobs)
+{
+	blobs.clear();
+	int height = runs.GetHeight();
+	const MaskRun *all = runs.GetRuns();
+	mRunLabels.resize(runs.GetRunCount());
+	mRunRows.resize(runs.GetRunCount());
+	mParents.clear();
+	mTotals.clear();
+	mLabelCount = 0;
+	NewLabel();		// The background
+	
+	for (int y=0; y<height; y++) {
+		int first = runs.GetRowStart(y);
+		int last = runs.GetRowStart(y + 1);
+		int above = (y > 0) ? runs.GetRowStart(y - 1) : first;
+		for (int i=first; i<last; i++) {
+			const MaskRun &run = all[i];
+			
+			// Skip runs above that end too far left to touch this one,
+			// even at a corner.  The last one that does touch may
+			// touch the next run too, so start from it next time.
+			while ((above < first) and (all[above].End < run.Start - 1)) {
+				above++;
+			}
+			int label = 0;
+			for (int j=above; (j < first) and (all[j].Start <= run.End + 1); j++) {
+				int root = FindRoot(mRunLabels[j]);
+				label = (label == 0) ? root : Join(label, root);
+			}
+			if (label == 0) {
+				label = NewLabel();
+			}
+			mRunLabels[i] = label;
+			mRunRows[i] = y;
+			Add(mTotals[label], y, run.Start, run.End);
+		}
+	}
+	
+	// Fold every joined label's totals into its root's.
+	for (int label=mLabelCount-1; label>0; label--) {
+		int root = FindRoot(label);
+		if (root != label) {
+			Merge(mTotals[root], mTotals[label]);
+		}
+	}
+	GroupRuns(runs.GetRunCount());
+	for (int label=1; label<mLabelCount; label++) {
+		if (mParents[label] != label) {
+			continue;
+		}
+		Blob blob;
+		blob.HullArea = MeasureHull(runs, label);
+		if (Fit(mTotals[label], blob)) {
+			blobs.push_back(blob);
+		}
+	}
+}
+
+/**
+ * @brief The same, for a packed mask.  It's turned into runs first.
+ */
+void BlobFinder::Find(const PackedMask &mask, std::vector<Blob> &blobs)
+{
+	mEncoded.FromPacked(mask);
+	Find(mEncoded, blobs);
+}
+
+int BlobFinder::NewLabel()
+{
+	int label = mLabelCount;
+	mParents.push_back(label);
+	Totals totals;
+	totals.Area = 0;
+	totals.SumX = 0;
+	totals.SumY = 0;
+	totals.SumXX = 0;
+	totals.SumXY = 0;
+	totals.SumYY = 0;
+	mTotals.push_back(totals);
+	mLabelCount++;
+	return label;
+}
+
+int BlobFinder::FindRoot(int label)
+{
+	while (mParents[label] != label) {
+		mParents[label] = mParents[mParents[label]];	// Path halving
+		label = mParents[label];
+	}
+	return label;
+}
+
+/**
+ * @brief Joins two roots, keeping the smaller label as the root.
+ * 
+ * @returns The new root.
+ */
+int BlobFinder::Join(int a, int b)
+{
+	if (a == b) {
+		return a;
+	}
+	if (a < b) {
+		mParents[b] = a;
+		return a;
+	}
+	mParents[a] = b;
+	return b;
+}
+
+/**
+ * @brief Adds the pixels from start to end (inclusive) of row y.
+ */
+void BlobFinder::Add(Totals &totals, int y, int start, int end)
+{
+	if (totals.Area == 0) {
+		totals.Left = start;
+		totals.Right = end;
+		totals.Top = y;
+		totals.Bottom = y;
+		for (int c=0; c<4; c++) {
+			int x = ((c == 1) or (c == 2)) ? end : start;
+			totals.CornerX[c] = x;
+			totals.CornerY[c] = y;
+			totals.CornerScore[c] = CornerScore(c, x, y);
+		}
+	} else {
+		if (start < totals.Left) {
+			totals.Left = start;
+		}
+		if (end > totals.Right) {
+			totals.Right = end;
+		}
+		totals.Bottom = y;		// Rows are visited in order
+		for (int c=0; c<4; c++) {
+			// Each corner's best pixel in a run is one of its ends.
+			int x = ((c == 1) or (c == 2)) ? end : start;
+			int score = CornerScore(c, x, y);
+			if (score > totals.CornerScore[c]) {	// Ties keep the first pixel, like a raster scan would
+				totals.CornerX[c] = x;
+				totals.CornerY[c] = y;
+				totals.CornerScore[c] = score;
+			}
+		}
+	}
+	int length = end - start + 1;
+	double sumX = (double) (start + end) * length / 2;
+	totals.Area += length;
+	totals.SumX += sumX;
+	totals.SumY += (double) y * length;
+	totals.SumXX += SumOfSquares(end) - SumOfSquares(start - 1);
+	totals.SumXY += sumX * y;
+	totals.SumYY += (double) y * y * length;
+}
+
+void BlobFinder::Merge(Totals &to, const Totals &from)
+{
+	if (from.Area == 0) {
+		return;
+	}
+	if (to.Area == 0) {
+		to = from;
+		return;
+	}
+	if (from.Left < to.Left) {
+		to.Left = from.Left;
+	}
+	if (from.Right > to.Right) {
+		to.Right = from.Right;
+	}
+	if (from.Top < to.Top) {
+		to.Top = from.Top;
+	}
+	if (from.Bottom > to.Bottom) {
+		to.Bottom = from.Bottom;
+	}
+	for (int c=0; c<4; c++) {
+		bool isBetter = (from.CornerScore[c] > to.CornerScore[c]);
+		if (from.CornerScore[c] == to.CornerScore[c]) {
+			// Same score; keep whichever comes first in a raster scan.
+			isBetter = (from.CornerY[c] < to.CornerY[c])
+					or ((from.CornerY[c] == to.CornerY[c]) and (from.CornerX[c] < to.CornerX[c]));
+		}
+		if (isBetter) {
+			to.CornerX[c] = from.CornerX[c];
+			to.CornerY[c] = from.CornerY[c];
+			to.CornerScore[c] = from.CornerScore[c];
+		}
+	}
+	to.Area += from.Area;
+	to.SumX += from.SumX;
+	to.SumY += from.SumY;
+	to.SumXX += from.SumXX;
+	to.SumXY += from.SumXY;
+	to.SumYY += from.SumYY;
+}
+
+/**
+ * @brief Sorts the run indexes by blob (a counting sort, so each
+ * blob's runs stay top to bottom), pointing every run's label at
+ * its root on the way.
+ */
+void BlobFinder::GroupRuns(int runCount)
+{
+	mRootStarts.assign(mLabelCount + 1, 0);
+	for (int i=0; i<runCount; i++) {
+		mRunLabels[i] = FindRoot(mRunLabels[i]);
+		mRootStarts[mRunLabels[i] + 1]++;
+	}
+	for (int label=0; label<mLabelCount; label++) {
+		mRootStarts[label + 1] += mRootStarts[label];
+	}
+	mRootRuns.resize(runCount);
+	for (int i=0; i<runCount; i++) {
+		mRootRuns[mRootStarts[mRunLabels[i]]++] = i;
+	}
+	
+	// Each start was moved up to the next one's; move them back.
+	for (int label=mLabelCount; label>0; label--) {
+		mRootStarts[label] = mRootStarts[label - 1];
+	}
+	mRootStarts[0] = 0;
+}
+
+/**
+ * @brief Counts the pixels inside a blob's convex hull.
+ * 
+ * @details
+ * Only the ends of each row can be corners of the hull, so the
+ * hull is found from those with Andrew's monotone chain (they're
+ * already in order, top to bottom and left to right).  The pixels
+ * inside are then counted with Pick's theorem: area + half the
+ * pixels on the edges + 1.
+ */
+int BlobFinder::MeasureHull(const RunMask &runs, int root)
+{
+	const MaskRun *all = runs.GetRuns();
+	mEnds.clear();
+	int end = mRootStarts[root + 1];
+	int rowY = -1;
+	for (int k=mRootStarts[root]; k<end; k++) {
+		int i = mRootRuns[k];
+		int y = mRunRows[i];
+		Point left = {all[i].Start, y};
+		Point right = {all[i].End, y};
+		if (y == rowY) {
+			mEnds.back() = right;		// A later run in the same row; the left end stays put
+			continue;
+		}
+		rowY = y;
+		mEnds.push_back(left);
+		mEnds.push_back(right);		// Even if it's the same point; the chains drop it
+	}
+	
+	int count = (int) mEnds.size();
+	if (count == 2) {
+		return GreatestCommonDivisor(mEnds[1].X - mEnds[0].X, mEnds[1].Y - mEnds[0].Y) + 1;
+	}
+	
+	// One chain forwards and one backwards, dropping every point that
+	// doesn't make a turn the same way.
+	mHull.resize(2 * count);
+	int size = 0;
+	for (int pass=0; pass<2; pass++) {
+		int chainStart = size;
+		for (int n=0; n<count; n++) {
+			const Point &p = (pass == 0) ? mEnds[n] : mEnds[count - 1 - n];
+			while (size >= chainStart + 2) {
+				const Point &a = mHull[size - 2];
+				const Point &b = mHull[size - 1];
+				long cross = (long) (b.X - a.X) * (p.Y - a.Y) - (long) (b.Y - a.Y) * (p.X - a.X);
+				if (cross < 0) {
+					break;
+				}
+				size--;
+			}
+			mHull[size++] = p;
+		}
+		size--;		// The last point starts the other chain
+	}
+	
+	long twiceArea = 0;
+	int edgePixels = 0;
+	for (int n=0; n<size; n++) {
+		const Point &a = mHull[n];
+		const Point &b = mHull[(n + 1) % size];
+		twiceArea += (long) a.X * b.Y - (long) b.X * a.Y;
+		edgePixels += GreatestCommonDivisor(b.X - a.X, b.Y - a.Y);
+	}
+	return (int) ((labs(twiceArea) + edgePixels) / 2 + 1);
+}
+
+/**
+ * @brief Works out a blob's shape from its totals.
+ * 
+ * @returns False if the options say to drop it.
+ */
+bool BlobFinder::Fit(const Totals &totals, Blob &blob)
+{
+	int boxWidth = totals.Right - totals.Left + 1;
+	int boxHeight = totals.Bottom - totals.Top + 1;
+	if ((boxWidth < mOptions.MinThickness) or (boxHeight < mOptions.MinThickness)) {
+		return false;
+	}
+	
+	blob.Area = totals.Area;
+	blob.Left = totals.Left;
+	blob.Top = totals.Top;
+	blob.Right = totals.Right;
+	blob.Bottom = totals.Bottom;
+	blob.CenterX = totals.SumX / totals.Area;
+	blob.CenterY = totals.SumY / totals.Area;
+	double xx = totals.SumXX / totals.Area - blob.CenterX * blob.CenterX;
+	double xy = totals.SumXY / totals.Area - blob.CenterX * blob.CenterY;
+	double yy = totals.SumYY / totals.Area - blob.CenterY * blob.CenterY;
+	blob.Orientation = 0.5 * atan2(2 * xy, xx - yy) * 180.0 / M_PI;
+	
+	for (int c=0; c<4; c++) {
+		blob.CornerX[c] = (float) totals.CornerX[c];
+		blob.CornerY[c] = (float) totals.CornerY[c];
+	}
+	const float *x = blob.CornerX;
+	const float *y = blob.CornerY;
+	blob.Width = (Distance(x[0], y[0], x[1], y[1]) + Distance(x[3], y[3], x[2], y[2])) / 2 + 1;
+	blob.Height = (Distance(x[0], y[0], x[3], y[3]) + Distance(x[1], y[1], x[2], y[2])) / 2 + 1;
+	blob.Rotation = atan2(y[1] - y[0], x[1] - x[0]) * 180.0 / M_PI;
+	
+	// Like the filled-in hull NI would score, compared to the fitted
+	// rectangle.
+	blob.Score = 100.0 * blob.HullArea / (blob.Width * blob.Height);
+	if (blob.Score > 100) {
+		blob.Score = 100;
+	}
+	
+	return (blob.Width >= mOptions.MinWidth) and (blob.Width <= mOptions.MaxWidth)
+			and (blob.Height >= mOptions.MinHeight) and (blob.Height <= mOptions.MaxHeight)
+			and (blob.Score >= mOptions.MinScore);
+}
@@ -0,0 +1,151 @@
+/**
+ * @file blobs.h
+ * 
+ * @brief Finds the blobs (groups of touching pixels) in a RunMask
+ * and fits a four-cornered shape to each, without NI Vision.
+ * 
+ * @details
+ * This does the work of RemoveSmallObjects, ConvexHull and
+ * imaqDetectRectangles on the mask's runs, never on single pixels:
+ *   - Runs are labeled row by row, and a run touching runs in the
+ *     row above joins their labels using union-find.
+ *   - Each label keeps running totals (area, moments, bounding box
+ *     and its most extreme pixel along each diagonal), worked out
+ *     for a whole run at once and added together when labels are
+ *     joined.
+ *   - The four corners are the extreme pixels along the diagonals.
+ *   - The convex hull is built from the two ends of each row of
+ *     the blob, and only its area is kept: that's all the score
+ *     needs, so the hull is never filled in.
+ * 
+ * Width, height, rotation and score are worked out the same way as
+ * for NI's RectangleMatch, so a Blob can stand in for one.
+ * 
+ * Usage:
+ * @code
+ * BlobFinder finder;
+ * vector<Blob> blobs;
+ * finder.Find(runs, blobs);
+ * @endcode
+ * 
+ * Like mask.h, this uses nothing from WPILib or nivision.
+ */
+
+#ifndef BLOBS_H_
+#define BLOBS_H_
+
+// Standard library
+#include <vector>
+
+// Program modules
+#include "mask.h"
+
+/**
+ * @brief One blob, with its corners in the order top left, top
+ * right, bottom right, bottom left.
+ */
+struct Blob
+{
+	int Area;		// In pixels
+	int Left;		// Bounding box, inclusive
+	int Top;
+	int Right;
+	int Bottom;
+	
+	double CenterX;		// Center of mass
+	double CenterY;
+	double Orientation;	// Of the long axis, from the moments; in degrees
+	
+	float CornerX[4];
+	float CornerY[4];
+	
+	double Width;		// Same meaning as in RectangleMatch
+	double Height;
+	double Rotation;	// In degrees
+	int HullArea;		// Pixels inside the convex hull
+	double Score;		// 0 to 100; how much of the fitted rectangle the hull covers
+};
+
+/**
+ * @brief Labels a mask and measures the blobs in it.
+ * 
+ * @details
+ * Pixels touching on any side or corner are in the same blob.
+ * Buffers are kept between calls, so once it has seen a picture of
+ * a given size (and about as many runs) Find allocates nothing.
+ */
+class BlobFinder
+{
+public:
+	/**
+	 * @brief Which blobs to keep.
+	 */
+	struct Options
+	{
+		int MinThickness;	// Blobs thinner than this (in pixels) are dropped, like RemoveSmallObjects
+		double MinWidth;	// Like RectangleDescriptor
+		double MaxWidth;
+		double MinHeight;
+		double MaxHeight;
+		double MinScore;
+	};
+	
+	static Options DefaultOptions();
+	
+	BlobFinder();
+	void SetOptions(const Options &);
+	const Options &GetOptions();
+	
+	void Find(const RunMask &, std::vector<Blob> &);
+	void Find(const PackedMask &, std::vector<Blob> &);
+	int GetLabelCount();
+	
+protected:
+	struct Totals
+	{
+		int Area;
+		int Left;
+		int Top;
+		int Right;
+		int Bottom;
+		double SumX;
+		double SumY;
+		double SumXX;
+		double SumXY;
+		double SumYY;
+		int CornerX[4];
+		int CornerY[4];
+		int CornerScore[4];
+	};
+	
+	struct Point
+	{
+		int X;
+		int Y;
+	};
+	
+	Options mOptions;
+	std::vector<int> mRunLabels;		// For each run of the mask
+	std::vector<int> mRunRows;
+	std::vector<int> mParents;		// Union-find; label 0 is the background
+	std::vector<Totals> mTotals;
+	int mLabelCount;
+	
+	std::vector<int> mRootRuns;		// Run indexes, grouped by blob
+	std::vector<int> mRootStarts;		// Where each label's group starts in mRootRuns
+	std::vector<Point> mEnds;		// Ends of the rows of one blob
+	std::vector<Point> mHull;
+	
+	RunMask mEncoded;			// For the PackedMask version of Find
+	
+	int NewLabel();
+	int FindRoot(int);
+	int Join(int, int);
+	void Add(Totals &, int, int, int);
+	void Merge(Totals &, const Totals &);
+	void GroupRuns(int);
+	int MeasureHull(const RunMask &, int);
+	bool Fit(const Totals &, Blob &);
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include "camera.h"
+
+/**
+ * @param[in] address The camera's IP address.
+ */
+CameraSession::CameraSession(const char *address) :
+		mCamera(AxisCamera::GetInstance(address))
+{
+	mResolution = AxisCamera::kResolution_640x480;
+	mCompression = kDefaultCompression;
+	mMaxFPS = 0;
+	mBrightness = kDefaultBrightness;
+	mWhiteBalance = AxisCamera::kWhiteBalance_Automatic;
+	
+	mIsConnected = false;
+	mHasConnected = false;
+	mIsFramePending = false;
+	mLastFrameTime = 0;
+	mFrameTimestamp = 0;
+	mLatency = 0;
+	mConfigureCount = 0;
+	mReconnectCount = 0;
+	
+	Configure();
+}
+
+AxisCamera &CameraSession::GetCamera()
+{
+	return mCamera;
+}
+
+/**
+ * @brief Changes the resolution, sending it to the camera only if
+ * it's different.
+ */
+void CameraSession::SetResolution(AxisCamera::Resolution_t resolution)
+{
+	if (resolution != mResolution) {
+		mResolution = resolution;
+		mCamera.WriteResolution(mResolution);
+	}
+}
+
+void CameraSession::SetCompression(int compression)
+{
+	if (compression != mCompression) {
+		mCompression = compression;
+		mCamera.WriteCompression(mCompression);
+	}
+}
+
+/**
+ * @brief Limits how many pictures a second the camera sends, or
+ * 0 for as many as it can.
+ */
+void CameraSession::SetMaxFPS(int maxFPS)
+{
+	if (maxFPS != mMaxFPS) {
+		mMaxFPS = maxFPS;
+		mCamera.WriteMaxFPS(mMaxFPS);
+	}
+}
+
+/**
+ * @brief Changes the brightness, from 0 to 100.
+ * 
+ * @details
+ * The colour thresholds in TargetUtils were tuned at
+ * kDefaultBrightness, so they'll need retuning after a change.
+ */
+void CameraSession::SetBrightness(int brightness)
+{
+	if (brightness != mBrightness) {
+		mBrightness = brightness;
+		mCamera.WriteBrightness(mBrightness);
+	}
+}
+
+void CameraSession::SetWhiteBalance(AxisCamera::WhiteBalance_t whiteBalance)
+{
+	if (whiteBalance != mWhiteBalance) {
+		mWhiteBalance = whiteBalance;
+		mCamera.WriteWhiteBalance(mWhiteBalance);
+	}
+}
+
+/**
+ * @brief Sends every setting to the camera.
+ * 
+ * @details
+ * Called once when the session starts and after every reconnect;
+ * there should be no need to call it otherwise.
+ */
+void CameraSession::Configure()
+{
+	mCamera.WriteResolution(mResolution);
+	mCamera.WriteCompression(mCompression);
+	if (mMaxFPS > 0) {
+		mCamera.WriteMaxFPS(mMaxFPS);
+	}
+	mCamera.WriteBrightness(mBrightness);
+	mCamera.WriteWhiteBalance(mWhiteBalance);
+	mConfigureCount++;
+}
+
+/**
+ * @brief Waits for the camera to have a new picture.
+ * 
+ * @param[in] timeout The longest to wait, in seconds.
+ * 
+ * @returns True if a picture arrived.  Its arrival time is
+ * available from GetFrameTimestamp.
+ */
+bool CameraSession::WaitForFrame(double timeout)
+{
+	int ticks = (int) (timeout * sysClkRateGet());
+	if (semTake(mCamera.GetNewImageSem(), ticks) == OK) {
+		FrameArrived(Timer::GetFPGATimestamp());
+		mIsFramePending = true;
+		return true;
+	}
+	
+	double now = Timer::GetFPGATimestamp();
+	if (mIsConnected and (now - mLastFrameTime > kReconnectTimeout)) {
+		mIsConnected = false;
+		Telemetry::GetInstance()->Log(false, "Camera connected");
+		printf("CameraSession: no picture for %.1f seconds, camera disconnected\n", now - mLastFrameTime);
+	}
+	return false;
+}
+
+/**
+ * @brief Copies the latest picture into an image.
+ * 
+ * @details
+ * If WaitForFrame hasn't just reported a new picture, whatever
+ * picture the camera has is taken and counted as arriving now.
+ * 
+ * @returns False if the camera had no picture to give.
+ */
+bool CameraSession::Capture(ColorImage *image)
+{
+	double start = Timer::GetFPGATimestamp();
+	if (mCamera.GetImage(image) == 0) {
+		mIsFramePending = false;
+		return false;
+	}
+	if (!mIsFramePending) {
+		FrameArrived(start);
+	}
+	mIsFramePending = false;
+	
+	mLatency = Timer::GetFPGATimestamp() - mFrameTimestamp;
+	Telemetry::GetInstance()->Log(mLatency * 1000, "Camera latency (ms)");
+	return true;
+}
+
+/**
+ * @brief Keeps track of the connection, resending the settings
+ * after a reconnect.
+ */
+void CameraSession::FrameArrived(double timestamp)
+{
+	mFrameTimestamp = timestamp;
+	mLastFrameTime = timestamp;
+	if (mIsConnected) {
+		return;
+	}
+	
+	mIsConnected = true;
+	Telemetry::GetInstance()->Log(true, "Camera connected");
+	if (mHasConnected) {
+		mReconnectCount++;
+		printf("CameraSession: camera reconnected, resending settings\n");
+		Configure();
+	}
+	mHasConnected = true;
+}
+
+bool CameraSession::IsConnected()
+{
+	return mIsConnected;
+}
+
+/**
+ * @brief When the latest picture arrived, from
+ * Timer::GetFPGATimestamp.
+ */
+double CameraSession::GetFrameTimestamp()
+{
+	return mFrameTimestamp;
+}
+
+/**
+ * @brief How long the latest picture took from arriving to being
+ * copied out of the camera, in seconds.
+ */
+double CameraSession::GetLatency()
+{
+	return mLatency;
+}
+
+/**
+ * @brief How many times the settings have been sent to the camera.
+ */
+UINT32 CameraSession::GetConfigureCount()
+{
+	return mConfigureCount;
+}
+
+UINT32 CameraSession::GetReconnectCount()
+{
+	return mReconnectCount;
+}
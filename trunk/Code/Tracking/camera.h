@@ -0,0 +1,95 @@
+/**
+ * @file camera.h
+ * 
+ * @brief Talks to the Axis camera: sets it up, notices when it
+ * drops out, and times each picture.
+ * 
+ * @details
+ * Every AxisCamera::Write... call is an HTTP request to the camera,
+ * so the settings are only sent when the session starts and again
+ * after the camera comes back from a disconnect (a camera that
+ * reboots forgets them).
+ * 
+ * Usage:
+ * @code
+ * CameraSession camera;
+ * ...
+ * // In the vision task
+ * if (camera.WaitForFrame(0.1) and camera.Capture(image)) {
+ *     // image arrived at camera.GetFrameTimestamp(), and was taken
+ *     // about kDefaultCaptureDelay before that (tunable from the
+ *     // dashboard as "(CAMERA) Capture delay <<")
+ * }
+ * @endcode
+ */
+
+#ifndef CAMERA_H_
+#define CAMERA_H_
+
+// 3rd party libraries
+#include "WPILib.h"
+#include "Vision/AxisCamera.h"
+#include "Vision/ColorImage.h"
+
+// Program modules
+#include "../telemetry.h"
+
+/**
+ * @brief One connection to the camera, and its settings.
+ * 
+ * @details
+ * The camera counts as disconnected once no picture has arrived
+ * for kReconnectTimeout seconds.  The next picture after that
+ * counts as a reconnect, and the settings are sent again.
+ * 
+ * WaitForFrame and Capture should only be called by one task; the
+ * getters can be called from anywhere.
+ */
+class CameraSession
+{
+public:
+	static const double kReconnectTimeout = 1.0;	// In seconds
+	static const double kDefaultCaptureDelay = 0.05;	// In seconds; exposure, compression and the network, roughly
+	static const int kDefaultCompression = 20;
+	static const int kDefaultBrightness = 0;	// What TargetUtils' thresholds were tuned at
+	
+	CameraSession(const char *);
+	AxisCamera &GetCamera();
+	
+	void SetResolution(AxisCamera::Resolution_t);
+	void SetCompression(int);
+	void SetMaxFPS(int);
+	void SetBrightness(int);
+	void SetWhiteBalance(AxisCamera::WhiteBalance_t);
+	void Configure();
+	
+	bool WaitForFrame(double);
+	bool Capture(ColorImage *);
+	
+	bool IsConnected();
+	double GetFrameTimestamp();
+	double GetLatency();
+	UINT32 GetConfigureCount();
+	UINT32 GetReconnectCount();
+	
+protected:
+	AxisCamera &mCamera;
+	AxisCamera::Resolution_t mResolution;
+	int mCompression;
+	int mMaxFPS;			// 0 to leave the camera's own
+	int mBrightness;
+	AxisCamera::WhiteBalance_t mWhiteBalance;
+	
+	volatile bool mIsConnected;
+	bool mHasConnected;
+	bool mIsFramePending;	// WaitForFrame saw a picture that Capture hasn't taken yet
+	double mLastFrameTime;
+	volatile double mFrameTimestamp;
+	volatile double mLatency;
+	UINT32 mConfigureCount;
+	UINT32 mReconnectCount;
+	
+	void FrameArrived(double);
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "governor.h"
+
+const CameraGovernor::Level CameraGovernor::kLevels[CameraGovernor::kLevelCount] = {
+		{AxisCamera::kResolution_640x480, 640, 20, 1.0},
+		{AxisCamera::kResolution_640x480, 640, 40, 0.85},	// A smaller JPEG decodes quicker
+		{AxisCamera::kResolution_320x240, 320, 30, 0.3},
+		{AxisCamera::kResolution_160x120, 160, 30, 0.1}
+};
+
+/**
+ * @param[in] camera The camera to set.  Starts it at the first
+ * level, as fast as it goes.
+ * @param[in] scheduler The control loop, to count its overruns, or
+ * NULL to go on the vision task's own time only.
+ */
+CameraGovernor::CameraGovernor(CameraSession *camera, ControllerScheduler *scheduler)
+{
+	mCamera = camera;
+	mScheduler = scheduler;
+	mBudget = kDefaultBudget;
+	mLevel = 0;
+	mMaxFPS = kMaxFPS;
+	mChangeTime = Timer::GetFPGATimestamp();
+	mFrameTime = 0;
+	mLoad = 0;
+	mOverrunRate = 0;
+	Apply(mLevel, mMaxFPS);
+	StartPeriod();
+}
+
+/**
+ * @brief Sets the share of the processor's time the vision task
+ * may use, from 0 to 1.
+ */
+void CameraGovernor::SetBudget(double budget)
+{
+	mBudget = budget;
+}
+
+/**
+ * @brief Counts one processed picture, and every kEvaluatePeriod
+ * decides whether to change the camera's settings.
+ * 
+ * @param[in] seconds How long the picture took, from copying it out
+ * of the camera to having the targets.
+ * @param[in] targets What was found in it.
+ * @param[in] width The picture's width, in pixels.
+ */
+void CameraGovernor::AddFrame(double seconds, const vector<TargetUtils::Target> &targets, int width)
+{
+	double now = Timer::GetFPGATimestamp();
+	if ((width != kLevels[mLevel].Width) or (now - seconds < mChangeTime + kChangeDelay)) {
+		// Taken before the last change reached the camera, so it
+		// says nothing about this level.
+		StartPeriod();
+		return;
+	}
+	
+	mBusyTime += seconds;
+	mFrameCount++;
+	int size = (int) targets.size();
+	for (int i=0; i<size; i++) {
+		mWidestTarget = max(mWidestTarget, targets[i].Width);
+	}
+	
+	if ((now - mPeriodStart >= kEvaluatePeriod) and (mFrameCount >= kMinFrames)) {
+		Evaluate(now);
+	}
+}
+
+/**
+ * @brief Starts counting afresh.
+ */
+void CameraGovernor::StartPeriod()
+{
+	mPeriodStart = Timer::GetFPGATimestamp();
+	mBusyTime = 0;
+	mFrameCount = 0;
+	mWidestTarget = 0;
+	if (mScheduler != NULL) {
+		mStartTicks = mScheduler->GetTickCount();
+		mStartOverruns = mScheduler->GetOverrunCount();
+	}
+}
+
+/**
+ * @brief Moves at most one level, then sets the frame rate to what
+ * the budget allows there.
+ */
+void CameraGovernor::Evaluate(double now)
+{
+	mFrameTime = mBusyTime / mFrameCount;
+	mLoad = mBusyTime / (now - mPeriodStart);
+	mOverrunRate = FindOverrunRate();
+	
+	int level = mLevel;
+	bool canStepDown = (mLevel + 1 < kLevelCount);
+	double scale = canStepDown ? (double) kLevels[mLevel + 1].Width / kLevels[mLevel].Width : 0;
+	if (((EstimateFPS(mLevel) < kMinFPS) or (mOverrunRate > kMaxOverrunRate)) and canStepDown) {
+		level = mLevel + 1;
+	} else if ((mLevel > 0) and (mWidestTarget < kMinTargetWidth) and (mOverrunRate <= kMaxOverrunRate)
+			and (EstimateFPS(mLevel - 1) >= kStepUpFPS)) {
+		level = mLevel - 1;
+	} else if (canStepDown and (mWidestTarget * scale >= kPlentyTargetWidth)) {
+		level = mLevel + 1;
+	}
+	
+	int fps = (int) EstimateFPS(level);
+	fps = (fps < kMinFPS) ? kMinFPS : ((fps > kMaxFPS) ? kMaxFPS : fps);
+	Apply(level, fps);
+	
+	Telemetry *s = Telemetry::GetInstance();
+	s->Log(mLevel, "Camera level");
+	s->Log(mMaxFPS, "Camera max FPS");
+	s->Log(mFrameTime * 1000, "Vision frame time (ms)");
+	s->Log(mLoad, "Vision load");
+	s->Log(mOverrunRate, "Vision loop overrun rate");
+	StartPeriod();
+}
+
+/**
+ * @brief The share of the control loop's ticks this period that
+ * overran.
+ */
+double CameraGovernor::FindOverrunRate()
+{
+	if (mScheduler == NULL) {
+		return 0;
+	}
+	UINT32 ticks = mScheduler->GetTickCount();
+	UINT32 overruns = mScheduler->GetOverrunCount();
+	if ((ticks <= mStartTicks) or (overruns < mStartOverruns)) {
+		return 0;		// Not running, or restarted since
+	}
+	return (double) (overruns - mStartOverruns) / (ticks - mStartTicks);
+}
+
+/**
+ * @brief How many pictures a second would fit in the budget at a
+ * level, going by the last period's frame time and the levels'
+ * costs.
+ */
+double CameraGovernor::EstimateFPS(int level)
+{
+	double frameTime = mFrameTime * kLevels[level].Cost / kLevels[mLevel].Cost;
+	if (frameTime <= 0) {
+		return kMaxFPS;
+	}
+	return mBudget / frameTime;
+}
+
+/**
+ * @brief Sets the camera to a level and frame rate.  The
+ * CameraSession only sends the settings that differ from what the
+ * camera already has.
+ */
+void CameraGovernor::Apply(int level, int fps)
+{
+	if (level != mLevel) {
+		mChangeTime = Timer::GetFPGATimestamp();
+	}
+	mLevel = level;
+	mMaxFPS = fps;
+	mCamera->SetResolution(kLevels[mLevel].Resolution);
+	mCamera->SetCompression(kLevels[mLevel].Compression);
+	mCamera->SetMaxFPS(mMaxFPS);
+	
+	Telemetry *s = Telemetry::GetInstance();
+	s->Log(kLevels[mLevel].Width, "Camera width");
+	s->Log(kLevels[mLevel].Compression, "Camera compression");
+}
+
+/**
+ * @brief Moves straight to a level, as fast as the camera goes.
+ * It's left to change from there as usual.
+ */
+void CameraGovernor::SetLevel(int level)
+{
+	level = (level < 0) ? 0 : ((level >= kLevelCount) ? kLevelCount - 1 : level);
+	Apply(level, kMaxFPS);
+	StartPeriod();
+}
+
+int CameraGovernor::GetLevel()
+{
+	return mLevel;
+}
+
+int CameraGovernor::GetMaxFPS()
+{
+	return mMaxFPS;
+}
+
+/**
+ * @brief How long a picture took to process, on average over the
+ * last period, in seconds.
+ */
+double CameraGovernor::GetFrameTime()
+{
+	return mFrameTime;
+}
+
+/**
+ * @brief The share of the last period the vision task spent
+ * processing.
+ */
+double CameraGovernor::GetLoad()
+{
+	return mLoad;
+}
+
+/**
+ * @brief The share of the control loop's ticks that overran in the
+ * last period.
+ */
+double CameraGovernor::GetOverrunRate()
+{
+	return mOverrunRate;
+}
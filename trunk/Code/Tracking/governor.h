@@ -0,0 +1,124 @@
+/**
+ * @file governor.h
+ * 
+ * @brief Picks the camera's resolution, compression and frame rate
+ * to suit how busy the robot is and how far away the targets are.
+ * 
+ * @details
+ * A 640x480 picture takes about four times as long to decode and
+ * search as a 320x240 one, and on the cRIO that can be long enough
+ * to make the control loop overrun.  But far-away targets are only
+ * a few pixels wide in a small picture, and their corners (and so
+ * the distance) get rough.  The governor measures how long each
+ * picture takes to process, and how often the control loop
+ * overruns, and moves between kLevels:
+ *   - down a level (to a cheaper one) if the vision task can't keep
+ *     to its budget even at kMinFPS, or the control loop overruns
+ *     more than kMaxOverrunRate of its ticks
+ *   - up a level if the widest target is narrower than
+ *     kMinTargetWidth (or there's none to be seen), and the level
+ *     up could still manage kStepUpFPS
+ *   - down a level if the targets would still be kPlentyTargetWidth
+ *     wide there, to save time
+ * Between them, the frame rate is set to as many pictures a second
+ * as fit in the budget.
+ * 
+ * Each decision is made on kEvaluatePeriod's worth of pictures, so
+ * one slow picture doesn't change anything.  Pictures left over from
+ * before a change are ignored: any of the wrong width, and any that
+ * arrive within kChangeDelay of the change (the first two levels
+ * only differ in compression, which doesn't show in the width).
+ * 
+ * Usage (from the vision task, see MultithreadedTargetFinder):
+ * @code
+ * CameraGovernor governor(&finder->GetCamera(), scheduler);
+ * ...
+ * // After each picture
+ * governor.AddFrame(seconds, targets, width);
+ * @endcode
+ */
+
+#ifndef GOVERNOR_H_
+#define GOVERNOR_H_
+
+// 3rd party libraries
+#include "WPILib.h"
+
+// Program modules
+#include "../scheduler.h"
+#include "camera.h"
+#include "target.h"
+
+/**
+ * @brief Steps the camera between settings to keep the vision task
+ * inside a share of the processor.
+ */
+class CameraGovernor
+{
+public:
+	/**
+	 * @brief One camera setting, and roughly how long a picture
+	 * takes with it compared to the first.
+	 */
+	struct Level
+	{
+		AxisCamera::Resolution_t Resolution;
+		int Width;			// In pixels
+		int Compression;
+		double Cost;
+	};
+	
+	static const int kLevelCount = 4;
+	static const Level kLevels[kLevelCount];	// Most pixels first
+	
+	static const double kDefaultBudget = 0.5;	// Of the processor's time
+	static const double kMaxOverrunRate = 0.02;	// Of the control loop's ticks
+	static const int kMinTargetWidth = 32;		// In pixels; narrower targets need a bigger picture
+	static const int kPlentyTargetWidth = 64;	// In pixels, at the next level down
+	static const int kMinFPS = 5;
+	static const int kMaxFPS = 30;			// As fast as the camera goes
+	static const int kStepUpFPS = 10;		// What the level up must manage, to step up to it
+	static const double kEvaluatePeriod = 1.0;	// In seconds
+	static const double kChangeDelay = 0.5;		// In seconds; for the camera to send pictures with new settings
+	static const int kMinFrames = 3;		// In a period, to judge it on
+	
+	CameraGovernor(CameraSession *, ControllerScheduler *);
+	void SetBudget(double);
+	void AddFrame(double, const vector<TargetUtils::Target> &, int);
+	void SetLevel(int);
+	
+	int GetLevel();
+	int GetMaxFPS();
+	double GetFrameTime();
+	double GetLoad();
+	double GetOverrunRate();
+	
+protected:
+	CameraSession *mCamera;
+	ControllerScheduler *mScheduler;	// May be NULL
+	double mBudget;
+	int mLevel;
+	int mMaxFPS;
+	double mChangeTime;			// When the level last changed
+	
+	// This period
+	double mPeriodStart;
+	double mBusyTime;			// In seconds
+	int mFrameCount;
+	double mWidestTarget;			// In pixels; 0 if none were seen
+	UINT32 mStartTicks;
+	UINT32 mStartOverruns;
+	
+	// The last period
+	double mFrameTime;			// Per picture, in seconds
+	double mLoad;
+	double mOverrunRate;
+	
+	void StartPeriod();
+	void Evaluate(double);
+	double FindOverrunRate();
+	double EstimateFPS(int);
+	void Apply(int, int);
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "lens.h"
+
+// System libraries
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+const char *LensModel::kLensFile = "camera_lens.txt";
+
+/**
+ * @brief A nominal Axis 206 at 640x480, with no distortion.
+ */
+LensModel::LensModel()
+{
+	Width = 640;
+	Height = 480;
+	FocalX = (Width / 2) / tan(kNominalFieldOfView / 2 * M_PI / 180);
+	FocalY = FocalX;
+	CenterX = Width / 2;
+	CenterY = Height / 2;
+	K1 = 0;
+	K2 = 0;
+}
+
+/**
+ * @brief Reads a lens from a file written by Save.
+ * 
+ * @details
+ * Each line is a name and a number; lines starting with # are
+ * comments.  Anything not in the file keeps its current value.
+ * 
+ * @returns False (leaving the lens alone) if the file can't be
+ * read or has a line that makes no sense.
+ */
+bool LensModel::Load(const char *fileName)
+{
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		return false;
+	}
+	LensModel lens = *this;
+	char line[128];
+	bool ok = true;
+	while (ok and (fgets(line, sizeof(line), file) != NULL)) {
+		char name[32];
+		double value;
+		if ((line[0] == '#') or (sscanf(line, "%31s", name) != 1)) {
+			continue;
+		}
+		if (sscanf(line, "%*s %lf", &value) != 1) {
+			ok = false;
+		} else if (strcmp(name, "width") == 0) {
+			lens.Width = (int) value;
+		} else if (strcmp(name, "height") == 0) {
+			lens.Height = (int) value;
+		} else if (strcmp(name, "focal_x") == 0) {
+			lens.FocalX = value;
+		} else if (strcmp(name, "focal_y") == 0) {
+			lens.FocalY = value;
+		} else if (strcmp(name, "center_x") == 0) {
+			lens.CenterX = value;
+		} else if (strcmp(name, "center_y") == 0) {
+			lens.CenterY = value;
+		} else if (strcmp(name, "k1") == 0) {
+			lens.K1 = value;
+		} else if (strcmp(name, "k2") == 0) {
+			lens.K2 = value;
+		} else {
+			ok = false;
+		}
+		if (!ok) {
+			printf("LensModel: can't make sense of \"%s\" in %s\n", name, fileName);
+		}
+	}
+	fclose(file);
+	ok = ok and (lens.Width > 0) and (lens.Height > 0) and (lens.FocalX > 0) and (lens.FocalY > 0);
+	if (ok) {
+		*this = lens;
+	}
+	return ok;
+}
+
+/**
+ * @brief Writes the lens to a file, in the form Load reads.
+ */
+bool LensModel::Save(const char *fileName) const
+{
+	FILE *file = fopen(fileName, "w");
+	if (file == NULL) {
+		return false;
+	}
+	fprintf(file, "# Camera intrinsics (see Tracking/lens.h)\n");
+	fprintf(file, "width %d\n", Width);
+	fprintf(file, "height %d\n", Height);
+	fprintf(file, "focal_x %.4f\n", FocalX);
+	fprintf(file, "focal_y %.4f\n", FocalY);
+	fprintf(file, "center_x %.4f\n", CenterX);
+	fprintf(file, "center_y %.4f\n", CenterY);
+	fprintf(file, "k1 %.6f\n", K1);
+	fprintf(file, "k2 %.6f\n", K2);
+	return fclose(file) == 0;
+}
+
+/**
+ * @brief The same lens, for a picture of a different size (the
+ * camera scales the whole sensor down, rather than cropping it).
+ */
+LensModel LensModel::Scaled(int width, int height) const
+{
+	LensModel lens = *this;
+	double scaleX = (double) width / Width;
+	double scaleY = (double) height / Height;
+	lens.Width = width;
+	lens.Height = height;
+	lens.FocalX *= scaleX;
+	lens.FocalY *= scaleY;
+	lens.CenterX *= scaleX;
+	lens.CenterY *= scaleY;
+	return lens;
+}
+
+/**
+ * @brief Moves a point the way the lens does.
+ * 
+ * @param[in] x Normalised, as a pinhole camera would see it.
+ * @param[in] y
+ * @param[out] distortedX Normalised, where the lens puts it.
+ * @param[out] distortedY
+ */
+void LensModel::Distort(double x, double y, double &distortedX, double &distortedY) const
+{
+	double r2 = x * x + y * y;
+	double scale = 1 + r2 * (K1 + r2 * K2);
+	distortedX = x * scale;
+	distortedY = y * scale;
+}
+
+/**
+ * @brief Undoes Distort, by fixed-point iteration (there's no
+ * closed form).  Converges quickly for any lens whose distortion
+ * is small next to 1, which covers the Axis 206.
+ */
+void LensModel::Undistort(double distortedX, double distortedY, double &x, double &y) const
+{
+	x = distortedX;
+	y = distortedY;
+	for (int i=0; i<kUndistortIterations; i++) {
+		double r2 = x * x + y * y;
+		double scale = 1 + r2 * (K1 + r2 * K2);
+		double nextX = distortedX / scale;
+		double nextY = distortedY / scale;
+		bool isDone = (fabs(nextX - x) < 1e-9) and (fabs(nextY - y) < 1e-9);
+		x = nextX;
+		y = nextY;
+		if (isDone) {
+			break;
+		}
+	}
+}
+
+
+
+CameraAngles::CameraAngles()
+{
+	Build(LensModel(), 640, 480);
+}
+
+/**
+ * @brief Works out the angles for a picture of the given size.
+ * 
+ * @param[in] lens The lens, at any size; it is scaled to fit.
+ * @param[in] width In pixels.
+ * @param[in] height
+ */
+void CameraAngles::Build(const LensModel &model, int width, int height)
+{
+	LensModel lens = model.Scaled(width, height);
+	double x;
+	double y;
+	mXAngles.resize(width);
+	for (int column=0; column<width; column++) {
+		lens.Undistort((column - lens.CenterX) / lens.FocalX, 0, x, y);
+		mXAngles[column] = (float) (atan(x) * 180 / M_PI);
+	}
+	mYAngles.resize(height);
+	for (int row=0; row<height; row++) {
+		lens.Undistort(0, (row - lens.CenterY) / lens.FocalY, x, y);
+		mYAngles[row] = (float) (atan(y) * 180 / M_PI);
+	}
+}
+
+/**
+ * @brief The horizontal angle to a place in the picture.
+ * 
+ * @param[in] x In pixels from the left; need not be whole.
+ */
+double CameraAngles::GetXAngle(double x) const
+{
+	return Lookup(mXAngles, x);
+}
+
+/**
+ * @brief The vertical angle to a place in the picture.
+ * 
+ * @param[in] y In pixels from the top; need not be whole.
+ */
+double CameraAngles::GetYAngle(double y) const
+{
+	return Lookup(mYAngles, y);
+}
+
+int CameraAngles::GetWidth() const
+{
+	return (int) mXAngles.size();
+}
+
+int CameraAngles::GetHeight() const
+{
+	return (int) mYAngles.size();
+}
+
+double CameraAngles::Lookup(const std::vector<float> &angles, double position)
+{
+	int last = (int) angles.size() - 1;
+	if (position <= 0) {
+		return angles[0];
+	}
+	if (position >= last) {
+		return angles[last];
+	}
+	int i = (int) position;
+	double fraction = position - i;
+	return angles[i] + (angles[i + 1] - angles[i]) * fraction;
+}
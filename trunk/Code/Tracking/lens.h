@@ -0,0 +1,108 @@
+/**
+ * @file lens.h
+ * 
+ * @brief Turns a place in the picture into the angle from the
+ * camera's optical axis, allowing for the lens.
+ * 
+ * @details
+ * The Axis 206's lens isn't a perfect pinhole: it bends straight
+ * lines outwards (barrel distortion), and the angle per pixel
+ * shrinks towards the edge of the picture, so scaling the offset
+ * from the middle linearly is a few degrees out near the sides.
+ * 
+ * LensModel holds the camera's intrinsics -- its focal length,
+ * where the optical axis hits the picture and two radial
+ * distortion coefficients -- as found by the camera_calibrate tool
+ * in /Simulation from pictures of a checkerboard.  The tool writes
+ * them to a file (kLensFile) to be copied onto the cRIO; without
+ * one, nominal values from the camera's data sheet are used.
+ * 
+ * CameraAngles works the angles out once for every column and row
+ * of the picture, so each target costs a table lookup.
+ * 
+ * Usage:
+ * @code
+ * // Once
+ * LensModel lens;
+ * lens.Load(LensModel::kLensFile);
+ * CameraAngles angles;
+ * angles.Build(lens, 640, 480);
+ * 
+ * // For each target
+ * double x = angles.GetXAngle(middleX);
+ * @endcode
+ */
+
+#ifndef LENS_H_
+#define LENS_H_
+
+// System libraries
+#include <vector>
+
+/**
+ * @brief A camera's intrinsics, in pixels of a picture of a given
+ * size.
+ * 
+ * @details
+ * Pixel (0, 0) is the middle of the top left pixel.  A point at
+ * normalised coordinates (x, y) -- its offset from the optical
+ * axis over its distance in front of the camera -- is moved by the
+ * lens to (x, y) * (1 + K1 r^2 + K2 r^4), where r^2 = x^2 + y^2,
+ * and lands at CenterX + FocalX * x, CenterY + FocalY * y.
+ */
+struct LensModel
+{
+	static const char *kLensFile;
+	
+	int Width;			// In pixels
+	int Height;
+	double FocalX;		// In pixels
+	double FocalY;
+	double CenterX;		// Where the optical axis hits the picture
+	double CenterY;
+	double K1;			// Radial distortion
+	double K2;
+	
+	LensModel();
+	bool Load(const char *);
+	bool Save(const char *) const;
+	LensModel Scaled(int, int) const;
+	void Distort(double, double, double &, double &) const;
+	void Undistort(double, double, double &, double &) const;
+	
+	static const double kNominalFieldOfView = 54;	// In degrees, across; from the Axis 206 data sheet
+	static const int kUndistortIterations = 20;
+};
+
+/**
+ * @brief The angle to every column and row of the picture.
+ * 
+ * @details
+ * The X angle of a column is worked out along the row through the
+ * optical axis, and the Y angle of a row along the column through
+ * it.  Without distortion that's exact anywhere in the picture;
+ * with it, a point well off both middle lines is slightly out, but
+ * far less than a linear scale is.
+ * 
+ * Angles are in degrees; X is positive to the right of the optical
+ * axis and Y below it.  Positions between pixels are interpolated,
+ * and ones outside the picture get the angle at its edge.
+ */
+class CameraAngles
+{
+public:
+	CameraAngles();
+	void Build(const LensModel &, int, int);
+	double GetXAngle(double) const;
+	double GetYAngle(double) const;
+	int GetWidth() const;
+	int GetHeight() const;
+	
+protected:
+	std::vector<float> mXAngles;		// One per column
+	std::vector<float> mYAngles;		// One per row
+	
+	static double Lookup(const std::vector<float> &, double);
+};
+
+#endif
@@ -0,0 +1,624 @@
+#include "mask.h"
+
+// Standard library
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MASK_USE_AVX2
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MASK_USE_SSE2
+#endif
+
+PackedMask::PackedMask()
+{
+	mWords = NULL;
+	mWidth = 0;
+	mHeight = 0;
+	mWordsPerRow = 0;
+	mCapacity = 0;
+}
+
+PackedMask::~PackedMask()
+{
+	delete[] mWords;
+}
+
+/**
+ * @brief Resizes the mask.  The contents are undefined afterwards.
+ */
+void PackedMask::SetSize(int width, int height)
+{
+	int wordsPerRow = (width + 31) / 32;
+	int needed = wordsPerRow * height;
+	if (needed > mCapacity) {
+		delete[] mWords;
+		mWords = new unsigned int[needed];
+		mCapacity = needed;
+	}
+	mWidth = width;
+	mHeight = height;
+	mWordsPerRow = wordsPerRow;
+}
+
+/**
+ * @brief Sets every pixel to 0.
+ */
+void PackedMask::Clear()
+{
+	if (mWords != NULL) {
+		memset(mWords, 0, sizeof(unsigned int) * mWordsPerRow * mHeight);
+	}
+}
+
+int PackedMask::GetWidth() const
+{
+	return mWidth;
+}
+
+int PackedMask::GetHeight() const
+{
+	return mHeight;
+}
+
+int PackedMask::GetWordsPerRow() const
+{
+	return mWordsPerRow;
+}
+
+unsigned int *PackedMask::GetRow(int y)
+{
+	return mWords + y * mWordsPerRow;
+}
+
+const unsigned int *PackedMask::GetRow(int y) const
+{
+	return mWords + y * mWordsPerRow;
+}
+
+bool PackedMask::Get(int x, int y) const
+{
+	return ((GetRow(y)[x >> 5] >> (x & 31)) & 1) != 0;
+}
+
+void PackedMask::Set(int x, int y, bool value)
+{
+	unsigned int bit = 1u << (x & 31);
+	if (value) {
+		GetRow(y)[x >> 5] |= bit;
+	} else {
+		GetRow(y)[x >> 5] &= ~bit;
+	}
+}
+
+/**
+ * @brief How many pixels are set.
+ */
+int PackedMask::Count() const
+{
+	int count = 0;
+	int total = mWordsPerRow * mHeight;
+	for (int i=0; i<total; i++) {
+		unsigned int word = mWords[i];
+		while (word != 0) {
+			word &= word - 1;
+			count++;
+		}
+	}
+	return count;
+}
+
+
+
+namespace
+{
+	int CountTrailingZeros(unsigned int word)
+	{
+#if defined(__GNUC__)
+		return __builtin_ctz(word);
+#else
+		int count = 0;
+		while ((word & 1) == 0) {
+			word >>= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+}
+
+RunMask::RunMask()
+{
+	mWidth = 0;
+	mHeight = 0;
+	mRowStarts.push_back(0);
+}
+
+/**
+ * @brief Empties the mask and sets its size, ready for the first
+ * row to be added.
+ */
+void RunMask::Reset(int width, int height)
+{
+	mWidth = width;
+	mHeight = height;
+	mRuns.clear();
+	mRowStarts.clear();
+	mRowStarts.reserve(height + 1);
+	mRowStarts.push_back(0);
+	mScratch.resize((width + 31) / 32);
+}
+
+/**
+ * @brief Adds a run to the row being built.  Runs must be added
+ * left to right and must not touch.
+ */
+void RunMask::AddRun(int start, int end)
+{
+	MaskRun run;
+	run.Start = start;
+	run.End = end;
+	mRuns.push_back(run);
+}
+
+/**
+ * @brief Finishes the row being built and starts the next.
+ */
+void RunMask::EndRow()
+{
+	mRowStarts.push_back((int) mRuns.size());
+}
+
+/**
+ * @brief Adds a whole row from one row of a PackedMask (or of the
+ * scratch row), then ends it.
+ * 
+ * @details
+ * Words that are all clear, or all set in the middle of a run,
+ * are skipped without looking at their bits.
+ */
+void RunMask::AddRow(const unsigned int *bits)
+{
+	int wordsPerRow = (mWidth + 31) / 32;
+	bool isInRun = false;
+	int start = 0;
+	for (int w=0; w<wordsPerRow; w++) {
+		unsigned int word = bits[w];
+		int base = w * 32;
+		if (base + 32 > mWidth) {
+			word &= (1u << (mWidth - base)) - 1;		// Ignore anything past the edge
+		}
+		if ((!isInRun and (word == 0)) or (isInRun and (word == ~0u))) {
+			continue;
+		}
+		int bit = 0;
+		while (bit < 32) {
+			unsigned int flips = (isInRun ? ~word : word) & (~0u << bit);
+			if (flips == 0) {
+				break;
+			}
+			int b = CountTrailingZeros(flips);
+			if (isInRun) {
+				AddRun(start, base + b - 1);
+			} else {
+				start = base + b;
+			}
+			isInRun = !isInRun;
+			bit = b + 1;
+		}
+	}
+	if (isInRun) {
+		AddRun(start, mWidth - 1);
+	}
+	EndRow();
+}
+
+int RunMask::GetWidth() const
+{
+	return mWidth;
+}
+
+int RunMask::GetHeight() const
+{
+	return mHeight;
+}
+
+int RunMask::GetRunCount() const
+{
+	return (int) mRuns.size();
+}
+
+/**
+ * @brief Every run, top row first.  Use GetRowStart to find where
+ * each row's runs are.
+ */
+const MaskRun *RunMask::GetRuns() const
+{
+	return mRuns.empty() ? NULL : &mRuns[0];
+}
+
+/**
+ * @brief The index of a row's first run.  The row's runs end where
+ * the next row's start, so GetRowStart(height) is the run count.
+ */
+int RunMask::GetRowStart(int y) const
+{
+	return mRowStarts[y];
+}
+
+/**
+ * @brief How many pixels are set.
+ */
+int RunMask::Count() const
+{
+	int count = 0;
+	int runCount = (int) mRuns.size();
+	for (int i=0; i<runCount; i++) {
+		count += mRuns[i].End - mRuns[i].Start + 1;
+	}
+	return count;
+}
+
+void RunMask::FromPacked(const PackedMask &mask)
+{
+	Reset(mask.GetWidth(), mask.GetHeight());
+	for (int y=0; y<mHeight; y++) {
+		AddRow(mask.GetRow(y));
+	}
+}
+
+void RunMask::ToPacked(PackedMask &mask) const
+{
+	mask.SetSize(mWidth, mHeight);
+	mask.Clear();
+	for (int y=0; y<mHeight; y++) {
+		for (int i=mRowStarts[y]; i<mRowStarts[y + 1]; i++) {
+			for (int x=mRuns[i].Start; x<=mRuns[i].End; x++) {
+				mask.Set(x, y, true);
+			}
+		}
+	}
+}
+
+/**
+ * @brief A packed row as wide as the mask, for building the mask a
+ * row at a time with AddRow.
+ */
+unsigned int *RunMask::GetScratchRow()
+{
+	return mScratch.empty() ? NULL : &mScratch[0];
+}
+
+
+
+namespace
+{
+	struct Layout
+	{
+		int BytesPerPixel;
+		int Offset[3];		// Of planes 1, 2 and 3 within a pixel
+	};
+	
+	Layout GetLayout(Masking::PixelLayout layout)
+	{
+		Layout result;
+		if (layout == Masking::kLayoutPacked) {
+			result.BytesPerPixel = 3;
+			result.Offset[0] = 0;
+			result.Offset[1] = 1;
+			result.Offset[2] = 2;
+		} else {
+			result.BytesPerPixel = 4;
+			result.Offset[0] = 2;
+			result.Offset[1] = 1;
+			result.Offset[2] = 0;
+		}
+		return result;
+	}
+	
+	/**
+	 * Thresholds pixels [start, width) of one row, one at a time.
+	 * The row must already be zeroed.
+	 */
+	void ThresholdRowScalar(const unsigned char *row, int start, int width,
+			const Layout &layout, const Masking::ColorRange &range, unsigned int *out)
+	{
+		const unsigned char *p = row + start * layout.BytesPerPixel;
+		for (int x=start; x<width; x++) {
+			int a = p[layout.Offset[0]];
+			int b = p[layout.Offset[1]];
+			int c = p[layout.Offset[2]];
+			if ((a >= range.Low[0]) and (a <= range.High[0])
+					and (b >= range.Low[1]) and (b <= range.High[1])
+					and (c >= range.Low[2]) and (c <= range.High[2])) {
+				out[x >> 5] |= 1u << (x & 31);
+			}
+			p += layout.BytesPerPixel;
+		}
+	}
+	
+	unsigned char ClampToByte(int value)
+	{
+		if (value < 0) {
+			return 0;
+		}
+		if (value > 255) {
+			return 255;
+		}
+		return (unsigned char) value;
+	}
+	
+	/**
+	 * The low and high bound of every byte of a 4-byte pixel, with
+	 * the unused byte allowed to be anything.  An empty range (low
+	 * above high) stays empty after clamping.
+	 */
+	void GetByteBounds(const Layout &layout, const Masking::ColorRange &range,
+			unsigned char low[4], unsigned char high[4])
+	{
+		low[3] = 0;
+		high[3] = 255;
+		for (int plane=0; plane<3; plane++) {
+			int offset = layout.Offset[plane];
+			if ((range.Low[plane] > range.High[plane]) or (range.Low[plane] > 255) or (range.High[plane] < 0)) {
+				low[offset] = 255;		// Nothing passes
+				high[offset] = 0;
+			} else {
+				low[offset] = ClampToByte(range.Low[plane]);
+				high[offset] = ClampToByte(range.High[plane]);
+			}
+		}
+	}
+	
+	/**
+	 * Squeezes every fourth bit of a movemask (one per pixel, after
+	 * AND-ing each pixel's four byte flags together) into the low
+	 * bits.
+	 */
+	inline unsigned int PackPixelFlags(unsigned int byteFlags)
+	{
+		unsigned int t = byteFlags & (byteFlags >> 1);
+		t &= t >> 2;
+		t &= 0x11111111;
+		t = (t | (t >> 3)) & 0x03030303;
+		t = (t | (t >> 6)) & 0x000F000F;
+		t = (t | (t >> 12)) & 0x000000FF;
+		return t;
+	}
+	
+#if defined(MASK_USE_SSE2)
+	/**
+	 * In range when max(x, low) == x and min(x, high) == x, which
+	 * works for unsigned bytes where SSE2 has no unsigned compare.
+	 */
+	inline unsigned int InRange16(__m128i pixels, __m128i low, __m128i high)
+	{
+		__m128i aboveLow = _mm_cmpeq_epi8(_mm_max_epu8(pixels, low), pixels);
+		__m128i belowHigh = _mm_cmpeq_epi8(_mm_min_epu8(pixels, high), pixels);
+		return (unsigned int) _mm_movemask_epi8(_mm_and_si128(aboveLow, belowHigh));
+	}
+#endif
+	
+#if defined(MASK_USE_AVX2)
+	inline unsigned int InRange32(__m256i pixels, __m256i low, __m256i high)
+	{
+		__m256i aboveLow = _mm256_cmpeq_epi8(_mm256_max_epu8(pixels, low), pixels);
+		__m256i belowHigh = _mm256_cmpeq_epi8(_mm256_min_epu8(pixels, high), pixels);
+		return (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(aboveLow, belowHigh));
+	}
+#endif
+	
+	/**
+	 * Thresholds one row of 4-byte pixels as many at a time as the
+	 * processor allows, and returns where it stopped.  Groups of 4
+	 * and 8 pixels never straddle a word of the mask.
+	 */
+	int ThresholdRowWide(const unsigned char *row, int width,
+			const unsigned char low[4], const unsigned char high[4], unsigned int *out)
+	{
+		int x = 0;
+		int lowPattern;
+		int highPattern;
+		memcpy(&lowPattern, low, 4);
+		memcpy(&highPattern, high, 4);
+#if defined(MASK_USE_AVX2)
+		__m256i low32 = _mm256_set1_epi32(lowPattern);
+		__m256i high32 = _mm256_set1_epi32(highPattern);
+		for (; x + 8 <= width; x += 8) {
+			__m256i pixels = _mm256_loadu_si256((const __m256i *) (row + x * 4));
+			unsigned int flags = PackPixelFlags(InRange32(pixels, low32, high32));
+			out[x >> 5] |= flags << (x & 31);
+		}
+#endif
+#if defined(MASK_USE_SSE2)
+		__m128i low16 = _mm_set1_epi32(lowPattern);
+		__m128i high16 = _mm_set1_epi32(highPattern);
+		for (; x + 4 <= width; x += 4) {
+			__m128i pixels = _mm_loadu_si128((const __m128i *) (row + x * 4));
+			unsigned int flags = PackPixelFlags(InRange16(pixels, low16, high16));
+			out[x >> 5] |= flags << (x & 31);
+		}
+#endif
+		return x;
+	}
+	
+	/**
+	 * Like ThresholdRowWide, but for every step'th 4-byte pixel.
+	 * Never reads past pixel sourceWidth - 1 of the row.
+	 */
+	int ThresholdRowSampledWide(const unsigned char *row, int width, int sourceWidth, int step,
+			const unsigned char low[4], const unsigned char high[4], unsigned int *out)
+	{
+		int x = 0;
+#if defined(MASK_USE_SSE2)
+		int lowPattern;
+		int highPattern;
+		memcpy(&lowPattern, low, 4);
+		memcpy(&highPattern, high, 4);
+		__m128i low16 = _mm_set1_epi32(lowPattern);
+		__m128i high16 = _mm_set1_epi32(highPattern);
+		int pixelBytes = step * 4;
+		if (step == 2) {
+			// Every other pixel of two loads, without going through memory
+			for (; (x + 4) * 2 <= sourceWidth; x += 4) {
+				const unsigned char *p = row + x * pixelBytes;
+				__m128 a = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *) p));
+				__m128 b = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *) (p + 16)));
+				__m128i pixels = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+				unsigned int flags = PackPixelFlags(InRange16(pixels, low16, high16));
+				out[x >> 5] |= flags << (x & 31);
+			}
+		}
+		for (; x + 4 <= width; x += 4) {
+			const unsigned char *p = row + x * pixelBytes;
+			int picked[4];
+			for (int i=0; i<4; i++) {
+				memcpy(&picked[i], p + i * pixelBytes, 4);
+			}
+			__m128i pixels = _mm_set_epi32(picked[3], picked[2], picked[1], picked[0]);
+			unsigned int flags = PackPixelFlags(InRange16(pixels, low16, high16));
+			out[x >> 5] |= flags << (x & 31);
+		}
+#endif
+		return x;
+	}
+}
+
+/**
+ * @brief Sets every pixel of the mask whose three planes are all in
+ * range, and clears the rest.
+ * 
+ * @param[in] pixels The first byte of the top row.
+ * @param[in] width In pixels.
+ * @param[in] height In pixels.
+ * @param[in] stride Bytes from the start of one row to the next.
+ * @param[in] layout How each pixel is stored.
+ * @param[in] range The ranges to keep (inclusive).
+ * @param[out] mask Resized to width by height.
+ */
+void Masking::Threshold(const unsigned char *pixels, int width, int height, int stride,
+		PixelLayout layout, const ColorRange &range, PackedMask &mask)
+{
+	Layout info = GetLayout(layout);
+	if (info.BytesPerPixel != 4) {
+		ThresholdScalar(pixels, width, height, stride, layout, range, mask);
+		return;
+	}
+	
+	mask.SetSize(width, height);
+	mask.Clear();
+	unsigned char low[4];
+	unsigned char high[4];
+	GetByteBounds(info, range, low, high);
+	for (int y=0; y<height; y++) {
+		const unsigned char *row = pixels + y * stride;
+		unsigned int *out = mask.GetRow(y);
+		int done = ThresholdRowWide(row, width, low, high, out);
+		ThresholdRowScalar(row, done, width, info, range, out);
+	}
+}
+
+/**
+ * @brief Thresholds straight into runs.
+ * 
+ * @details
+ * Each row is thresholded into one packed row, which stays in the
+ * cache, and turned into runs before moving on, so the full-size
+ * packed mask is never written out.
+ */
+void Masking::Threshold(const unsigned char *pixels, int width, int height, int stride,
+		PixelLayout layout, const ColorRange &range, RunMask &runs)
+{
+	Layout info = GetLayout(layout);
+	unsigned char low[4];
+	unsigned char high[4];
+	GetByteBounds(info, range, low, high);
+	runs.Reset(width, height);
+	unsigned int *out = runs.GetScratchRow();
+	int wordsPerRow = (width + 31) / 32;
+	for (int y=0; y<height; y++) {
+		const unsigned char *row = pixels + y * stride;
+		memset(out, 0, sizeof(unsigned int) * wordsPerRow);
+		int done = 0;
+		if (info.BytesPerPixel == 4) {
+			done = ThresholdRowWide(row, width, low, high, out);
+		}
+		ThresholdRowScalar(row, done, width, info, range, out);
+		runs.AddRow(out);
+	}
+}
+
+/**
+ * @brief Thresholds every step'th pixel of every step'th row
+ * into runs.
+ * 
+ * @details
+ * Pixel (x, y) of the mask comes from pixel (x * step, y * step)
+ * of the picture, so the mask is about 1 / step as wide and high.
+ * Only those pixels are read, which is where the time goes.  Lines
+ * thinner than step pixels may come out broken up or missing.
+ * 
+ * @param[in] step 1 is the same as Threshold.
+ */
+void Masking::ThresholdSampled(const unsigned char *pixels, int width, int height, int stride,
+		PixelLayout layout, const ColorRange &range, int step, RunMask &runs)
+{
+	if (step <= 1) {
+		Threshold(pixels, width, height, stride, layout, range, runs);
+		return;
+	}
+	Layout info = GetLayout(layout);
+	unsigned char low[4];
+	unsigned char high[4];
+	GetByteBounds(info, range, low, high);
+	int sampledWidth = (width + step - 1) / step;
+	int sampledHeight = (height + step - 1) / step;
+	Layout sampled = info;
+	sampled.BytesPerPixel *= step;		// So the scalar loop skips the pixels in between
+	
+	runs.Reset(sampledWidth, sampledHeight);
+	unsigned int *out = runs.GetScratchRow();
+	int wordsPerRow = (sampledWidth + 31) / 32;
+	for (int y=0; y<sampledHeight; y++) {
+		const unsigned char *row = pixels + y * step * stride;
+		memset(out, 0, sizeof(unsigned int) * wordsPerRow);
+		int done = 0;
+		if (info.BytesPerPixel == 4) {
+			done = ThresholdRowSampledWide(row, sampledWidth, width, step, low, high, out);
+		}
+		ThresholdRowScalar(row, done, sampledWidth, sampled, range, out);
+		runs.AddRow(out);
+	}
+}
+
+/**
+ * @brief The same as Threshold, one pixel at a time.  Useful for
+ * checking and timing the faster versions.
+ */
+void Masking::ThresholdScalar(const unsigned char *pixels, int width, int height, int stride,
+		PixelLayout layout, const ColorRange &range, PackedMask &mask)
+{
+	Layout info = GetLayout(layout);
+	mask.SetSize(width, height);
+	mask.Clear();
+	for (int y=0; y<height; y++) {
+		ThresholdRowScalar(pixels + y * stride, 0, width, info, range, mask.GetRow(y));
+	}
+}
+
+/**
+ * @brief Which version Threshold uses for 4-byte pixels: "AVX2",
+ * "SSE2" or "scalar".
+ */
+const char *Masking::GetImplementationName()
+{
+#if defined(MASK_USE_AVX2)
+	return "AVX2";
+#elif defined(MASK_USE_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
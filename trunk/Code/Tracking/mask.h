@@ -0,0 +1,175 @@
+/**
+ * @file mask.h
+ * 
+ * @brief Turns a color picture into a black-and-white mask, one bit
+ * per pixel, without NI Vision.
+ * 
+ * @details
+ * The first step of finding a target is always a color threshold:
+ * keep the pixels whose three color planes are each within a range.
+ * This does that straight from the pixel bytes, so it can be timed
+ * on its own and run anywhere (a laptop, or a Linux coprocessor),
+ * not just on the cRIO.
+ * 
+ * On x86 the work is done 8 pixels at a time with AVX2 (if the
+ * compiler was told to use it, e.g. -mavx2) or 4 at a time with
+ * SSE2; everywhere else, including the cRIO, one pixel at a time.
+ * Every version gives exactly the same answer.
+ * 
+ * The mask can come out either packed (PackedMask) or as runs of
+ * set pixels (RunMask).  The lit-up tape in a camera picture makes
+ * only a few long runs per row, so a RunMask is usually tiny, and
+ * what reads it (see blobs.h) only touches each run once.
+ * 
+ * ThresholdSampled makes a smaller mask from every second (or
+ * third, ...) pixel of every second row, for a quick first look.
+ * 
+ * Usage:
+ * @code
+ * Masking::ColorRange range = {{243, 141, 161}, {255, 255, 255}};
+ * PackedMask mask;
+ * Masking::Threshold(pixels, 640, 480, 640 * 4, Masking::kLayoutNI, range, mask);
+ * if (mask.Get(320, 240)) {
+ *     // The middle pixel is in range
+ * }
+ * @endcode
+ * 
+ * This file deliberately uses nothing from WPILib or nivision.
+ */
+
+#ifndef MASK_H_
+#define MASK_H_
+
+// Standard library
+#include <vector>
+
+/**
+ * @brief A black-and-white image, packed 32 pixels to a word.
+ * 
+ * @details
+ * Pixel x of a row is bit (x % 32) of word (x / 32), counting from
+ * the least significant bit.  Each row starts on a new word, and
+ * the unused bits at the end of a row are always 0.
+ * 
+ * The memory is only reallocated when the mask has to grow, so
+ * reusing one mask for every picture doesn't allocate.
+ */
+class PackedMask
+{
+public:
+	PackedMask();
+	~PackedMask();
+	
+	void SetSize(int, int);
+	void Clear();
+	
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetWordsPerRow() const;
+	unsigned int *GetRow(int);
+	const unsigned int *GetRow(int) const;
+	
+	bool Get(int, int) const;
+	void Set(int, int, bool);
+	int Count() const;
+	
+protected:
+	unsigned int *mWords;
+	int mWidth;
+	int mHeight;
+	int mWordsPerRow;
+	int mCapacity;		// In words
+	
+private:
+	PackedMask(const PackedMask &);
+	PackedMask &operator=(const PackedMask &);
+};
+
+/**
+ * @brief One row's stretch of set pixels, from Start to End
+ * inclusive.
+ */
+struct MaskRun
+{
+	int Start;
+	int End;
+};
+
+/**
+ * @brief A black-and-white image stored as the runs of set pixels
+ * in each row, in order.
+ * 
+ * @details
+ * Build one a row at a time, top to bottom:
+ * @code
+ * runs.Reset(width, height);
+ * for (int y=0; y<height; y++) {
+ *     runs.AddRun(start, end);	// As many as the row has, left to right
+ *     runs.EndRow();
+ * }
+ * @endcode
+ * 
+ * Like PackedMask, memory is only reallocated when it has to grow.
+ */
+class RunMask
+{
+public:
+	RunMask();
+	
+	void Reset(int, int);
+	void AddRun(int, int);
+	void EndRow();
+	void AddRow(const unsigned int *);
+	
+	int GetWidth() const;
+	int GetHeight() const;
+	int GetRunCount() const;
+	const MaskRun *GetRuns() const;
+	int GetRowStart(int) const;
+	int Count() const;
+	
+	void FromPacked(const PackedMask &);
+	void ToPacked(PackedMask &) const;
+	
+	unsigned int *GetScratchRow();
+	
+protected:
+	int mWidth;
+	int mHeight;
+	std::vector<MaskRun> mRuns;
+	std::vector<int> mRowStarts;		// Index of each row's first run; one extra at the end
+	std::vector<unsigned int> mScratch;	// One packed row, for building a row at a time
+};
+
+/**
+ * @brief Color thresholding into a PackedMask.
+ */
+namespace Masking
+{
+	/**
+	 * @brief How the color planes are laid out in memory.
+	 */
+	enum PixelLayout
+	{
+		kLayoutNI,			// 4 bytes: plane 3, plane 2, plane 1, unused (NI's RGBValue and HSLValue)
+		kLayoutPacked		// 3 bytes: plane 1, plane 2, plane 3 (PPM files, raw 24-bit RGB)
+	};
+	
+	/**
+	 * @brief Inclusive ranges for the three planes (red, green and
+	 * blue, or hue, saturation and luminance).
+	 */
+	struct ColorRange
+	{
+		int Low[3];
+		int High[3];
+	};
+	
+	void Threshold(const unsigned char *, int, int, int, PixelLayout, const ColorRange &, PackedMask &);
+	void ThresholdScalar(const unsigned char *, int, int, int, PixelLayout, const ColorRange &, PackedMask &);
+	void Threshold(const unsigned char *, int, int, int, PixelLayout, const ColorRange &, RunMask &);
+	void ThresholdSampled(const unsigned char *, int, int, int, PixelLayout, const ColorRange &, int, RunMask &);
+	const char *GetImplementationName();
+}
+
+#endif
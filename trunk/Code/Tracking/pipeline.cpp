@@ -0,0 +1,792 @@
+#include "pipeline.h"
+#include "target.h"
+#include "../telemetry.h"
+
+SearchRegion::SearchRegion()
+{
+	IsSet = false;
+	Bounds.top = 0;
+	Bounds.left = 0;
+	Bounds.height = 0;
+	Bounds.width = 0;
+	Region = NULL;
+	TargetCount = 0;
+	ImageWidth = 0;
+	ImageHeight = 0;
+}
+
+PipelineFrame::PipelineFrame()
+{
+	Image = NULL;
+	Region = NULL;
+	Mask = NULL;
+	Targets = NULL;
+}
+
+
+
+/**
+ * @param[in] name Used for timing.  Must outlive the stage (a
+ * string literal is fine).
+ */
+PipelineStage::PipelineStage(const char *name)
+{
+	mName = name;
+}
+
+PipelineStage::~PipelineStage()
+{
+	// Empty
+}
+
+const char *PipelineStage::GetName() const
+{
+	return mName;
+}
+
+
+
+ImagePipeline::ImagePipeline()
+{
+	mStageCount = 0;
+	mFrame.Rectangles.reserve(kMaxRectangles);
+}
+
+/**
+ * @brief Adds a stage to the end of the list.
+ * 
+ * @param[in] stage Not owned; it must outlive the pipeline.
+ * 
+ * @returns False if the pipeline already has kMaxStages stages.
+ */
+bool ImagePipeline::AddStage(PipelineStage *stage)
+{
+	if (mStageCount >= kMaxStages) {
+		return false;
+	}
+	mTimer.AddStage(stage->GetName());
+	mStages[mStageCount] = stage;
+	mStageCount++;
+	return true;
+}
+
+/**
+ * @brief Runs every stage on a picture, in the order they were
+ * added.
+ * 
+ * @param[in] image Left unchanged.
+ * @param[out] targets Emptied, then filled with what was found.
+ * @param[in] region Where the targets were last time, for the
+ * stages that can make use of it.
+ * 
+ * @returns False if a stage found nothing for the rest to work
+ * on.
+ */
+bool ImagePipeline::Run(ColorImage *image, vector<TargetUtils::Target> &targets, const SearchRegion *region)
+{
+	targets.clear();
+	mFrame.Image = image;
+	mFrame.Region = region;
+	mFrame.Mask = NULL;
+	mFrame.Rectangles.clear();
+	mFrame.Targets = &targets;
+	
+	bool isComplete = true;
+	for (int i=0; i<mStageCount; i++) {
+		mTimer.Begin(i);
+		if (!mStages[i]->Process(mFrame)) {
+			isComplete = false;
+			break;
+		}
+	}
+	mTimer.EndFrame();
+	
+	mFrame.Image = NULL;
+	mFrame.Region = NULL;
+	mFrame.Targets = NULL;
+	return isComplete;
+}
+
+int ImagePipeline::GetStageCount() const
+{
+	return mStageCount;
+}
+
+/**
+ * @brief How long each stage has taken, over every picture since
+ * the timer was last reset.  The stages are timed under their own
+ * names, in the order they were added.
+ */
+StageTimer &ImagePipeline::GetStageTimer()
+{
+	return mTimer;
+}
+
+
+
+/**
+ * @param[in] threshold The range of each color plane.
+ * @param[in] mode IMAQ_RGB or IMAQ_HSL.
+ * @param[in] width The usual width of the pictures, to size the
+ * buffer for.
+ * @param[in] height Likewise.
+ */
+ThresholdStage::ThresholdStage(const Threshold &threshold, ColorMode mode, int width, int height) :
+		PipelineStage("threshold")
+{
+	mRanges[0].minValue = threshold.plane1Low;
+	mRanges[0].maxValue = threshold.plane1High;
+	mRanges[1].minValue = threshold.plane2Low;
+	mRanges[1].maxValue = threshold.plane2High;
+	mRanges[2].minValue = threshold.plane3Low;
+	mRanges[2].maxValue = threshold.plane3High;
+	mMode = mode;
+	mImage = new BinaryImage();
+	imaqSetImageSize(mImage->GetImaqImage(), width, height);
+}
+
+ThresholdStage::~ThresholdStage()
+{
+	delete mImage;
+}
+
+bool ThresholdStage::Process(PipelineFrame &frame)
+{
+	imaqColorThreshold(
+			mImage->GetImaqImage(), frame.Image->GetImaqImage(),
+			1, mMode, &mRanges[0], &mRanges[1], &mRanges[2]);
+	frame.Mask = mImage;
+	return true;
+}
+
+
+
+/**
+ * @param[in] erosions How many 3x3 erosions a particle must survive
+ * to be kept, at the usual width.
+ * @param[in] width The usual width of the pictures.
+ * @param[in] height Likewise.
+ */
+SizeFilterStage::SizeFilterStage(int erosions, int width, int height) :
+		PipelineStage("filter")
+{
+	mErosions = erosions;
+	mUsualWidth = width;
+	mImage = new BinaryImage();
+	imaqSetImageSize(mImage->GetImaqImage(), width, height);
+}
+
+SizeFilterStage::~SizeFilterStage()
+{
+	delete mImage;
+}
+
+bool SizeFilterStage::Process(PipelineFrame &frame)
+{
+	// In a smaller picture the tape is thinner, and survives fewer.
+	int erosions = (int) (mErosions * frame.Image->GetWidth() / (double) mUsualWidth + 0.5);
+	if (erosions < 1) {
+		return true;
+	}
+	imaqSizeFilter(
+			mImage->GetImaqImage(), frame.Mask->GetImaqImage(),
+			false, erosions, IMAQ_KEEP_LARGE, NULL);
+	frame.Mask = mImage;
+	return true;
+}
+
+
+
+ConvexHullStage::ConvexHullStage(int width, int height) :
+		PipelineStage("hull")
+{
+	mImage = new BinaryImage();
+	imaqSetImageSize(mImage->GetImaqImage(), width, height);
+}
+
+ConvexHullStage::~ConvexHullStage()
+{
+	delete mImage;
+}
+
+bool ConvexHullStage::Process(PipelineFrame &frame)
+{
+	imaqConvexHull(mImage->GetImaqImage(), frame.Mask->GetImaqImage(), false);
+	frame.Mask = mImage;
+	return true;
+}
+
+
+
+/**
+ * @param[in] descriptor The sizes of rectangle to look for, at the
+ * usual width.
+ * @param[in] curveOptions How NI Vision finds the edges.
+ * @param[in] shapeOptions Which matches to keep.
+ * @param[in] width The usual width of the pictures, in pixels.
+ */
+RectangleStage::RectangleStage(
+		const RectangleDescriptor &descriptor,
+		const CurveOptions &curveOptions,
+		const ShapeDetectionOptions &shapeOptions,
+		int width) :
+		PipelineStage("shapes")
+{
+	mUsualDescriptor = descriptor;
+	mUsualWidth = width;
+	mCurveOptions = curveOptions;
+	mShapeOptions = shapeOptions;
+	SetImageWidth(width);
+}
+
+/**
+ * @brief Scales the sizes of rectangle to look for to a picture's
+ * width.
+ */
+void RectangleStage::SetImageWidth(int width)
+{
+	double scale = (double) width / mUsualWidth;
+	mDescriptor.minWidth = mUsualDescriptor.minWidth * scale;
+	mDescriptor.maxWidth = mUsualDescriptor.maxWidth * scale;
+	mDescriptor.minHeight = mUsualDescriptor.minHeight * scale;
+	mDescriptor.maxHeight = mUsualDescriptor.maxHeight * scale;
+	mDescriptorWidth = width;
+}
+
+bool RectangleStage::Process(PipelineFrame &frame)
+{
+	int width = frame.Image->GetWidth();
+	if (width != mDescriptorWidth) {
+		SetImageWidth(width);
+	}
+	
+	const SearchRegion *region = frame.Region;
+	bool isTracking = (region != NULL) and region->IsSet;
+	bool searchAll = !isTracking;
+	if (isTracking) {
+		Detect(frame, region->Region);
+		// Some of the targets may have left the region.
+		searchAll = ((int) frame.Rectangles.size() < region->TargetCount);
+	}
+	if (searchAll) {
+		Detect(frame, NULL);
+	}
+	Telemetry::GetInstance()->Log(!searchAll, "Camera region search");
+	return !frame.Rectangles.empty();
+}
+
+/**
+ * @brief Finds the rectangles in the frame's mask, replacing any
+ * found before.
+ * 
+ * @param[in] roi Where to look, or NULL for everywhere.
+ */
+void RectangleStage::Detect(PipelineFrame &frame, ROI *roi)
+{
+	int numberOfMatches;
+	
+	RectangleMatch *rectangleMatch = imaqDetectRectangles(
+			frame.Mask->GetImaqImage(),
+			&mDescriptor,
+			&mCurveOptions,
+			&mShapeOptions,
+			roi,
+			&numberOfMatches		// Is modified by function.
+	);
+	frame.Rectangles.clear();
+	
+	Telemetry::GetInstance()->Log(numberOfMatches, "DetectRectangles");
+	
+	if (rectangleMatch == NULL) {
+		return;
+	}
+	for (int i = 0; i < numberOfMatches; i++) {
+		frame.Rectangles.push_back(rectangleMatch[i]);
+	}
+	imaqDispose(rectangleMatch);
+}
+
+
+
+/**
+ * @param[in] minArea Smaller particles are dropped, in pixels at
+ * the usual width.
+ * @param[in] width The usual width of the pictures, in pixels.
+ */
+ParticleStage::ParticleStage(double minArea, int width) :
+		PipelineStage("particles")
+{
+	mMinArea = minArea;
+	mUsualWidth = width;
+}
+
+bool ParticleStage::Process(PipelineFrame &frame)
+{
+	double scale = (double) frame.Image->GetWidth() / mUsualWidth;
+	double minArea = mMinArea * scale * scale;
+	Image *mask = frame.Mask->GetImaqImage();
+	int count = 0;
+	imaqCountParticles(mask, true, &count);
+	frame.Rectangles.clear();
+	for (int i=0; i<count; i++) {
+		double area = 0;
+		imaqMeasureParticle(mask, i, false, IMAQ_MT_AREA, &area);
+		if (area < minArea) {
+			continue;
+		}
+		double left = 0, top = 0, width = 0, height = 0;
+		imaqMeasureParticle(mask, i, false, IMAQ_MT_BOUNDING_RECT_LEFT, &left);
+		imaqMeasureParticle(mask, i, false, IMAQ_MT_BOUNDING_RECT_TOP, &top);
+		imaqMeasureParticle(mask, i, false, IMAQ_MT_BOUNDING_RECT_WIDTH, &width);
+		imaqMeasureParticle(mask, i, false, IMAQ_MT_BOUNDING_RECT_HEIGHT, &height);
+		
+		float right = (float) (left + width - 1);
+		float bottom = (float) (top + height - 1);
+		RectangleMatch r;
+		r.corner[0].x = (float) left;
+		r.corner[0].y = (float) top;
+		r.corner[1].x = right;
+		r.corner[1].y = (float) top;
+		r.corner[2].x = right;
+		r.corner[2].y = bottom;
+		r.corner[3].x = (float) left;
+		r.corner[3].y = bottom;
+		r.width = width;
+		r.height = height;
+		r.rotation = 0;
+		r.score = 100 * area / (width * height);
+		frame.Rectangles.push_back(r);
+	}
+	return !frame.Rectangles.empty();
+}
+
+
+
+/**
+ * @param[in] colorRange The colors to keep.
+ * @param[in] options Which blobs count as rectangles, at the usual
+ * width.
+ * @param[in] width The usual width of the pictures.
+ * @param[in] height Likewise.
+ */
+BlobSearchStage::BlobSearchStage(
+		const Masking::ColorRange &colorRange,
+		const BlobFinder::Options &options,
+		int width,
+		int height) :
+		PipelineStage("search")
+{
+	mColorRange = colorRange;
+	mUsualOptions = options;
+	mUsualWidth = width;
+	mRuns.Reset(width, height);
+	mBlobs.reserve(ImagePipeline::kMaxRectangles);
+	mWindows.reserve(ImagePipeline::kMaxRectangles);
+	mPyramidStep = kDefaultPyramidStep;
+	SetImageWidth(width);
+}
+
+/**
+ * @brief Scales the sizes of blob to keep to a picture's width, for
+ * both the full-size and the first look.
+ */
+void BlobSearchStage::SetImageWidth(int width)
+{
+	double scale = (double) width / mUsualWidth;
+	BlobFinder::Options options = mUsualOptions;
+	options.MinThickness = max(1, (int) (options.MinThickness * scale + 0.5));
+	options.MinWidth *= scale;
+	options.MaxWidth *= scale;
+	options.MinHeight *= scale;
+	options.MaxHeight *= scale;
+	mBlobFinder.SetOptions(options);
+	mOptionsWidth = width;
+	SetPyramidStep(mPyramidStep);
+}
+
+/**
+ * @brief Finds the rectangles, looking near the last targets first.
+ * 
+ * @details
+ * Unlike NI Vision, this only thresholds and labels the pixels in
+ * the region, so tracking saves time at every step.
+ */
+bool BlobSearchStage::Process(PipelineFrame &frame)
+{
+	frame.Rectangles.clear();
+	ImageType type;
+	imaqGetImageType(frame.Image->GetImaqImage(), &type);
+	if (type != IMAQ_IMAGE_RGB) {
+		return false;
+	}
+	ImageInfo info;
+	imaqGetImageInfo(frame.Image->GetImaqImage(), &info);
+	if (info.xRes != mOptionsWidth) {
+		SetImageWidth(info.xRes);
+	}
+	
+	const SearchRegion *region = frame.Region;
+	bool isTracking = (region != NULL) and region->IsSet;
+	bool searchAll = !isTracking;
+	if (isTracking) {
+		bool isClipped = DetectBlobs(frame, info, region->Bounds);
+		searchAll = isClipped or ((int) frame.Rectangles.size() < region->TargetCount);
+	}
+	bool isCoarse = searchAll and (mPyramidStep > 1) and DetectPyramid(frame, info);
+	if (searchAll and !isCoarse) {
+		frame.Rectangles.clear();
+		Rect all = {0, 0, info.yRes, info.xRes};
+		DetectBlobs(frame, info, all);
+	}
+	Telemetry::GetInstance()->Log(!searchAll, "Camera region search");
+	Telemetry::GetInstance()->Log(isCoarse, "Camera pyramid search");
+	return !frame.Rectangles.empty();
+}
+
+/**
+ * @brief Searches the whole picture at 1 / mPyramidStep size, then
+ * at full size around whatever turned up.
+ * 
+ * @returns False if the result can't be trusted (a rectangle ran
+ * off the edge of its window, or the windows would cover most of
+ * the picture anyway), in which case the whole picture should be
+ * searched at full size instead.
+ */
+bool BlobSearchStage::DetectPyramid(PipelineFrame &frame, const ImageInfo &info)
+{
+	int stride = info.pixelsPerLine * sizeof(RGBValue);
+	Masking::ThresholdSampled(
+			(const unsigned char *) info.imageStart,
+			info.xRes,
+			info.yRes,
+			stride,
+			Masking::kLayoutNI,
+			mColorRange,
+			mPyramidStep,
+			mRuns);
+	mCoarseFinder.Find(mRuns, mBlobs);
+	FindWindows(info.xRes, info.yRes);
+	
+	int windowArea = 0;
+	int size = (int) mWindows.size();
+	for (int i=0; i<size; i++) {
+		windowArea += mWindows[i].width * mWindows[i].height;
+	}
+	if (windowArea > kMaxWindowFraction * info.xRes * info.yRes) {
+		return false;
+	}
+	
+	frame.Rectangles.clear();
+	for (int i=0; i<size; i++) {
+		if (DetectBlobs(frame, info, mWindows[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Turns the blobs found by the coarse search into full-size
+ * windows to search, joining any that overlap so that no pixel is
+ * searched twice.
+ * 
+ * @param[in] width The width of the picture, in pixels.
+ * @param[in] height The height of the picture, in pixels.
+ */
+void BlobSearchStage::FindWindows(int width, int height)
+{
+	mWindows.clear();
+	int margin = kWindowMargin + mPyramidStep;
+	int size = (int) mBlobs.size();
+	for (int i=0; i<size; i++) {
+		Blob &blob = mBlobs[i];
+		int left = blob.Left * mPyramidStep - margin;
+		int top = blob.Top * mPyramidStep - margin;
+		int right = (blob.Right + 1) * mPyramidStep + margin;		// Exclusive
+		int bottom = (blob.Bottom + 1) * mPyramidStep + margin;
+		left = (left < 0) ? 0 : left;
+		top = (top < 0) ? 0 : top;
+		right = (right > width) ? width : right;
+		bottom = (bottom > height) ? height : bottom;
+		Rect window = {top, left, bottom - top, right - left};
+		mWindows.push_back(window);
+	}
+	
+	bool isJoined = true;
+	while (isJoined) {
+		isJoined = false;
+		for (int i=0; i<(int) mWindows.size(); i++) {
+			for (int j=i+1; j<(int) mWindows.size(); j++) {
+				Rect &a = mWindows[i];
+				Rect &b = mWindows[j];
+				if ((a.left > b.left + b.width) or (b.left > a.left + a.width)
+						or (a.top > b.top + b.height) or (b.top > a.top + a.height)) {
+					continue;		// Not even touching
+				}
+				int right = max(a.left + a.width, b.left + b.width);
+				int bottom = max(a.top + a.height, b.top + b.height);
+				a.left = min(a.left, b.left);
+				a.top = min(a.top, b.top);
+				a.width = right - a.left;
+				a.height = bottom - a.top;
+				mWindows.erase(mWindows.begin() + j);
+				isJoined = true;
+				j--;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Thresholds and labels part of a picture, adding the
+ * rectangles found to the frame.
+ * 
+ * @returns True if a rectangle touches the edge of the region
+ * (other than the edge of the picture), meaning it may continue
+ * outside it.
+ */
+bool BlobSearchStage::DetectBlobs(PipelineFrame &frame, const ImageInfo &info, const Rect &region)
+{
+	const unsigned char *pixels = (const unsigned char *) info.imageStart;
+	int stride = info.pixelsPerLine * sizeof(RGBValue);
+	Masking::Threshold(
+			pixels + region.top * stride + region.left * sizeof(RGBValue),
+			region.width,
+			region.height,
+			stride,
+			Masking::kLayoutNI,
+			mColorRange,
+			mRuns);
+	mBlobFinder.Find(mRuns, mBlobs);
+	
+	bool isClipped = false;
+	int size = (int) mBlobs.size();
+	for (int i=0; i<size; i++) {
+		Blob &blob = mBlobs[i];
+		RectangleMatch r;
+		for (int c=0; c<4; c++) {
+			r.corner[c].x = blob.CornerX[c] + region.left;
+			r.corner[c].y = blob.CornerY[c] + region.top;
+		}
+		r.rotation = blob.Rotation;
+		r.width = blob.Width;
+		r.height = blob.Height;
+		r.score = blob.Score;
+		frame.Rectangles.push_back(r);
+		
+		isClipped = isClipped
+				or ((blob.Left == 0) and (region.left > 0))
+				or ((blob.Top == 0) and (region.top > 0))
+				or ((blob.Right == region.width - 1) and (region.left + region.width < info.xRes))
+				or ((blob.Bottom == region.height - 1) and (region.top + region.height < info.yRes));
+	}
+	return isClipped;
+}
+
+/**
+ * @brief How much smaller the first look at the whole picture is:
+ * 2 for 320x240, 4 for 160x120, or 1 to skip it and search the
+ * whole picture at full size.
+ * 
+ * @details
+ * Bigger steps are quicker, but the tape gets thinner along with
+ * everything else, and targets far enough away may be missed.
+ */
+void BlobSearchStage::SetPyramidStep(int step)
+{
+	mPyramidStep = (step < 1) ? 1 : step;
+	
+	// Blobs are about 1 / step the size when sampled, and their
+	// outlines too rough to score.
+	BlobFinder::Options options = mBlobFinder.GetOptions();
+	options.MinThickness = max(1, options.MinThickness / mPyramidStep);
+	options.MinWidth /= mPyramidStep;
+	options.MaxWidth = options.MaxWidth / mPyramidStep + 1;
+	options.MinHeight /= mPyramidStep;
+	options.MaxHeight = options.MaxHeight / mPyramidStep + 1;
+	options.MinScore = 0;
+	mCoarseFinder.SetOptions(options);
+}
+
+int BlobSearchStage::GetPyramidStep()
+{
+	return mPyramidStep;
+}
+
+
+
+/**
+ * @param[in] width The usual width of the pictures, in pixels.
+ * @param[in] height Likewise.
+ */
+MeasureStage::MeasureStage(int width, int height) :
+		PipelineStage("measure")
+{
+	mIsLensCalibrated = mLens.Load(LensModel::kLensFile);
+	if (!mIsLensCalibrated) {
+		printf("MeasureStage: no usable %s, assuming a nominal lens\n", LensModel::kLensFile);
+	}
+	mTargetWidth = 0;
+	mTargetHeight = 0;
+	SetImageSize(width, height);
+}
+
+/**
+ * @brief Sets the size of the target, in inches.  Until it's set,
+ * targets have no distance or pose.
+ */
+void MeasureStage::SetTargetSize(double width, double height)
+{
+	mTargetWidth = width;
+	mTargetHeight = height;
+	mPoseSolver.SetTargetSize(width, height);
+}
+
+/**
+ * @brief Whether the lens came from a calibration file rather than
+ * being assumed.
+ */
+bool MeasureStage::IsLensCalibrated()
+{
+	return mIsLensCalibrated;
+}
+
+void MeasureStage::SetImageSize(int width, int height)
+{
+	mAngles.Build(mLens, width, height);
+	mPoseSolver.SetLens(mLens, width, height);
+}
+
+bool MeasureStage::Process(PipelineFrame &frame)
+{
+	int width = frame.Image->GetWidth();
+	int height = frame.Image->GetHeight();
+	if ((width != mAngles.GetWidth()) or (height != mAngles.GetHeight())) {
+		SetImageSize(width, height);
+	}
+	
+	int size = (int) frame.Rectangles.size();
+	for (int i=0; i<size; i++) {
+		frame.Targets->push_back(MakeTarget(frame.Rectangles[i]));
+	}
+	return !frame.Targets->empty();
+}
+
+/**
+ * @brief Turns a rectangle into a target.
+ */
+TargetUtils::Target MeasureStage::MakeTarget(const RectangleMatch &r)
+{
+	TargetUtils::Target t;
+	
+	t.Width = r.width;
+	t.Height = r.height;
+	t.Rotation = r.rotation;	// Rotation from camera's horizontal axis.
+	
+	t.Score = r.score;
+	t.TopLeft.Set(r.corner[0].x, r.corner[0].y);
+	t.TopRight.Set(r.corner[1].x, r.corner[1].y);
+	t.BottomRight.Set(r.corner[2].x, r.corner[2].y);
+	t.BottomLeft.Set(r.corner[3].x, r.corner[3].y);
+	
+	float avgMiddleX = (r.corner[0].x + r.corner[1].x + r.corner[2].x + r.corner[3].x) / 4;
+	float avgMiddleY = (r.corner[0].y + r.corner[1].y + r.corner[2].y + r.corner[3].y) / 4;
+	t.Middle.Set(avgMiddleX, avgMiddleY);
+	
+	t.DistanceFromCamera = 0;
+	if (mTargetWidth > 0) {
+		double x[4] = {r.corner[0].x, r.corner[1].x, r.corner[2].x, r.corner[3].x};
+		double y[4] = {r.corner[0].y, r.corner[1].y, r.corner[2].y, r.corner[3].y};
+		mPoseSolver.Solve(x, y, t.Pose);
+		if (mIsLensCalibrated and t.Pose.IsValid) {
+			t.DistanceFromCamera = t.Pose.Distance;
+		} else {
+			t.DistanceFromCamera = CalculateDistanceBasedOnWidth(t.Width);
+		}
+	}
+	t.XAngleFromCamera = FindXAngle(avgMiddleX);
+	t.YAngleFromCamera = FindYAngle(avgMiddleY);
+	return t;
+}
+
+/**
+ * Input:
+ *   - Width (in pixels)
+ * 
+ * Output:
+ *   - Distance from the camera to approx the center of the target
+ *     (in inches)
+ * 
+ * The formula was measured with the 24 inch wide target in 640x480
+ * pictures; other sizes of either are scaled to match.
+ */
+double MeasureStage::CalculateDistanceBasedOnWidth(double widthInPixels)
+{
+	// Based on exeriments we conducted...
+	// Axis 206 Network camera
+	// 640x480
+	// The dial contains a focus -- the groove over the 'ar' in
+	// 'Near' should be just a hair to the left of the bump.
+	// Original formula: (17490 / widthInPixels) - 6.97
+	
+	double width = widthInPixels * (640.0 / mAngles.GetWidth()) * (24 / mTargetWidth);
+	double distance = (17490 / width) - 6.97;
+	return distance;
+}
+
+/**
+ * @brief The horizontal angle to a place in the picture, in
+ * degrees, allowing for the lens (see lens.h).
+ */
+double MeasureStage::FindXAngle(double middleXCoordinate) {
+	return mAngles.GetXAngle(middleXCoordinate);
+}
+
+/**
+ * @brief The vertical angle to a place in the picture, in degrees,
+ * allowing for the lens.
+ */
+double MeasureStage::FindYAngle(double middleYCoordinate) {
+	return mAngles.GetYAngle(middleYCoordinate);
+}
+
+
+
+/**
+ * @param[in] minScore Targets scoring less are dropped.
+ * @param[in] maxTargets How many to keep at most, or 0 for all of
+ * them.
+ */
+ScoreStage::ScoreStage(double minScore, int maxTargets) :
+		PipelineStage("score")
+{
+	mMinScore = minScore;
+	mMaxTargets = maxTargets;
+}
+
+bool ScoreStage::Process(PipelineFrame &frame)
+{
+	vector<TargetUtils::Target> &targets = *frame.Targets;
+	int kept = 0;
+	int size = (int) targets.size();
+	for (int i=0; i<size; i++) {
+		if (targets[i].Score < mMinScore) {
+			continue;
+		}
+		// An insertion sort: there are only ever a few targets, and
+		// equal scores stay in the order they were found.
+		TargetUtils::Target t = targets[i];
+		int j = kept;
+		while ((j > 0) and (targets[j - 1].Score < t.Score)) {
+			targets[j] = targets[j - 1];
+			j--;
+		}
+		targets[j] = t;
+		kept++;
+	}
+	if ((mMaxTargets > 0) and (kept > mMaxTargets)) {
+		kept = mMaxTargets;
+	}
+	targets.resize(kept);
+	return kept > 0;
+}
@@ -0,0 +1,346 @@
+/**
+ * @file pipeline.h
+ * 
+ * @brief Image processing put together from stages: a kind of
+ * target is a list of them, run in order on every picture.
+ * 
+ * @details
+ * Each stage does one job -- thresholding, removing small
+ * particles, filling in hulls, fitting shapes, measuring, scoring --
+ * and keeps whatever images and vectors it needs from one picture
+ * to the next, so a pipeline allocates nothing once its buffers
+ * have grown to fit.  Stages hand their work on through a
+ * PipelineFrame: the latest black-and-white image, the shapes found
+ * in it and the targets made from them.
+ * 
+ * The pipeline times every stage with a StageTimer, under the
+ * stage's name, so any kind of target can be profiled stage by
+ * stage without the stages timing themselves.
+ * 
+ * Usage:
+ * @code
+ * // Once
+ * ThresholdStage threshold(range, IMAQ_RGB, 640, 480);
+ * ConvexHullStage hull(640, 480);
+ * ParticleStage particles(20, 640);
+ * MeasureStage measure(640, 480);
+ * ImagePipeline pipeline;
+ * pipeline.AddStage(&threshold);
+ * pipeline.AddStage(&hull);
+ * pipeline.AddStage(&particles);
+ * pipeline.AddStage(&measure);
+ * 
+ * // Every picture
+ * pipeline.Run(image, targets);
+ * @endcode
+ * 
+ * A pipeline doesn't own its stages, so one stage can be in more
+ * than one pipeline, as long as only one of them runs at a time.
+ * 
+ * Sizes given to a stage in pixels (smallest particles, sizes of
+ * rectangle) are for the usual width of the pictures it is made
+ * with.  A CameraGovernor may ask the camera for smaller pictures,
+ * so the stages scale them to each picture's width.
+ */
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+// Standard library
+#include <vector>
+
+// 3rd party libraries
+#include "WPILib.h"
+#include "nivision.h"
+#include "Vision/ColorImage.h"
+#include "Vision/BinaryImage.h"
+
+// Program modules
+#include "stages.h"
+#include "mask.h"
+#include "blobs.h"
+#include "lens.h"
+#include "pose.h"
+
+namespace TargetUtils {
+	struct Target;
+}
+
+/**
+ * @brief Where to look for the targets, when they were found in
+ * the last picture.
+ */
+struct SearchRegion
+{
+public:
+	SearchRegion();
+	
+	bool IsSet;
+	Rect Bounds;
+	ROI *Region;		// The same rectangle, for NI Vision
+	int TargetCount;	// How many targets were found in it last time
+	int ImageWidth;		// Of the picture it was found in
+	int ImageHeight;
+};
+
+/**
+ * @brief What the stages pass along to each other while one
+ * picture is processed.
+ */
+struct PipelineFrame
+{
+public:
+	PipelineFrame();
+	
+	ColorImage *Image;			// Left unchanged
+	const SearchRegion *Region;		// NULL to search the whole picture
+	BinaryImage *Mask;			// The latest black-and-white image; belongs to the stage that made it
+	vector<RectangleMatch> Rectangles;	// The shapes found
+	vector<TargetUtils::Target> *Targets;	// What the pipeline returns
+};
+
+/**
+ * @brief One step of the image processing.
+ */
+class PipelineStage
+{
+public:
+	PipelineStage(const char *);
+	virtual ~PipelineStage();
+	const char *GetName() const;
+	
+	/**
+	 * @brief Does this stage's work on a picture.
+	 * 
+	 * @returns False if there is nothing left for the later stages
+	 * to do (no particles, say), in which case they are skipped.
+	 */
+	virtual bool Process(PipelineFrame &) = 0;
+	
+protected:
+	const char *mName;
+};
+
+/**
+ * @brief Runs a list of stages on a picture, timing each one.
+ * 
+ * @details
+ * Only one task at a time may run a given pipeline.
+ */
+class ImagePipeline
+{
+public:
+	static const int kMaxStages = StageTimer::kMaxStages;
+	static const int kMaxRectangles = 32;		// Only a starting size; more still fit
+	
+	ImagePipeline();
+	bool AddStage(PipelineStage *);
+	bool Run(ColorImage *, vector<TargetUtils::Target> &, const SearchRegion *region = NULL);
+	int GetStageCount() const;
+	StageTimer &GetStageTimer();
+	
+protected:
+	PipelineStage *mStages[kMaxStages];
+	int mStageCount;
+	StageTimer mTimer;
+	PipelineFrame mFrame;
+};
+
+
+
+/**
+ * @brief Keeps the pixels whose color is within a range.
+ */
+class ThresholdStage : public PipelineStage
+{
+public:
+	ThresholdStage(const Threshold &, ColorMode, int, int);
+	virtual ~ThresholdStage();
+	bool Process(PipelineFrame &);
+	
+protected:
+	Range mRanges[3];
+	ColorMode mMode;
+	BinaryImage *mImage;
+};
+
+/**
+ * @brief Removes the particles too small to survive a number of
+ * erosions, like RemoveSmallObjects.
+ */
+class SizeFilterStage : public PipelineStage
+{
+public:
+	SizeFilterStage(int, int, int);
+	virtual ~SizeFilterStage();
+	bool Process(PipelineFrame &);
+	
+protected:
+	int mErosions;			// At the usual width
+	int mUsualWidth;		// In pixels
+	BinaryImage *mImage;
+};
+
+/**
+ * @brief Fills in each particle's convex hull, so a partly hidden
+ * or broken-up target is whole again.
+ */
+class ConvexHullStage : public PipelineStage
+{
+public:
+	ConvexHullStage(int, int);
+	virtual ~ConvexHullStage();
+	bool Process(PipelineFrame &);
+	
+protected:
+	BinaryImage *mImage;
+};
+
+/**
+ * @brief Fits rectangles to the particles with NI Vision, looking
+ * in the frame's region first when it has one.
+ * 
+ * @details
+ * If fewer rectangles turn up in the region than were there last
+ * time, some may have left it, so the whole picture is searched
+ * after all.
+ */
+class RectangleStage : public PipelineStage
+{
+public:
+	RectangleStage(const RectangleDescriptor &, const CurveOptions &, const ShapeDetectionOptions &, int);
+	bool Process(PipelineFrame &);
+	
+protected:
+	RectangleDescriptor mUsualDescriptor;	// At the usual width
+	int mUsualWidth;			// In pixels
+	RectangleDescriptor mDescriptor;	// Scaled to the latest picture
+	int mDescriptorWidth;
+	CurveOptions mCurveOptions;
+	ShapeDetectionOptions mShapeOptions;
+	
+	void SetImageWidth(int);
+	void Detect(PipelineFrame &, ROI *);
+};
+
+/**
+ * @brief Turns each particle big enough to keep into a rectangle:
+ * its bounding box, scored on how much of the box it fills.
+ * 
+ * @details
+ * For round or irregular targets, where fitting a rectangle means
+ * little.
+ */
+class ParticleStage : public PipelineStage
+{
+public:
+	ParticleStage(double, int);
+	bool Process(PipelineFrame &);
+	
+protected:
+	double mMinArea;		// In pixels, at the usual width
+	int mUsualWidth;		// In pixels
+};
+
+/**
+ * @brief Finds rectangles straight from an RGB picture's pixels
+ * with the in-tree code in mask.h and blobs.h, instead of NI
+ * Vision.
+ * 
+ * @details
+ * Thresholding and labelling are done together, a window at a
+ * time, so they are one stage here.
+ * 
+ * When the whole picture has to be searched, the first look is at
+ * every second pixel of every second row (see SetPyramidStep), and
+ * only windows around each blob found are searched at full size.
+ * The corners always come from the full-size picture.
+ * 
+ * Only RGB images can be searched; anything else finds nothing.
+ */
+class BlobSearchStage : public PipelineStage
+{
+public:
+	static const int kDefaultPyramidStep = 2;	// 320x240 first
+	static const int kWindowMargin = 8;		// In full-size pixels, beyond the blob's sampled pixels
+	static const double kMaxWindowFraction = 0.5;	// Of the picture; past that, just search all of it
+	
+	BlobSearchStage(const Masking::ColorRange &, const BlobFinder::Options &, int, int);
+	bool Process(PipelineFrame &);
+	void SetPyramidStep(int);
+	int GetPyramidStep();
+	
+protected:
+	Masking::ColorRange mColorRange;
+	BlobFinder::Options mUsualOptions;	// At the usual width
+	int mUsualWidth;			// In pixels
+	int mOptionsWidth;			// What mBlobFinder's options are scaled to
+	RunMask mRuns;
+	BlobFinder mBlobFinder;
+	vector<Blob> mBlobs;
+	
+	// For the first, smaller look at the whole picture
+	int mPyramidStep;
+	BlobFinder mCoarseFinder;
+	vector<Rect> mWindows;
+	
+	void SetImageWidth(int);
+	bool DetectBlobs(PipelineFrame &, const ImageInfo &, const Rect &);
+	bool DetectPyramid(PipelineFrame &, const ImageInfo &);
+	void FindWindows(int, int);
+};
+
+/**
+ * @brief Turns rectangles into targets: works out their middles,
+ * the angles to them and, if the target's size is known, the
+ * distance to them and where the camera is from them.
+ * 
+ * @details
+ * The lens (see lens.h) is loaded once, from LensModel::kLensFile,
+ * and the angle tables are rebuilt whenever the picture's size
+ * changes.
+ * 
+ * The distance comes from the pose solved from the corners when
+ * the lens has been calibrated.  Otherwise it comes from the
+ * width, by a formula measured on the real camera, since the
+ * nominal lens is only a guess.
+ */
+class MeasureStage : public PipelineStage
+{
+public:
+	MeasureStage(int, int);
+	bool Process(PipelineFrame &);
+	void SetTargetSize(double, double);
+	bool IsLensCalibrated();
+	
+protected:
+	LensModel mLens;
+	bool mIsLensCalibrated;
+	CameraAngles mAngles;
+	PoseSolver mPoseSolver;
+	double mTargetWidth;		// In inches; 0 if not known
+	double mTargetHeight;
+	
+	void SetImageSize(int, int);
+	TargetUtils::Target MakeTarget(const RectangleMatch &);
+	double CalculateDistanceBasedOnWidth(double);
+	double FindXAngle(double);
+	double FindYAngle(double);
+};
+
+/**
+ * @brief Puts the targets best first, and drops those scoring too
+ * low or past a maximum count.
+ */
+class ScoreStage : public PipelineStage
+{
+public:
+	ScoreStage(double, int);
+	bool Process(PipelineFrame &);
+	
+protected:
+	double mMinScore;
+	int mMaxTargets;		// 0 for no limit
+};
+
+#endif
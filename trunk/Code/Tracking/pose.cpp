@@ -0,0 +1,208 @@
+#include "pose.h"
+
+// System libraries
+#include <math.h>
+
+namespace
+{
+	/**
+	 * Solves the 8x8 system a x = b in place, by Gaussian
+	 * elimination with partial pivoting.  Returns false if it's
+	 * singular.
+	 */
+	bool Solve8(double a[8][8], double b[8], double x[8])
+	{
+		for (int column=0; column<8; column++) {
+			int pivot = column;
+			for (int row=column+1; row<8; row++) {
+				if (fabs(a[row][column]) > fabs(a[pivot][column])) {
+					pivot = row;
+				}
+			}
+			if (fabs(a[pivot][column]) < 1e-12) {
+				return false;
+			}
+			if (pivot != column) {
+				for (int k=0; k<8; k++) {
+					double swap = a[pivot][k];
+					a[pivot][k] = a[column][k];
+					a[column][k] = swap;
+				}
+				double swap = b[pivot];
+				b[pivot] = b[column];
+				b[column] = swap;
+			}
+			for (int row=column+1; row<8; row++) {
+				double factor = a[row][column] / a[column][column];
+				for (int k=column; k<8; k++) {
+					a[row][k] -= factor * a[column][k];
+				}
+				b[row] -= factor * b[column];
+			}
+		}
+		for (int row=7; row>=0; row--) {
+			double sum = b[row];
+			for (int k=row+1; k<8; k++) {
+				sum -= a[row][k] * x[k];
+			}
+			x[row] = sum / a[row][row];
+		}
+		return true;
+	}
+	
+	double Length(const double *v)
+	{
+		return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	}
+}
+
+TargetPose::TargetPose()
+{
+	IsValid = false;
+	Distance = 0;
+	Lateral = 0;
+	Along = 0;
+	FaceAngle = 0;
+}
+
+PoseSolver::PoseSolver()
+{
+	SetLens(LensModel(), 640, 480);
+	SetTargetSize(kDefaultTargetWidth, kDefaultTargetHeight);
+}
+
+/**
+ * @brief Sets the lens the pictures are taken through.
+ * 
+ * @param[in] lens At any size; it is scaled to fit.
+ * @param[in] width Of the pictures the corners come from, in
+ * pixels.
+ * @param[in] height
+ */
+void PoseSolver::SetLens(const LensModel &lens, int width, int height)
+{
+	mLens = lens.Scaled(width, height);
+}
+
+/**
+ * @brief Sets the size of the rectangle the corners are of.
+ * 
+ * @param[in] width In inches.
+ * @param[in] height
+ */
+void PoseSolver::SetTargetSize(double width, double height)
+{
+	mHalfWidth = width / 2;
+	mHalfHeight = height / 2;
+}
+
+/**
+ * @brief Finds the homography from the backboard (in inches, from
+ * the target's middle, x right and y down) to the picture (in
+ * normalised, undistorted coordinates).  Four points fix it
+ * exactly.
+ * 
+ * @param[out] h Row by row, with h[8] = 1.
+ */
+bool PoseSolver::FindHomography(const double *x, const double *y, double *h) const
+{
+	const double boardX[4] = {-mHalfWidth, mHalfWidth, mHalfWidth, -mHalfWidth};
+	const double boardY[4] = {-mHalfHeight, -mHalfHeight, mHalfHeight, mHalfHeight};
+	double a[8][8];
+	double b[8];
+	for (int i=0; i<4; i++) {
+		double u;
+		double v;
+		mLens.Undistort((x[i] - mLens.CenterX) / mLens.FocalX, (y[i] - mLens.CenterY) / mLens.FocalY, u, v);
+		double X = boardX[i];
+		double Y = boardY[i];
+		double rowU[8] = {X, Y, 1, 0, 0, 0, -u * X, -u * Y};
+		double rowV[8] = {0, 0, 0, X, Y, 1, -v * X, -v * Y};
+		for (int k=0; k<8; k++) {
+			a[2 * i][k] = rowU[k];
+			a[2 * i + 1][k] = rowV[k];
+		}
+		b[2 * i] = u;
+		b[2 * i + 1] = v;
+	}
+	if (!Solve8(a, b, h)) {
+		return false;
+	}
+	h[8] = 1;
+	return true;
+}
+
+/**
+ * @brief Works out where the camera is relative to a target.
+ * 
+ * @details
+ * With the lens taken out, the homography is the first two columns
+ * of the backboard's rotation and its position, up to a scale:
+ * H = s [r1 r2 t].  The scale comes from r1 and r2 being unit
+ * length (averaged, as noise makes them differ), and r2 is then
+ * made exactly perpendicular to r1.
+ * 
+ * @param[in] x The corners' x, in pixels: top left, top right,
+ * bottom right, bottom left.
+ * @param[in] y Their y.
+ * @param[out] pose Set even when this fails, with IsValid false.
+ * 
+ * @returns False if the corners don't make a rectangle seen from
+ * in front.
+ */
+bool PoseSolver::Solve(const double *x, const double *y, TargetPose &pose) const
+{
+	pose = TargetPose();
+	double h[9];
+	if (!FindHomography(x, y, h)) {
+		return false;
+	}
+	double r1[3] = {h[0], h[3], h[6]};
+	double r2[3] = {h[1], h[4], h[7]};
+	double t[3] = {h[2], h[5], h[8]};
+	double length1 = Length(r1);
+	double length2 = Length(r2);
+	if ((length1 <= 0) or (length2 <= 0)) {
+		return false;
+	}
+	double scale = 2 / (length1 + length2);
+	if (t[2] < 0) {
+		scale = -scale;		// The target is in front of the camera
+	}
+	for (int i=0; i<3; i++) {
+		r1[i] *= scale;
+		r2[i] *= scale;
+		t[i] *= scale;
+	}
+	
+	length1 = Length(r1);
+	double dot = 0;
+	for (int i=0; i<3; i++) {
+		r1[i] /= length1;
+		dot += r1[i] * r2[i];
+	}
+	for (int i=0; i<3; i++) {
+		r2[i] -= dot * r1[i];
+	}
+	length2 = Length(r2);
+	for (int i=0; i<3; i++) {
+		r2[i] /= length2;
+	}
+	// Into the backboard, in the camera's terms
+	double r3[3] = {
+		r1[1] * r2[2] - r1[2] * r2[1],
+		r1[2] * r2[0] - r1[0] * r2[2],
+		r1[0] * r2[1] - r1[1] * r2[0]
+	};
+	if (r3[2] <= 0) {
+		return false;		// Seen from behind, so the corners are muddled
+	}
+	
+	// The camera's position on the backboard's axes is -R^T t.
+	pose.Distance = Length(t);
+	pose.Lateral = -(r1[0] * t[0] + r1[1] * t[1] + r1[2] * t[2]);
+	pose.Along = r3[0] * t[0] + r3[1] * t[1] + r3[2] * t[2];
+	pose.FaceAngle = atan2(r3[0], r3[2]) * 180 / M_PI;
+	pose.IsValid = true;
+	return true;
+}
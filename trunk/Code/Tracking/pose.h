@@ -0,0 +1,90 @@
+/**
+ * @file pose.h
+ * 
+ * @brief Works out where the camera is relative to a target from
+ * the target's four corners in one picture.
+ * 
+ * @details
+ * The target is a rectangle of known size (24x18 inches, to the
+ * outside of the tape) on a flat backboard, so its corners in the
+ * picture pin down a homography from the backboard to the picture,
+ * and that in turn the camera's position and heading relative to
+ * the backboard -- no averaging over several pictures needed.
+ * 
+ * The corners are first moved back to where a pinhole camera would
+ * have seen them, using the lens (see lens.h), so the answer is
+ * only as good as the lens calibration.
+ * 
+ * How good a single picture is: with the corners a third of a
+ * pixel out (at random), from 10 feet straight on, the distance is
+ * within about half an inch, but the face angle is only within
+ * about 2 degrees and the lateral offset within 4 inches.  Those
+ * two come from how much nearer one side of the target is than
+ * the other, which is slight for a 24 inch target seen head on;
+ * they get better the further round to the side the robot is, and
+ * worse with distance.
+ * 
+ * Usage:
+ * @code
+ * // Once
+ * PoseSolver solver;
+ * solver.SetLens(lens, 640, 480);
+ * 
+ * // For each target, corners in the order top left, top right,
+ * // bottom right, bottom left
+ * TargetPose pose;
+ * if (solver.Solve(x, y, pose)) {
+ *     // pose.Distance, pose.Lateral, pose.FaceAngle
+ * }
+ * @endcode
+ */
+
+#ifndef POSE_H_
+#define POSE_H_
+
+// Program modules
+#include "lens.h"
+
+/**
+ * @brief Where the camera is relative to one target.
+ * 
+ * @details
+ * Seen from in front of the backboard: Lateral is positive when the
+ * camera is to the right of the target's middle, and FaceAngle is
+ * positive when the robot has to turn clockwise to face the
+ * backboard square on.
+ */
+struct TargetPose
+{
+	bool IsValid;			// False if the corners couldn't be made sense of
+	double Distance;		// In inches, from the camera to the middle of the target
+	double Lateral;			// In inches, along the backboard from the target's middle
+	double Along;			// In inches, straight out from the backboard
+	double FaceAngle;		// In degrees
+	
+	TargetPose();
+};
+
+/**
+ * @brief Solves for a TargetPose from four corners, in closed form.
+ */
+class PoseSolver
+{
+public:
+	static const double kDefaultTargetWidth = 24;		// In inches
+	static const double kDefaultTargetHeight = 18;
+	
+	PoseSolver();
+	void SetLens(const LensModel &, int, int);
+	void SetTargetSize(double, double);
+	bool Solve(const double *, const double *, TargetPose &) const;
+	
+protected:
+	LensModel mLens;			// Scaled to the pictures' size
+	double mHalfWidth;			// In inches
+	double mHalfHeight;
+	
+	bool FindHomography(const double *, const double *, double *) const;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "stages.h"
+
+StageTimer::StageTimer()
+{
+	mStageCount = 0;
+	mCurrent = -1;
+	mStartTime = 0;
+	Reset();
+}
+
+/**
+ * @brief Names a stage.
+ * 
+ * @param[in] name Must outlive the timer (a string literal is
+ * fine).
+ * 
+ * @returns The number to pass to Begin, or -1 if there's no room.
+ * Beginning stage -1 just ends the current one.
+ */
+int StageTimer::AddStage(const char *name)
+{
+	if (mStageCount >= kMaxStages) {
+		return -1;
+	}
+	mNames[mStageCount] = name;
+	mTotals[mStageCount] = 0;
+	return mStageCount++;
+}
+
+/**
+ * @brief Ends the current stage, if any, and starts timing another.
+ */
+void StageTimer::Begin(int stage)
+{
+	double now = Timer::GetPPCTimestamp();
+	if (mCurrent >= 0) {
+		mTotals[mCurrent] += now - mStartTime;
+	}
+	mCurrent = ((stage >= 0) and (stage < mStageCount)) ? stage : -1;
+	mStartTime = now;
+}
+
+void StageTimer::End()
+{
+	Begin(-1);
+}
+
+/**
+ * @brief Ends the current stage and counts one more picture.
+ */
+void StageTimer::EndFrame()
+{
+	End();
+	mFrameCount++;
+}
+
+/**
+ * @brief Sets every total, and the picture count, back to 0.
+ */
+void StageTimer::Reset()
+{
+	for (int i=0; i<kMaxStages; i++) {
+		mTotals[i] = 0;
+	}
+	mCurrent = -1;
+	mFrameCount = 0;
+}
+
+int StageTimer::GetStageCount() const
+{
+	return mStageCount;
+}
+
+const char *StageTimer::GetStageName(int stage) const
+{
+	return mNames[stage];
+}
+
+/**
+ * @brief All the time spent in a stage since the last Reset, in
+ * seconds.
+ */
+double StageTimer::GetTotal(int stage) const
+{
+	return mTotals[stage];
+}
+
+/**
+ * @brief The time spent in a stage per picture, in seconds.
+ */
+double StageTimer::GetAverage(int stage) const
+{
+	return (mFrameCount > 0) ? mTotals[stage] / mFrameCount : 0;
+}
+
+UINT32 StageTimer::GetFrameCount() const
+{
+	return mFrameCount;
+}
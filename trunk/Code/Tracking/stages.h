@@ -0,0 +1,66 @@
+/**
+ * @file stages.h
+ * 
+ * @brief Adds up how long each stage of the image processing
+ * takes, so changes to it can be judged on numbers.
+ * 
+ * @details
+ * Times come from Timer::GetPPCTimestamp, the processor's own
+ * clock, which is much finer than the control loop's.
+ * 
+ * Usage:
+ * @code
+ * // Once
+ * int threshold = timer.AddStage("threshold");
+ * int shapes = timer.AddStage("shapes");
+ * 
+ * // Every picture
+ * timer.Begin(threshold);
+ * ...
+ * timer.Begin(shapes);		// Ends the threshold stage
+ * ...
+ * timer.EndFrame();		// Ends the shapes stage and counts the picture
+ * @endcode
+ * 
+ * A stage can be begun more than once a picture; its times are
+ * added together.
+ */
+
+#ifndef STAGES_H_
+#define STAGES_H_
+
+// 3rd party libraries
+#include "WPILib.h"
+
+/**
+ * @brief Running totals of the time spent in each named stage.
+ */
+class StageTimer
+{
+public:
+	static const int kMaxStages = 8;
+	
+	StageTimer();
+	int AddStage(const char *);
+	
+	void Begin(int);
+	void End();
+	void EndFrame();
+	void Reset();
+	
+	int GetStageCount() const;
+	const char *GetStageName(int) const;
+	double GetTotal(int) const;
+	double GetAverage(int) const;
+	UINT32 GetFrameCount() const;
+	
+protected:
+	const char *mNames[kMaxStages];
+	double mTotals[kMaxStages];		// In seconds
+	int mStageCount;
+	int mCurrent;				// -1 if none
+	double mStartTime;
+	UINT32 mFrameCount;
+};
+
+#endif
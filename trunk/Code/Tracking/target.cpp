@@ -1,5 +1,9 @@
 // 3rd party modules
 #include "target.h"
+#include "track_silver.h"
+#include "tracker.h"
+#include "../sensors.h"
+#include "../Subsystems/turning.h"
 #include "Vision/ImageBase.h"
 /*
 TestThread::TestThread(
@@ -44,7 +48,7 @@ TestThreadListener::TestThreadListener() :
 	END_REGION;
 	mLonelyNumber = 0;
 	bool result = mTestThread.Start();
-	SmartDashboard::GetInstance()->Log(result, "Listener::Result");
+	Telemetry::GetInstance()->Log(result, "Listener::Result");
 }
 
 void TestThreadListener::Update()
@@ -75,8 +79,8 @@ TestThreadController::TestThreadController(TestThreadListener *testThreadListene
 void TestThreadController::Run()
 {
 	mTestThreadListener->Update();
-	SmartDashboard::GetInstance()->Log(mTestThreadListener->GetSharedNumber(), "TestThread::SharedNumber");
-	SmartDashboard::GetInstance()->Log(mTestThreadListener->GetLonelyNumber(), "TestThread::LonelyNumber");
+	Telemetry::GetInstance()->Log(mTestThreadListener->GetSharedNumber(), "TestThread::SharedNumber");
+	Telemetry::GetInstance()->Log(mTestThreadListener->GetLonelyNumber(), "TestThread::LonelyNumber");
 }
 
 */
@@ -101,6 +105,15 @@ void TargetUtils::Coordinate::Set(float x, float y)
 	Coordinate::Y = y;
 }
 
+TargetUtils::TargetSnapshot::TargetSnapshot()
+{
+	Count = 0;
+	Timestamp = 0;
+	FrameNumber = 0;
+	ImageWidth = 0;
+	ImageHeight = 0;
+}
+
 TargetUtils::SaneBinaryImage::SaneBinaryImage(void) : BinaryImage()
 {
 	// Empty
@@ -116,6 +129,29 @@ vector<RectangleMatch> *TargetUtils::SaneBinaryImage::DetectRectangles(
 		CurveOptions *curveOptions,
 		ShapeDetectionOptions *shapeDetectionOptions,
 		ROI *roi)
+{
+	vector<RectangleMatch> *rectangles = new vector<RectangleMatch>;
+	DetectRectangles(
+			rectangleDescriptor,
+			curveOptions,
+			shapeDetectionOptions,
+			roi,
+			*rectangles);
+	return rectangles;
+}
+
+/**
+ * @brief Finds rectangles, putting them in a vector the caller
+ * owns (and can reuse).
+ * 
+ * @param[out] rectangles Emptied, then filled with the matches.
+ */
+void TargetUtils::SaneBinaryImage::DetectRectangles(
+		RectangleDescriptor *rectangleDescriptor,
+		CurveOptions *curveOptions,
+		ShapeDetectionOptions *shapeDetectionOptions,
+		ROI *roi,
+		vector<RectangleMatch> &rectangles)
 {
 	int numberOfMatches;
 	
@@ -127,18 +163,17 @@ vector<RectangleMatch> *TargetUtils::SaneBinaryImage::DetectRectangles(
 			roi,
 			&numberOfMatches		// Is modified by function.
 	);
-	vector<RectangleMatch> *rectangles = new vector<RectangleMatch>;
+	rectangles.clear();
 	
-	SmartDashboard::GetInstance()->Log(numberOfMatches, "DetectRectangles");
+	Telemetry::GetInstance()->Log(numberOfMatches, "DetectRectangles");
 	
 	if (rectangleMatch == NULL) {
-		return rectangles;
+		return;
 	}
 	for (int i = 0; i < numberOfMatches; i++) {
-		rectangles->push_back(rectangleMatch[i]);
+		rectangles.push_back(rectangleMatch[i]);
 	}
 	imaqDispose(rectangleMatch);
-	return rectangles;
 }
 
 vector<RectangleMatch> *TargetUtils::SaneBinaryImage::DetectRectangles(
@@ -184,124 +219,311 @@ static ShapeDetectionOptions shapeDetectionOptions = {
 
 
 
+namespace
+{
+	/**
+	 * @brief The in-tree engine's version of TargetUtils::threshold.
+	 */
+	Masking::ColorRange MakeColorRange(const Threshold &threshold)
+	{
+		Masking::ColorRange range;
+		range.Low[0] = threshold.plane1Low;
+		range.High[0] = threshold.plane1High;
+		range.Low[1] = threshold.plane2Low;
+		range.High[1] = threshold.plane2High;
+		range.Low[2] = threshold.plane3Low;
+		range.High[2] = threshold.plane3High;
+		return range;
+	}
+
+	/**
+	 * @brief The in-tree engine's version of rectangleDescriptor and
+	 * shapeDetectionOptions.
+	 */
+	BlobFinder::Options MakeBlobOptions()
+	{
+		BlobFinder::Options options = BlobFinder::DefaultOptions();
+		options.MinWidth = rectangleDescriptor.minWidth;
+		options.MaxWidth = rectangleDescriptor.maxWidth;
+		options.MinHeight = rectangleDescriptor.minHeight;
+		options.MaxHeight = rectangleDescriptor.maxHeight;
+		options.MinScore = shapeDetectionOptions.minMatchScore;
+		return options;
+	}
+}
+	
+const char *TargetFinder::kCameraAddress = "10.29.76.11";
+	
 TargetFinder::TargetFinder() :
-		BaseComponent()
+		BaseComponent(),
+		mThreshold(TargetUtils::threshold, IMAQ_RGB, kImageWidth, kImageHeight),
+		mSizeFilter(kErosions, kImageWidth, kImageHeight),
+		mHull(kImageWidth, kImageHeight),
+		mRectangles(rectangleDescriptor, curveOptions, shapeDetectionOptions, kImageWidth),
+		mBlobSearch(MakeColorRange(TargetUtils::threshold), MakeBlobOptions(), kImageWidth, kImageHeight),
+		mMeasure(kImageWidth, kImageHeight),
+		mScore(shapeDetectionOptions.minMatchScore, 0)
 {
-	// Empty
+	mCamera = NULL;
+	mEngine = kNIVision;
+	mCameraImage = new RGBImage();
+	
+	// Sizing the image now means the first picture doesn't have to.
+	imaqSetImageSize(mCameraImage->GetImaqImage(), kImageWidth, kImageHeight);
+	
+	mMeasure.SetTargetSize(kTargetWidthInches, kTargetHeightInches);
+	
+	mNIPipeline.AddStage(&mThreshold);
+	mNIPipeline.AddStage(&mSizeFilter);
+	mNIPipeline.AddStage(&mHull);
+	mNIPipeline.AddStage(&mRectangles);
+	mNIPipeline.AddStage(&mMeasure);
+	mNIPipeline.AddStage(&mScore);
+	
+	mInTreePipeline.AddStage(&mBlobSearch);
+	mInTreePipeline.AddStage(&mMeasure);
+	mInTreePipeline.AddStage(&mScore);
+	
+	mRegion.Region = imaqCreateROI();
+	mRegionContour = 0;
+}
+
+TargetFinder::~TargetFinder()
+{
+	delete mCameraImage;
+	delete mCamera;
+	imaqDispose(mRegion.Region);
 }
 
+/**
+ * @brief Takes a picture and finds the targets in it.
+ */
 vector<TargetUtils::Target> TargetFinder::GetTargets()
 {
 	vector<TargetUtils::Target> targets;
-	
-	AxisCamera &camera = GetCamera();
-	HSLImage *image = camera.GetImage();
+	if (Capture()) {
+		ProcessImage(targets);
+	}
+	return targets;
+}
+
+/**
+ * @brief Copies the camera's latest picture into our own image.
+ * 
+ * @returns False if the camera had no picture to give.
+ */
+bool TargetFinder::Capture()
+{
+	return GetCamera().Capture(mCameraImage);
+}
+
+/**
+ * @brief Finds the targets in the last picture taken by Capture.
+ */
+void TargetFinder::ProcessImage(vector<TargetUtils::Target> &targets)
+{
+	ProcessImage(mCameraImage, targets);
+}
+
+/**
+ * @brief Finds the targets in an image.
+ * 
+ * @details
+ * The intermediate images are written into the stages' buffers,
+ * so once the vector has grown to fit the usual number of targets
+ * this allocates nothing (NI Vision's own scratch memory aside).
+ * 
+ * @param[in] image Left unchanged.  The in-tree engine needs an
+ * RGB image; NI Vision is used for any other kind.
+ * @param[out] targets Emptied, then filled with what was found,
+ * best score first.
+ */
+void TargetFinder::ProcessImage(ColorImage *image, vector<TargetUtils::Target> &targets)
+{
+	targets.clear();
 	
 	if ((image->GetWidth() == 0) or (image->GetHeight() == 0)) {
-		delete image;
-		return targets;
+		return;
+	}
+	if ((image->GetWidth() != mRegion.ImageWidth) or (image->GetHeight() != mRegion.ImageHeight)) {
+		ResetTracking();	// The camera's resolution changed; the region means nothing now
 	}
 	
-	BinaryImage *thresholdImage = image->ThresholdRGB(TargetUtils::threshold);    // Get only colors within range
-	BinaryImage *bigObjectsImage = thresholdImage->RemoveSmallObjects(false, 1);  // Remove small objects
-	BinaryImage *convexHullImage = bigObjectsImage->ConvexHull(false);  		  // Rill in partial and full rectangles
-	TargetUtils::SaneBinaryImage *processedImage = (TargetUtils::SaneBinaryImage *) convexHullImage;
-	
-	vector<RectangleMatch> *rectangles = processedImage->DetectRectangles(
-			&rectangleDescriptor,
-			&curveOptions,
-			&shapeDetectionOptions,
-			NULL
-	);
-	
-	delete thresholdImage;
-	delete bigObjectsImage;
-	delete convexHullImage;
-	delete processedImage;
+	GetPipeline(image).Run(image, targets, &mRegion);
 	
-	int size = (int) rectangles->size();
-	SmartDashboard::GetInstance()->Log(size, "Number of targets");
+	int size = (int) targets.size();
+	Telemetry::GetInstance()->Log(size, "Number of targets");
 	
 	if (size == 0) {
-		SmartDashboard::GetInstance()->Log("None found", "Camera Pics");
-		delete rectangles;
-		delete image;
-		return targets;		// Empty vector
+		Telemetry::GetInstance()->Log("None found", "Camera Pics");
+		ResetTracking();
+		return;		// Empty vector
 	}
-	SmartDashboard::GetInstance()->Log("Found", "Camera Pics");
-	
+	Telemetry::GetInstance()->Log("Found", "Camera Pics");
+	UpdateRegion(targets, image->GetWidth(), image->GetHeight());
+}
+
+/**
+ * @brief The pipeline that will process an image: the engine's,
+ * unless it's the in-tree engine and the image isn't RGB.
+ */
+ImagePipeline &TargetFinder::GetPipeline(ColorImage *image)
+{
+	ImageType type;
+	imaqGetImageType(image->GetImaqImage(), &type);
+	if ((mEngine == kInTree) and (type == IMAQ_IMAGE_RGB)) {
+		return mInTreePipeline;
+	}
+	return mNIPipeline;
+}
+
+/**
+ * @brief Sets the region to search next time to around the
+ * targets just found.
+ * 
+ * @param[in] targets What was found.
+ * @param[in] width The width of the picture, in pixels.
+ * @param[in] height The height of the picture, in pixels.
+ */
+void TargetFinder::UpdateRegion(const vector<TargetUtils::Target> &targets, int width, int height)
+{
+	int size = (int) targets.size();
+	float left = (float) width;
+	float right = 0;
+	float top = (float) height;
+	float bottom = 0;
 	for (int i=0; i<size; i++) {
-		TargetUtils::Target t;
-		RectangleMatch r = rectangles->at(i);
-		
-		t.Width = r.width;
-		t.Height = r.height;
-		t.Rotation = r.rotation;	// Rotation from camera's horizontal axis.
-		
-		t.Score = r.score;
-		t.TopLeft.Set(r.corner[0].x, r.corner[0].y);
-		t.TopRight.Set(r.corner[1].x, r.corner[1].y);
-		t.BottomRight.Set(r.corner[2].x, r.corner[2].y);
-		t.BottomLeft.Set(r.corner[3].x, r.corner[3].y);
-		
-		float avgMiddleX = (r.corner[0].x + r.corner[1].x + r.corner[2].x + r.corner[3].x) / 4;
-		float avgMiddleY = (r.corner[0].y + r.corner[1].y + r.corner[2].y + r.corner[3].y) / 4;
-		t.Middle.Set(avgMiddleX, avgMiddleY);
-		
-		t.DistanceFromCamera = CalculateDistanceBasedOnWidth(t.Width);
-		t.XAngleFromCamera = FindXAngle(avgMiddleX);
-		t.YAngleFromCamera = FindYAngle(avgMiddleY);
-		targets.push_back(t);
+		const TargetUtils::Coordinate *corners[4] = {
+				&targets[i].TopLeft, &targets[i].TopRight,
+				&targets[i].BottomRight, &targets[i].BottomLeft};
+		for (int c=0; c<4; c++) {
+			left = min(left, corners[c]->X);
+			right = max(right, corners[c]->X);
+			top = min(top, corners[c]->Y);
+			bottom = max(bottom, corners[c]->Y);
+		}
+	}
+	int marginX = (int) ((right - left) * kRegionMargin);
+	int marginY = (int) ((bottom - top) * kRegionMargin);
+	if (marginX < kMinRegionMargin) {
+		marginX = kMinRegionMargin;
+	}
+	if (marginY < kMinRegionMargin) {
+		marginY = kMinRegionMargin;
 	}
 	
-	delete image;
-	delete rectangles;
-	return targets;
+	Rect region;
+	region.left = max(0, (int) left - marginX);
+	region.top = max(0, (int) top - marginY);
+	region.width = min(width, (int) right + 1 + marginX) - region.left;
+	region.height = min(height, (int) bottom + 1 + marginY) - region.top;
+	
+	if (mRegionContour != 0) {
+		imaqRemoveContour(mRegion.Region, mRegionContour);
+	}
+	mRegionContour = imaqAddRectContour(mRegion.Region, region);
+	mRegion.Bounds = region;
+	mRegion.IsSet = (mRegionContour != 0);
+	mRegion.TargetCount = size;
+	mRegion.ImageWidth = width;
+	mRegion.ImageHeight = height;
+}
+
+/**
+ * @brief Makes the next picture be searched from edge to edge.
+ */
+void TargetFinder::ResetTracking()
+{
+	mRegion.IsSet = false;
+	mRegion.TargetCount = 0;
+}
+
+/**
+ * @brief Whether the next picture will only be searched near the
+ * last targets.
+ */
+bool TargetFinder::IsTracking()
+{
+	return mRegion.IsSet;
+}
+
+/**
+ * @brief Chooses what finds the rectangles.  NI Vision is the
+ * default.
+ */
+void TargetFinder::SetEngine(Engine engine)
+{
+	mEngine = engine;
+	ResetTracking();
+}
+
+TargetFinder::Engine TargetFinder::GetEngine()
+{
+	return mEngine;
+}
+
+/**
+ * @brief How much smaller the in-tree engine's first look at the
+ * whole picture is (see BlobSearchStage::SetPyramidStep).
+ */
+void TargetFinder::SetPyramidStep(int step)
+{
+	mBlobSearch.SetPyramidStep(step);
 }
 
+int TargetFinder::GetPyramidStep()
+{
+	return mBlobSearch.GetPyramidStep();
+}
 
 /**
- * Input:
- *   - Width (in pixels)
+ * @brief How long each stage of the current engine's pipeline has
+ * taken, over every picture since the timer was last reset.
  * 
- * Output:
- *   - Distance from the camera to approx the center of the target
- *     (in inches)
+ * @details
+ * Pictures the in-tree engine can't take (anything but RGB) go
+ * through NI Vision's pipeline, and are timed there.
  */
-double TargetFinder::CalculateDistanceBasedOnWidth(double widthInPixels)
-{
-	// Based on exeriments we conducted...
-	// Axis 206 Network camera
-	// 640x480
-	// The dial contains a focus -- the groove over the 'ar' in
-	// 'Near' should be just a hair to the left of the bump.
-	// Original formula: (17490 / widthInPixels) - 6.97
-	
-	double distance = (17490 / widthInPixels) - 6.97; 
-	return distance;
+StageTimer &TargetFinder::GetStageTimer()
+{
+	if (mEngine == kInTree) {
+		return mInTreePipeline.GetStageTimer();
+	}
+	return mNIPipeline.GetStageTimer();
 }
 
-double TargetFinder::FindXAngle(double middleXCoordinate) {
-	double delta = middleXCoordinate - kMiddleXOfImage;
-	double percentage = delta / kMiddleXOfImage;
-	double angle = percentage * kMaxXAngleOfCamera;
-	return angle;
+/**
+ * @brief The size of the last picture taken by Capture, in pixels.
+ * 
+ * @details
+ * Usually kImageWidth by kImageHeight, but a CameraGovernor may
+ * have turned the camera's resolution down.
+ */
+int TargetFinder::GetImageWidth()
+{
+	return mCameraImage->GetWidth();
 }
 
-double TargetFinder::FindYAngle(double middleYCoordinate) {
-	double delta = middleYCoordinate - kMiddleYOfImage;
-	double percentage = delta / kMiddleYOfImage;
-	double angle = percentage * kMaxYAngleOfCamera;
-	return angle;
+int TargetFinder::GetImageHeight()
+{
+	return mCameraImage->GetHeight();
 }
 
-AxisCamera & TargetFinder::GetCamera()
+/**
+ * @brief Gets the camera, connecting to it (and sending it its
+ * settings) the first time.
+ * 
+ * @details
+ * It starts at kImageWidth by kImageHeight, with
+ * CameraSession::kDefaultCompression; those stay unless something
+ * (a CameraGovernor, say) changes them.
+ */
+CameraSession & TargetFinder::GetCamera()
 {
-	AxisCamera &camera = AxisCamera::GetInstance("10.29.76.11");
-	camera.WriteResolution(AxisCamera::kResolution_640x480);
-	camera.WriteCompression(20);
-	camera.WriteBrightness(AxisCamera::kWhiteBalance_Automatic);
-	return camera;
+	if (mCamera == NULL) {
+		mCamera = new CameraSession(kCameraAddress);
+	}
+	return *mCamera;
 }
 
 
@@ -309,59 +531,119 @@ AxisCamera & TargetFinder::GetCamera()
 
 TargetSnapshotController::TargetSnapshotController(
 		RobotDrive *robotDrive,
-		TargetFinder *targetFinder, 
-		Joystick *joystick, 
-		Watchdog &watchdog,
+		MultithreadedTargetFinder *targetFinder, 
+		SnapshotJoystick *joystick, 
 		Gyro *gyro) :
-		BaseController(),
-		mWatchdog(watchdog)
+		BaseController()
 {
 	mRobotDrive = robotDrive;
 	mTargetFinder = targetFinder;
+	mTracker = new TargetTracker();
+	mGyroHistory = new GyroHistory(gyro);
+	mTurn = new HeadingTurn(robotDrive, gyro);
 	mJoystick = joystick;
-	mGyro = gyro;
+	mCaptureDelay = Parameters::GetInstance()->AddFloat("(CAMERA) Capture delay <<",
+			CameraSession::kDefaultCaptureDelay);
+	mIsAiming = false;
+	mAimedFrame = 0;
+}
+
+TargetSnapshotController::~TargetSnapshotController()
+{
+	delete mTurn;
+	delete mGyroHistory;
+	delete mTracker;
 }
 
 void TargetSnapshotController::Run()
 {
-	if (mJoystick->GetRawButton(2)) {
-		mWatchdog.SetEnabled(false);
-		vector<TargetUtils::Target> targets = mTargetFinder->GetTargets();
-		
-		SmartDashboard::GetInstance()->Log("Yes", "Snapshot");
-		
-		if (!targets.empty()) {
-			TargetUtils::Target t = FindHighestTarget(targets);
-			PrintDiagnostics(t);
-			
-			// When the robot turns clockwise, the gyro (which is upside-down on the robot, btw)
-			// decreases the angle it returns.
-			// The target returns a positive angle when the robot is pointing to the right of
-			// the target.
-			float start = -mGyro->GetAngle();
-			float finish = start + t.XAngleFromCamera;
-			float delta = finish - start;
-			float adjustment = kTurnPower;
-			if (delta < 0) {
-				adjustment = -adjustment;
-			}
-			float current = start;
-			
-			SmartDashboard *s = SmartDashboard::GetInstance();
-			s->Log(start, "c start");
-			s->Log(finish, "c finish");
-			s->Log(delta, "c delta");
-			s->Log(adjustment, "c adjustment");
-			while (!Compare(current, finish)) {
-				mRobotDrive->TankDrive(adjustment, -adjustment);
-				current = mGyro->GetAngle();
-				s->Log(current, "c current");
+	// Keep the tracks up to date even when not aiming.
+	TargetUtils::TargetSnapshot snapshot = mTargetFinder->ReturnTargetData();
+	mTracker->Update(snapshot);
+	
+	Telemetry *s = Telemetry::GetInstance();
+	if (!mJoystick->GetRawButton(2)) {
+		s->Log("No", "Snapshot");
+		mTurn->Cancel();
+		mIsAiming = false;
+		return;
+	}
+	s->Log("Yes", "Snapshot");
+	
+	bool isNewPicture = (snapshot.FrameNumber != mAimedFrame);
+	if (!mIsAiming or (mTurn->IsTurning() and isNewPicture)) {
+		float heading = 0;
+		if (FindHeading(snapshot, heading)) {
+			if (mIsAiming) {
+				mTurn->SetHeading(heading);
+			} else {
+				mTurn->Start(heading);
+				mIsAiming = true;
 			}
+			mAimedFrame = snapshot.FrameNumber;
 		}
-	} else {
-		SmartDashboard::GetInstance()->Log("No", "Snapshot");
 	}
-	mWatchdog.SetEnabled(true);
+	
+	HeadingTurn::State state = mTurn->Step();
+	s->Log((INT32) state, "c state");
+	s->Log(mTurn->GetHeading(), "c heading");
+	s->Log(mTurn->GetError(), "c error");
+}
+
+/**
+ * @brief Stops turning when switched away from.
+ */
+void TargetSnapshotController::Exit()
+{
+	mTurn->Cancel();
+	mIsAiming = false;
+}
+
+/**
+ * @brief Works out which way the robot should face to point at the
+ * highest target in a picture.
+ * 
+ * @param[in] snapshot The latest picture's targets.
+ * @param[out] heading The gyro angle to turn to, in degrees.
+ * 
+ * @returns False if there's no target to aim at, or the gyro's
+ * history doesn't go back as far as the picture.
+ */
+bool TargetSnapshotController::FindHeading(const TargetUtils::TargetSnapshot &snapshot, float &heading)
+{
+	// The targets as they were when the latest picture was taken,
+	// to go with the gyro's angle at that moment.
+	double pictureTime = snapshot.Timestamp - mCaptureDelay->Get();
+	TrackedTarget tracked[TargetTracker::kMaxTracks];
+	int count = mTracker->GetTargets(snapshot.Timestamp, tracked, TargetTracker::kMaxTracks);
+	
+	Telemetry::GetInstance()->Log(count, "Snapshot tracks");
+	Telemetry::GetInstance()->Log(Timer::GetFPGATimestamp() - pictureTime, "Snapshot latency");
+	
+	float pictureAngle = 0;
+	bool hasPictureAngle = mGyroHistory->GetAngleAt(pictureTime, pictureAngle);
+	Telemetry::GetInstance()->Log(hasPictureAngle, "Snapshot gyro history");
+	
+	if ((count == 0) or !hasPictureAngle) {
+		return false;
+	}
+	
+	vector<TargetUtils::Target> targets;
+	double age = tracked[0].Age;
+	for (int i=0; i<count; i++) {
+		targets.push_back(tracked[i].Estimate);
+		age = min(age, tracked[i].Age);
+	}
+	Telemetry::GetInstance()->Log(age, "Snapshot age");
+	TargetUtils::Target t = FindHighestTarget(targets);
+	PrintDiagnostics(t);
+	
+	// When the robot turns clockwise, the gyro (which is upside-down on the robot, btw)
+	// decreases the angle it returns.
+	// The target returns a positive angle when the robot is pointing to the right of
+	// the target -- to the right of where it pointed when the picture was taken, that is.
+	heading = pictureAngle - t.XAngleFromCamera;
+	return true;
 }
 
 TargetUtils::Target TargetSnapshotController::FindHighestTarget(std::vector<TargetUtils::Target> targetsList)
@@ -382,36 +664,28 @@ TargetUtils::Target TargetSnapshotController::FindHighestTarget(std::vector<Targ
 
 void TargetSnapshotController::PrintDiagnostics(TargetUtils::Target t) 
 {
-	SmartDashboard::GetInstance()->Log(t.Width, "t.Width");
-	SmartDashboard::GetInstance()->Log(t.Height, "t.Height");
-	SmartDashboard::GetInstance()->Log(t.Rotation, "t.Rotation");
-
-	SmartDashboard::GetInstance()->Log(t.Score, "t.Score");
-
-	SmartDashboard::GetInstance()->Log(t.TopLeft.X, "t.TopLeft.x");
-	SmartDashboard::GetInstance()->Log(t.TopLeft.Y, "t.TopLeft.y");
-	SmartDashboard::GetInstance()->Log(t.TopRight.X, "t.TopRight.x");
-	SmartDashboard::GetInstance()->Log(t.TopRight.Y, "t.TopRight.y");
-	SmartDashboard::GetInstance()->Log(t.BottomLeft.X, "t.BottomLeft.x");
-	SmartDashboard::GetInstance()->Log(t.BottomLeft.Y, "t.BottomLeft.y");
-	SmartDashboard::GetInstance()->Log(t.BottomRight.X, "t.BottomRight.x");
-	SmartDashboard::GetInstance()->Log(t.BottomRight.Y, "t.BottomRight.y");
-
-	SmartDashboard::GetInstance()->Log(t.Middle.X, "t.Middle.x");
-	SmartDashboard::GetInstance()->Log(t.Middle.Y, "t.Middle.y");
-	SmartDashboard::GetInstance()->Log(t.DistanceFromCamera, "t.DistanceFromCamera");
-	SmartDashboard::GetInstance()->Log(t.XAngleFromCamera, "t.XAngleFromCamera");
-	SmartDashboard::GetInstance()->Log(t.YAngleFromCamera, "t.YAngleFromCamera");
+	Telemetry::GetInstance()->Log(t.Width, "t.Width");
+	Telemetry::GetInstance()->Log(t.Height, "t.Height");
+	Telemetry::GetInstance()->Log(t.Rotation, "t.Rotation");
+
+	Telemetry::GetInstance()->Log(t.Score, "t.Score");
+
+	Telemetry::GetInstance()->Log(t.TopLeft.X, "t.TopLeft.x");
+	Telemetry::GetInstance()->Log(t.TopLeft.Y, "t.TopLeft.y");
+	Telemetry::GetInstance()->Log(t.TopRight.X, "t.TopRight.x");
+	Telemetry::GetInstance()->Log(t.TopRight.Y, "t.TopRight.y");
+	Telemetry::GetInstance()->Log(t.BottomLeft.X, "t.BottomLeft.x");
+	Telemetry::GetInstance()->Log(t.BottomLeft.Y, "t.BottomLeft.y");
+	Telemetry::GetInstance()->Log(t.BottomRight.X, "t.BottomRight.x");
+	Telemetry::GetInstance()->Log(t.BottomRight.Y, "t.BottomRight.y");
+
+	Telemetry::GetInstance()->Log(t.Middle.X, "t.Middle.x");
+	Telemetry::GetInstance()->Log(t.Middle.Y, "t.Middle.y");
+	Telemetry::GetInstance()->Log(t.DistanceFromCamera, "t.DistanceFromCamera");
+	Telemetry::GetInstance()->Log(t.XAngleFromCamera, "t.XAngleFromCamera");
+	Telemetry::GetInstance()->Log(t.YAngleFromCamera, "t.YAngleFromCamera");
+	Telemetry::GetInstance()->Log(t.Pose.IsValid, "t.Pose.IsValid");
+	Telemetry::GetInstance()->Log(t.Pose.Distance, "t.Pose.Distance");
+	Telemetry::GetInstance()->Log(t.Pose.Lateral, "t.Pose.Lateral");
+	Telemetry::GetInstance()->Log(t.Pose.FaceAngle, "t.Pose.FaceAngle");
 }
-
-bool TargetSnapshotController::Compare(float number, float target)
-{
-	float lowLimit = target - kTolerance;
-	float highLimit = target + kTolerance;
-	if (lowLimit <= number and number <= highLimit) {
-		return true;
-	} else {
-		return false;
-	}
-}
-
@@ -24,6 +24,11 @@
 
 // Program modules
 #include "../Definitions/components.h"
+#include "../Client/input.h"
+#include "../telemetry.h"
+#include "../parameters.h"
+#include "camera.h"
+#include "pipeline.h"
 
 
 /*
@@ -122,6 +127,32 @@ namespace TargetUtils {
 		double DistanceFromCamera;
 		double XAngleFromCamera;
 		double YAngleFromCamera;
+		TargetPose Pose;		// From the four corners
+	};
+	
+	
+	/**
+	 * @brief Every target found in one camera image, and when that
+	 * image was taken.
+	 * 
+	 * @details
+	 * A fixed-size array rather than a vector so that it can be
+	 * copied between tasks without allocating.
+	 */
+	struct TargetSnapshot
+	{
+	public:
+		static const int kMaxTargets = 8;
+		
+		TargetSnapshot();
+		
+		Target Targets[kMaxTargets];
+		int Count;
+		
+		double Timestamp;		// From Timer::GetFPGATimestamp, when the image arrived
+		UINT32 FrameNumber;		// Counts up from 1; 0 means nothing has been processed yet
+		int ImageWidth;			// In pixels; the targets' positions are in this picture
+		int ImageHeight;
 	};
 	
 	static Threshold threshold = Threshold(
@@ -154,6 +185,13 @@ namespace TargetUtils {
 	
 		vector<RectangleMatch> *DetectRectangles(
 				RectangleDescriptor *);
+		
+		void DetectRectangles(
+				RectangleDescriptor *,
+				CurveOptions *,
+				ShapeDetectionOptions *,
+				ROI *,
+				vector<RectangleMatch> &);
 	};
 
 } // End namespace.
@@ -163,6 +201,33 @@ namespace TargetUtils {
  * The TargetFinder class is responsible for interfacing with the
  * camera, and doing any image analysis code.
  * 
+ * GetTargets takes a picture and processes it on the spot, which
+ * takes about half a second.  To keep the control loop running,
+ * use a MultithreadedTargetFinder (in track_silver.h) instead.
+ * 
+ * The processing is an ImagePipeline (see pipeline.h) for each
+ * engine, made of stages that keep their own buffers, so every
+ * image it needs (the camera picture and each intermediate
+ * black-and-white image) is allocated once, at 640x480, and reused
+ * for every picture.  Because of that, only one task at a time may
+ * use a given TargetFinder.
+ * 
+ * Once targets have been found, the next picture is only searched
+ * for rectangles in a region around them (their bounding box,
+ * grown by kRegionMargin on every side), which is much quicker
+ * than searching the whole picture.  If fewer targets turn up there
+ * than last time, the whole picture is searched after all.
+ * 
+ * The rectangles can be found either by NI Vision or by the
+ * in-tree code in mask.h and blobs.h (see SetEngine):
+ *   - NI Vision: ThresholdStage, SizeFilterStage, ConvexHullStage
+ *     and RectangleStage
+ *   - in-tree: BlobSearchStage, which looks at a smaller picture
+ *     first (see SetPyramidStep)
+ * 
+ * Both then share a MeasureStage, which fills in the targets, and
+ * a ScoreStage, which puts the best first.
+ * 
  * Note: the image processing settings was actually tested and
  * debugged using the NI Vision Assistant tool, then ported
  * over to code.  See the 2010 and 2012 vision samples for 
@@ -173,50 +238,115 @@ namespace TargetUtils {
 class TargetFinder : public BaseComponent
 {
 public:
+	enum Engine
+	{
+		kNIVision,		// ThresholdRGB, RemoveSmallObjects, ConvexHull and imaqDetectRectangles
+		kInTree			// Masking::Threshold and BlobFinder
+	};
+	
 	TargetFinder();
+	virtual ~TargetFinder();
 	vector<TargetUtils::Target> GetTargets();
+	bool Capture();
+	void ProcessImage(vector<TargetUtils::Target> &);
+	void ProcessImage(ColorImage *, vector<TargetUtils::Target> &);
+	void ResetTracking();
+	bool IsTracking();
+	void SetEngine(Engine);
+	Engine GetEngine();
+	void SetPyramidStep(int);
+	int GetPyramidStep();
+	StageTimer &GetStageTimer();
+	int GetImageWidth();
+	int GetImageHeight();
+	CameraSession & GetCamera();
 protected:
-	AxisCamera & GetCamera();
-	double CalculateDistanceBasedOnWidth(double);
-	double FindXAngle(double);
-	double FindYAngle(double);
+	CameraSession *mCamera;		// Made the first time it's needed
+	Engine mEngine;
+	RGBImage *mCameraImage;		// Preallocated, reused for every picture
+	
+	// The stages, some shared by both engines' pipelines
+	ThresholdStage mThreshold;
+	SizeFilterStage mSizeFilter;
+	ConvexHullStage mHull;
+	RectangleStage mRectangles;
+	BlobSearchStage mBlobSearch;
+	MeasureStage mMeasure;
+	ScoreStage mScore;
+	ImagePipeline mNIPipeline;
+	ImagePipeline mInTreePipeline;
+	
+	// Where to look for rectangles next time
+	SearchRegion mRegion;
+	ContourID mRegionContour;
+	
+	ImagePipeline &GetPipeline(ColorImage *);
+	void UpdateRegion(const vector<TargetUtils::Target> &, int, int);
+	
 	static const double kTargetWidthInches = 24;
 	static const double kTargetHeightInches = 18;
-	static const double kMiddleXOfImage = 320.0;
-	static const double kMaxXAngleOfCamera = 30;	// In degrees
-	static const double kMiddleYOfImage = 240.0;
-	static const double kMaxYAngleOfCamera = 20;		// In degrees
+	static const int kImageWidth = 640;
+	static const int kImageHeight = 480;
+	static const char *kCameraAddress;
+	static const double kRegionMargin = 0.5;	// Fraction of the targets' size
+	static const int kMinRegionMargin = 16;		// In pixels
+	static const int kErosions = 1;			// For RemoveSmallObjects
 };
 
 
+class MultithreadedTargetFinder;
+class TargetTracker;
+class GyroHistory;
+class HeadingTurn;
+
 /**
- * @brief This class is responsible for taking a picture 
- * snapshot.  
+ * @brief Turns the robot towards the highest target the camera
+ * can see.
+ * 
+ * @details
+ * Uses the latest result from a MultithreadedTargetFinder, so
+ * looking for the target no longer stops the robot.  Every result
+ * goes through a TargetTracker, and targets not seen for
+ * TargetTracker::kMaxCoastTime are ignored.
  * 
- * @warning This will freeze the robot for half a second.
+ * The camera's angle to the target is only true for the way the
+ * robot faced when the picture was taken, which can be a few
+ * hundred milliseconds ago.  So the heading to turn to is the
+ * gyro's angle at that moment (from a GyroHistory) plus the
+ * camera's angle, and the robot can keep turning while the picture
+ * is processed.
+ * 
+ * The turn is a HeadingTurn, stepped once per Run, so aiming costs
+ * one tick rather than holding up every other controller.  Holding
+ * the button down aims at the target, and each newer picture moves
+ * the heading while the turn is going.  Letting go cancels the turn;
+ * once it finishes (or times out) the button has to be pressed
+ * again to aim again.
  */
 class TargetSnapshotController : public BaseController
 {
 protected:
 	RobotDrive *mRobotDrive;
-	TargetFinder *mTargetFinder;
-	Joystick *mJoystick;
-	Watchdog &mWatchdog;
-	Gyro *mGyro;
-	
-	static const float kTolerance = 0.5;
-	static const float kTurnPower = 0.4;
+	MultithreadedTargetFinder *mTargetFinder;
+	TargetTracker *mTracker;
+	GyroHistory *mGyroHistory;
+	HeadingTurn *mTurn;
+	SnapshotJoystick *mJoystick;
+	FloatParameter *mCaptureDelay;	// In seconds, from the picture being taken to it arriving
+	bool mIsAiming;			// The button is down and a turn has been started
+	UINT32 mAimedFrame;		// The picture the heading came from
 	
-	bool Compare(float, float);
+	bool FindHeading(const TargetUtils::TargetSnapshot &, float &);
 	
 public:
 	TargetSnapshotController(
 			RobotDrive *,
-			TargetFinder *, 
-			Joystick *, 
-			Watchdog &,
+			MultithreadedTargetFinder *, 
+			SnapshotJoystick *, 
 			Gyro *);
+	virtual ~TargetSnapshotController();
 	void Run();
+	void Exit();
 	TargetUtils::Target FindHighestTarget(vector<TargetUtils::Target>);
 	void PrintDiagnostics(TargetUtils::Target);
 };
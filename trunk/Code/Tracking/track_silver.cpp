@@ -1,4 +1,5 @@
 #include "track_silver.h"
+#include "governor.h"
 
 
 
@@ -8,37 +9,211 @@ ImageTarget::ImageTarget()
 	// Empty
 }
 
-Target ImageTarget::ProcessImage(HSLImage *image) {
-	Target t = Target();
-	return t;
+ImageTarget::~ImageTarget()
+{
+	// Empty
 }
 
-SilverImageTarget::SilverImageTarget() :
-	ImageTarget(),
-	colorThreshold(
+/**
+ * @brief Finds the targets in an image.
+ * 
+ * @param[in] image Left unchanged.
+ * @param[out] targets Emptied, then filled with what was found.
+ */
+void ImageTarget::ProcessImage(ColorImage *image, vector<TargetUtils::Target> &targets)
+{
+	mPipeline.Run(image, targets);
+}
+
+/**
+ * @brief How long each stage has taken, over every picture since
+ * the timer was last reset.
+ */
+StageTimer &ImageTarget::GetStageTimer()
+{
+	return mPipeline.GetStageTimer();
+}
+
+
+
+static Threshold silverThreshold = Threshold(
 		210,	// Red min
 		255,	// Red max
 		79,		// Green min
 		183,	// Green max
 		84,		// Blue min
 		160		// Blue max
-	)
+);
+
+SilverImageTarget::SilverImageTarget() :
+		ImageTarget(),
+		mThreshold(silverThreshold, IMAQ_RGB, kImageWidth, kImageHeight),
+		mHull(kImageWidth, kImageHeight),
+		mParticles(kMinArea, kImageWidth),
+		mMeasure(kImageWidth, kImageHeight),
+		mScore(0, 0)
+{
+	mPipeline.AddStage(&mThreshold);
+	mPipeline.AddStage(&mHull);
+	mPipeline.AddStage(&mParticles);
+	mPipeline.AddStage(&mMeasure);
+	mPipeline.AddStage(&mScore);
+}
+
+
+
+MultithreadedTargetFinder *MultithreadedTargetFinder::sFinders[kMaxFinders];
+int MultithreadedTargetFinder::sFinderCount = 0;
+
+/**
+ * @param[in] targetFinder Does the actual image processing.  Only
+ * the task uses it once the task has started.
+ */
+MultithreadedTargetFinder::MultithreadedTargetFinder(TargetFinder *targetFinder)
+{
+	mTargetFinder = targetFinder;
+	mGovernor = NULL;
+	mIsRunning = false;
+	mPublished = 0;
+	mFrameCount = 0;
+	mTargets.reserve(TargetUtils::TargetSnapshot::kMaxTargets);
+	for (int i=0; i<2; i++) {
+		mSlots[i].Sequence = 0;
+	}
+	
+	// Task arguments are plain integers, so the task is told which
+	// finder it belongs to by its index here.
+	mIndex = -1;
+	if (sFinderCount < kMaxFinders) {
+		mIndex = sFinderCount;
+		sFinders[mIndex] = this;
+		sFinderCount++;
+	} else {
+		printf("MultithreadedTargetFinder: too many finders, this one won't run\n");
+	}
+	mTask = new Task("TargetFinder", (FUNCPTR) MultithreadedTargetFinder::RunTask, kPriority);
+}
+
+/**
+ * @brief Lets a governor change the camera's settings to suit how
+ * long pictures take.  Call before StartTask.
+ */
+void MultithreadedTargetFinder::SetGovernor(CameraGovernor *governor)
+{
+	mGovernor = governor;
+}
+
+/**
+ * @brief Starts looking for targets in the background.
+ */
+void MultithreadedTargetFinder::StartTask()
+{
+	if (mIsRunning or (mIndex < 0)) {
+		return;
+	}
+	mIsRunning = true;
+	mTask->Start((UINT32) mIndex);
+}
+
+/**
+ * @brief Asks the task to stop.  It finishes the image it's working
+ * on first; the last result stays available.
+ */
+void MultithreadedTargetFinder::EndTask()
+{
+	mIsRunning = false;
+}
+
+bool MultithreadedTargetFinder::IsRunning()
 {
-	// Empty constructor
+	return mIsRunning;
 }
 
-Target SilverImageTarget::ProcessImage(HSLImage *image)
+/**
+ * @brief Gets the most recently found targets.  Never blocks.
+ * 
+ * @details
+ * Check TargetSnapshot::Timestamp to see how old the result is --
+ * if the camera is unplugged, the last result stays here forever.
+ */
+TargetUtils::TargetSnapshot MultithreadedTargetFinder::ReturnTargetData()
 {
-	BinaryImage *thresholdImage = image->ThresholdRGB(colorThreshold);
-	BinaryImage *convexImage = thresholdImage->ConvexHull(false);
-	convexImage->GetNumberParticles();
-	ParticleAnalysisReport particleReport = convexImage->GetParticleAnalysisReport(0);
-	Centroid centroid;
-	centroid.x = particleReport.center_mass_x;
-	centroid.y = particleReport.center_mass_y;
+	TargetUtils::TargetSnapshot snapshot;
+	while (true) {
+		const Slot &slot = mSlots[mPublished];
+		UINT32 before = slot.Sequence;
+		Tools::MemoryBarrier();
+		snapshot = slot.Snapshot;
+		Tools::MemoryBarrier();
+		if (((before & 1) == 0) and (slot.Sequence == before)) {
+			return snapshot;
+		}
+		// The task reused this slot while we were copying it; by now
+		// mPublished points at a newer one.
+	}
+}
+
+/**
+ * @brief The finder's task.  Runs until EndTask is called.
+ */
+int MultithreadedTargetFinder::RunTask(UINT32 index)
+{
+	MultithreadedTargetFinder *finder = sFinders[index];
+	CameraSession &camera = finder->mTargetFinder->GetCamera();
+	while (finder->mIsRunning) {
+		finder->ProcessFrame(camera);
+	}
+	return 0;
+}
+
+/**
+ * @brief Waits (for a little while) for a new image, and processes
+ * it if one came.
+ */
+void MultithreadedTargetFinder::ProcessFrame(CameraSession &camera)
+{
+	if (!camera.WaitForFrame(kFrameTimeout)) {
+		return;
+	}
+	double start = Timer::GetPPCTimestamp();
+	if (!mTargetFinder->Capture()) {
+		return;
+	}
+	mTargetFinder->ProcessImage(mTargets);
+	double seconds = Timer::GetPPCTimestamp() - start;
+	Publish(camera.GetFrameTimestamp());
+	if (mGovernor != NULL) {
+		mGovernor->AddFrame(seconds, mTargets, mTargetFinder->GetImageWidth());
+	}
+}
+
+/**
+ * @brief Fills in the unpublished slot, then publishes it.
+ */
+void MultithreadedTargetFinder::Publish(double timestamp)
+{
+	int next = 1 - mPublished;
+	Slot &slot = mSlots[next];
+	
+	slot.Sequence++;		// Odd: being written
+	Tools::MemoryBarrier();
 	
-	delete thresholdImage;
-	delete convexImage;
+	int count = (int) mTargets.size();
+	if (count > TargetUtils::TargetSnapshot::kMaxTargets) {
+		count = TargetUtils::TargetSnapshot::kMaxTargets;
+	}
+	for (int i=0; i<count; i++) {
+		slot.Snapshot.Targets[i] = mTargets[i];
+	}
+	slot.Snapshot.Count = count;
+	slot.Snapshot.Timestamp = timestamp;
+	slot.Snapshot.ImageWidth = mTargetFinder->GetImageWidth();
+	slot.Snapshot.ImageHeight = mTargetFinder->GetImageHeight();
+	mFrameCount++;
+	slot.Snapshot.FrameNumber = mFrameCount;
 	
-	return centroid;
+	Tools::MemoryBarrier();
+	slot.Sequence++;		// Even: done
+	Tools::MemoryBarrier();
+	mPublished = next;
 }
@@ -23,42 +23,126 @@
 
 // Program modules
 #include "../Definitions/components.h"
+#include "../tools.h"
 #include "target.h"
+#include "pipeline.h"
 
+class CameraGovernor;
 
-struct Target{
-	// Empty
-};
-
-
+/**
+ * @brief A kind of target, found by running its own list of stages
+ * (see pipeline.h) on each picture.
+ * 
+ * @details
+ * Subclasses add their stages to mPipeline in their constructors,
+ * and GetStageTimer shows where the time goes.
+ */
 class ImageTarget {
 public:
+	static const int kImageWidth = 640;		// What the stages' buffers are sized for at first
+	static const int kImageHeight = 480;
+	
 	ImageTarget();
-	virtual Target ProcessImage(HSLImage *image);
+	virtual ~ImageTarget();
+	virtual void ProcessImage(ColorImage *, vector<TargetUtils::Target> &);
+	StageTimer &GetStageTimer();
+	
+protected:
+	ImagePipeline mPipeline;
 };
 
-class SilverImageTarget : ImageTarget {
+/**
+ * @brief Anything silver: the pixels in its color range, filled
+ * out to their hulls, then each particle's bounding box.
+ * 
+ * @details
+ * The size of the thing isn't known, so the targets have angles
+ * but no distance.  They come best filled first.
+ */
+class SilverImageTarget : public ImageTarget {
 public:
+	static const double kMinArea = 20;		// In pixels, at kImageWidth
+	
 	SilverImageTarget();
-	Target ProcessImage(HSLImage *image);
-	struct Centroid : Target {
-		int x;
-		int y;
-	};
 	
 protected:
-	Threshold colorThreshold;
+	ThresholdStage mThreshold;
+	ConvexHullStage mHull;
+	ParticleStage mParticles;
+	MeasureStage mMeasure;
+	ScoreStage mScore;
 };
 
 
-class MultithreadedTargetFinder{
+/**
+ * @brief Runs a TargetFinder on its own task, so the control loop
+ * never waits for the camera.
+ * 
+ * @details
+ * The task waits for each new camera image, finds the targets in
+ * it and publishes them.  ReturnTargetData gives back whatever was
+ * published last, along with when its image arrived, and never
+ * blocks.
+ * 
+ * Results are passed through two slots: the task always fills in
+ * the one that isn't published, then flips mPublished.  Each slot
+ * has a sequence number that is odd while it is being written, so
+ * a reader that was unlucky enough to be copying a slot just as
+ * the task started reusing it can tell, and simply tries again.
+ * Neither side ever takes a lock.
+ * 
+ * The task times each picture, from copying it out of the camera to
+ * having its targets, and if it has a CameraGovernor, tells it, so
+ * the camera's resolution and frame rate follow what the robot can
+ * afford (see governor.h).
+ * 
+ * Usage:
+ * @code
+ * TargetFinder *targetFinder = new TargetFinder();
+ * MultithreadedTargetFinder *finder = new MultithreadedTargetFinder(targetFinder);
+ * finder->SetGovernor(new CameraGovernor(&targetFinder->GetCamera(), scheduler));
+ * finder->StartTask();
+ * ...
+ * TargetUtils::TargetSnapshot snapshot = finder->ReturnTargetData();
+ * @endcode
+ */
+class MultithreadedTargetFinder
+{
 public:
-	MultithreadedTargetFinder(ImageTarget);
+	static const INT32 kPriority = 130;		// Below the robot's main task (101)
+	static const int kMaxFinders = 4;
+	static const double kFrameTimeout = 0.1;	// In seconds; how often EndTask is noticed
+	
+	MultithreadedTargetFinder(TargetFinder *);
+	void SetGovernor(CameraGovernor *);
 	void StartTask();
 	void EndTask();
-	Target *ReturnTargetData();
-
+	bool IsRunning();
+	TargetUtils::TargetSnapshot ReturnTargetData();
+	
+protected:
+	struct Slot
+	{
+		volatile UINT32 Sequence;
+		TargetUtils::TargetSnapshot Snapshot;
+	};
+	
+	TargetFinder *mTargetFinder;
+	CameraGovernor *mGovernor;	// May be NULL; only the task uses it once started
+	Task *mTask;
+	int mIndex;
+	volatile bool mIsRunning;
+	Slot mSlots[2];
+	volatile int mPublished;
+	UINT32 mFrameCount;		// Only touched by the task
+	vector<TargetUtils::Target> mTargets;	// Likewise; reused every frame
+	
+	void ProcessFrame(CameraSession &);
+	void Publish(double);
 	
+	static MultithreadedTargetFinder *sFinders[kMaxFinders];
+	static int sFinderCount;
+	static int RunTask(UINT32);
 };
 
 #endif
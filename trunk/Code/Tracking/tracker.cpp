@@ -0,0 +1,338 @@
+#include "tracker.h"
+
+namespace
+{
+	/**
+	 * How noisy each quantity's measurements are, and how quickly
+	 * its rate of change can change, as standard deviations.
+	 */
+	struct Noise
+	{
+		double Measurement;
+		double Acceleration;
+	};
+	
+	const Noise kNoise[] = {
+		{2.0, 800},	// Middle x, in pixels; moves fast when the robot turns
+		{2.0, 500},	// Middle y, in pixels
+		{1.0, 100},	// Width, in pixels
+		{6.0, 300},	// Distance, in inches
+		{0.2, 80}	// X angle, in degrees; the same as middle x
+	};
+}
+
+ConstantVelocityFilter::ConstantVelocityFilter()
+{
+	mMeasurementVariance = 1;
+	mAccelerationVariance = 1;
+	Reset(0);
+}
+
+/**
+ * @param[in] measurement The standard deviation of a measurement.
+ * @param[in] acceleration The standard deviation of the
+ * acceleration, per second squared.
+ */
+void ConstantVelocityFilter::SetNoise(double measurement, double acceleration)
+{
+	mMeasurementVariance = measurement * measurement;
+	mAccelerationVariance = acceleration * acceleration;
+}
+
+/**
+ * @brief Starts again from one measurement, with no idea of the
+ * rate.
+ */
+void ConstantVelocityFilter::Reset(double value)
+{
+	mValue = value;
+	mRate = 0;
+	mCovariance[0][0] = mMeasurementVariance;
+	mCovariance[0][1] = 0;
+	mCovariance[1][0] = 0;
+	mCovariance[1][1] = kInitialRateVariance;
+}
+
+/**
+ * @brief Moves the estimate forward in time, growing its
+ * uncertainty.
+ * 
+ * @param[in] seconds How far.  Going backwards does nothing.
+ */
+void ConstantVelocityFilter::Predict(double seconds)
+{
+	if (seconds <= 0) {
+		return;
+	}
+	double t = seconds;
+	double (&p)[2][2] = mCovariance;
+	double q = mAccelerationVariance;
+	mValue += mRate * t;
+	double p00 = p[0][0] + t * (p[0][1] + p[1][0]) + t * t * p[1][1] + q * t * t * t * t / 4;
+	double p01 = p[0][1] + t * p[1][1] + q * t * t * t / 2;
+	double p11 = p[1][1] + q * t * t;
+	p[0][0] = p00;
+	p[0][1] = p01;
+	p[1][0] = p01;
+	p[1][1] = p11;
+}
+
+/**
+ * @brief Blends in a measurement taken at the current time.
+ */
+void ConstantVelocityFilter::Correct(double measurement)
+{
+	double (&p)[2][2] = mCovariance;
+	double innovation = measurement - mValue;
+	double s = p[0][0] + mMeasurementVariance;
+	double k0 = p[0][0] / s;
+	double k1 = p[1][0] / s;
+	mValue += k0 * innovation;
+	mRate += k1 * innovation;
+	double p00 = (1 - k0) * p[0][0];
+	double p01 = (1 - k0) * p[0][1];
+	double p11 = p[1][1] - k1 * p[0][1];
+	p[0][0] = p00;
+	p[0][1] = p01;
+	p[1][0] = p01;
+	p[1][1] = p11;
+}
+
+/**
+ * @brief The estimate some time after the last Predict or Correct,
+ * without changing anything.
+ */
+double ConstantVelocityFilter::GetValue(double seconds) const
+{
+	return mValue + mRate * seconds;
+}
+
+/**
+ * @brief The estimated rate of change, per second.
+ */
+double ConstantVelocityFilter::GetRate() const
+{
+	return mRate;
+}
+
+/**
+ * @brief How uncertain GetValue is, as a variance.
+ */
+double ConstantVelocityFilter::GetVariance(double seconds) const
+{
+	if (seconds <= 0) {
+		return mCovariance[0][0];
+	}
+	double t = seconds;
+	const double (&p)[2][2] = mCovariance;
+	return p[0][0] + t * (p[0][1] + p[1][0]) + t * t * p[1][1] + mAccelerationVariance * t * t * t * t / 4;
+}
+
+
+
+TargetTracker::TargetTracker()
+{
+	mNextId = 1;
+	Reset();
+}
+
+/**
+ * @brief Forgets every track.
+ */
+void TargetTracker::Reset()
+{
+	mTrackCount = 0;
+	mLastFrameNumber = 0;
+	mImageWidth = 0;
+}
+
+int TargetTracker::GetTrackCount()
+{
+	return mTrackCount;
+}
+
+/**
+ * @brief Takes in the targets from one picture.
+ * 
+ * @details
+ * Can be called every loop with the latest snapshot: a picture
+ * that has already been seen (by its FrameNumber) is ignored.
+ * 
+ * If the camera's resolution has changed, every track starts
+ * again, since their positions and speeds are in the old pixels.
+ */
+void TargetTracker::Update(const TargetUtils::TargetSnapshot &snapshot)
+{
+	if ((snapshot.FrameNumber == 0) or (snapshot.FrameNumber == mLastFrameNumber)) {
+		return;
+	}
+	mLastFrameNumber = snapshot.FrameNumber;
+	if (snapshot.ImageWidth != mImageWidth) {
+		mTrackCount = 0;
+		mImageWidth = snapshot.ImageWidth;
+	}
+	double time = snapshot.Timestamp;
+	
+	// Drop the tracks that haven't been seen for too long.
+	for (int i=mTrackCount-1; i>=0; i--) {
+		if (time - mTracks[i].Time > kMaxCoastTime) {
+			mTracks[i] = mTracks[mTrackCount - 1];
+			mTrackCount--;
+		}
+	}
+	
+	// Match the closest track and target, then the next closest, and
+	// so on.  There are only a handful of each.
+	bool isTrackMatched[kMaxTracks] = {false};
+	bool isTargetMatched[TargetUtils::TargetSnapshot::kMaxTargets] = {false};
+	while (true) {
+		int bestTrack = -1;
+		int bestTarget = -1;
+		double bestDistance = 0;
+		for (int i=0; i<mTrackCount; i++) {
+			for (int j=0; j<snapshot.Count; j++) {
+				if (isTrackMatched[i] or isTargetMatched[j]) {
+					continue;
+				}
+				double distance = MatchDistance(mTracks[i], snapshot.Targets[j], time);
+				if ((distance >= 0) and ((bestTrack < 0) or (distance < bestDistance))) {
+					bestTrack = i;
+					bestTarget = j;
+					bestDistance = distance;
+				}
+			}
+		}
+		if (bestTrack < 0) {
+			break;
+		}
+		isTrackMatched[bestTrack] = true;
+		isTargetMatched[bestTarget] = true;
+		Correct(mTracks[bestTrack], snapshot.Targets[bestTarget], time);
+	}
+	
+	for (int j=0; j<snapshot.Count; j++) {
+		if (!isTargetMatched[j]) {
+			StartTrack(snapshot.Targets[j], time);
+		}
+	}
+}
+
+/**
+ * @brief Predicts every track at a given time.
+ * 
+ * @param[in] time From Timer::GetFPGATimestamp, like the
+ * snapshots' timestamps.
+ * @param[out] targets Filled in, oldest track first.
+ * @param[in] maxCount How many targets there's room for.
+ * 
+ * @returns How many targets were filled in.  Tracks not seen for
+ * kMaxCoastTime are left out.
+ */
+int TargetTracker::GetTargets(double time, TrackedTarget *targets, int maxCount)
+{
+	int count = 0;
+	for (int i=0; (i < mTrackCount) and (count < maxCount); i++) {
+		Track &track = mTracks[i];
+		double age = time - track.Time;
+		if (age > kMaxCoastTime) {
+			continue;
+		}
+		TrackedTarget &out = targets[count];
+		out.Id = track.Id;
+		out.Hits = track.Hits;
+		out.Age = age;
+		
+		TargetUtils::Target &t = out.Estimate;
+		t = track.Last;
+		float middleX = (float) track.Filters[kMiddleX].GetValue(age);
+		float middleY = (float) track.Filters[kMiddleY].GetValue(age);
+		float dx = middleX - t.Middle.X;
+		float dy = middleY - t.Middle.Y;
+		TargetUtils::Coordinate *corners[4] = {&t.TopLeft, &t.TopRight, &t.BottomRight, &t.BottomLeft};
+		for (int c=0; c<4; c++) {
+			corners[c]->Set(corners[c]->X + dx, corners[c]->Y + dy);
+		}
+		t.Middle.Set(middleX, middleY);
+		t.Width = track.Filters[kWidth].GetValue(age);
+		t.DistanceFromCamera = track.Filters[kDistance].GetValue(age);
+		t.XAngleFromCamera = track.Filters[kXAngle].GetValue(age);
+		count++;
+	}
+	
+	// Oldest first (smallest Id), so the order doesn't shuffle as
+	// tracks come and go.
+	for (int i=1; i<count; i++) {
+		TrackedTarget moving = targets[i];
+		int j = i;
+		while ((j > 0) and (targets[j - 1].Id > moving.Id)) {
+			targets[j] = targets[j - 1];
+			j--;
+		}
+		targets[j] = moving;
+	}
+	return count;
+}
+
+void TargetTracker::StartTrack(const TargetUtils::Target &target, double time)
+{
+	if (mTrackCount >= kMaxTracks) {
+		return;
+	}
+	Track &track = mTracks[mTrackCount];
+	track.Id = mNextId++;
+	track.Hits = 1;
+	track.Time = time;
+	track.Last = target;
+	for (int q=0; q<kQuantityCount; q++) {
+		track.Filters[q].SetNoise(kNoise[q].Measurement, kNoise[q].Acceleration);
+		track.Filters[q].Reset(GetQuantity(target, q));
+	}
+	mTrackCount++;
+}
+
+void TargetTracker::Correct(Track &track, const TargetUtils::Target &target, double time)
+{
+	for (int q=0; q<kQuantityCount; q++) {
+		track.Filters[q].Predict(time - track.Time);
+		track.Filters[q].Correct(GetQuantity(target, q));
+	}
+	track.Time = time;
+	track.Last = target;
+	track.Hits++;
+}
+
+double TargetTracker::GetQuantity(const TargetUtils::Target &target, int quantity)
+{
+	switch (quantity) {
+	case kMiddleX:
+		return target.Middle.X;
+	case kMiddleY:
+		return target.Middle.Y;
+	case kWidth:
+		return target.Width;
+	case kDistance:
+		return target.DistanceFromCamera;
+	default:
+		return target.XAngleFromCamera;
+	}
+}
+
+/**
+ * @brief How far a target is from where a track expects it to be.
+ * 
+ * @returns The distance in pixels, or -1 if it's too far to match.
+ */
+double TargetTracker::MatchDistance(const Track &track, const TargetUtils::Target &target, double time)
+{
+	double age = time - track.Time;
+	double dx = track.Filters[kMiddleX].GetValue(age) - target.Middle.X;
+	double dy = track.Filters[kMiddleY].GetValue(age) - target.Middle.Y;
+	double distance = sqrt(dx * dx + dy * dy);
+	double limit = kMatchFraction * target.Width;
+	if (limit < kMinMatchDistance) {
+		limit = kMinMatchDistance;
+	}
+	double spread = 3 * sqrt(track.Filters[kMiddleX].GetVariance(age) + track.Filters[kMiddleY].GetVariance(age));
+	limit += (spread < target.Width) ? spread : target.Width;
+	return (distance <= limit) ? distance : -1;
+}
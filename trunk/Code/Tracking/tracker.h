@@ -0,0 +1,131 @@
+/**
+ * @file tracker.h
+ * 
+ * @brief Follows the targets from one camera picture to the next,
+ * smoothing them and filling in between pictures.
+ * 
+ * @details
+ * The camera only gives a new picture about 10 times a second, and
+ * each one is a little noisy, but the controllers want to know
+ * where the targets are 100 times a second.  TargetTracker keeps a
+ * track for each target (normally the four hoops), matching each
+ * new picture's targets to the tracks by where the tracks expect
+ * them to be.  Each track has a Kalman filter, assuming a constant
+ * rate of change, for the target's middle, width, distance and
+ * angle, and can say where the target should be at any moment,
+ * not just when a picture arrived.
+ * 
+ * Usage:
+ * @code
+ * // Every loop
+ * tracker.Update(finder->ReturnTargetData());
+ * TrackedTarget targets[TargetTracker::kMaxTracks];
+ * int count = tracker.GetTargets(Timer::GetFPGATimestamp(), targets, TargetTracker::kMaxTracks);
+ * @endcode
+ * 
+ * @warning Not thread-safe: update and query it from one task.
+ */
+
+#ifndef TRACKER_H_
+#define TRACKER_H_
+
+// Program modules
+#include "target.h"
+
+/**
+ * @brief A Kalman filter for one quantity that changes at a steady
+ * rate, give or take some random acceleration.
+ */
+class ConstantVelocityFilter
+{
+public:
+	ConstantVelocityFilter();
+	void SetNoise(double, double);
+	void Reset(double);
+	void Predict(double);
+	void Correct(double);
+	double GetValue(double) const;
+	double GetRate() const;
+	double GetVariance(double) const;
+	
+protected:
+	double mValue;
+	double mRate;
+	double mCovariance[2][2];	// Of the value and the rate
+	double mMeasurementVariance;
+	double mAccelerationVariance;
+	
+	static const double kInitialRateVariance = 1e6;		// Nothing is known about the rate at first
+};
+
+/**
+ * @brief The tracker's best guess at a target.
+ */
+struct TrackedTarget
+{
+	int Id;				// The same for as long as the target is followed
+	int Hits;			// How many pictures it has been seen in
+	double Age;			// Seconds since it was last seen
+	TargetUtils::Target Estimate;	// Middle, width, distance and X angle filtered; the rest as last seen
+};
+
+/**
+ * @brief Matches targets across pictures and predicts them between
+ * pictures.
+ * 
+ * @details
+ * Targets are matched greedily, nearest first, to the track whose
+ * predicted middle is closest, if it's within kMatchFraction of
+ * the target's width (but at least kMinMatchDistance), plus three
+ * times the prediction's standard deviation (but at most another
+ * width).  So a track that is turning hard or hasn't been seen for
+ * a while looks further afield.  A target with no track starts a
+ * new one, and a track not seen for kMaxCoastTime is dropped.
+ */
+class TargetTracker
+{
+public:
+	static const int kMaxTracks = TargetUtils::TargetSnapshot::kMaxTargets;
+	static const double kMaxCoastTime = 0.5;	// In seconds
+	static const double kMatchFraction = 0.5;	// Of the target's width
+	static const double kMinMatchDistance = 20;	// In pixels
+	
+	TargetTracker();
+	void Update(const TargetUtils::TargetSnapshot &);
+	int GetTargets(double, TrackedTarget *, int);
+	int GetTrackCount();
+	void Reset();
+	
+protected:
+	enum Quantity
+	{
+		kMiddleX,
+		kMiddleY,
+		kWidth,
+		kDistance,
+		kXAngle,
+		kQuantityCount
+	};
+	
+	struct Track
+	{
+		int Id;
+		int Hits;
+		double Time;			// Of the last picture it was seen in
+		TargetUtils::Target Last;	// As last seen
+		ConstantVelocityFilter Filters[kQuantityCount];
+	};
+	
+	Track mTracks[kMaxTracks];
+	int mTrackCount;
+	int mNextId;
+	UINT32 mLastFrameNumber;
+	int mImageWidth;		// Of the last picture; tracks in pixels don't carry over a change
+	
+	void StartTrack(const TargetUtils::Target &, double);
+	void Correct(Track &, const TargetUtils::Target &, double);
+	double GetQuantity(const TargetUtils::Target &, int);
+	double MatchDistance(const Track &, const TargetUtils::Target &, double);
+};
+
+#endif
@@ -13,7 +13,7 @@ void TableTest::Run()
 	std::string testString = mTable->GetString("testString");
 	mTable->EndTransaction();
 	
-	SmartDashboard *s = SmartDashboard::GetInstance();
+	Telemetry *s = Telemetry::GetInstance();
 	s->Log(testInt, "testInt");
 	s->Log(testString.c_str(), "testString");
 }
@@ -4,6 +4,7 @@
 #include <string>
 #include "WPILib.h"
 #include "Definitions/components.h"
+#include "telemetry.h"
 
 class TableTest : public BaseController
 {
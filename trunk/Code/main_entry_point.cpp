@@ -29,7 +29,9 @@
 
 //#define ROBOT MAINROBOT
 //#define ROBOT PROTOTYPE
+#ifndef ROBOT
 #define ROBOT SIDEWAYSROBOT
+#endif
 
 /// Do not modify below
 
@@ -0,0 +1,257 @@
+#include "parameters.h"
+
+namespace
+{
+	const char *kTableName = "SmartDashboard";
+}
+
+/**
+ * @param[in] key The SmartDashboard key.  Must outlive the
+ * parameter (a string literal is fine).
+ */
+Parameter::Parameter(const char *key)
+{
+	mKey = key;
+	mChangeCount = 0;
+}
+
+Parameter::~Parameter()
+{
+	NetworkTable::GetTable(kTableName)->RemoveChangeListener(mKey, this);
+}
+
+const char *Parameter::GetKey()
+{
+	return mKey;
+}
+
+/**
+ * @brief How many times the value has been changed, either from
+ * the dashboard or by Set.
+ */
+UINT32 Parameter::GetChangeCount()
+{
+	return mChangeCount;
+}
+
+/**
+ * @brief Puts the current value on the dashboard, and starts
+ * listening for edits if we weren't already.
+ */
+void Parameter::Publish()
+{
+	NetworkTable *table = NetworkTable::GetTable(kTableName);
+	table->RemoveChangeListener(mKey, this);
+	table->PutString(mKey, Format().c_str());
+	table->AddChangeListener(mKey, this);
+}
+
+/**
+ * @brief Called by the NetworkTable when the key is edited.
+ *
+ * @details
+ * Values that can't be parsed are ignored, so a half-typed
+ * number on the dashboard doesn't turn into garbage.
+ */
+void Parameter::ValueChanged(NetworkTable *table, const char *name, NetworkTables_Types type)
+{
+	if (Parse(table->GetString(name))) {
+		mChangeCount++;
+	}
+}
+
+void Parameter::ValueConfirmed(NetworkTable *table, const char *name, NetworkTables_Types type)
+{
+	// Empty
+}
+
+
+
+FloatParameter::FloatParameter(const char *key, float value) :
+		Parameter(key)
+{
+	mValue = value;
+	Publish();
+}
+
+float FloatParameter::Get()
+{
+	return mValue;
+}
+
+/**
+ * @brief Changes the value here and on the dashboard.
+ */
+void FloatParameter::Set(float value)
+{
+	mValue = value;
+	mChangeCount++;
+	Publish();
+}
+
+bool FloatParameter::Parse(const std::string &text)
+{
+	float value;
+	if (sscanf(text.c_str(), "%20f", &value) != 1) {
+		return false;
+	}
+	mValue = value;
+	return true;
+}
+
+std::string FloatParameter::Format()
+{
+	return Tools::FloatToString(mValue);
+}
+
+
+
+IntParameter::IntParameter(const char *key, int value) :
+		Parameter(key)
+{
+	mValue = value;
+	Publish();
+}
+
+int IntParameter::Get()
+{
+	return mValue;
+}
+
+/**
+ * @brief Changes the value here and on the dashboard.
+ */
+void IntParameter::Set(int value)
+{
+	mValue = value;
+	mChangeCount++;
+	Publish();
+}
+
+bool IntParameter::Parse(const std::string &text)
+{
+	int value;
+	if (sscanf(text.c_str(), "%d", &value) != 1) {
+		return false;
+	}
+	mValue = value;
+	return true;
+}
+
+std::string IntParameter::Format()
+{
+	char buffer[16];
+	sprintf(buffer, "%d", (int) mValue);
+	return buffer;
+}
+
+
+
+BoolParameter::BoolParameter(const char *key, bool value) :
+		Parameter(key)
+{
+	mValue = value;
+	Publish();
+}
+
+bool BoolParameter::Get()
+{
+	return mValue;
+}
+
+/**
+ * @brief Changes the value here and on the dashboard.
+ */
+void BoolParameter::Set(bool value)
+{
+	mValue = value;
+	mChangeCount++;
+	Publish();
+}
+
+bool BoolParameter::Parse(const std::string &text)
+{
+	if ((text == "1") or (text == "true")) {
+		mValue = true;
+	} else if ((text == "0") or (text == "false")) {
+		mValue = false;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+std::string BoolParameter::Format()
+{
+	return mValue ? "1" : "0";
+}
+
+
+
+Parameters::Parameters()
+{
+	mLock = semMCreate(SEM_Q_PRIORITY | SEM_DELETE_SAFE | SEM_INVERSION_SAFE);
+}
+
+Parameters *Parameters::GetInstance()
+{
+	static Parameters *instance = new Parameters();
+	return instance;
+}
+
+template <class T>
+T *Parameters::Find(std::vector<T *> &parameters, const char *key)
+{
+	int size = (int) parameters.size();
+	for (int i=0; i<size; i++) {
+		if (strcmp(parameters[i]->GetKey(), key) == 0) {
+			return parameters[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Declares a float parameter (or finds the existing one).
+ *
+ * @param[in] key The SmartDashboard key.
+ * @param[in] value The starting value, also put on the dashboard.
+ */
+FloatParameter *Parameters::AddFloat(const char *key, float value)
+{
+	Synchronized sync(mLock);
+	FloatParameter *parameter = Find(mFloats, key);
+	if (parameter == NULL) {
+		parameter = new FloatParameter(key, value);
+		mFloats.push_back(parameter);
+	}
+	return parameter;
+}
+
+/**
+ * @brief Declares an int parameter (or finds the existing one).
+ */
+IntParameter *Parameters::AddInt(const char *key, int value)
+{
+	Synchronized sync(mLock);
+	IntParameter *parameter = Find(mInts, key);
+	if (parameter == NULL) {
+		parameter = new IntParameter(key, value);
+		mInts.push_back(parameter);
+	}
+	return parameter;
+}
+
+/**
+ * @brief Declares a bool parameter (or finds the existing one).
+ */
+BoolParameter *Parameters::AddBool(const char *key, bool value)
+{
+	Synchronized sync(mLock);
+	BoolParameter *parameter = Find(mBools, key);
+	if (parameter == NULL) {
+		parameter = new BoolParameter(key, value);
+		mBools.push_back(parameter);
+	}
+	return parameter;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file parameters.h
+ *
+ * @brief Numbers we tune from the SmartDashboard while the
+ * robot is running (shooter presets, speed limits, etc).
+ *
+ * @details
+ * Controllers used to fetch these from the SmartDashboard as
+ * strings and parse them with Tools::StringToFloat on every
+ * single loop, even though they hardly ever change.  Instead,
+ * each one is now declared once as a Parameter, which keeps
+ * the current value in a plain variable and listens to the
+ * dashboard table for changes.  The string is only parsed
+ * when someone actually edits it.
+ *
+ * Usage:
+ * @code
+ * // In the constructor
+ * mPreset = Parameters::GetInstance()->AddFloat("(SHOOTER) Preset 1 <<", 0.24);
+ *
+ * // In Run
+ * mShooter->SetSpeed(mPreset->Get());
+ * @endcode
+ *
+ * The values are still shown on the dashboard as strings, so
+ * existing dashboard layouts keep working.
+ */
+
+#ifndef PARAMETERS_H_
+#define PARAMETERS_H_
+
+// System libraries
+#include <string>
+#include <vector>
+
+// 3rd party libraries
+#include "WPILib.h"
+#include "NetworkTables/NetworkTable.h"
+
+// Program modules
+#include "tools.h"
+
+/**
+ * @brief One value backed by a SmartDashboard key.
+ *
+ * @details
+ * ValueChanged is called by the NetworkTable (on its own
+ * thread) whenever the key is edited.  Subclasses parse the
+ * string there and store the result; the getters are a single
+ * read of a 32-bit value, which is atomic on the cRIO.
+ *
+ * Anything that needs to react to an edit (rather than just
+ * read the latest value) can compare GetChangeCount against
+ * the count it saw last time.
+ */
+class Parameter : public NetworkTableChangeListener
+{
+protected:
+	const char *mKey;
+	volatile UINT32 mChangeCount;
+
+	virtual bool Parse(const std::string &) = 0;
+	virtual std::string Format() = 0;
+	void Publish();
+
+public:
+	Parameter(const char *);
+	virtual ~Parameter();
+	const char *GetKey();
+	UINT32 GetChangeCount();
+	void ValueChanged(NetworkTable *, const char *, NetworkTables_Types);
+	void ValueConfirmed(NetworkTable *, const char *, NetworkTables_Types);
+};
+
+/**
+ * @brief A tunable float.
+ */
+class FloatParameter : public Parameter
+{
+protected:
+	volatile float mValue;
+
+	bool Parse(const std::string &);
+	std::string Format();
+
+public:
+	FloatParameter(const char *, float);
+	float Get();
+	void Set(float);
+};
+
+/**
+ * @brief A tunable int.
+ */
+class IntParameter : public Parameter
+{
+protected:
+	volatile int mValue;
+
+	bool Parse(const std::string &);
+	std::string Format();
+
+public:
+	IntParameter(const char *, int);
+	int Get();
+	void Set(int);
+};
+
+/**
+ * @brief A tunable on/off switch.  Accepts "1", "0", "true"
+ * and "false" from the dashboard.
+ */
+class BoolParameter : public Parameter
+{
+protected:
+	volatile bool mValue;
+
+	bool Parse(const std::string &);
+	std::string Format();
+
+public:
+	BoolParameter(const char *, bool);
+	bool Get();
+	void Set(bool);
+};
+
+/**
+ * @brief Owns every Parameter, so that each dashboard key is
+ * declared (and listened to) only once.
+ *
+ * @details
+ * Asking for a key that already exists returns the existing
+ * parameter and ignores the new default, so two controllers
+ * can safely share a key.  Parameters live for the rest of
+ * the program.
+ */
+class Parameters
+{
+protected:
+	std::vector<FloatParameter *> mFloats;
+	std::vector<IntParameter *> mInts;
+	std::vector<BoolParameter *> mBools;
+	SEM_ID mLock;
+
+	Parameters();
+
+	template <class T>
+	static T *Find(std::vector<T *> &, const char *);
+
+public:
+	static Parameters *GetInstance();
+
+	FloatParameter *AddFloat(const char *, float);
+	IntParameter *AddInt(const char *, int);
+	BoolParameter *AddBool(const char *, bool);
+};
+
+#endif
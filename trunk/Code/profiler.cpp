@@ -0,0 +1,204 @@
+#include "profiler.h"
+
+ExecutionHistogram::ExecutionHistogram()
+{
+	Reset();
+}
+
+void ExecutionHistogram::Reset()
+{
+	for (int i=0; i<kBucketCount; i++) {
+		mBuckets[i] = 0;
+	}
+	mCount = 0;
+	mTotal = 0;
+	mMin = 0xFFFFFFFF;
+	mMax = 0;
+}
+
+int ExecutionHistogram::BucketFor(UINT32 microseconds)
+{
+	if (microseconds < 1000) {
+		return microseconds / 10;
+	}
+	if (microseconds < 10000) {
+		return kFineBuckets + (microseconds - 1000) / 100;
+	}
+	if (microseconds < 100000) {
+		return kFineBuckets + kMediumBuckets + (microseconds - 10000) / 1000;
+	}
+	return kBucketCount - 1;
+}
+
+/**
+ * @brief The largest duration (in microseconds) that still falls
+ * in the given bucket.  Percentiles are rounded up to this.
+ */
+UINT32 ExecutionHistogram::BucketUpperBound(int bucket)
+{
+	if (bucket < kFineBuckets) {
+		return (bucket + 1) * 10;
+	}
+	bucket -= kFineBuckets;
+	if (bucket < kMediumBuckets) {
+		return 1000 + (bucket + 1) * 100;
+	}
+	bucket -= kMediumBuckets;
+	if (bucket < kCoarseBuckets) {
+		return 10000 + (bucket + 1) * 1000;
+	}
+	return 0xFFFFFFFF;
+}
+
+/**
+ * @brief Adds one sample.
+ * 
+ * @param[in] seconds The duration to record.  Negative values
+ * are recorded as zero.
+ */
+void ExecutionHistogram::Record(double seconds)
+{
+	UINT32 microseconds = (seconds <= 0) ? 0 : (UINT32) (seconds * 1e6);
+	mBuckets[BucketFor(microseconds)]++;
+	mTotal += microseconds;
+	if (microseconds < mMin) {
+		mMin = microseconds;
+	}
+	if (microseconds > mMax) {
+		mMax = microseconds;
+	}
+	// Written last, so a reader never sees more samples counted
+	// than have made it into the buckets.
+	mCount++;
+}
+
+ExecutionHistogram::Summary ExecutionHistogram::Summarize()
+{
+	Summary summary;
+	summary.Count = mCount;
+	if (summary.Count == 0) {
+		summary.Min = summary.Mean = summary.P99 = summary.Max = 0;
+		return summary;
+	}
+	summary.Min = mMin;
+	summary.Max = mMax;
+	summary.Mean = mTotal / summary.Count;
+	
+	UINT32 target = summary.Count - summary.Count / 100;
+	UINT32 seen = 0;
+	summary.P99 = summary.Max;
+	for (int i=0; i<kBucketCount; i++) {
+		seen += mBuckets[i];
+		if (seen >= target) {
+			summary.P99 = BucketUpperBound(i);
+			break;
+		}
+	}
+	if (summary.P99 > summary.Max) {
+		summary.P99 = summary.Max;
+	}
+	return summary;
+}
+
+
+
+
+ExecutionProfiler::ExecutionProfiler()
+{
+	mEntryCount = 0;
+	mPublisher = new Notifier(ExecutionProfiler::Publish, this);
+}
+
+ExecutionProfiler::~ExecutionProfiler()
+{
+	delete mPublisher;
+}
+
+/**
+ * @brief Adds a controller to profile.
+ * 
+ * @returns An id to pass to RecordExecution, or -1 if there's no
+ * room left (in which case recording is silently skipped).
+ */
+int ExecutionProfiler::Add(const char *name)
+{
+	if (mEntryCount >= kMaxEntries) {
+		return -1;
+	}
+	Entry &entry = mEntries[mEntryCount];
+	entry.Name = name;
+	snprintf(entry.Key, sizeof(entry.Key), "Profile::%s", name);
+	return mEntryCount++;
+}
+
+/**
+ * @brief Clears every histogram and starts publishing.
+ */
+void ExecutionProfiler::Start()
+{
+	for (int i=0; i<mEntryCount; i++) {
+		mEntries[i].Histogram.Reset();
+	}
+	mJitter.Reset();
+	mPublisher->StartPeriodic(kPublishPeriod);
+}
+
+void ExecutionProfiler::Stop()
+{
+	mPublisher->Stop();
+}
+
+void ExecutionProfiler::RecordExecution(int id, double seconds)
+{
+	if ((id < 0) or (id >= mEntryCount)) {
+		return;
+	}
+	mEntries[id].Histogram.Record(seconds);
+}
+
+/**
+ * @param[in] seconds How far the last loop period was from the
+ * nominal period (either direction).
+ */
+void ExecutionProfiler::RecordJitter(double seconds)
+{
+	mJitter.Record((seconds < 0) ? -seconds : seconds);
+}
+
+ExecutionHistogram::Summary ExecutionProfiler::GetExecutionSummary(int id)
+{
+	if ((id < 0) or (id >= mEntryCount)) {
+		return ExecutionHistogram().Summarize();
+	}
+	return mEntries[id].Histogram.Summarize();
+}
+
+ExecutionHistogram::Summary ExecutionProfiler::GetJitterSummary()
+{
+	return mJitter.Summarize();
+}
+
+void ExecutionProfiler::Publish(void *profiler)
+{
+	((ExecutionProfiler *) profiler)->Publish();
+}
+
+void ExecutionProfiler::Publish()
+{
+	for (int i=0; i<mEntryCount; i++) {
+		PublishHistogram(mEntries[i].Histogram, mEntries[i].Key);
+	}
+	PublishHistogram(mJitter, "Profile::Jitter");
+}
+
+void ExecutionProfiler::PublishHistogram(ExecutionHistogram &histogram, const char *key)
+{
+	ExecutionHistogram::Summary s = histogram.Summarize();
+	char text[64];
+	snprintf(text, sizeof(text), "%u/%u/%u/%u", 
+			(unsigned int) s.Min, 
+			(unsigned int) s.Mean, 
+			(unsigned int) s.P99, 
+			(unsigned int) s.Max);
+	Telemetry::GetInstance()->Log(text, key);
+}
@@ -0,0 +1,116 @@
+/**
+ * @file profiler.h
+ * 
+ * @brief Measures how long each controller takes to run and how
+ * steady the control loop is.
+ * 
+ * @details
+ * The control loop only ever writes to the histograms in here,
+ * and a low-rate Notifier only ever reads them, so nothing is
+ * locked.  Every field is a single 32-bit word, which the 
+ * PowerPC reads and writes in one go -- the worst the publisher
+ * can see is a histogram that is one sample out of date.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+// System libraries
+#include <vector>
+
+// 3rd party libraries
+#include "WPILib.h"
+
+// Program modules
+#include "telemetry.h"
+
+/**
+ * @brief A fixed-size histogram of durations.
+ * 
+ * @details
+ * Buckets are 10 us wide up to 1 ms, 100 us wide up to 10 ms,
+ * and 1 ms wide up to 100 ms; anything longer lands in the 
+ * last bucket.  That's fine-grained enough to see a controller
+ * that takes 40 us while still catching one that takes 40 ms.
+ * 
+ * Only one thread may call Record().
+ */
+class ExecutionHistogram
+{
+public:
+	struct Summary
+	{
+		UINT32 Count;
+		UINT32 Min;		// In microseconds
+		UINT32 Mean;	// In microseconds
+		UINT32 P99;		// In microseconds
+		UINT32 Max;		// In microseconds
+	};
+	
+protected:
+	static const int kFineBuckets = 100;	// 10 us each, to 1 ms
+	static const int kMediumBuckets = 90;	// 100 us each, to 10 ms
+	static const int kCoarseBuckets = 90;	// 1 ms each, to 100 ms
+	static const int kBucketCount = kFineBuckets + kMediumBuckets + kCoarseBuckets + 1;
+	
+	volatile UINT32 mBuckets[kBucketCount];
+	volatile UINT32 mCount;
+	volatile UINT32 mTotal;		// In microseconds
+	volatile UINT32 mMin;		// In microseconds
+	volatile UINT32 mMax;		// In microseconds
+	
+	static int BucketFor(UINT32);
+	static UINT32 BucketUpperBound(int);
+	
+public:
+	ExecutionHistogram();
+	void Reset();
+	void Record(double);
+	Summary Summarize();
+};
+
+/**
+ * @brief Keeps an ExecutionHistogram for each controller, plus 
+ * one for the loop's period jitter, and publishes them to the
+ * SmartDashboard.
+ * 
+ * @details
+ * Each controller shows up as "Profile::<name>" with the text
+ * "min/mean/p99/max" (in microseconds).  "Profile::Jitter" is 
+ * how far each loop period was from the nominal period.
+ */
+class ExecutionProfiler
+{
+protected:
+	static const double kPublishPeriod = 1.0;	// In seconds
+	static const int kMaxEntries = 32;
+	
+	struct Entry
+	{
+		const char *Name;
+		char Key[64];
+		ExecutionHistogram Histogram;
+	};
+	
+	Entry mEntries[kMaxEntries];
+	int mEntryCount;
+	ExecutionHistogram mJitter;
+	Notifier *mPublisher;
+	
+	static void Publish(void *);
+	void Publish();
+	void PublishHistogram(ExecutionHistogram &, const char *);
+	
+public:
+	ExecutionProfiler();
+	~ExecutionProfiler();
+	int Add(const char *);
+	void Start();
+	void Stop();
+	void RecordExecution(int, double);
+	void RecordJitter(double);
+	ExecutionHistogram::Summary GetExecutionSummary(int);
+	ExecutionHistogram::Summary GetJitterSummary();
+};
+
+#endif
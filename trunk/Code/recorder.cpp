@@ -0,0 +1,224 @@
+#include "recorder.h"
+
+FlightRecorder::FlightRecorder()
+{
+	mHead = 0;
+	mTail = 0;
+	mIsRecording = false;
+	mDroppedCount = 0;
+	mWrittenDroppedCount = 0;
+	mChannelCount = 0;
+	mStartTime = 0;
+	mFile = NULL;
+	mFileName[0] = '\0';
+	mTask = new Task("FlightRecorder", (FUNCPTR) FlightRecorder::RunTask, kPriority);
+
+	AddChannel("Recorder", "dropped", "");
+}
+
+FlightRecorder *FlightRecorder::GetInstance()
+{
+	static FlightRecorder *instance = NULL;
+	if (instance == NULL) {
+		instance = new FlightRecorder();
+	}
+	return instance;
+}
+
+/**
+ * @brief Declares a channel.  Must be called before Start.
+ *
+ * @param[in] name What is being recorded.
+ * @param[in] fieldA The name of the first value.
+ * @param[in] fieldB The name of the second value, or "" if unused.
+ *
+ * @returns The channel number to pass to Record, or -1 if the
+ * recorder has already started or has no room left.  Recording
+ * to channel -1 does nothing, so callers don't need to check.
+ */
+int FlightRecorder::AddChannel(const char *name, const char *fieldA, const char *fieldB)
+{
+	if (mIsRecording or (mChannelCount >= kMaxChannels)) {
+		return -1;
+	}
+	FlightChannelInfo &info = mChannels[mChannelCount];
+	memset(&info, 0, sizeof(info));
+	strncpy(info.Name, name, sizeof(info.Name) - 1);
+	strncpy(info.FieldA, fieldA, sizeof(info.FieldA) - 1);
+	strncpy(info.FieldB, fieldB, sizeof(info.FieldB) - 1);
+	return mChannelCount++;
+}
+
+/**
+ * @brief Opens a new file and starts recording.
+ *
+ * @returns False if no file could be opened, in which case nothing
+ * is recorded (and the robot carries on as normal).
+ */
+bool FlightRecorder::Start()
+{
+	if (mIsRecording) {
+		return true;
+	}
+	if (!OpenFile()) {
+		printf("FlightRecorder: could not open a file, not recording\n");
+		return false;
+	}
+	mStartTime = Timer::GetFPGATimestamp();
+	mIsRecording = true;
+	mTask->Start();
+	return true;
+}
+
+/**
+ * @brief Picks the first unused flightNNN.rec and writes the
+ * header and channel names to it.
+ */
+bool FlightRecorder::OpenFile()
+{
+	for (int i=0; i<kMaxFiles; i++) {
+		sprintf(mFileName, "flight%03d.rec", i);
+		FILE *existing = fopen(mFileName, "rb");
+		if (existing != NULL) {
+			fclose(existing);
+			continue;
+		}
+		mFile = fopen(mFileName, "wb");
+		break;
+	}
+	if (mFile == NULL) {
+		mFileName[0] = '\0';
+		return false;
+	}
+
+	FlightFileHeader header;
+	memcpy(header.Magic, "FREC", 4);
+	header.ByteOrder = 0x01020304;
+	header.Version = kVersion;
+	header.ChannelCount = mChannelCount;
+	fwrite(&header, sizeof(header), 1, mFile);
+	fwrite(mChannels, sizeof(FlightChannelInfo), mChannelCount, mFile);
+	fflush(mFile);
+	return true;
+}
+
+/**
+ * @brief Adds a sample to the ring.  Never blocks.
+ *
+ * @param[in] channel From AddChannel.
+ * @param[in] a The first value.
+ * @param[in] b The second value, if the channel has one.
+ */
+void FlightRecorder::Record(int channel, float a, float b)
+{
+	if (!mIsRecording or (channel < 0)) {
+		return;
+	}
+	UINT32 head = mHead;
+	if (head - mTail >= kCapacity) {
+		mDroppedCount++;
+		return;
+	}
+	FlightSample &sample = mRing[head & (kCapacity - 1)];
+	sample.Time = (UINT32) ((Timer::GetFPGATimestamp() - mStartTime) * 1e6);
+	sample.Channel = (UINT16) channel;
+	sample.Reserved = 0;
+	sample.A = a;
+	sample.B = b;
+	Tools::MemoryBarrier();
+	mHead = head + 1;
+}
+
+/**
+ * @brief The draining task.  Never returns.
+ */
+int FlightRecorder::RunTask()
+{
+	FlightRecorder *recorder = GetInstance();
+	while (true) {
+		recorder->Drain();
+		Wait(kDrainPeriod);
+	}
+	return 0;
+}
+
+/**
+ * @brief Writes everything in the ring to the file.
+ */
+void FlightRecorder::Drain()
+{
+	UINT32 head = mHead;
+	Tools::MemoryBarrier();
+	UINT32 tail = mTail;
+	while (tail != head) {
+		UINT32 start = tail & (kCapacity - 1);
+		UINT32 count = head - tail;
+		if (start + count > kCapacity) {
+			count = kCapacity - start;		// Up to the end of the ring; the rest next time around
+		}
+		fwrite(&mRing[start], sizeof(FlightSample), count, mFile);
+		tail += count;
+	}
+	Tools::MemoryBarrier();
+	mTail = tail;
+
+	if (mDroppedCount != mWrittenDroppedCount) {
+		WriteDroppedCount();
+	}
+	fflush(mFile);
+}
+
+/**
+ * @brief Writes the dropped-sample count straight to the file,
+ * since only the main task may use the ring.
+ */
+void FlightRecorder::WriteDroppedCount()
+{
+	mWrittenDroppedCount = mDroppedCount;
+	FlightSample sample;
+	sample.Time = (UINT32) ((Timer::GetFPGATimestamp() - mStartTime) * 1e6);
+	sample.Channel = 0;
+	sample.Reserved = 0;
+	sample.A = (float) mWrittenDroppedCount;
+	sample.B = 0;
+	fwrite(&sample, sizeof(sample), 1, mFile);
+}
+
+bool FlightRecorder::IsRecording()
+{
+	return mIsRecording;
+}
+
+UINT32 FlightRecorder::GetDroppedCount()
+{
+	return mDroppedCount;
+}
+
+/**
+ * @brief The file being written, or "" if not recording.
+ */
+const char *FlightRecorder::GetFileName()
+{
+	return mFileName;
+}
+
+
+
+RecordingRobotDrive::RecordingRobotDrive(
+		SpeedController *frontLeftMotor,
+		SpeedController *rearLeftMotor,
+		SpeedController *frontRightMotor,
+		SpeedController *rearRightMotor) :
+		RobotDrive(frontLeftMotor, rearLeftMotor, frontRightMotor, rearRightMotor)
+{
+	mChannel = FlightRecorder::GetInstance()->AddChannel("Drive", "left", "right");
+}
+
+/**
+ * @brief Records the outputs, then sets the motors as usual.
+ */
+void RecordingRobotDrive::SetLeftRightMotorOutputs(float leftOutput, float rightOutput)
+{
+	FlightRecorder::GetInstance()->Record(mChannel, leftOutput, rightOutput);
+	RobotDrive::SetLeftRightMotorOutputs(leftOutput, rightOutput);
+}
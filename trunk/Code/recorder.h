@@ -0,0 +1,157 @@
+/**
+ * @file recorder.h
+ *
+ * @brief A flight-data recorder: logs motor commands and sensor
+ * readings to a file on the cRIO during a match.
+ *
+ * @details
+ * Samples are small fixed-size structs (a timestamp, a channel
+ * number and two floats).  The control loop puts them in a ring
+ * buffer, which costs a copy and no locking; a low-priority task
+ * empties the ring into a file a few times a second.
+ *
+ * Each boot writes a new file, flight000.rec, flight001.rec and so
+ * on, in the current directory (the root of the cRIO's drive).
+ * Fetch them over FTP and convert them with the flight2csv tool
+ * in /Simulation.
+ *
+ * File layout (all in the cRIO's byte order -- see
+ * FlightFileHeader::ByteOrder):
+ *   - a FlightFileHeader
+ *   - FlightFileHeader::ChannelCount FlightChannelInfo structs
+ *   - FlightSample structs until the end of the file
+ *
+ * Usage:
+ * @code
+ * // Once, while setting up
+ * FlightRecorder *r = FlightRecorder::GetInstance();
+ * mChannel = r->AddChannel("Shooter", "top", "bottom");
+ * ...
+ * r->Start();
+ *
+ * // Whenever
+ * r->Record(mChannel, topSpeed, bottomSpeed);
+ * @endcode
+ *
+ * @warning The ring has a single producer: only the robot's main
+ * task (the one running the controllers) may call Record.
+ */
+
+#ifndef RECORDER_H_
+#define RECORDER_H_
+
+// System libraries
+#include <stdio.h>
+
+// 3rd party libraries
+#include "WPILib.h"
+
+// Program modules
+#include "tools.h"
+
+/**
+ * @brief The start of every recording.
+ */
+struct FlightFileHeader
+{
+	char Magic[4];			// "FREC"
+	UINT32 ByteOrder;		// 0x01020304, as written by the cRIO
+	UINT32 Version;
+	UINT32 ChannelCount;
+};
+
+/**
+ * @brief The names of one channel and its two values.  Unused
+ * value names are empty.
+ */
+struct FlightChannelInfo
+{
+	char Name[24];
+	char FieldA[20];
+	char FieldB[20];
+};
+
+/**
+ * @brief One recorded sample.
+ */
+struct FlightSample
+{
+	UINT32 Time;		// In microseconds since the recorder started; wraps after about 71.6 minutes
+	UINT16 Channel;
+	UINT16 Reserved;
+	float A;
+	float B;
+};
+
+/**
+ * @brief Owns the ring buffer, the file and the task that writes
+ * one to the other.
+ *
+ * @details
+ * If the ring fills up (for example, because the drive is slow)
+ * new samples are dropped and counted rather than making the
+ * control loop wait.  The count is written to the file on
+ * channel 0.
+ */
+class FlightRecorder
+{
+public:
+	static const UINT32 kVersion = 1;
+	static const UINT32 kCapacity = 4096;		// Samples; a power of two
+	static const int kMaxChannels = 32;
+	static const int kMaxFiles = 1000;
+	static const double kDrainPeriod = 0.05;	// In seconds
+	static const INT32 kPriority = 160;		// Below the telemetry task
+
+	static FlightRecorder *GetInstance();
+
+	int AddChannel(const char *, const char *, const char *);
+	bool Start();
+	void Record(int, float, float b = 0);
+
+	bool IsRecording();
+	UINT32 GetDroppedCount();
+	const char *GetFileName();
+
+protected:
+	FlightSample mRing[kCapacity];
+	volatile UINT32 mHead;		// Only written by Record
+	volatile UINT32 mTail;		// Only written by the drain task
+	volatile bool mIsRecording;
+	volatile UINT32 mDroppedCount;
+	UINT32 mWrittenDroppedCount;
+
+	FlightChannelInfo mChannels[kMaxChannels];
+	int mChannelCount;
+	double mStartTime;
+	FILE *mFile;
+	char mFileName[32];
+	Task *mTask;
+
+	FlightRecorder();
+	bool OpenFile();
+	void Drain();
+	void WriteDroppedCount();
+
+	static int RunTask();
+};
+
+/**
+ * @brief A RobotDrive that records what it sends to the left and
+ * right motors.
+ *
+ * @details
+ * TankDrive, ArcadeDrive and Drive all end up calling
+ * SetLeftRightMotorOutputs, so this catches every drive command.
+ */
+class RecordingRobotDrive : public RobotDrive
+{
+protected:
+	int mChannel;
+
+public:
+	RecordingRobotDrive(SpeedController *, SpeedController *, SpeedController *, SpeedController *);
+	void SetLeftRightMotorOutputs(float, float);
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "scheduler.h"
+
+/**
+ * @param[in] period The length of one tick, in seconds.
+ */
+ControllerScheduler::ControllerScheduler(double period)
+{
+	mPeriod = period;
+	mNextDeadline = 0;
+	mLastTickStart = 0;
+	mTickCount = 0;
+	mOverrunCount = 0;
+	mSlowestController = "";
+	mInput = NULL;
+}
+
+/**
+ * @brief Adds a controller to the schedule.
+ * 
+ * @param[in] controller The controller to run.
+ * @param[in] name A name to report it by.  Must outlive the 
+ * scheduler (a string literal is fine).
+ * @param[in] divisor Run the controller once every this many
+ * ticks.  Use 1 for things like driving that need to react
+ * immediately, and higher numbers for things like telemetry.
+ */
+void ControllerScheduler::Add(BaseController *controller, const char *name, int divisor)
+{
+	Entry entry;
+	entry.Controller = controller;
+	entry.Name = name;
+	entry.Divisor = (divisor < 1) ? 1 : divisor;
+	entry.LastExecutionTime = 0;
+	entry.ProfileId = mProfiler.Add(name);
+	mEntries.push_back(entry);
+}
+
+/**
+ * @brief Sets the joysticks to read at the start of every tick,
+ * before any controller runs.
+ */
+void ControllerScheduler::SetInput(DriverInput *input)
+{
+	mInput = input;
+}
+
+/**
+ * @brief Starts the schedule from now.  Call this right before 
+ * entering the loop -- otherwise the first tick will look like
+ * an overrun.
+ */
+void ControllerScheduler::Start()
+{
+	mTickCount = 0;
+	mNextDeadline = Timer::GetFPGATimestamp();
+	mLastTickStart = 0;
+	mProfiler.Start();
+}
+
+/**
+ * @brief Runs every controller that is due this tick.
+ */
+void ControllerScheduler::Tick()
+{
+	double tickStart = Timer::GetFPGATimestamp();
+	if (mLastTickStart > 0) {
+		mProfiler.RecordJitter((tickStart - mLastTickStart) - mPeriod);
+	}
+	mLastTickStart = tickStart;
+	
+	if (mInput != NULL) {
+		mInput->Update();
+	}
+	
+	double slowestTime = -1;
+	int size = (int) mEntries.size();
+	for (int i=0; i<size; i++) {
+		Entry &entry = mEntries[i];
+		if ((mTickCount % entry.Divisor) != 0) {
+			continue;
+		}
+		double start = Timer::GetFPGATimestamp();
+		entry.Controller->Run();
+		entry.LastExecutionTime = Timer::GetFPGATimestamp() - start;
+		mProfiler.RecordExecution(entry.ProfileId, entry.LastExecutionTime);
+		
+		if (entry.LastExecutionTime > slowestTime) {
+			slowestTime = entry.LastExecutionTime;
+			mSlowestController = entry.Name;
+		}
+	}
+	mTickCount++;
+}
+
+/**
+ * @brief Sleeps until the start of the next tick.
+ * 
+ * @details
+ * Returns immediately (and counts an overrun) if the current
+ * tick already went over the period.
+ */
+void ControllerScheduler::WaitForNextTick()
+{
+	mNextDeadline += mPeriod;
+	double now = Timer::GetFPGATimestamp();
+	double remaining = mNextDeadline - now;
+	
+	if (remaining > 0) {
+		Wait(remaining);
+	} else {
+		mOverrunCount++;
+		mNextDeadline = now;
+		ReportOverrun();
+	}
+}
+
+void ControllerScheduler::ReportOverrun()
+{
+	Telemetry *s = Telemetry::GetInstance();
+	s->Log(mOverrunCount, "Scheduler::Overruns");
+	s->Log(mSlowestController, "Scheduler::SlowestController");
+}
+
+double ControllerScheduler::GetPeriod()
+{
+	return mPeriod;
+}
+
+UINT32 ControllerScheduler::GetTickCount()
+{
+	return mTickCount;
+}
+
+UINT32 ControllerScheduler::GetOverrunCount()
+{
+	return mOverrunCount;
+}
+
+/**
+ * @brief How long (in seconds) the named controller took the
+ * last time it ran.  Returns 0 if no such controller.
+ */
+double ControllerScheduler::GetLastExecutionTime(const char *name)
+{
+	int size = (int) mEntries.size();
+	for (int i=0; i<size; i++) {
+		if (strcmp(mEntries[i].Name, name) == 0) {
+			return mEntries[i].LastExecutionTime;
+		}
+	}
+	return 0;
+}
+
+ExecutionProfiler &ControllerScheduler::GetProfiler()
+{
+	return mProfiler;
+}
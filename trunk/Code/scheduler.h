@@ -0,0 +1,97 @@
+/**
+ * @file scheduler.h
+ * 
+ * @brief Runs controllers on a fixed period.
+ * 
+ * @details
+ * Used to be, every robot profile called Wait() after each
+ * controller, so the loop got slower every time we added a 
+ * controller.  The scheduler instead runs every controller
+ * once per tick (or once every few ticks, see the divisor in
+ * ControllerScheduler::Add) and then sleeps only for whatever
+ * is left of the period.
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+// System libraries
+#include <vector>
+
+// 3rd party libraries
+#include "WPILib.h"
+
+// Program modules
+#include "Definitions/components.h"
+#include "profiler.h"
+#include "Client/input.h"
+
+/**
+ * @brief Runs a collection of controllers at a fixed rate.
+ * 
+ * @details
+ * Usage, inside OperatorControl:
+ * @code
+ * mScheduler->Start();
+ * while (IsOperatorControl()) {
+ *     mScheduler->Tick();
+ *     GetWatchdog().Feed();
+ *     mScheduler->WaitForNextTick();
+ * }
+ * @endcode
+ * 
+ * Ticks are scheduled against absolute deadlines, so time spent
+ * inside the controllers is taken out of the wait instead of
+ * being added to it.  If a tick takes longer than the period,
+ * it counts as an overrun and the schedule restarts from the
+ * current time (instead of trying to catch up with a burst of
+ * back-to-back ticks).  Overruns are reported to the 
+ * SmartDashboard along with the slowest controller of that tick.
+ * 
+ * Every run of every controller, and the length of every loop
+ * period, is also fed to an ExecutionProfiler (see profiler.h).
+ * 
+ * If given a DriverInput (see SetInput), each tick starts by
+ * taking a snapshot of the joysticks, so every controller in
+ * that tick sees the same driver input.
+ */
+class ControllerScheduler
+{
+protected:
+	struct Entry
+	{
+		BaseController *Controller;
+		const char *Name;
+		int Divisor;
+		double LastExecutionTime;	// In seconds
+		int ProfileId;
+	};
+	
+	std::vector<Entry> mEntries;
+	double mPeriod;
+	double mNextDeadline;
+	double mLastTickStart;
+	UINT32 mTickCount;
+	UINT32 mOverrunCount;
+	const char *mSlowestController;
+	ExecutionProfiler mProfiler;
+	DriverInput *mInput;
+	
+	void ReportOverrun();
+	
+public:
+	ControllerScheduler(double);
+	void Add(BaseController *, const char *, int divisor = 1);
+	void SetInput(DriverInput *);
+	void Start();
+	void Tick();
+	void WaitForNextTick();
+	
+	double GetPeriod();
+	UINT32 GetTickCount();
+	UINT32 GetOverrunCount();
+	double GetLastExecutionTime(const char *);
+	ExecutionProfiler &GetProfiler();
+};
+
+#endif
@@ -5,7 +5,7 @@ SimpleEncoderTest::SimpleEncoderTest(Encoder *leftEncoder, Encoder *rightEncoder
 {
 	mLeftEncoder = leftEncoder;
 	mRightEncoder = rightEncoder;
-	mS = SmartDashboard::GetInstance();
+	mS = Telemetry::GetInstance();
 	
 	mS->Log(mLeftEncoder->GetRate(), "Left Encoder:");
 	mS->Log(mRightEncoder->GetRate(), "Right Encoder:");
@@ -38,7 +38,7 @@ RangeFinder::RangeFinder(AnalogChannel *ultrasoundSensor) :
 float RangeFinder::FromWallInches(void)
 {
 	INT32 rawDistance = FromWallRaw();
-	float inchesDistance = (float) rawDistance * 0.5;		// Based on experimental data.
+	float inchesDistance = (float) rawDistance * kInchesPerUnit;
 	return inchesDistance;
 }
 
@@ -100,7 +100,7 @@ RangeFinderTest::RangeFinderTest(RangeFinder *rangeFinder) :
  */
 void RangeFinderTest::Run(void)
 {
-	SmartDashboard::GetInstance()->Log(mRangeFinder->FromWallInches(), "(ULTRASOUND) Distance ");
+	Telemetry::GetInstance()->Log(mRangeFinder->FromWallInches(), "(ULTRASOUND) Distance ");
 }
 
 
@@ -122,7 +122,7 @@ GyroTest::GyroTest(Gyro *gyro) :
  */
 void GyroTest::Run()
 {
-	SmartDashboard::GetInstance()->Log(mGyro->GetAngle(), "(GYRO) Rotation ");
+	Telemetry::GetInstance()->Log(mGyro->GetAngle(), "(GYRO) Rotation ");
 }
 
 
@@ -140,5 +140,177 @@ DigitalInputTestController::DigitalInputTestController(DigitalInput *digitalInpu
  */
 void DigitalInputTestController::Run()
 {
-	SmartDashboard::GetInstance()->Log((bool) mDigitalInput->Get(), "DigitalInputTestController");
+	Telemetry::GetInstance()->Log((bool) mDigitalInput->Get(), "DigitalInputTestController");
+}
+
+
+
+SensorRecorder::SensorRecorder() :
+		BaseController()
+{
+	// Empty
+}
+
+void SensorRecorder::Add(Gyro *gyro, Encoder *encoder, RangeFinder *rangeFinder, int channel)
+{
+	Sensor sensor;
+	sensor.SensorGyro = gyro;
+	sensor.SensorEncoder = encoder;
+	sensor.SensorRangeFinder = rangeFinder;
+	sensor.Channel = channel;
+	mSensors.push_back(sensor);
+}
+
+/**
+ * @brief Records a gyro's angle (in degrees).
+ * 
+ * @param[in] gyro The gyro.
+ * @param[in] name The channel name in the recording.
+ */
+void SensorRecorder::AddGyro(Gyro *gyro, const char *name)
+{
+	Add(gyro, NULL, NULL, FlightRecorder::GetInstance()->AddChannel(name, "angle", ""));
+}
+
+/**
+ * @brief Records an encoder's distance and rate.
+ * 
+ * @param[in] encoder The encoder.
+ * @param[in] name The channel name in the recording.
+ */
+void SensorRecorder::AddEncoder(Encoder *encoder, const char *name)
+{
+	Add(NULL, encoder, NULL, FlightRecorder::GetInstance()->AddChannel(name, "distance", "rate"));
+}
+
+/**
+ * @brief Records the rangefinder's raw reading and its distance
+ * in inches.
+ * 
+ * @param[in] rangeFinder The rangefinder.
+ * @param[in] name The channel name in the recording.
+ */
+void SensorRecorder::AddRangeFinder(RangeFinder *rangeFinder, const char *name)
+{
+	Add(NULL, NULL, rangeFinder, FlightRecorder::GetInstance()->AddChannel(name, "raw", "inches"));
+}
+
+/**
+ * @brief Records one sample from every sensor.
+ */
+void SensorRecorder::Run()
+{
+	FlightRecorder *recorder = FlightRecorder::GetInstance();
+	int size = (int) mSensors.size();
+	for (int i=0; i<size; i++) {
+		Sensor &sensor = mSensors[i];
+		if (sensor.SensorGyro != NULL) {
+			recorder->Record(sensor.Channel, sensor.SensorGyro->GetAngle());
+		} else if (sensor.SensorEncoder != NULL) {
+			recorder->Record(sensor.Channel, sensor.SensorEncoder->GetDistance(), sensor.SensorEncoder->GetRate());
+		} else if (sensor.SensorRangeFinder != NULL) {
+			INT32 raw = sensor.SensorRangeFinder->FromWallRaw();
+			recorder->Record(sensor.Channel, raw, raw * RangeFinder::kInchesPerUnit);
+		}
+	}
+}
+
+
+
+/**
+ * @brief Starts sampling the gyro.
+ * 
+ * @param[in] gyro The gyro.  Resetting it while the history is in
+ * use makes the older samples meaningless.
+ */
+GyroHistory::GyroHistory(Gyro *gyro)
+{
+	mGyro = gyro;
+	mHead = 0;
+	mSampler = new Notifier(GyroHistory::RecordSample, this);
+	mSampler->StartPeriodic(kSamplePeriod);
+}
+
+/**
+ * @brief Stops sampling.  Deleting the Notifier waits for a sample
+ * being recorded to finish.
+ */
+GyroHistory::~GyroHistory()
+{
+	delete mSampler;
+}
+
+void GyroHistory::RecordSample(void *history)
+{
+	((GyroHistory *) history)->Record();
+}
+
+/**
+ * @brief Adds the gyro's angle now to the ring.  Only called by the
+ * Notifier.
+ */
+void GyroHistory::Record()
+{
+	UINT32 head = mHead;
+	Sample &sample = mSamples[head & (kCapacity - 1)];
+	sample.Time = Timer::GetFPGATimestamp();
+	sample.Angle = mGyro->GetAngle();
+	Tools::MemoryBarrier();
+	mHead = head + 1;
+}
+
+/**
+ * @brief Finds the gyro's angle at some time in the last second or
+ * so, interpolating between the samples either side of it.
+ * 
+ * @param[in] time From Timer::GetFPGATimestamp.
+ * @param[out] angle In degrees, as the gyro returns it.  Set to the
+ * newest sample if the time is after it.
+ * 
+ * @returns False if nothing has been sampled yet or the time is
+ * older than the history goes back (see GetOldestTime), in which
+ * case angle is left alone.
+ */
+bool GyroHistory::GetAngleAt(double time, float &angle)
+{
+	UINT32 head = mHead;
+	Tools::MemoryBarrier();
+	int count = (head < (UINT32) kSafeCount) ? (int) head : kSafeCount;
+	if (count == 0) {
+		return false;
+	}
+	
+	const Sample *newer = &mSamples[(head - 1) & (kCapacity - 1)];
+	if (time >= newer->Time) {
+		angle = newer->Angle;
+		return true;
+	}
+	for (int i=2; i<=count; i++) {
+		const Sample *older = &mSamples[(head - i) & (kCapacity - 1)];
+		if (older->Time <= time) {
+			double span = newer->Time - older->Time;
+			double fraction = (span > 0) ? (time - older->Time) / span : 1;
+			angle = (float) (older->Angle + (newer->Angle - older->Angle) * fraction);
+			return true;
+		}
+		newer = older;
+	}
+	return false;
+}
+
+/**
+ * @brief How far back GetAngleAt can look.
+ * 
+ * @returns The time of the oldest usable sample, or 0 if there
+ * aren't any.
+ */
+double GyroHistory::GetOldestTime()
+{
+	UINT32 head = mHead;
+	Tools::MemoryBarrier();
+	int count = (head < (UINT32) kSafeCount) ? (int) head : kSafeCount;
+	if (count == 0) {
+		return 0;
+	}
+	return mSamples[(head - count) & (kCapacity - 1)].Time;
 }
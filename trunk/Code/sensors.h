@@ -8,11 +8,16 @@
 #ifndef SENSORS_H_
 #define SENSORS_H_
 
+// System libraries
+#include <vector>
+
 // 3rd party libraries
 #include "WPILib.h"
 
 // Program modules
 #include "Definitions/components.h"
+#include "telemetry.h"
+#include "recorder.h"
 
 /**
  * @brief Reports the left and right encoder values
@@ -26,7 +31,7 @@ class SimpleEncoderTest : public BaseController
 protected:
 	Encoder *mLeftEncoder;
 	Encoder *mRightEncoder;
-	SmartDashboard *mS;
+	Telemetry *mS;
 	
 public:
 	SimpleEncoderTest(Encoder*, Encoder*);
@@ -54,6 +59,8 @@ protected:
 	static const INT32 kWallDistanceMax = 200;	// In inches.
 	
 public:
+	static const float kInchesPerUnit = 0.5;	// Based on experimental data.
+	
 	RangeFinder(AnalogChannel *);
 	float FromWallInches(void);
 	INT32 FromWallRaw(void);
@@ -103,4 +110,75 @@ public:
 	void Run();
 };
 
+/**
+ * @brief Samples sensors into the flight recorder (see recorder.h).
+ * 
+ * @details
+ * Add every sensor before calling FlightRecorder::Start, since
+ * that's when the channel names are written out.  Sampling once
+ * every few ticks (see ControllerScheduler::Add) is plenty.
+ */
+class SensorRecorder : public BaseController
+{
+protected:
+	struct Sensor
+	{
+		Gyro *SensorGyro;
+		Encoder *SensorEncoder;
+		RangeFinder *SensorRangeFinder;
+		int Channel;
+	};
+	std::vector<Sensor> mSensors;
+	
+	void Add(Gyro *, Encoder *, RangeFinder *, int);
+	
+public:
+	SensorRecorder();
+	void AddGyro(Gyro *, const char *);
+	void AddEncoder(Encoder *, const char *);
+	void AddRangeFinder(RangeFinder *, const char *);
+	void Run();
+};
+
+/**
+ * @brief Remembers which way the gyro pointed over the last second
+ * or so, so it can say which way the robot faced when something
+ * happened (like the camera taking a picture).
+ * 
+ * @details
+ * A Notifier samples the gyro every kSamplePeriod, much faster than
+ * the control loop, into a ring of kCapacity samples.  The Notifier
+ * is the only writer; GetAngleAt can be called from any one other
+ * task, and only looks at samples too recent to be overwritten
+ * while it reads them.
+ */
+class GyroHistory
+{
+public:
+	static const int kCapacity = 256;		// Samples; a power of two
+	static const double kSamplePeriod = 0.005;	// In seconds
+	
+	GyroHistory(Gyro *);
+	~GyroHistory();
+	bool GetAngleAt(double, float &);
+	double GetOldestTime();
+	
+protected:
+	struct Sample
+	{
+		double Time;		// From Timer::GetFPGATimestamp
+		float Angle;		// In degrees, as the gyro returns it
+	};
+	
+	Gyro *mGyro;
+	Sample mSamples[kCapacity];
+	volatile UINT32 mHead;		// Only written by the Notifier
+	Notifier *mSampler;
+	
+	static const int kSafeCount = kCapacity - 16;	// Leaves the writer room to get ahead while reading
+	
+	void Record();
+	static void RecordSample(void *);
+};
+
 #endif
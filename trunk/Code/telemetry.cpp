@@ -0,0 +1,257 @@
+#include "telemetry.h"
+
+namespace
+{
+	const char *kTableName = "SmartDashboard";
+}
+
+Telemetry::Telemetry()
+{
+	mEntryCount = 0;
+	for (int i=0; i<kNumAliases; i++) {
+		mAliases[i].Pointer = NULL;
+		mAliases[i].Index = -1;
+	}
+	mPeriod = kDefaultPeriod;
+	mSentCount = 0;
+	mSuppressedCount = 0;
+	mLock = semMCreate(SEM_Q_PRIORITY | SEM_DELETE_SAFE | SEM_INVERSION_SAFE);
+	mTask = new Task("Telemetry", (FUNCPTR) Telemetry::RunTask, kPriority);
+}
+
+/**
+ * @brief Gets the telemetry table, starting the task that sends
+ * it the first time this is called.
+ */
+Telemetry *Telemetry::GetInstance()
+{
+	static Telemetry *instance = NULL;
+	if (instance == NULL) {
+		instance = new Telemetry();
+		instance->mTask->Start();
+	}
+	return instance;
+}
+
+/**
+ * @brief The sending task.  Never returns.
+ */
+int Telemetry::RunTask()
+{
+	Telemetry *telemetry = GetInstance();
+	while (true) {
+		telemetry->Flush();
+		Wait(telemetry->mPeriod);
+	}
+	return 0;
+}
+
+/**
+ * @brief Changes how often values are sent.
+ *
+ * @param[in] period In seconds.
+ */
+void Telemetry::SetPeriod(double period)
+{
+	mPeriod = period;
+}
+
+void Telemetry::Log(bool value, const char *key)
+{
+	Store(key, kBoolean, value ? 1 : 0, NULL);
+}
+
+void Telemetry::Log(INT32 value, const char *key)
+{
+	Store(key, kInteger, value, NULL);
+}
+
+void Telemetry::Log(UINT32 value, const char *key)
+{
+	Store(key, kUnsigned, value, NULL);
+}
+
+void Telemetry::Log(float value, const char *key)
+{
+	Store(key, kFloat, value, NULL);
+}
+
+void Telemetry::Log(double value, const char *key)
+{
+	Store(key, kDouble, value, NULL);
+}
+
+void Telemetry::Log(const char *value, const char *key)
+{
+	Store(key, kText, 0, value);
+}
+
+/**
+ * @brief Finds the entry for a key, adding one if needed.  Must be
+ * called with mLock held.
+ *
+ * @returns The index into mEntries, or -1 if the table is full.
+ */
+int Telemetry::Intern(const char *key)
+{
+	UINT32 hash = ((UINT32) (size_t) key >> 2) * 2654435761U;
+	int slot = (int) (hash >> 23) & (kNumAliases - 1);
+	int probes = 0;
+	while (mAliases[slot].Pointer != NULL) {
+		if (mAliases[slot].Pointer == key) {
+			return mAliases[slot].Index;
+		}
+		slot = (slot + 1) & (kNumAliases - 1);
+		probes++;
+		if (probes == kNumAliases) {
+			slot = -1;
+			break;
+		}
+	}
+
+	// First time we've seen this pointer -- it may still be a key
+	// we already know, at a different address.
+	int index = -1;
+	for (int i=0; i<mEntryCount; i++) {
+		if (strcmp(mEntries[i].Key, key) == 0) {
+			index = i;
+			break;
+		}
+	}
+	if ((index < 0) and (mEntryCount < kMaxEntries)) {
+		index = mEntryCount;
+		mEntries[index].Key = key;
+		mEntries[index].Type = kText;
+		mEntries[index].Number = 0;
+		mEntries[index].Text[0] = '\0';
+		mEntries[index].HasValue = false;
+		mEntries[index].Dirty = false;
+		mEntryCount++;
+	}
+	if ((index >= 0) and (slot >= 0)) {
+		mAliases[slot].Pointer = key;
+		mAliases[slot].Index = index;
+	}
+	return index;
+}
+
+/**
+ * @brief Records a value, marking it to be sent if it changed.
+ */
+void Telemetry::Store(const char *key, ValueType type, double number, const char *text)
+{
+	{
+		Synchronized sync(mLock);
+		int index = Intern(key);
+		if (index >= 0) {
+			Entry &entry = mEntries[index];
+			bool isSame = (entry.Type == type) and (entry.Number == number);
+			if (isSame and (type == kText)) {
+				isSame = (strncmp(entry.Text, text, kMaxTextLength - 1) == 0);
+			}
+			if (isSame and entry.HasValue) {
+				mSuppressedCount++;
+				return;
+			}
+			entry.Type = type;
+			entry.Number = number;
+			if (type == kText) {
+				strncpy(entry.Text, text, kMaxTextLength - 1);
+				entry.Text[kMaxTextLength - 1] = '\0';
+			} else {
+				entry.Text[0] = '\0';
+			}
+			entry.HasValue = true;
+			entry.Dirty = true;
+			return;
+		}
+	}
+
+	// The table is full, so send it the old way.
+	Entry entry;
+	entry.Key = key;
+	entry.Type = type;
+	entry.Number = number;
+	if (type == kText) {
+		strncpy(entry.Text, text, kMaxTextLength - 1);
+		entry.Text[kMaxTextLength - 1] = '\0';
+	}
+	Send(entry);
+}
+
+/**
+ * @brief Sends every value that changed since the last flush, as
+ * one NetworkTable transaction.
+ *
+ * @details
+ * The table is only locked long enough to copy the changed
+ * entries out, so the network is never waited on while holding
+ * it.  Normally only called by the telemetry task.
+ */
+void Telemetry::Flush()
+{
+	int count = 0;
+	{
+		Synchronized sync(mLock);
+		for (int i=0; i<mEntryCount; i++) {
+			if (mEntries[i].Dirty) {
+				mBatch[count] = mEntries[i];
+				mEntries[i].Dirty = false;
+				count++;
+			}
+		}
+	}
+	if (count == 0) {
+		return;
+	}
+
+	NetworkTable *table = NetworkTable::GetTable(kTableName);
+	table->BeginTransaction();
+	for (int i=0; i<count; i++) {
+		Send(mBatch[i]);
+	}
+	table->EndTransaction();
+	mSentCount += count;
+}
+
+void Telemetry::Send(const Entry &entry)
+{
+	SmartDashboard *s = SmartDashboard::GetInstance();
+	switch (entry.Type) {
+	case kBoolean:
+		s->Log(entry.Number != 0, entry.Key);
+		break;
+	case kInteger:
+		s->Log((INT32) entry.Number, entry.Key);
+		break;
+	case kUnsigned:
+		s->Log((UINT32) entry.Number, entry.Key);
+		break;
+	case kFloat:
+		s->Log((float) entry.Number, entry.Key);
+		break;
+	case kDouble:
+		s->Log(entry.Number, entry.Key);
+		break;
+	case kText:
+		s->Log(entry.Text, entry.Key);
+		break;
+	}
+}
+
+/**
+ * @brief How many values have been sent to the dashboard.
+ */
+UINT32 Telemetry::GetSentCount()
+{
+	return mSentCount;
+}
+
+/**
+ * @brief How many Log calls were skipped because the value hadn't
+ * changed.
+ */
+UINT32 Telemetry::GetSuppressedCount()
+{
+	return mSuppressedCount;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file telemetry.h
+ *
+ * @brief Buffers values headed for the SmartDashboard and sends
+ * them a few times a second.
+ *
+ * @details
+ * Every SmartDashboard::Log call goes out over the network right
+ * away, and the controllers make a lot of them (TankJoysticks
+ * alone logs 7 values a loop, 100 times a second), most of them
+ * the same value as last time.  Telemetry::Log instead just
+ * records the value in a table, and a low-priority task sends
+ * whatever actually changed as one batch, 10 times a second
+ * by default.
+ *
+ * Usage is the same as the old Log calls:
+ * @code
+ * Telemetry::GetInstance()->Log(driveSpeed.Left, "(TANK DRIVE) Left speed ");
+ * @endcode
+ *
+ * @warning Keys are remembered by address, so they must outlive
+ * the program -- string literals are fine, a char buffer on the
+ * stack is not.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+// 3rd party libraries
+#include "WPILib.h"
+#include "NetworkTables/NetworkTable.h"
+
+/**
+ * @brief A table of the latest value for every dashboard key.
+ *
+ * @details
+ * Keys are looked up by pointer in a small hash table, falling
+ * back to comparing the text only the first time a given pointer
+ * is seen.  All storage is allocated up front.  If the table
+ * fills up, extra keys are sent straight to the SmartDashboard
+ * like before.
+ */
+class Telemetry
+{
+public:
+	static const double kDefaultPeriod = 0.1;	// In seconds
+	static const INT32 kPriority = 150;		// Below the robot's main task (101)
+	static const int kMaxEntries = 256;
+	static const int kMaxTextLength = 64;
+	static const int kNumAliases = 512;	// Power of two
+
+	static Telemetry *GetInstance();
+
+	void Log(bool, const char *);
+	void Log(INT32, const char *);
+	void Log(UINT32, const char *);
+	void Log(float, const char *);
+	void Log(double, const char *);
+	void Log(const char *, const char *);
+
+	void SetPeriod(double);
+	void Flush();
+
+	UINT32 GetSentCount();
+	UINT32 GetSuppressedCount();
+
+protected:
+	enum ValueType
+	{
+		kBoolean,
+		kInteger,
+		kUnsigned,
+		kFloat,
+		kDouble,
+		kText
+	};
+
+	struct Entry
+	{
+		const char *Key;
+		ValueType Type;
+		double Number;
+		char Text[kMaxTextLength];
+		bool HasValue;
+		bool Dirty;
+	};
+
+	struct Alias
+	{
+		const char *Pointer;
+		int Index;
+	};
+
+	Entry mEntries[kMaxEntries];
+	int mEntryCount;
+	Alias mAliases[kNumAliases];
+	Entry mBatch[kMaxEntries];	// Only touched by the flushing task
+	SEM_ID mLock;
+	Task *mTask;
+	volatile double mPeriod;
+	UINT32 mSentCount;
+	UINT32 mSuppressedCount;
+
+	Telemetry();
+	int Intern(const char *);
+	void Store(const char *, ValueType, double, const char *);
+	void Send(const Entry &);
+
+	static int RunTask();
+};
+
+#endif
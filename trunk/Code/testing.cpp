@@ -8,8 +8,7 @@ ServoController::ServoController(Servo *servo) :
 	BaseController()
 {
 	mServo = servo;
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	s->PutString("(SERVO) Value <<", "0.0");
+	mValue = Parameters::GetInstance()->AddFloat("(SERVO) Value <<", 0.0);
 }
 
 /**
@@ -18,16 +17,15 @@ ServoController::ServoController(Servo *servo) :
  */
 void ServoController::Run()
 {
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	float value = Tools::StringToFloat(s->GetString("(SERVO) Value <<"));
+	float value = mValue->Get();
 	if (value > 1.0) {
 		value = 1.0;
 	} else if (value < -1.0) {
 		value = -1.0;
 	}
-	SmartDashboard::GetInstance()->Log(value, "(SERVO) amount fed:");
+	Telemetry::GetInstance()->Log(value, "(SERVO) amount fed:");
 	mServo->Set(value);
-	SmartDashboard::GetInstance()->Log(mServo->Get(), "(SERVO) amount reported:");
+	Telemetry::GetInstance()->Log(mServo->Get(), "(SERVO) amount reported:");
 }
 
 
@@ -36,15 +34,15 @@ EncoderTestController::EncoderTestController(Encoder *encoder) :
 {
 	mEncoder = encoder;
 	printf("Testing Encoder");
-	SmartDashboard::GetInstance()->Log("Encoder test initialized", "(ENCODER TEST) status:");
+	Telemetry::GetInstance()->Log("Encoder test initialized", "(ENCODER TEST) status:");
 	SmartDashboard::GetInstance()->PutString("(ENCODER TEST) command <<", "deactivate");
 	//mPreviousCommand = "deactivate";
 }
 
 void EncoderTestController::Run()
 {
-	SmartDashboard *s = SmartDashboard::GetInstance();
-	string command = s->GetString("(ENCODER TEST) command <<");
+	Telemetry *s = Telemetry::GetInstance();
+	string command = SmartDashboard::GetInstance()->GetString("(ENCODER TEST) command <<");
 	
 	if (command != mPreviousCommand) {
 		if (command == "start") {
@@ -14,6 +14,8 @@
 #include "WPILib.h"
 #include "Definitions/components.h"
 #include "tools.h"
+#include "parameters.h"
+#include "telemetry.h"
 
 /**
  * @brief A experimental class used to control a servo.
@@ -28,6 +30,7 @@ class ServoController : public BaseController
 {
 protected:
 	Servo *mServo;
+	FloatParameter *mValue;
 	
 public:
 	ServoController(Servo *);
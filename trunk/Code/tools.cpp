@@ -104,3 +104,23 @@ std::string Tools::FloatToString(float input)
 	ss << input;
 	return ss.str();
 }
+
+
+/**
+ * @brief Makes sure every memory write before this point is seen by
+ * other tasks before any write after it.
+ * 
+ * @details
+ * Used to hand data between tasks without a lock: fill in the data,
+ * call this, then set the flag or index that says it's ready.  The
+ * reading task calls this between checking the flag and reading the
+ * data.
+ */
+void Tools::MemoryBarrier()
+{
+#if defined(__PPC__) || defined(__ppc__) || defined(_ARCH_PPC)
+	__asm__ __volatile__ ("sync" : : : "memory");
+#else
+	__sync_synchronize();
+#endif
+}
@@ -4,6 +4,7 @@
 // Standard libraries
 #include <string>
 #include <sstream>
+#include <stdio.h>
 
 /**
  * @brief A set of useful functions that are used frequently
@@ -24,6 +25,7 @@ namespace Tools
 	float StringToFloat(std::string);
 	float StringToFloat(const char *);
 	std::string FloatToString(float);
+	void MemoryBarrier();
 }
 
 
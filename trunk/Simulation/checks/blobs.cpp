@@ -0,0 +1,412 @@
+/**
+ * @file blobs.cpp
+ *
+ * @brief Finds the blobs in random masks with BlobFinder and with a
+ * plain flood fill, one pixel at a time, and checks they agree.
+ *
+ * @details
+ * Checks that:
+ *   - RunMask::FromPacked and ToPacked give back the mask they
+ *     started from
+ *   - BlobFinder finds the same blobs as the flood fill, in the same
+ *     order, with the same areas, bounding boxes, centers, corners
+ *     and hull areas
+ *   - the thickness filter drops exactly the blobs whose bounding
+ *     box is too thin
+ *   - Find gives the same answer from a PackedMask as from its runs
+ *
+ * Besides random masks of a few sizes, there are made-up ones with
+ * blobs that only touch at a corner, runs either side of a word
+ * boundary (x = 31 and 32) and runs up against the right edge.
+ *
+ * The flood fill's hull area comes from the hull of every pixel,
+ * counting the pixels inside it one by one.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "../../Code/Tracking/blobs.h"
+#include "check.h"
+
+namespace
+{
+	const unsigned int kSeed = 2012;
+	const int kTrials = 50;
+
+	struct Point
+	{
+		int X;
+		int Y;
+
+		bool operator<(const Point &other) const
+		{
+			return (X < other.X) or ((X == other.X) and (Y < other.Y));
+		}
+
+		bool operator==(const Point &other) const
+		{
+			return (X == other.X) and (Y == other.Y);
+		}
+	};
+
+	/**
+	 * What the flood fill makes of one blob.
+	 */
+	struct Expected
+	{
+		int Area;
+		int Left;
+		int Top;
+		int Right;
+		int Bottom;
+		double CenterX;
+		double CenterY;
+		int CornerX[4];
+		int CornerY[4];
+		int HullArea;
+	};
+
+	long Cross(const Point &a, const Point &b, const Point &p)
+	{
+		return (long) (b.X - a.X) * (p.Y - a.Y) - (long) (b.Y - a.Y) * (p.X - a.X);
+	}
+
+	/**
+	 * Counts the pixels inside or on the convex hull of some pixels.
+	 */
+	int CountHull(std::vector<Point> points)
+	{
+		std::sort(points.begin(), points.end());
+		points.erase(std::unique(points.begin(), points.end()), points.end());
+		int count = (int) points.size();
+
+		// Andrew's monotone chain, anticlockwise, without collinear points
+		std::vector<Point> hull(2 * count);
+		int size = 0;
+		for (int i = 0; i < count; i++) {
+			while ((size >= 2) and (Cross(hull[size - 2], hull[size - 1], points[i]) <= 0)) {
+				size--;
+			}
+			hull[size++] = points[i];
+		}
+		for (int i = count - 2, lower = size + 1; i >= 0; i--) {
+			while ((size >= lower) and (Cross(hull[size - 2], hull[size - 1], points[i]) <= 0)) {
+				size--;
+			}
+			hull[size++] = points[i];
+		}
+		if (count > 1) {
+			size--;		// The first point, again
+		}
+
+		int left = points.front().X;
+		int right = points.back().X;
+		int top = points[0].Y;
+		int bottom = points[0].Y;
+		for (int i = 0; i < count; i++) {
+			top = std::min(top, points[i].Y);
+			bottom = std::max(bottom, points[i].Y);
+		}
+		int inside = 0;
+		for (int y = top; y <= bottom; y++) {
+			for (int x = left; x <= right; x++) {
+				Point p = {x, y};
+				bool isInside = true;
+				for (int i = 0; (i < size) and isInside; i++) {
+					// With only two corners, the "hull" is a line there and back.
+					isInside = (Cross(hull[i], hull[(i + 1) % size], p) >= 0);
+				}
+				inside += isInside ? 1 : 0;
+			}
+		}
+		return inside;
+	}
+
+	int CornerScore(int corner, int x, int y)
+	{
+		switch (corner) {
+		case 0:
+			return -(x + y);
+		case 1:
+			return x - y;
+		case 2:
+			return x + y;
+		default:
+			return y - x;
+		}
+	}
+
+	/**
+	 * Labels every set pixel of the mask by flood fill, touching on
+	 * sides or corners, in the order a raster scan first meets each
+	 * blob, and measures each blob a pixel at a time.
+	 */
+	void FloodFill(const PackedMask &mask, std::vector<Expected> &blobs)
+	{
+		int width = mask.GetWidth();
+		int height = mask.GetHeight();
+		std::vector<int> labels(width * height, -1);
+		std::vector<std::vector<Point> > members;
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				if (!mask.Get(x, y) or (labels[y * width + x] >= 0)) {
+					continue;
+				}
+				int label = (int) members.size();
+				members.push_back(std::vector<Point>());
+				std::vector<Point> stack;
+				Point start = {x, y};
+				stack.push_back(start);
+				labels[y * width + x] = label;
+				while (!stack.empty()) {
+					Point p = stack.back();
+					stack.pop_back();
+					members[label].push_back(p);
+					for (int dy = -1; dy <= 1; dy++) {
+						for (int dx = -1; dx <= 1; dx++) {
+							Point q = {p.X + dx, p.Y + dy};
+							if ((q.X < 0) or (q.X >= width) or (q.Y < 0) or (q.Y >= height)
+									or !mask.Get(q.X, q.Y) or (labels[q.Y * width + q.X] >= 0)) {
+								continue;
+							}
+							labels[q.Y * width + q.X] = label;
+							stack.push_back(q);
+						}
+					}
+				}
+			}
+		}
+
+		blobs.clear();
+		for (size_t label = 0; label < members.size(); label++) {
+			Expected blob;
+			blob.Area = 0;
+			blob.Left = width;
+			blob.Top = height;
+			blob.Right = -1;
+			blob.Bottom = -1;
+			double sumX = 0;
+			double sumY = 0;
+			int best[4];
+			for (int y = 0; y < height; y++) {
+				for (int x = 0; x < width; x++) {
+					if (labels[y * width + x] != (int) label) {
+						continue;
+					}
+					for (int c = 0; c < 4; c++) {
+						// Strictly better, so ties keep the first in raster order
+						if ((blob.Area == 0) or (CornerScore(c, x, y) > best[c])) {
+							best[c] = CornerScore(c, x, y);
+							blob.CornerX[c] = x;
+							blob.CornerY[c] = y;
+						}
+					}
+					blob.Area++;
+					blob.Left = std::min(blob.Left, x);
+					blob.Top = std::min(blob.Top, y);
+					blob.Right = std::max(blob.Right, x);
+					blob.Bottom = std::max(blob.Bottom, y);
+					sumX += x;
+					sumY += y;
+				}
+			}
+			blob.CenterX = sumX / blob.Area;
+			blob.CenterY = sumY / blob.Area;
+			blob.HullArea = CountHull(members[label]);
+			blobs.push_back(blob);
+		}
+	}
+
+	bool IsSame(const Blob &blob, const Expected &expected)
+	{
+		bool isSame = (blob.Area == expected.Area)
+				and (blob.Left == expected.Left) and (blob.Top == expected.Top)
+				and (blob.Right == expected.Right) and (blob.Bottom == expected.Bottom)
+				and (fabs(blob.CenterX - expected.CenterX) < 1e-6)
+				and (fabs(blob.CenterY - expected.CenterY) < 1e-6)
+				and (blob.HullArea == expected.HullArea);
+		for (int c = 0; c < 4; c++) {
+			isSame = isSame and (blob.CornerX[c] == expected.CornerX[c])
+					and (blob.CornerY[c] == expected.CornerY[c]);
+		}
+		return isSame;
+	}
+
+	void Report(const char *name, const Blob &blob, const Expected &expected)
+	{
+		fprintf(stderr, "  %s: found area %d box %d,%d-%d,%d hull %d;"
+				" flood fill has area %d box %d,%d-%d,%d hull %d\n", name,
+				blob.Area, blob.Left, blob.Top, blob.Right, blob.Bottom, blob.HullArea,
+				expected.Area, expected.Left, expected.Top, expected.Right, expected.Bottom,
+				expected.HullArea);
+	}
+
+	bool AreSame(const PackedMask &mask, const PackedMask &expected)
+	{
+		if ((mask.GetWidth() != expected.GetWidth()) or (mask.GetHeight() != expected.GetHeight())) {
+			return false;
+		}
+		size_t rowBytes = sizeof(unsigned int) * expected.GetWordsPerRow();
+		for (int y = 0; y < expected.GetHeight(); y++) {
+			if (memcmp(mask.GetRow(y), expected.GetRow(y), rowBytes) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Runs every check on one mask.
+	 */
+	void CheckMask(const char *name, const PackedMask &mask)
+	{
+		RunMask runs;
+		runs.FromPacked(mask);
+		CHECK(runs.Count() == mask.Count());
+		PackedMask unpacked;
+		unpacked.SetSize(mask.GetWidth() + 40, mask.GetHeight() + 3);	// Bigger, and dirty
+		for (int y = 0; y < unpacked.GetHeight(); y++) {
+			memset(unpacked.GetRow(y), 0xFF, sizeof(unsigned int) * unpacked.GetWordsPerRow());
+		}
+		runs.ToPacked(unpacked);
+		if (!CHECK(AreSame(unpacked, mask))) {
+			fprintf(stderr, "  %s: ToPacked\n", name);
+		}
+
+		std::vector<Expected> expected;
+		FloodFill(mask, expected);
+		BlobFinder finder;
+		BlobFinder::Options options = BlobFinder::DefaultOptions();
+		options.MinThickness = 1;
+		options.MinWidth = 0;
+		options.MinHeight = 0;
+		options.MaxWidth = 1e9;
+		options.MaxHeight = 1e9;
+		finder.SetOptions(options);
+		std::vector<Blob> blobs;
+		finder.Find(runs, blobs);
+		if (!CHECK(blobs.size() == expected.size())) {
+			fprintf(stderr, "  %s: found %d blobs, flood fill has %d\n", name,
+					(int) blobs.size(), (int) expected.size());
+			return;
+		}
+		for (size_t i = 0; i < blobs.size(); i++) {
+			if (!CHECK(IsSame(blobs[i], expected[i]))) {
+				Report(name, blobs[i], expected[i]);
+			}
+			CHECK(blobs[i].HullArea >= blobs[i].Area);
+		}
+
+		// Thin blobs dropped, the rest kept in order
+		options.MinThickness = 3;
+		finder.SetOptions(options);
+		std::vector<Blob> thick;
+		finder.Find(mask, thick);
+		size_t kept = 0;
+		for (size_t i = 0; i < expected.size(); i++) {
+			if ((expected[i].Right - expected[i].Left + 1 < 3)
+					or (expected[i].Bottom - expected[i].Top + 1 < 3)) {
+				continue;
+			}
+			if (CHECK(kept < thick.size()) and !CHECK(IsSame(thick[kept], expected[i]))) {
+				Report(name, thick[kept], expected[i]);
+			}
+			kept++;
+		}
+		CHECK(thick.size() == kept);
+	}
+
+	/**
+	 * A random mask made of runs, dense enough that blobs touch and
+	 * join in every way.
+	 */
+	void MakeRandomMask(int width, int height, PackedMask &mask)
+	{
+		mask.SetSize(width, height);
+		mask.Clear();
+		for (int y = 0; y < height; y++) {
+			int x = rand() % 4;
+			while (x < width) {
+				int length = 1 + rand() % 6;
+				for (int i = x; (i < x + length) and (i < width); i++) {
+					mask.Set(i, y, true);
+				}
+				x += length + 1 + rand() % 5;
+			}
+		}
+	}
+
+	/**
+	 * Sets a run of pixels, from start to end inclusive.
+	 */
+	void SetRun(PackedMask &mask, int y, int start, int end)
+	{
+		for (int x = start; x <= end; x++) {
+			mask.Set(x, y, true);
+		}
+	}
+}
+
+int main()
+{
+	PackedMask mask;
+
+	// Touching only at corners: one blob, a staircase; then the same
+	// steps two apart, which don't touch at all.
+	mask.SetSize(20, 6);
+	mask.Clear();
+	for (int y = 0; y < 6; y++) {
+		SetRun(mask, y, 2 + y, 3 + y);
+	}
+	CheckMask("staircase", mask);
+	mask.Clear();
+	for (int y = 0; y < 6; y++) {
+		SetRun(mask, y, 2 + 3 * y, 3 + 3 * y);
+	}
+	CheckMask("broken staircase", mask);
+
+	// Runs either side of a word boundary, touching at a corner and
+	// along a side, and runs against the right edge.
+	mask.SetSize(64, 8);
+	mask.Clear();
+	SetRun(mask, 0, 28, 31);
+	SetRun(mask, 1, 32, 35);
+	SetRun(mask, 3, 31, 31);
+	SetRun(mask, 4, 32, 32);
+	SetRun(mask, 6, 0, 31);
+	SetRun(mask, 7, 32, 63);
+	SetRun(mask, 2, 60, 63);
+	SetRun(mask, 3, 63, 63);
+	SetRun(mask, 5, 62, 63);
+	CheckMask("word boundaries", mask);
+	mask.SetSize(70, 5);
+	mask.Clear();
+	SetRun(mask, 0, 0, 69);
+	SetRun(mask, 2, 31, 32);
+	SetRun(mask, 2, 69, 69);
+	SetRun(mask, 3, 68, 68);
+	SetRun(mask, 4, 0, 0);
+	SetRun(mask, 4, 64, 69);
+	CheckMask("right edge", mask);
+
+	// A few lone pixels and an empty mask
+	mask.SetSize(1, 1);
+	mask.Clear();
+	CheckMask("empty", mask);
+	mask.Set(0, 0, true);
+	CheckMask("one pixel", mask);
+
+	srand(kSeed);
+	const int sizes[][2] = {{5, 5}, {31, 9}, {32, 12}, {33, 16}, {64, 20}, {97, 40}};
+	for (int trial = 0; trial < kTrials; trial++) {
+		for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+			MakeRandomMask(sizes[i][0], sizes[i][1], mask);
+			CheckMask("random", mask);
+		}
+	}
+
+	return Check::Finish("blobs");
+}
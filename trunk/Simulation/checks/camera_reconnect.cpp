@@ -0,0 +1,102 @@
+/**
+ * @file camera_reconnect.cpp
+ *
+ * @brief Unplugs the camera under a CameraSession and plugs it back
+ * in, and checks the session notices and sends its settings again.
+ *
+ * @details
+ * While it's unplugged, the camera's settings are put back to its
+ * own defaults, as a real one does when it reboots.  A dropout
+ * shorter than CameraSession::kReconnectTimeout must not count as a
+ * disconnect, and nothing may be sent to the camera while it stays
+ * connected.
+ */
+
+#include <vector>
+
+#include "WPILib.h"
+#include "Simulator.h"
+#include "../../Code/Tracking/camera.h"
+#include "check.h"
+
+namespace
+{
+	const int kFrameWidth = 160;
+	const int kFrameHeight = 120;
+	const double kWaitTimeout = 0.1;	// In seconds, as the vision task waits
+
+	/**
+	 * Waits for and takes pictures for a while, the way the vision
+	 * task does.
+	 *
+	 * @returns How many pictures were taken.
+	 */
+	int TakePictures(CameraSession &session, ColorImage &image, double seconds)
+	{
+		int count = 0;
+		double end = Timer::GetFPGATimestamp() + seconds;
+		while (Timer::GetFPGATimestamp() < end) {
+			if (session.WaitForFrame(kWaitTimeout) and session.Capture(&image)) {
+				count++;
+			}
+		}
+		return count;
+	}
+}
+
+int main()
+{
+	Simulator::UseVirtualClock();
+	std::vector<UINT8> frame(kFrameWidth * kFrameHeight * 3, 128);
+	Simulator::SetCameraFrame(&frame[0], kFrameWidth, kFrameHeight);
+
+	CameraSession session("10.0.0.11");
+	AxisCamera &camera = session.GetCamera();
+	RGBImage image;
+	CHECK(session.GetConfigureCount() == 1);
+	CHECK(camera.GetResolution() == AxisCamera::kResolution_640x480);
+	CHECK(camera.GetCompression() == CameraSession::kDefaultCompression);
+	CHECK(camera.GetBrightness() == CameraSession::kDefaultBrightness);
+
+	// Connected: pictures arrive and nothing more is sent.
+	UINT32 writes = camera.GetParameterWriteCount();
+	CHECK(TakePictures(session, image, 1.0) >= 25);
+	CHECK(session.IsConnected());
+	CHECK(camera.GetParameterWriteCount() == writes);
+	session.SetResolution(AxisCamera::kResolution_320x240);
+	session.SetResolution(AxisCamera::kResolution_320x240);
+	CHECK(camera.GetParameterWriteCount() == writes + 1);
+
+	// A short dropout isn't a disconnect.
+	Simulator::SetCameraConnected(false);
+	CHECK(TakePictures(session, image, CameraSession::kReconnectTimeout / 2) == 0);
+	CHECK(session.IsConnected());
+	Simulator::SetCameraConnected(true);
+	CHECK(TakePictures(session, image, 0.5) > 0);
+	CHECK(session.GetReconnectCount() == 0);
+	CHECK(session.GetConfigureCount() == 1);
+
+	// A long one is, and the camera forgets its settings meanwhile.
+	Simulator::SetCameraConnected(false);
+	camera.WriteResolution(AxisCamera::kResolution_640x480);
+	camera.WriteCompression(50);
+	camera.WriteBrightness(50);
+	CHECK(TakePictures(session, image, CameraSession::kReconnectTimeout + 0.5) == 0);
+	CHECK(!session.IsConnected());
+	CHECK(session.GetConfigureCount() == 1);
+
+	// Back again: the settings are sent once more, and only once.
+	Simulator::SetCameraConnected(true);
+	writes = camera.GetParameterWriteCount();
+	CHECK(TakePictures(session, image, 1.0) >= 25);
+	CHECK(session.IsConnected());
+	CHECK(session.GetReconnectCount() == 1);
+	CHECK(session.GetConfigureCount() == 2);
+	CHECK(camera.GetParameterWriteCount() > writes);
+	CHECK(camera.GetResolution() == AxisCamera::kResolution_320x240);
+	CHECK(camera.GetCompression() == CameraSession::kDefaultCompression);
+	CHECK(camera.GetBrightness() == CameraSession::kDefaultBrightness);
+	CHECK(image.GetWidth() == 320);
+
+	return Check::Finish("camera_reconnect");
+}
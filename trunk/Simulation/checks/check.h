@@ -0,0 +1,77 @@
+/**
+ * @file check.h
+ *
+ * @brief A few lines of support for the host checks in this
+ * directory.
+ *
+ * @details
+ * Each check is its own program, built against the simulated WPILib
+ * and the robot code, and run by `make check`.  It exits nonzero if
+ * anything it checked didn't hold:
+ *
+ *     int main()
+ *     {
+ *         CHECK(tracker.GetTrackCount() == 1);
+ *         CHECK_NEAR(heading, 90.0, 0.5);
+ *         return Check::Finish("tracker");
+ *     }
+ *
+ * Every failure is printed with its file and line, and the check
+ * carries on, so one run shows everything that's wrong.
+ */
+
+#ifndef SIM_CHECKS_CHECK_H_
+#define SIM_CHECKS_CHECK_H_
+
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace Check
+{
+	static int sFailureCount = 0;
+
+	inline bool That(bool condition, const char *text, const char *file, int line)
+	{
+		if (!condition) {
+			fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+			sFailureCount++;
+		}
+		return condition;
+	}
+
+	inline bool Near(double actual, double expected, double tolerance, const char *text, const char *file, int line)
+	{
+		if (!(fabs(actual - expected) <= tolerance)) {
+			fprintf(stderr, "%s:%d: check failed: %s is %g, expected %g (to within %g)\n",
+					file, line, text, actual, expected, tolerance);
+			sFailureCount++;
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Prints a summary and ends the program.  Background tasks and
+	 * notifiers may still be running, so the static destructors they
+	 * depend on are skipped (as in main.cpp).
+	 */
+	inline int Finish(const char *name)
+	{
+		if (sFailureCount == 0) {
+			printf("%s: ok\n", name);
+		} else {
+			printf("%s: %d checks failed\n", name, sFailureCount);
+		}
+		fflush(stdout);
+		fflush(stderr);
+		_exit((sFailureCount == 0) ? 0 : 1);
+		return 1;
+	}
+}
+
+#define CHECK(condition) Check::That((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance) \
+	Check::Near((actual), (expected), (tolerance), #actual, __FILE__, __LINE__)
+
+#endif
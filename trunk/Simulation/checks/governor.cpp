@@ -0,0 +1,188 @@
+/**
+ * @file governor.cpp
+ *
+ * @brief Feeds CameraGovernor made-up picture times and target
+ * widths, and checks the levels and frame rates it picks.
+ *
+ * @details
+ * Checks that the governor:
+ *   - steps down when the control loop overruns
+ *   - steps down when even kMinFPS won't fit in the budget
+ *   - steps up when the targets are too narrow, or there are none,
+ *     but not to a level that couldn't manage kStepUpFPS
+ *   - steps down when the targets would still be plenty wide
+ *   - keeps the frame rate between kMinFPS and kMaxFPS
+ *   - ignores pictures from before a change, whether they give
+ *     themselves away by their width or not
+ *
+ * A stand-in control loop ticks a real ControllerScheduler on the
+ * virtual clock, with one controller that can be made to overrun.
+ * Pictures arrive ten times a second; nothing is actually looked at.
+ */
+
+#include <vector>
+
+#include "WPILib.h"
+#include "Simulator.h"
+#include "../../Code/Tracking/governor.h"
+#include "check.h"
+
+namespace
+{
+	const double kLoopPeriod = 0.01;	// In seconds
+	const int kTicksPerFrame = 10;
+	const double kMaxWait = 5.0;		// In seconds, for a decision
+
+	bool sIsLoopSlow = false;
+
+	/**
+	 * Makes every tick overrun while sIsLoopSlow is set.
+	 */
+	class SlowController : public BaseController
+	{
+	public:
+		void Run()
+		{
+			if (sIsLoopSlow) {
+				Wait(1.5 * kLoopPeriod);
+			}
+		}
+	};
+
+	/**
+	 * The targets in a picture at the governor's level, given their
+	 * width in a 640-wide picture (0 for none).
+	 */
+	std::vector<TargetUtils::Target> MakeTargets(CameraGovernor &governor, double width)
+	{
+		std::vector<TargetUtils::Target> targets;
+		if (width > 0) {
+			TargetUtils::Target target;
+			target.Width = width * CameraGovernor::kLevels[governor.GetLevel()].Width / 640;
+			targets.push_back(target);
+		}
+		return targets;
+	}
+
+	/**
+	 * Runs the loop for a while, handing the governor a picture every
+	 * kTicksPerFrame ticks.
+	 *
+	 * @param[in] width The pictures' width, or 0 for whatever the
+	 * governor last asked for.
+	 */
+	void Feed(CameraGovernor &governor, ControllerScheduler &scheduler, double seconds,
+			double frameTime, double targetWidth, int width = 0)
+	{
+		int ticks = (int) (seconds / kLoopPeriod + 0.5);
+		for (int i = 1; i <= ticks; i++) {
+			scheduler.Tick();
+			scheduler.WaitForNextTick();
+			if (i % kTicksPerFrame == 0) {
+				int frameWidth = (width > 0) ? width : CameraGovernor::kLevels[governor.GetLevel()].Width;
+				governor.AddFrame(frameTime, MakeTargets(governor, targetWidth), frameWidth);
+			}
+		}
+	}
+
+	/**
+	 * Feeds pictures until the governor has judged a period of them,
+	 * which shows as its frame time becoming theirs.  Each call should
+	 * use a frame time different from the one before.
+	 *
+	 * @returns False if it never did.
+	 */
+	bool Decide(CameraGovernor &governor, ControllerScheduler &scheduler, double frameTime,
+			double targetWidth)
+	{
+		double end = Timer::GetFPGATimestamp() + kMaxWait;
+		while (Timer::GetFPGATimestamp() < end) {
+			Feed(governor, scheduler, kLoopPeriod * kTicksPerFrame, frameTime, targetWidth);
+			if (fabs(governor.GetFrameTime() - frameTime) < 1e-9) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	Simulator::UseVirtualClock();
+	CameraSession session("10.0.0.11");
+	AxisCamera &camera = session.GetCamera();
+	ControllerScheduler scheduler(kLoopPeriod);
+	scheduler.Add(new SlowController(), "SlowController");
+	scheduler.Start();
+
+	CameraGovernor governor(&session, &scheduler);
+	governor.SetBudget(0.5);
+	CHECK(governor.GetLevel() == 0);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMaxFPS);
+	CHECK(camera.GetResolution() == AxisCamera::kResolution_640x480);
+	CHECK(camera.GetCompression() == CameraGovernor::kLevels[0].Compression);
+
+	// Quick pictures and a target of a good size, but the loop overruns.
+	sIsLoopSlow = true;
+	CHECK(Decide(governor, scheduler, 0.010, 50));
+	sIsLoopSlow = false;
+	CHECK(governor.GetOverrunRate() > CameraGovernor::kMaxOverrunRate);
+	CHECK(governor.GetLevel() == 1);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMaxFPS);
+	CHECK(camera.GetCompression() == CameraGovernor::kLevels[1].Compression);
+
+	// Level 1 only differs in compression, so pictures from level 0 look
+	// the same.  Slow ones arriving just after the change mustn't count.
+	Feed(governor, scheduler, CameraGovernor::kChangeDelay - 0.1, 0.4, 20);
+	CHECK(Decide(governor, scheduler, 0.020, 20));
+	CHECK(governor.GetOverrunRate() == 0);
+
+	// A narrow target, and level 0 can manage 0.5 / (0.020 / 0.85) = 21
+	// pictures a second: step up.
+	CHECK(governor.GetLevel() == 0);
+	CHECK(governor.GetMaxFPS() == 21);
+	CHECK(camera.GetCompression() == CameraGovernor::kLevels[0].Compression);
+
+	// Pictures too slow for even kMinFPS: step down, at kMinFPS.
+	CHECK(Decide(governor, scheduler, 0.150, 50));
+	CHECK(governor.GetLevel() == 1);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMinFPS);
+
+	// No targets at all: step back up, to as many pictures a second as
+	// fit, 0.5 / (0.030 / 0.85) = 14.
+	CHECK(Decide(governor, scheduler, 0.030, 0));
+	CHECK(governor.GetLevel() == 0);
+	CHECK(governor.GetMaxFPS() == 14);
+
+	// A wide target is still plenty wide at level 1, and at level 2
+	// (320x240); at level 3 it wouldn't be.  The frame rate is clamped
+	// to kMaxFPS.
+	CHECK(Decide(governor, scheduler, 0.020, 200));
+	CHECK(governor.GetLevel() == 1);
+	CHECK(Decide(governor, scheduler, 0.017, 200));
+	CHECK(governor.GetLevel() == 2);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMaxFPS);
+	CHECK(camera.GetResolution() == AxisCamera::kResolution_320x240);
+	CHECK(Decide(governor, scheduler, 0.006, 200));
+	CHECK(governor.GetLevel() == 2);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMaxFPS);
+
+	// No targets, but level 1 would only manage
+	// 0.5 / (0.1 * 0.85 / 0.3) = 1.8 pictures a second: stay.
+	CHECK(Decide(governor, scheduler, 0.100, 0));
+	CHECK(governor.GetLevel() == 2);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMinFPS);
+
+	// Pictures of the wrong size are never counted.
+	Feed(governor, scheduler, 3 * CameraGovernor::kEvaluatePeriod, 0.050, 0, 640);
+	CHECK_NEAR(governor.GetFrameTime(), 0.100, 1e-9);
+	CHECK(governor.GetLevel() == 2);
+
+	// SetLevel clamps, and goes as fast as the camera does.
+	governor.SetLevel(CameraGovernor::kLevelCount);
+	CHECK(governor.GetLevel() == CameraGovernor::kLevelCount - 1);
+	CHECK(governor.GetMaxFPS() == CameraGovernor::kMaxFPS);
+	CHECK(camera.GetResolution() == AxisCamera::kResolution_160x120);
+
+	return Check::Finish("governor");
+}
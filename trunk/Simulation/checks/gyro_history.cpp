@@ -0,0 +1,111 @@
+/**
+ * @file gyro_history.cpp
+ *
+ * @brief Turns a simulated gyro along a known curve and checks what
+ * GyroHistory says it read at times in between its samples.
+ *
+ * @details
+ * Checks that GetAngleAt:
+ *   - has nothing to say before the first sample
+ *   - interpolates between the samples either side of a time
+ *   - gives the newest sample for a time after it
+ *   - refuses a time older than the history goes back
+ *   - still does all that once the ring has wrapped around
+ *
+ * The angle follows a curve rather than a straight line, so picking
+ * the nearest sample instead of interpolating would show.
+ */
+
+#include "WPILib.h"
+#include "Simulator.h"
+#include "../../Code/sensors.h"
+#include "check.h"
+
+namespace
+{
+	const UINT32 kGyroModule = 1;
+	const UINT32 kGyroChannel = 1;
+	const double kScriptPeriod = 0.0005;	// In seconds; a tenth of a sample
+	const double kTolerance = 0.03;		// In degrees
+
+	/**
+	 * Where the gyro points at some time, in degrees.
+	 */
+	double ScriptedAngle(double time)
+	{
+		return 10 * time * time;
+	}
+
+	void MoveGyro(void *)
+	{
+		Simulator::SetGyroAngle(kGyroModule, kGyroChannel, (float) ScriptedAngle(Simulator::GetTime()));
+	}
+
+	/**
+	 * Checks the history's angle at a time between two samples (a
+	 * quarter of the way along, from the one at sampleTime).
+	 */
+	void CheckBetweenSamples(GyroHistory &history, double sampleTime)
+	{
+		double time = sampleTime + GyroHistory::kSamplePeriod / 4;
+		float angle = 0;
+		if (CHECK(history.GetAngleAt(time, angle))) {
+			CHECK_NEAR(angle, ScriptedAngle(time), kTolerance);
+		}
+	}
+}
+
+int main()
+{
+	Simulator::UseVirtualClock();
+	Simulator::SetGyroAngle(kGyroModule, kGyroChannel, 0);
+	Simulator::AddPeriodicCallback(MoveGyro, NULL, kScriptPeriod);
+	Gyro gyro(kGyroModule, kGyroChannel);
+	GyroHistory history(&gyro);
+
+	// Nothing sampled yet.
+	float angle = -1;
+	CHECK(!history.GetAngleAt(Timer::GetFPGATimestamp(), angle));
+	CHECK(angle == -1);
+	CHECK(history.GetOldestTime() == 0);
+
+	// Half a second in, the history goes back to the first sample.  (The
+	// simulated Notifier may be a poll late with it.)
+	Simulator::Sleep(0.5);
+	double now = Timer::GetFPGATimestamp();
+	double oldest = history.GetOldestTime();
+	CHECK(oldest > 0);
+	CHECK(oldest <= 2 * GyroHistory::kSamplePeriod + 1e-6);
+	CHECK(!history.GetAngleAt(oldest - GyroHistory::kSamplePeriod / 2, angle));
+	CHECK(angle == -1);
+	CheckBetweenSamples(history, oldest);
+	CheckBetweenSamples(history, 0.25);
+	CheckBetweenSamples(history, now - 2 * GyroHistory::kSamplePeriod);
+
+	// After the newest sample, the newest sample it is.
+	float newest = 0;
+	CHECK(history.GetAngleAt(now, newest));
+	CHECK(newest >= ScriptedAngle(now - GyroHistory::kSamplePeriod) - kTolerance);
+	CHECK(newest <= ScriptedAngle(now) + kTolerance);
+	CHECK(history.GetAngleAt(now + 1.0, angle));
+	CHECK(angle == newest);
+
+	// Well past kCapacity samples, the ring has wrapped around, and
+	// the history only goes back a little less than it holds.
+	Simulator::Sleep(2.0);
+	now = Timer::GetFPGATimestamp();
+	oldest = history.GetOldestTime();
+	CHECK(now - oldest < GyroHistory::kCapacity * GyroHistory::kSamplePeriod);
+	CHECK(now - oldest > GyroHistory::kCapacity * GyroHistory::kSamplePeriod / 2);
+	angle = -1;
+	CHECK(!history.GetAngleAt(oldest - GyroHistory::kSamplePeriod / 2, angle));
+	CHECK(!history.GetAngleAt(now - 2.0, angle));
+	CHECK(angle == -1);
+	CheckBetweenSamples(history, oldest);
+	CheckBetweenSamples(history, (oldest + now) / 2);
+	CheckBetweenSamples(history, now - 2 * GyroHistory::kSamplePeriod);
+	CHECK(history.GetAngleAt(now + 1.0, angle));
+	CHECK(angle >= ScriptedAngle(now - GyroHistory::kSamplePeriod) - kTolerance);
+
+	return Check::Finish("gyro_history");
+}
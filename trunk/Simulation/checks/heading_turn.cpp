@@ -0,0 +1,238 @@
+/**
+ * @file heading_turn.cpp
+ *
+ * @brief Turns a simple model of the drivetrain with HeadingTurn, and
+ * checks how each turn ends.
+ *
+ * @details
+ * Checks that:
+ *   - a turn either way ends within kTolerance of its heading, once
+ *     it has stayed there for kSettleTime, and stops the motors
+ *   - a robot that can't turn (pushed against a wall, say) gives up
+ *     after kTimeout
+ *   - Cancel stops the motors straight away
+ *   - SetHeading moves a turn without restarting its timeout, and
+ *     does nothing once the turn is over
+ *
+ * The model turns the robot at a rate that follows the difference
+ * between the two sides' power, with a little lag and a deadband
+ * for friction.  It reads the Jaguars and sets the gyro on the
+ * virtual clock, so HeadingTurn is stepped just as a controller
+ * would step it.
+ */
+
+#include <math.h>
+
+#include "WPILib.h"
+#include "Simulator.h"
+#include "../../Code/Subsystems/turning.h"
+#include "check.h"
+
+namespace
+{
+	const UINT32 kModule = 1;
+	const UINT32 kLeftChannel = 1;
+	const UINT32 kRightChannel = 2;
+	const UINT32 kGyroChannel = 1;
+	const double kLoopPeriod = 0.01;	// In seconds, as the robot's
+	const double kModelPeriod = 0.001;	// In seconds
+
+	/**
+	 * The drivetrain: how fast and which way it's turning, and
+	 * whether something stops it turning at all.
+	 */
+	struct Drivetrain
+	{
+		static const double kFullRate = 360;	// In degrees per second, at full power
+		static const double kLag = 0.1;		// In seconds
+		static const double kDeadband = 0.08;	// Power that only overcomes friction
+
+		double Angle;		// In degrees; anticlockwise is up, as for the gyro
+		double Rate;		// In degrees per second
+		bool IsBlocked;
+
+		/**
+		 * What a side's power actually does, after friction.
+		 */
+		static double Effective(double power)
+		{
+			if (fabs(power) <= kDeadband) {
+				return 0;
+			}
+			return (power > 0) ? power - kDeadband : power + kDeadband;
+		}
+
+		void Update(double dt)
+		{
+			// RobotDrive sends the right side negated, so driving it
+			// forwards is a negative PWM.
+			double left = Effective(Simulator::GetPwm(kModule, kLeftChannel));
+			double right = Effective(-Simulator::GetPwm(kModule, kRightChannel));
+			double target = IsBlocked ? 0 : kFullRate * (right - left) / 2;
+			Rate += (target - Rate) * dt / kLag;
+			Angle += Rate * dt;
+			Simulator::SetGyroAngle(kModule, kGyroChannel, (float) Angle);
+		}
+	};
+
+	Drivetrain sDrivetrain = {0, 0, false};
+
+	void UpdateDrivetrain(void *)
+	{
+		sDrivetrain.Update(kModelPeriod);
+	}
+
+	bool AreMotorsStopped()
+	{
+		return (Simulator::GetPwm(kModule, kLeftChannel) == 0)
+				and (Simulator::GetPwm(kModule, kRightChannel) == 0);
+	}
+
+	/**
+	 * Lets the robot come to rest and stand still from here on.
+	 */
+	void Settle(bool isBlocked)
+	{
+		Simulator::Sleep(0.5);
+		sDrivetrain.IsBlocked = isBlocked;
+	}
+
+	/**
+	 * Steps a turn every loop period until it's over, or for at most
+	 * a while longer than it's allowed.
+	 *
+	 * @param[out] settledTime When the gyro last came within
+	 * tolerance of the heading, or -1 if it never did.
+	 *
+	 * @returns How the turn ended.
+	 */
+	HeadingTurn::State RunTurn(HeadingTurn &turn, Gyro &gyro, double &settledTime)
+	{
+		settledTime = -1;
+		HeadingTurn::State state = turn.GetState();
+		double end = Timer::GetFPGATimestamp() + HeadingTurn::kTimeout + 1.0;
+		while ((state == HeadingTurn::kTurning) and (Timer::GetFPGATimestamp() < end)) {
+			Simulator::Sleep(kLoopPeriod);
+			bool isWithin = fabs(turn.GetHeading() - gyro.GetAngle()) <= HeadingTurn::kTolerance;
+			if (!isWithin) {
+				settledTime = -1;
+			} else if (settledTime < 0) {
+				settledTime = Timer::GetFPGATimestamp();
+			}
+			state = turn.Step();
+		}
+		return state;
+	}
+
+	void CheckTurn(HeadingTurn &turn, Gyro &gyro, float by)
+	{
+		Settle(false);
+		float heading = gyro.GetAngle() + by;
+		turn.Start(heading);
+		CHECK(turn.IsTurning());
+		CHECK_NEAR(turn.GetError(), by, 0.01);
+
+		double settledTime = 0;
+		double start = Timer::GetFPGATimestamp();
+		CHECK(RunTurn(turn, gyro, settledTime) == HeadingTurn::kDone);
+		double now = Timer::GetFPGATimestamp();
+		CHECK(now - start < HeadingTurn::kTimeout);
+		CHECK(settledTime >= 0);
+		CHECK(now - settledTime >= HeadingTurn::kSettleTime - 1e-6);
+		CHECK_NEAR(turn.GetError(), 0, HeadingTurn::kTolerance);
+		CHECK_NEAR(gyro.GetAngle(), heading, HeadingTurn::kTolerance);
+		CHECK(turn.GetHeading() == heading);
+		CHECK(AreMotorsStopped());
+
+		// Once it's over, steps and new headings change nothing.
+		turn.SetHeading(heading + 45);
+		CHECK(turn.GetHeading() == heading);
+		CHECK(turn.Step() == HeadingTurn::kDone);
+		CHECK(AreMotorsStopped());
+	}
+
+	void CheckTimeout(HeadingTurn &turn, Gyro &gyro)
+	{
+		Settle(true);
+		double start = Timer::GetFPGATimestamp();
+		turn.Start(gyro.GetAngle() + 90);
+		double settledTime = 0;
+		CHECK(RunTurn(turn, gyro, settledTime) == HeadingTurn::kTimedOut);
+		CHECK_NEAR(Timer::GetFPGATimestamp() - start, HeadingTurn::kTimeout, 1.5 * kLoopPeriod);
+		CHECK_NEAR(turn.GetError(), 90, 0.01);
+		CHECK(AreMotorsStopped());
+	}
+
+	void CheckCancel(HeadingTurn &turn, Gyro &gyro)
+	{
+		Settle(false);
+		float start = gyro.GetAngle();
+		turn.Start(start + 90);
+		for (int i = 0; i < 10; i++) {
+			Simulator::Sleep(kLoopPeriod);
+			turn.Step();
+		}
+		CHECK(turn.IsTurning());
+		CHECK(!AreMotorsStopped());
+		CHECK(gyro.GetAngle() > start);
+
+		turn.Cancel();
+		CHECK(turn.GetState() == HeadingTurn::kCancelled);
+		CHECK(AreMotorsStopped());
+		Simulator::Sleep(kLoopPeriod);
+		CHECK(turn.Step() == HeadingTurn::kCancelled);
+		CHECK(AreMotorsStopped());
+	}
+
+	void CheckSetHeading(HeadingTurn &turn, Gyro &gyro)
+	{
+		// A newer heading partway through is where the turn ends up.
+		Settle(false);
+		float start = gyro.GetAngle();
+		turn.Start(start + 90);
+		for (int i = 0; i < 10; i++) {
+			Simulator::Sleep(kLoopPeriod);
+			turn.Step();
+		}
+		turn.SetHeading(start + 30);
+		CHECK(turn.GetHeading() == start + 30);
+		double settledTime = 0;
+		CHECK(RunTurn(turn, gyro, settledTime) == HeadingTurn::kDone);
+		CHECK_NEAR(gyro.GetAngle(), start + 30, HeadingTurn::kTolerance);
+
+		// And moving it doesn't buy the turn more time.
+		Settle(true);
+		double began = Timer::GetFPGATimestamp();
+		turn.Start(gyro.GetAngle() + 90);
+		while (Timer::GetFPGATimestamp() - began < HeadingTurn::kTimeout * 3 / 4) {
+			Simulator::Sleep(kLoopPeriod);
+			turn.Step();
+		}
+		CHECK(turn.IsTurning());
+		turn.SetHeading(turn.GetHeading() - 45);
+		CHECK(RunTurn(turn, gyro, settledTime) == HeadingTurn::kTimedOut);
+		CHECK_NEAR(Timer::GetFPGATimestamp() - began, HeadingTurn::kTimeout, 1.5 * kLoopPeriod);
+	}
+}
+
+int main()
+{
+	Simulator::UseVirtualClock();
+	Simulator::SetGyroAngle(kModule, kGyroChannel, 0);
+	Simulator::AddPeriodicCallback(UpdateDrivetrain, NULL, kModelPeriod);
+
+	RobotDrive robotDrive(kLeftChannel, kRightChannel);
+	Gyro gyro(kModule, kGyroChannel);
+	HeadingTurn turn(&robotDrive, &gyro);
+	CHECK(turn.GetState() == HeadingTurn::kIdle);
+	CHECK(turn.Step() == HeadingTurn::kIdle);
+
+	CheckTurn(turn, gyro, 90);
+	CheckTurn(turn, gyro, -45);
+	CheckTurn(turn, gyro, 5);
+	CheckTimeout(turn, gyro);
+	CheckCancel(turn, gyro);
+	CheckSetHeading(turn, gyro);
+
+	return Check::Finish("heading_turn");
+}
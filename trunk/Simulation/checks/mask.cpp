@@ -0,0 +1,231 @@
+/**
+ * @file mask.cpp
+ *
+ * @brief Thresholds random pictures with every version of the mask
+ * code and checks they all agree with Masking::ThresholdScalar.
+ *
+ * @details
+ * Checks, for both pixel layouts, that:
+ *   - Threshold into a PackedMask sets exactly the same bits,
+ *     including leaving the unused bits at the end of each row clear
+ *   - Threshold into a RunMask gives the same runs
+ *   - ThresholdSampled gives what ThresholdScalar gives on just the
+ *     sampled pixels
+ *
+ * The widths are chosen so the SIMD loops (4 and 8 pixels at a time)
+ * and the mask's 32-pixel words all leave some pixels over, the
+ * ranges reach 0 and 255 (and beyond), and the rows are padded out
+ * with pixels that would pass, so reading or writing past the end of
+ * a row shows.
+ *
+ * `make check` runs this twice: as built, and again with mask.cpp
+ * built with -mavx2 (on a processor that has it), passing the name
+ * of the version it should be using.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../../Code/Tracking/mask.h"
+#include "check.h"
+
+namespace
+{
+	const int kWidths[] = {1, 3, 7, 13, 31, 33, 45, 71, 103, 161};
+	const int kWidthCount = sizeof(kWidths) / sizeof(kWidths[0]);
+	const int kHeight = 5;
+	const int kPadding = 13;		// In bytes, past the end of each row
+	const unsigned int kSeed = 2012;
+
+	const Masking::ColorRange kRanges[] = {
+		{{0, 100, 200}, {40, 150, 255}},
+		{{243, 141, 161}, {255, 255, 255}},
+		{{0, 0, 0}, {0, 255, 255}},
+		{{255, 0, 0}, {255, 255, 255}},
+		{{-10, 60, 128}, {300, 60, 128}},		// Outside 0 to 255, and one value only
+		{{0, 0, 0}, {255, 255, 255}},			// Everything
+		{{50, 0, 0}, {49, 255, 255}},			// Nothing
+	};
+	const int kRangeCount = sizeof(kRanges) / sizeof(kRanges[0]);
+
+	/**
+	 * A random byte, mostly at or either side of the range's bounds.
+	 */
+	unsigned char MakeByte(int low, int high)
+	{
+		int value;
+		switch (rand() % 5) {
+		case 0:
+			value = low + (rand() % 3) - 1;
+			break;
+		case 1:
+			value = high + (rand() % 3) - 1;
+			break;
+		case 2:
+			value = (rand() % 2) ? 0 : 255;
+			break;
+		default:
+			value = rand() % 256;
+			break;
+		}
+		return (unsigned char) ((value < 0) ? 0 : ((value > 255) ? 255 : value));
+	}
+
+	/**
+	 * A random picture for a range, with its padding all in range
+	 * (where there's such a thing as in range).
+	 *
+	 * @returns The stride.
+	 */
+	int MakePicture(int width, int height, Masking::PixelLayout layout,
+			const Masking::ColorRange &range, std::vector<unsigned char> &pixels)
+	{
+		int bytesPerPixel = (layout == Masking::kLayoutNI) ? 4 : 3;
+		int stride = width * bytesPerPixel + kPadding;
+		pixels.resize(stride * height);
+		for (int y = 0; y < height; y++) {
+			unsigned char *row = &pixels[y * stride];
+			for (int x = 0; x < width; x++) {
+				unsigned char *p = row + x * bytesPerPixel;
+				for (int plane = 0; plane < 3; plane++) {
+					int offset = (layout == Masking::kLayoutNI) ? 2 - plane : plane;
+					p[offset] = MakeByte(range.Low[plane], range.High[plane]);
+				}
+				if (layout == Masking::kLayoutNI) {
+					p[3] = (unsigned char) (rand() % 256);
+				}
+			}
+			for (int i = width * bytesPerPixel; i < stride; i++) {
+				int offset = i % bytesPerPixel;
+				int plane = (layout == Masking::kLayoutNI) ? ((offset < 3) ? 2 - offset : 0) : offset;
+				int low = (range.Low[plane] < 0) ? 0 : range.Low[plane];
+				row[i] = (unsigned char) ((low > 255) ? 255 : low);
+			}
+		}
+		return stride;
+	}
+
+	bool AreSame(const PackedMask &mask, const PackedMask &expected)
+	{
+		if ((mask.GetWidth() != expected.GetWidth()) or (mask.GetHeight() != expected.GetHeight())) {
+			return false;
+		}
+		size_t rowBytes = sizeof(unsigned int) * expected.GetWordsPerRow();
+		for (int y = 0; y < expected.GetHeight(); y++) {
+			if (memcmp(mask.GetRow(y), expected.GetRow(y), rowBytes) != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool AreSame(const RunMask &runs, const RunMask &expected)
+	{
+		if ((runs.GetWidth() != expected.GetWidth()) or (runs.GetHeight() != expected.GetHeight())
+				or (runs.GetRunCount() != expected.GetRunCount())) {
+			return false;
+		}
+		for (int y = 0; y <= expected.GetHeight(); y++) {
+			if (runs.GetRowStart(y) != expected.GetRowStart(y)) {
+				return false;
+			}
+		}
+		for (int i = 0; i < expected.GetRunCount(); i++) {
+			if ((runs.GetRuns()[i].Start != expected.GetRuns()[i].Start)
+					or (runs.GetRuns()[i].End != expected.GetRuns()[i].End)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void Report(const char *what, Masking::PixelLayout layout, int width, int range)
+	{
+		fprintf(stderr, "  %s, %s layout, width %d, range %d\n", what,
+				(layout == Masking::kLayoutNI) ? "NI" : "packed", width, range);
+	}
+
+	/**
+	 * Copies every step'th pixel of every step'th row into a picture
+	 * of its own.
+	 */
+	int Sample(const std::vector<unsigned char> &pixels, int width, int height, int stride,
+			Masking::PixelLayout layout, int step, std::vector<unsigned char> &sampled)
+	{
+		int bytesPerPixel = (layout == Masking::kLayoutNI) ? 4 : 3;
+		int sampledWidth = (width + step - 1) / step;
+		int sampledHeight = (height + step - 1) / step;
+		int sampledStride = sampledWidth * bytesPerPixel;
+		sampled.resize(sampledStride * sampledHeight);
+		for (int y = 0; y < sampledHeight; y++) {
+			for (int x = 0; x < sampledWidth; x++) {
+				memcpy(&sampled[y * sampledStride + x * bytesPerPixel],
+						&pixels[y * step * stride + x * step * bytesPerPixel], bytesPerPixel);
+			}
+		}
+		return sampledStride;
+	}
+
+	void CheckPicture(Masking::PixelLayout layout, int width, int rangeIndex)
+	{
+		const Masking::ColorRange &range = kRanges[rangeIndex];
+		std::vector<unsigned char> pixels;
+		int stride = MakePicture(width, kHeight, layout, range, pixels);
+
+		PackedMask expected;
+		Masking::ThresholdScalar(&pixels[0], width, kHeight, stride, layout, range, expected);
+		PackedMask mask;
+		Masking::Threshold(&pixels[0], width, kHeight, stride, layout, range, mask);
+		if (!CHECK(AreSame(mask, expected))) {
+			Report("PackedMask", layout, width, rangeIndex);
+		}
+
+		RunMask expectedRuns;
+		expectedRuns.FromPacked(expected);
+		RunMask runs;
+		Masking::Threshold(&pixels[0], width, kHeight, stride, layout, range, runs);
+		if (!CHECK(AreSame(runs, expectedRuns))) {
+			Report("RunMask", layout, width, rangeIndex);
+		}
+
+		for (int step = 2; step <= 3; step++) {
+			std::vector<unsigned char> sampled;
+			int sampledStride = Sample(pixels, width, kHeight, stride, layout, step, sampled);
+			int sampledWidth = (width + step - 1) / step;
+			int sampledHeight = (kHeight + step - 1) / step;
+			Masking::ThresholdScalar(&sampled[0], sampledWidth, sampledHeight, sampledStride,
+					layout, range, expected);
+			expectedRuns.FromPacked(expected);
+			Masking::ThresholdSampled(&pixels[0], width, kHeight, stride, layout, range, step, runs);
+			if (!CHECK(AreSame(runs, expectedRuns))) {
+				Report((step == 2) ? "ThresholdSampled by 2" : "ThresholdSampled by 3",
+						layout, width, rangeIndex);
+			}
+		}
+	}
+}
+
+/**
+ * @param[in] argv[1] If given, the name GetImplementationName should
+ * give.
+ */
+int main(int argc, char **argv)
+{
+	printf("mask: using %s\n", Masking::GetImplementationName());
+	if (argc > 1) {
+		CHECK(strcmp(Masking::GetImplementationName(), argv[1]) == 0);
+	}
+
+	srand(kSeed);
+	for (int trial = 0; trial < 20; trial++) {
+		for (int i = 0; i < kWidthCount; i++) {
+			for (int range = 0; range < kRangeCount; range++) {
+				CheckPicture(Masking::kLayoutNI, kWidths[i], range);
+				CheckPicture(Masking::kLayoutPacked, kWidths[i], range);
+			}
+		}
+	}
+
+	return Check::Finish("mask");
+}
@@ -0,0 +1,88 @@
+/**
+ * @file target_finder_task.cpp
+ *
+ * @brief Runs MultithreadedTargetFinder's task on a bench frame and
+ * reads its snapshots from a stand-in control loop.
+ *
+ * @details
+ * Usage:
+ *
+ *     target_finder_task FRAME.ppm TARGET_COUNT
+ *
+ * On the virtual clock the camera sends 30 frames a second, and the
+ * loop reads a snapshot every 10 ms, as the robot's would.  Each
+ * snapshot must be a whole one (every target found, none left over
+ * from another frame), and FrameNumber and Timestamp must only ever
+ * move forward.  Once EndTask is called they must stop.
+ */
+
+#include <stdlib.h>
+
+#include "WPILib.h"
+#include "Simulator.h"
+#include "../../Code/Tracking/target.h"
+#include "../../Code/Tracking/track_silver.h"
+#include "check.h"
+
+namespace
+{
+	const double kLoopPeriod = 0.01;	// In seconds
+	const double kRunTime = 3.0;		// In seconds
+	const int kMinFrames = 30;		// Out of the 90 the camera sends in kRunTime
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s FRAME.ppm TARGET_COUNT\n", argv[0]);
+		return 2;
+	}
+	int targetCount = atoi(argv[2]);
+
+	Simulator::UseVirtualClock();
+	if (!Simulator::LoadCameraFrame(argv[1])) {
+		fprintf(stderr, "could not read camera frame %s\n", argv[1]);
+		return 2;
+	}
+
+	MultithreadedTargetFinder finder(new TargetFinder());
+	TargetUtils::TargetSnapshot first = finder.ReturnTargetData();
+	CHECK(first.FrameNumber == 0);
+	CHECK(first.Count == 0);
+
+	finder.StartTask();
+	CHECK(finder.IsRunning());
+
+	UINT32 lastFrame = 0;
+	double lastTimestamp = 0;
+	int changes = 0;
+	for (double t = 0; t < kRunTime; t += kLoopPeriod) {
+		Simulator::Sleep(kLoopPeriod);
+		TargetUtils::TargetSnapshot snapshot = finder.ReturnTargetData();
+		CHECK(snapshot.FrameNumber >= lastFrame);
+		if (snapshot.FrameNumber == lastFrame) {
+			CHECK(snapshot.Timestamp == lastTimestamp);
+			continue;
+		}
+		changes++;
+		CHECK(snapshot.Timestamp > lastTimestamp);
+		CHECK(snapshot.Timestamp <= Timer::GetFPGATimestamp());
+		CHECK(snapshot.Count == targetCount);
+		CHECK(snapshot.ImageWidth == 640);
+		lastFrame = snapshot.FrameNumber;
+		lastTimestamp = snapshot.Timestamp;
+	}
+	CHECK(lastFrame >= (UINT32) kMinFrames);
+	CHECK(changes >= kMinFrames);
+
+	// The task finishes the frame it's on, then stops publishing.
+	finder.EndTask();
+	CHECK(!finder.IsRunning());
+	Simulator::Sleep(0.5);
+	UINT32 stopped = finder.ReturnTargetData().FrameNumber;
+	Simulator::Sleep(0.5);
+	CHECK(finder.ReturnTargetData().FrameNumber == stopped);
+	CHECK(finder.ReturnTargetData().Count == targetCount);
+
+	return Check::Finish("target_finder_task");
+}
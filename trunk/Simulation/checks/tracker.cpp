@@ -0,0 +1,267 @@
+/**
+ * @file tracker.cpp
+ *
+ * @brief Feeds TargetTracker made-up snapshots of targets moving at
+ * steady speeds, and checks what it makes of them.
+ *
+ * @details
+ * Checks that:
+ *   - ConstantVelocityFilter settles on a steady rate
+ *   - each target keeps its track (and Id) while it moves, even
+ *     when two of them pass each other
+ *   - between pictures, GetTargets predicts along each target's
+ *     measured speed
+ *   - a picture already seen is ignored
+ *   - tracks are dropped once not seen for kMaxCoastTime
+ *   - a change of picture size starts every track again
+ *
+ * The tracker only goes by the snapshots' timestamps, so no clock
+ * is needed.
+ */
+
+#include "WPILib.h"
+#include "../../Code/Tracking/tracker.h"
+#include "check.h"
+
+namespace
+{
+	const double kFramePeriod = 0.1;	// In seconds
+	const int kImageWidth = 640;
+	const int kImageHeight = 480;
+
+	/**
+	 * A target moving across the picture at a steady speed.
+	 */
+	struct Mover
+	{
+		double X;		// In pixels, at time 0
+		double Y;
+		double SpeedX;		// In pixels per second
+		double Width;		// In pixels
+
+		double GetX(double time) const
+		{
+			return X + SpeedX * time;
+		}
+	};
+
+	TargetUtils::Target MakeTarget(double x, double y, double width)
+	{
+		TargetUtils::Target target;
+		double height = width * 0.75;
+		target.Width = width;
+		target.Height = height;
+		target.Rotation = 0;
+		target.Score = 100;
+		target.Middle.Set((float) x, (float) y);
+		target.TopLeft.Set((float) (x - width / 2), (float) (y - height / 2));
+		target.TopRight.Set((float) (x + width / 2), (float) (y - height / 2));
+		target.BottomRight.Set((float) (x + width / 2), (float) (y + height / 2));
+		target.BottomLeft.Set((float) (x - width / 2), (float) (y + height / 2));
+		target.DistanceFromCamera = 24 * 640 / width;
+		target.XAngleFromCamera = (x - kImageWidth / 2) * 0.1;
+		target.YAngleFromCamera = 0;
+		return target;
+	}
+
+	TargetUtils::TargetSnapshot MakeSnapshot(UINT32 frameNumber, double time, const Mover *movers, int count,
+			int imageWidth = kImageWidth)
+	{
+		TargetUtils::TargetSnapshot snapshot;
+		snapshot.FrameNumber = frameNumber;
+		snapshot.Timestamp = time;
+		snapshot.ImageWidth = imageWidth;
+		snapshot.ImageHeight = imageWidth * kImageHeight / kImageWidth;
+		snapshot.Count = count;
+		for (int i = 0; i < count; i++) {
+			double scale = (double) imageWidth / kImageWidth;
+			snapshot.Targets[i] = MakeTarget(movers[i].GetX(time) * scale, movers[i].Y * scale,
+					movers[i].Width * scale);
+		}
+		return snapshot;
+	}
+
+	/**
+	 * The tracked target nearest a point, or NULL if there's none.
+	 */
+	const TrackedTarget *FindNearest(const TrackedTarget *targets, int count, double x, double y)
+	{
+		const TrackedTarget *nearest = NULL;
+		double nearestDistance = 0;
+		for (int i = 0; i < count; i++) {
+			double dx = targets[i].Estimate.Middle.X - x;
+			double dy = targets[i].Estimate.Middle.Y - y;
+			double distance = sqrt(dx * dx + dy * dy);
+			if ((nearest == NULL) or (distance < nearestDistance)) {
+				nearest = &targets[i];
+				nearestDistance = distance;
+			}
+		}
+		return nearest;
+	}
+
+	void CheckFilter()
+	{
+		ConstantVelocityFilter filter;
+		filter.SetNoise(1.0, 10);
+		filter.Reset(10);
+		for (int i = 1; i <= 20; i++) {
+			filter.Predict(kFramePeriod);
+			filter.Correct(10 + 40 * i * kFramePeriod);
+		}
+		CHECK_NEAR(filter.GetRate(), 40, 0.5);
+		CHECK_NEAR(filter.GetValue(0), 90, 0.5);
+		CHECK_NEAR(filter.GetValue(0.5), 110, 0.5);
+		CHECK(filter.GetVariance(0.5) > filter.GetVariance(0));
+	}
+
+	void CheckTracking()
+	{
+		// Two targets at nearly the same height, passing each other at
+		// 2.5 s, and one standing still above them.
+		const Mover movers[] = {
+			{100, 290, 100, 60},
+			{600, 310, -100, 60},
+			{320, 100, 0, 50}
+		};
+		const int count = 3;
+
+		TargetTracker tracker;
+		TrackedTarget targets[TargetTracker::kMaxTracks];
+		int ids[count];
+		UINT32 frame = 0;
+		double time = 0;
+		for (int step = 0; step < 20; step++) {
+			time = 1.0 + step * kFramePeriod;
+			tracker.Update(MakeSnapshot(++frame, time, movers, count));
+			CHECK(tracker.GetTrackCount() == count);
+			int found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+			CHECK(found == count);
+			for (int i = 0; i < count; i++) {
+				const TrackedTarget *nearest = FindNearest(targets, found, movers[i].GetX(time), movers[i].Y);
+				if (!CHECK(nearest != NULL)) {
+					continue;
+				}
+				if (step == 0) {
+					ids[i] = nearest->Id;
+				} else {
+					CHECK(nearest->Id == ids[i]);
+					CHECK(nearest->Hits == step + 1);
+				}
+			}
+		}
+		CHECK(ids[0] != ids[1]);
+
+		// The last picture again changes nothing.
+		tracker.Update(MakeSnapshot(frame, time, movers, count));
+		int found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+		CHECK(found == count);
+		CHECK(targets[0].Hits == 20);
+
+		// Halfway to the next picture, each should be where its speed
+		// takes it.
+		double later = time + kFramePeriod / 2;
+		found = tracker.GetTargets(later, targets, TargetTracker::kMaxTracks);
+		CHECK(found == count);
+		for (int i = 0; i < found; i++) {
+			const Mover *mover = NULL;
+			for (int j = 0; j < count; j++) {
+				if (targets[i].Id == ids[j]) {
+					mover = &movers[j];
+				}
+			}
+			if (!CHECK(mover != NULL)) {
+				continue;
+			}
+			CHECK_NEAR(targets[i].Estimate.Middle.X, mover->GetX(later), 1.0);
+			CHECK_NEAR(targets[i].Estimate.Middle.Y, mover->Y, 1.0);
+			CHECK_NEAR(targets[i].Estimate.TopLeft.X, mover->GetX(later) - mover->Width / 2, 1.0);
+			CHECK_NEAR(targets[i].Estimate.Width, mover->Width, 1.0);
+			CHECK_NEAR(targets[i].Age, kFramePeriod / 2, 1e-9);
+		}
+
+		// Then they vanish.  Still predicted for kMaxCoastTime...
+		double lastSeen = time;
+		tracker.Update(MakeSnapshot(++frame, lastSeen + kFramePeriod, movers, 0));
+		CHECK(tracker.GetTrackCount() == count);
+		CHECK(tracker.GetTargets(lastSeen + TargetTracker::kMaxCoastTime - 0.01, targets,
+				TargetTracker::kMaxTracks) == count);
+		CHECK(tracker.GetTargets(lastSeen + TargetTracker::kMaxCoastTime + 0.01, targets,
+				TargetTracker::kMaxTracks) == 0);
+
+		// ...and dropped by the first picture after that.
+		tracker.Update(MakeSnapshot(++frame, lastSeen + TargetTracker::kMaxCoastTime + kFramePeriod, movers, 0));
+		CHECK(tracker.GetTrackCount() == 0);
+
+		// Back again, they get new tracks.
+		time = lastSeen + 1.0;
+		tracker.Update(MakeSnapshot(++frame, time, movers, count));
+		CHECK(tracker.GetTrackCount() == count);
+		found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+		for (int i = 0; i < found; i++) {
+			CHECK(targets[i].Id > ids[0]);
+			CHECK(targets[i].Id > ids[1]);
+			CHECK(targets[i].Id > ids[2]);
+			CHECK(targets[i].Hits == 1);
+		}
+	}
+
+	void CheckImageSizeChange()
+	{
+		const Mover movers[] = {
+			{200, 240, 20, 60},
+			{440, 240, 20, 60}
+		};
+		const int count = 2;
+
+		TargetTracker tracker;
+		TrackedTarget targets[TargetTracker::kMaxTracks];
+		UINT32 frame = 0;
+		double time = 0;
+		for (int step = 0; step < 5; step++) {
+			time = step * kFramePeriod;
+			tracker.Update(MakeSnapshot(++frame, time, movers, count));
+		}
+		int found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+		CHECK(found == count);
+		int lastId = 0;
+		for (int i = 0; i < found; i++) {
+			CHECK(targets[i].Hits == 5);
+			lastId = (targets[i].Id > lastId) ? targets[i].Id : lastId;
+		}
+
+		// The same targets at half the resolution: the old tracks, in
+		// the old pixels, are gone, and each target starts anew.
+		time += kFramePeriod;
+		tracker.Update(MakeSnapshot(++frame, time, movers, count, kImageWidth / 2));
+		CHECK(tracker.GetTrackCount() == count);
+		found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+		CHECK(found == count);
+		for (int i = 0; i < found; i++) {
+			CHECK(targets[i].Hits == 1);
+			CHECK(targets[i].Id > lastId);
+			CHECK(targets[i].Estimate.Middle.X < kImageWidth / 2);
+		}
+
+		// And carry on from there.
+		time += kFramePeriod;
+		tracker.Update(MakeSnapshot(++frame, time, movers, count, kImageWidth / 2));
+		found = tracker.GetTargets(time, targets, TargetTracker::kMaxTracks);
+		CHECK(found == count);
+		for (int i = 0; i < found; i++) {
+			CHECK(targets[i].Hits == 2);
+		}
+
+		// Reset forgets everything.
+		tracker.Reset();
+		CHECK(tracker.GetTrackCount() == 0);
+	}
+}
+
+int main()
+{
+	CheckFilter();
+	CheckTracking();
+	CheckImageSizeChange();
+	return Check::Finish("tracker");
+}
@@ -0,0 +1,30 @@
+/**
+ * @file AnalogChannel.h
+ *
+ * @brief Host stand-in for WPILib's AnalogChannel.
+ */
+
+#ifndef SIM_ANALOGCHANNEL_H_
+#define SIM_ANALOGCHANNEL_H_
+
+#include "vxWorks.h"
+
+class AnalogChannel
+{
+public:
+	AnalogChannel(UINT8 moduleNumber, UINT32 channel);
+	explicit AnalogChannel(UINT32 channel);
+	virtual ~AnalogChannel();
+
+	INT16 GetValue();
+	INT32 GetAverageValue();
+	float GetVoltage();
+	float GetAverageVoltage();
+	UINT32 GetChannel();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+};
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file Compressor.h
+ *
+ * @brief Host stand-in for WPILib's Compressor.
+ *
+ * @details
+ * The simulated compressor has no pressure model: it simply turns its
+ * relay on while started.
+ */
+
+#ifndef SIM_COMPRESSOR_H_
+#define SIM_COMPRESSOR_H_
+
+#include "vxWorks.h"
+#include "Relay.h"
+
+class Compressor
+{
+public:
+	Compressor(UINT8 pressureSwitchModuleNumber, UINT32 pressureSwitchChannel,
+			UINT8 compresssorRelayModuleNumber, UINT32 compressorRelayChannel);
+	Compressor(UINT32 pressureSwitchChannel, UINT32 compressorRelayChannel);
+	virtual ~Compressor();
+
+	void Start();
+	void Stop();
+	bool Enabled();
+	UINT32 GetPressureSwitchValue();
+	void SetRelayValue(Relay::Value relayValue);
+
+private:
+	UINT32 m_pressureSwitchModule;
+	UINT32 m_pressureSwitchChannel;
+	Relay m_relay;
+	bool m_enabled;
+};
+
+#endif
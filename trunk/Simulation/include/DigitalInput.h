@@ -0,0 +1,26 @@
+/**
+ * @file DigitalInput.h
+ *
+ * @brief Host stand-in for WPILib's DigitalInput.
+ */
+
+#ifndef SIM_DIGITALINPUT_H_
+#define SIM_DIGITALINPUT_H_
+
+#include "vxWorks.h"
+
+class DigitalInput
+{
+public:
+	explicit DigitalInput(UINT32 channel);
+	DigitalInput(UINT8 moduleNumber, UINT32 channel);
+	virtual ~DigitalInput();
+	UINT32 Get();
+	UINT32 GetChannel();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+};
+
+#endif
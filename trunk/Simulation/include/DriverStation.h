@@ -0,0 +1,40 @@
+/**
+ * @file DriverStation.h
+ *
+ * @brief Host stand-in for the driver station.
+ *
+ * @details
+ * The robot mode follows the simulated match timeline (see
+ * Simulator::StartMatch) and joystick values come from the
+ * Simulator stick table.
+ */
+
+#ifndef SIM_DRIVERSTATION_H_
+#define SIM_DRIVERSTATION_H_
+
+#include "vxWorks.h"
+
+class DriverStation
+{
+public:
+	static const UINT32 kJoystickPorts = 4;
+
+	static DriverStation *GetInstance();
+
+	float GetStickAxis(UINT32 stick, UINT32 axis);
+	short GetStickButtons(UINT32 stick);
+
+	bool IsEnabled();
+	bool IsDisabled();
+	bool IsAutonomous();
+	bool IsOperatorControl();
+	bool IsNewControlData();
+	bool IsFMSAttached();
+	double GetMatchTime();
+	float GetBatteryVoltage();
+
+protected:
+	DriverStation();
+};
+
+#endif
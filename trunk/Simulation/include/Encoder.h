@@ -0,0 +1,57 @@
+/**
+ * @file Encoder.h
+ *
+ * @brief Host stand-in for WPILib's quadrature Encoder.
+ *
+ * @details
+ * Counts and rates come from the Simulator encoder table, keyed by
+ * the module and channel of the A input.
+ */
+
+#ifndef SIM_ENCODER_H_
+#define SIM_ENCODER_H_
+
+#include "vxWorks.h"
+
+class Encoder
+{
+public:
+	typedef enum
+	{
+		k1X,
+		k2X,
+		k4X
+	} EncodingType;
+
+	Encoder(UINT32 aChannel, UINT32 bChannel, bool reverseDirection = false, EncodingType encodingType = k4X);
+	Encoder(UINT8 aModuleNumber, UINT32 aChannel, UINT8 bModuleNumber, UINT32 bChannel,
+			bool reverseDirection = false, EncodingType encodingType = k4X);
+	virtual ~Encoder();
+
+	void Start();
+	INT32 Get();
+	INT32 GetRaw();
+	void Reset();
+	void Stop();
+	double GetPeriod();
+	void SetMaxPeriod(double maxPeriod);
+	bool GetStopped();
+	bool GetDirection();
+	double GetDistance();
+	double GetRate();
+	void SetMinRate(double minRate);
+	void SetDistancePerPulse(double distancePerPulse);
+	void SetReverseDirection(bool reverseDirection);
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+	bool m_reverseDirection;
+	bool m_counting;
+	INT32 m_offset;
+	INT32 m_stoppedCount;
+	double m_maxPeriod;
+	double m_distancePerPulse;
+};
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file Gyro.h
+ *
+ * @brief Host stand-in for WPILib's Gyro.
+ */
+
+#ifndef SIM_GYRO_H_
+#define SIM_GYRO_H_
+
+#include "vxWorks.h"
+
+class Gyro
+{
+public:
+	explicit Gyro(UINT32 channel);
+	Gyro(UINT8 moduleNumber, UINT32 channel);
+	virtual ~Gyro();
+	virtual float GetAngle();
+	void SetSensitivity(float voltsPerDegreePerSecond);
+	virtual void Reset();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+	float m_offset;
+};
+
+#endif
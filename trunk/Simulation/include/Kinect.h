@@ -0,0 +1,37 @@
+/**
+ * @file Kinect.h
+ *
+ * @brief Host stand-in for the Kinect server connection.
+ *
+ * @details
+ * The simulated Kinect never tracks anyone.
+ */
+
+#ifndef SIM_KINECT_H_
+#define SIM_KINECT_H_
+
+#include "vxWorks.h"
+#include "Skeleton.h"
+
+class Kinect
+{
+public:
+	typedef enum
+	{
+		kNotTracked,
+		kPositionOnly,
+		kTracked
+	} SkeletonTrackingState;
+
+	static Kinect *GetInstance();
+
+	int GetNumberOfPlayers();
+	SkeletonTrackingState GetTrackingState(int skeletonIndex = 1);
+	Skeleton GetSkeleton(int skeletonIndex = 1);
+
+private:
+	Kinect();
+	Skeleton m_skeleton;
+};
+
+#endif
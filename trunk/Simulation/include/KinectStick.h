@@ -0,0 +1,33 @@
+/**
+ * @file KinectStick.h
+ *
+ * @brief Host stand-in for the Kinect "virtual joysticks".
+ */
+
+#ifndef SIM_KINECTSTICK_H_
+#define SIM_KINECTSTICK_H_
+
+#include "GenericHID.h"
+
+class KinectStick : public GenericHID
+{
+public:
+	explicit KinectStick(int id);
+
+	virtual float GetX(JoystickHand hand = kRightHand);
+	virtual float GetY(JoystickHand hand = kRightHand);
+	virtual float GetZ();
+	virtual float GetTwist();
+	virtual float GetThrottle();
+	virtual float GetRawAxis(UINT32 axis);
+
+	virtual bool GetTrigger(JoystickHand hand = kRightHand);
+	virtual bool GetTop(JoystickHand hand = kRightHand);
+	virtual bool GetBumper(JoystickHand hand = kRightHand);
+	virtual bool GetRawButton(UINT32 button);
+
+private:
+	int m_id;
+};
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file NetworkTable.h
+ *
+ * @brief Host stand-in for the 2012 NetworkTables API.
+ *
+ * @details
+ * Tables live in process memory.  There is no network: a "remote"
+ * change is simply a Put from another thread (or from the host entry
+ * point).  Change listeners are called synchronously from whichever
+ * thread made the change, after the table lock has been released.
+ */
+
+#ifndef SIM_NETWORKTABLE_H_
+#define SIM_NETWORKTABLE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "vxWorks.h"
+
+typedef enum
+{
+	kNetworkTables_Types_NONE = -1,
+	kNetworkTables_Types_STRING = 0,
+	kNetworkTables_Types_INT,
+	kNetworkTables_Types_DOUBLE,
+	kNetworkTables_Types_BOOLEAN
+} NetworkTables_Types;
+
+class NetworkTable;
+
+class NetworkTableChangeListener
+{
+public:
+	virtual ~NetworkTableChangeListener() {}
+	virtual void ValueChanged(NetworkTable *table, const char *name, NetworkTables_Types type) = 0;
+	virtual void ValueConfirmed(NetworkTable *table, const char *name, NetworkTables_Types type) = 0;
+};
+
+class NetworkTable
+{
+public:
+	static NetworkTable *GetTable(const char *tableName);
+	static NetworkTable *GetTable(std::string tableName);
+
+	std::vector<const char *> GetKeys();
+
+	void BeginTransaction();
+	void EndTransaction();
+
+	void AddChangeListener(const char *keyName, NetworkTableChangeListener *listener);
+	void AddChangeListenerAny(NetworkTableChangeListener *listener);
+	void RemoveChangeListener(const char *keyName, NetworkTableChangeListener *listener);
+	void RemoveChangeListenerAny(NetworkTableChangeListener *listener);
+
+	bool ContainsKey(const char *keyName);
+	bool ContainsKey(std::string keyName);
+
+	int GetInt(const char *keyName);
+	int GetInt(std::string keyName);
+	bool GetBoolean(const char *keyName);
+	bool GetBoolean(std::string keyName);
+	double GetDouble(const char *keyName);
+	double GetDouble(std::string keyName);
+	std::string GetString(const char *keyName);
+	std::string GetString(std::string keyName);
+	int GetString(const char *keyName, char *value, int len);
+
+	void PutInt(const char *keyName, int value);
+	void PutInt(std::string keyName, int value);
+	void PutBoolean(const char *keyName, bool value);
+	void PutBoolean(std::string keyName, bool value);
+	void PutDouble(const char *keyName, double value);
+	void PutDouble(std::string keyName, double value);
+	void PutString(const char *keyName, const char *value);
+	void PutString(std::string keyName, std::string value);
+
+private:
+	struct Entry
+	{
+		NetworkTables_Types Type;
+		std::string StringValue;
+		int IntValue;
+		double DoubleValue;
+		bool BooleanValue;
+	};
+
+	explicit NetworkTable(std::string name);
+	bool Lookup(std::string keyName, Entry &entry);
+	void Store(std::string keyName, Entry &entry);
+
+	std::string m_name;
+	std::map<std::string, Entry> m_entries;
+	std::multimap<std::string, NetworkTableChangeListener *> m_listeners;
+	std::vector<NetworkTableChangeListener *> m_anyListeners;
+	SEM_ID m_dataLock;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file Notifier.h
+ *
+ * @brief Host stand-in for WPILib's Notifier.
+ *
+ * @details
+ * On the cRIO every Notifier is serviced by one shared task.  On the
+ * host each Notifier gets its own thread, which is close enough for
+ * the low-rate housekeeping we use it for.
+ */
+
+#ifndef SIM_NOTIFIER_H_
+#define SIM_NOTIFIER_H_
+
+#include <pthread.h>
+#include "vxWorks.h"
+
+typedef void (*TimerEventHandler)(void *param);
+
+class Notifier
+{
+public:
+	Notifier(TimerEventHandler handler, void *param = NULL);
+	virtual ~Notifier();
+	void StartSingle(double delay);
+	void StartPeriodic(double period);
+	void Stop();
+
+private:
+	static void *ThreadEntry(void *);
+	void Run();
+
+	TimerEventHandler m_handler;
+	void *m_param;
+	double m_period;
+	double m_expirationTime;
+	bool m_periodic;
+	volatile bool m_queued;
+	volatile bool m_destroying;
+	bool m_threadStarted;
+	pthread_t m_thread;
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condition;
+};
+
+#endif
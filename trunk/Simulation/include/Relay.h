@@ -0,0 +1,42 @@
+/**
+ * @file Relay.h
+ *
+ * @brief Host stand-in for WPILib's Relay.
+ */
+
+#ifndef SIM_RELAY_H_
+#define SIM_RELAY_H_
+
+#include "vxWorks.h"
+
+class Relay
+{
+public:
+	typedef enum
+	{
+		kOff,
+		kOn,
+		kForward,
+		kReverse
+	} Value;
+	typedef enum
+	{
+		kBothDirections,
+		kForwardOnly,
+		kReverseOnly
+	} Direction;
+
+	Relay(UINT32 channel, Direction direction = kBothDirections);
+	Relay(UINT8 moduleNumber, UINT32 channel, Direction direction = kBothDirections);
+	virtual ~Relay();
+
+	void Set(Value value);
+	Value Get();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+	Direction m_direction;
+};
+
+#endif
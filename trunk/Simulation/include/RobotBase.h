@@ -0,0 +1,50 @@
+/**
+ * @file RobotBase.h
+ *
+ * @brief Host stand-in for WPILib's RobotBase.
+ */
+
+#ifndef SIM_ROBOTBASE_H_
+#define SIM_ROBOTBASE_H_
+
+#include "vxWorks.h"
+#include "Watchdog.h"
+#include "DriverStation.h"
+
+class RobotBase;
+
+/**
+ * On the cRIO this macro registers a factory that the FRC startup
+ * code calls; on the host the factory is called by main().
+ */
+#define START_ROBOT_CLASS(_ClassName_) \
+	RobotBase *FRC_userClassFactory() \
+	{ \
+		return new _ClassName_(); \
+	}
+
+RobotBase *FRC_userClassFactory();
+
+class RobotBase
+{
+public:
+	virtual ~RobotBase();
+
+	bool IsEnabled();
+	bool IsDisabled();
+	bool IsAutonomous();
+	bool IsOperatorControl();
+	bool IsSystemActive();
+	bool IsNewDataAvailable();
+	Watchdog &GetWatchdog();
+
+	virtual void StartCompetition() = 0;
+
+protected:
+	RobotBase();
+
+	Watchdog m_watchdog;
+	DriverStation *m_ds;
+};
+
+#endif
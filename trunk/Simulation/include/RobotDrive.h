@@ -0,0 +1,66 @@
+/**
+ * @file RobotDrive.h
+ *
+ * @brief Host stand-in for WPILib's RobotDrive.
+ *
+ * @details
+ * The drive math (TankDrive, ArcadeDrive, Drive) follows WPILib so
+ * the simulated motor outputs match what the cRIO would produce.
+ */
+
+#ifndef SIM_ROBOTDRIVE_H_
+#define SIM_ROBOTDRIVE_H_
+
+#include "vxWorks.h"
+#include "SpeedController.h"
+#include "GenericHID.h"
+
+class RobotDrive
+{
+public:
+	typedef enum
+	{
+		kFrontLeftMotor = 0,
+		kFrontRightMotor = 1,
+		kRearLeftMotor = 2,
+		kRearRightMotor = 3
+	} MotorType;
+
+	RobotDrive(UINT32 leftMotorChannel, UINT32 rightMotorChannel);
+	RobotDrive(UINT32 frontLeftMotorChannel, UINT32 rearLeftMotorChannel,
+			UINT32 frontRightMotorChannel, UINT32 rearRightMotorChannel);
+	RobotDrive(SpeedController *leftMotor, SpeedController *rightMotor);
+	RobotDrive(SpeedController *frontLeftMotor, SpeedController *rearLeftMotor,
+			SpeedController *frontRightMotor, SpeedController *rearRightMotor);
+	virtual ~RobotDrive();
+
+	void Drive(float outputMagnitude, float curve);
+	void TankDrive(GenericHID *leftStick, GenericHID *rightStick);
+	void TankDrive(float leftValue, float rightValue, bool squaredInputs = true);
+	void ArcadeDrive(GenericHID *stick, bool squaredInputs = true);
+	void ArcadeDrive(float moveValue, float rotateValue, bool squaredInputs = true);
+	virtual void SetLeftRightMotorOutputs(float leftOutput, float rightOutput);
+	void SetInvertedMotor(MotorType motor, bool isInverted);
+	void SetSensitivity(float sensitivity);
+	void SetMaxOutput(double maxOutput);
+	void StopMotor();
+	void SetSafetyEnabled(bool enabled);
+	void SetExpiration(float timeout);
+
+protected:
+	void InitRobotDrive();
+	float Limit(float num);
+
+	static const INT32 kMaxNumberOfMotors = 4;
+
+	INT32 m_invertedMotors[kMaxNumberOfMotors];
+	float m_sensitivity;
+	double m_maxOutput;
+	bool m_deleteSpeedControllers;
+	SpeedController *m_frontLeftMotor;
+	SpeedController *m_frontRightMotor;
+	SpeedController *m_rearLeftMotor;
+	SpeedController *m_rearRightMotor;
+};
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file SimpleRobot.h
+ *
+ * @brief Host stand-in for WPILib's SimpleRobot.
+ */
+
+#ifndef SIM_SIMPLEROBOT_H_
+#define SIM_SIMPLEROBOT_H_
+
+#include "RobotBase.h"
+
+class SimpleRobot : public RobotBase
+{
+public:
+	SimpleRobot();
+	virtual ~SimpleRobot();
+	virtual void RobotInit();
+	virtual void Disabled();
+	virtual void Autonomous();
+	virtual void OperatorControl();
+	virtual void RobotMain();
+	void StartCompetition();
+
+private:
+	bool m_robotMainOverridden;
+};
+
+#endif
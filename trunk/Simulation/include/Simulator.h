@@ -0,0 +1,99 @@
+/**
+ * @file Simulator.h
+ *
+ * @brief Host-only hooks for driving the simulated WPILib.
+ *
+ * @details
+ * Nothing in here exists on the cRIO, so robot code (anything under
+ * /Code) must never include this file.  It is used by the host
+ * entry point and by anything that wants to poke at the simulated
+ * hardware -- for example, to press a joystick button or to read back
+ * what a Jaguar was told to do.
+ *
+ * Hardware is addressed the same way the robot code addresses it:
+ * by module number and channel.
+ *
+ * Time normally follows the wall clock.  With UseVirtualClock(),
+ * simulator time only moves forward when every simulated thread is
+ * asleep, and then jumps straight to the next wake-up -- a match runs
+ * as fast as the robot code can execute, and the same inputs always
+ * produce the same run.
+ */
+
+#ifndef SIM_SIMULATOR_H_
+#define SIM_SIMULATOR_H_
+
+#include "vxWorks.h"
+
+namespace Simulator
+{
+	static const UINT32 kNumModules = 3;
+	static const UINT32 kNumChannels = 17;
+	static const UINT32 kNumSticks = 5;
+	static const UINT32 kNumStickAxes = 7;
+	static const UINT32 kNumStickButtons = 16;
+
+	// Time
+	double GetTime();
+	void Sleep(double);
+
+	// Virtual clock (see Simulator.cpp).  Call UseVirtualClock()
+	// before any other thread is started.
+	void UseVirtualClock();
+	bool IsVirtualClock();
+	void AddThread();
+	void RemoveThread();
+	void BeginBlocking();
+	void EndBlocking();
+
+	// Host callbacks, called every period seconds of simulator time.
+	// They run on a simulator thread and must not sleep.
+	typedef void (*PeriodicCallback)(void *);
+	void AddPeriodicCallback(PeriodicCallback, void *, double);
+
+	// Match timeline (seconds from the start of the match)
+	void StartMatch(double, double);
+	double GetMatchTime();
+	bool IsMatchOver();
+	bool IsAutonomousPeriod();
+	bool IsTeleopPeriod();
+
+	// Driver station
+	void SetStickAxis(UINT32, UINT32, float);
+	float GetStickAxis(UINT32, UINT32);
+	void SetStickButton(UINT32, UINT32, bool);
+	UINT16 GetStickButtons(UINT32);
+
+	// Outputs written by the robot
+	void SetPwm(UINT32, UINT32, float);
+	float GetPwm(UINT32, UINT32);
+	void SetSolenoid(UINT32, UINT32, bool);
+	bool GetSolenoid(UINT32, UINT32);
+	void SetRelay(UINT32, UINT32, INT32);
+	INT32 GetRelay(UINT32, UINT32);
+
+	// Inputs read by the robot
+	void SetDigitalInput(UINT32, UINT32, bool);
+	bool GetDigitalInput(UINT32, UINT32);
+	void SetAnalogValue(UINT32, UINT32, INT32);
+	INT32 GetAnalogValue(UINT32, UINT32);
+	void SetGyroAngle(UINT32, UINT32, float);
+	float GetGyroAngle(UINT32, UINT32);
+	void SetEncoder(UINT32, UINT32, INT32, double);
+	INT32 GetEncoderCount(UINT32, UINT32);
+	double GetEncoderRate(UINT32, UINT32);
+
+	// Match scripts (see MatchScript.cpp for the format)
+	bool LoadMatchScript(const char *);
+	int GetScriptFailureCount();
+
+	// Camera (frames are 24-bit RGB, row-major)
+	void SetCameraFrame(const UINT8 *, int, int);
+	bool LoadCameraFrame(const char *);
+	UINT32 GetCameraFrameNumber();
+	bool GetCameraFrame(UINT8 *, int, int);
+	void GetCameraFrameSize(int &, int &);
+	void SetCameraConnected(bool);
+}
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file Skeleton.h
+ *
+ * @brief Host stand-in for the Kinect skeleton data.
+ */
+
+#ifndef SIM_SKELETON_H_
+#define SIM_SKELETON_H_
+
+class Skeleton
+{
+public:
+	typedef enum
+	{
+		kNonTracked,
+		kInferred,
+		kTracked
+	} JointTrackingState;
+
+	typedef struct
+	{
+		float x;
+		float y;
+		float z;
+		JointTrackingState trackingState;
+	} Joint;
+
+	typedef enum
+	{
+		HipCenter = 0,
+		Spine,
+		ShoulderCenter,
+		Head,
+		ShoulderLeft,
+		ElbowLeft,
+		WristLeft,
+		HandLeft,
+		ShoulderRight,
+		ElbowRight,
+		WristRight,
+		HandRight,
+		HipLeft,
+		KneeLeft,
+		AnkleLeft,
+		FootLeft,
+		HipRight,
+		KneeRight,
+		AnkleRight,
+		FootRight,
+		JointCount
+	} JointTypes;
+
+	Skeleton();
+
+	Joint GetHandRight() { return m_joints[HandRight]; }
+	Joint GetHandLeft() { return m_joints[HandLeft]; }
+	Joint GetWristRight() { return m_joints[WristRight]; }
+	Joint GetWristLeft() { return m_joints[WristLeft]; }
+	Joint GetElbowLeft() { return m_joints[ElbowLeft]; }
+	Joint GetElbowRight() { return m_joints[ElbowRight]; }
+	Joint GetShoulderLeft() { return m_joints[ShoulderLeft]; }
+	Joint GetShoulderRight() { return m_joints[ShoulderRight]; }
+	Joint GetShoulderCenter() { return m_joints[ShoulderCenter]; }
+	Joint GetHead() { return m_joints[Head]; }
+	Joint GetSpine() { return m_joints[Spine]; }
+	Joint GetHipCenter() { return m_joints[HipCenter]; }
+	Joint GetHipRight() { return m_joints[HipRight]; }
+	Joint GetHipLeft() { return m_joints[HipLeft]; }
+	Joint GetKneeLeft() { return m_joints[KneeLeft]; }
+	Joint GetKneeRight() { return m_joints[KneeRight]; }
+	Joint GetAnkleLeft() { return m_joints[AnkleLeft]; }
+	Joint GetAnkleRight() { return m_joints[AnkleRight]; }
+	Joint GetFootLeft() { return m_joints[FootLeft]; }
+	Joint GetFootRight() { return m_joints[FootRight]; }
+	Joint GetJointValue(JointTypes index) { return m_joints[index]; }
+
+private:
+	Joint m_joints[JointCount];
+};
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file SmartDashboard.h
+ *
+ * @brief Host stand-in for the 2012 SmartDashboard.
+ *
+ * @details
+ * Every value, including the deprecated Log() calls, is stored in the
+ * "SmartDashboard" NetworkTable so the host can read it back (and
+ * listeners fire the same way they do on the robot).
+ */
+
+#ifndef SIM_SMARTDASHBOARD_H_
+#define SIM_SMARTDASHBOARD_H_
+
+#include <string>
+#include "vxWorks.h"
+
+class NetworkTable;
+
+class SmartDashboard
+{
+public:
+	static SmartDashboard *GetInstance();
+	static NetworkTable *GetTable();
+
+	static void PutBoolean(const char *keyName, bool value);
+	static bool GetBoolean(const char *keyName);
+	static void PutInt(const char *keyName, int value);
+	static int GetInt(const char *keyName);
+	static void PutDouble(const char *keyName, double value);
+	static double GetDouble(const char *keyName);
+	static void PutString(const char *keyName, const char *value);
+	static void PutString(std::string keyName, std::string value);
+	static std::string GetString(const char *keyName);
+	static std::string GetString(std::string keyName);
+	static int GetString(const char *keyName, char *value, int len);
+
+	static void Log(bool value, const char *name);
+	static void Log(char value, const char *name);
+	static void Log(UINT8 value, const char *name);
+	static void Log(INT16 value, const char *name);
+	static void Log(UINT16 value, const char *name);
+	static void Log(INT32 value, const char *name);
+	static void Log(UINT32 value, const char *name);
+	static void Log(float value, const char *name);
+	static void Log(double value, const char *name);
+	static void Log(const char *value, const char *name);
+
+private:
+	SmartDashboard();
+};
+
+#endif
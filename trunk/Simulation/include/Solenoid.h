@@ -0,0 +1,26 @@
+/**
+ * @file Solenoid.h
+ *
+ * @brief Host stand-in for WPILib's Solenoid.
+ */
+
+#ifndef SIM_SOLENOID_H_
+#define SIM_SOLENOID_H_
+
+#include "vxWorks.h"
+
+class Solenoid
+{
+public:
+	explicit Solenoid(UINT32 channel);
+	Solenoid(UINT8 moduleNumber, UINT32 channel);
+	virtual ~Solenoid();
+	virtual void Set(bool on);
+	virtual bool Get();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+};
+
+#endif
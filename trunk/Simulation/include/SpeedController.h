@@ -0,0 +1,73 @@
+/**
+ * @file SpeedController.h
+ *
+ * @brief Host stand-in for WPILib's SpeedController interface.
+ */
+
+#ifndef SIM_SPEEDCONTROLLER_H_
+#define SIM_SPEEDCONTROLLER_H_
+
+#include "vxWorks.h"
+
+class SpeedController
+{
+public:
+	virtual ~SpeedController() {}
+	virtual void Set(float speed, UINT8 syncGroup = 0) = 0;
+	virtual float Get() = 0;
+	virtual void Disable() = 0;
+};
+
+/**
+ * @brief A speed controller driven by a PWM channel.  The value
+ * written is stored in the Simulator's PWM table.
+ */
+class PWMSpeedController : public SpeedController
+{
+public:
+	virtual ~PWMSpeedController();
+	virtual void Set(float speed, UINT8 syncGroup = 0);
+	virtual float Get();
+	virtual void Disable();
+	UINT32 GetModuleNumber();
+	UINT32 GetChannel();
+
+protected:
+	PWMSpeedController(UINT32 moduleNumber, UINT32 channel);
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+};
+
+class Jaguar : public PWMSpeedController
+{
+public:
+	explicit Jaguar(UINT32 channel);
+	Jaguar(UINT8 moduleNumber, UINT32 channel);
+};
+
+class Victor : public PWMSpeedController
+{
+public:
+	explicit Victor(UINT32 channel);
+	Victor(UINT8 moduleNumber, UINT32 channel);
+};
+
+class Servo
+{
+public:
+	explicit Servo(UINT32 channel);
+	Servo(UINT8 moduleNumber, UINT32 channel);
+	virtual ~Servo();
+	void Set(float value);
+	float Get();
+	void SetAngle(float angle);
+	float GetAngle();
+
+private:
+	UINT32 m_moduleNumber;
+	UINT32 m_channel;
+};
+
+#endif
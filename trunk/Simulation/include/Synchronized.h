@@ -0,0 +1,27 @@
+/**
+ * @file Synchronized.h
+ *
+ * @brief Host stand-in for WPILib's scoped semaphore lock.
+ */
+
+#ifndef SIM_SYNCHRONIZED_H_
+#define SIM_SYNCHRONIZED_H_
+
+#include "vxWorks.h"
+
+#define CRITICAL_REGION(s) { Synchronized _sync(s);
+#define END_REGION }
+
+/**
+ * @brief Takes a semaphore for the lifetime of the object.
+ */
+class Synchronized
+{
+public:
+	explicit Synchronized(SEM_ID);
+	virtual ~Synchronized();
+private:
+	SEM_ID m_semaphore;
+};
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file Task.h
+ *
+ * @brief Host stand-in for WPILib's wrapper around VxWorks tasks.
+ *
+ * @details
+ * Each task runs on its own pthread.  Stopping a task is cooperative:
+ * Stop() makes Verify() return false and then waits for the task
+ * function to return, so long-running task loops must check Verify().
+ */
+
+#ifndef SIM_TASK_H_
+#define SIM_TASK_H_
+
+#include <pthread.h>
+#include "vxWorks.h"
+
+class Task
+{
+public:
+	static const UINT32 kDefaultPriority = 101;
+	static const INT32 kInvalidTaskID = -1;
+
+	Task(const char *name, FUNCPTR function, INT32 priority = kDefaultPriority, UINT32 stackSize = 20000);
+	virtual ~Task();
+
+	bool Start(UINT32 arg0 = 0, UINT32 arg1 = 0, UINT32 arg2 = 0, UINT32 arg3 = 0, UINT32 arg4 = 0,
+			UINT32 arg5 = 0, UINT32 arg6 = 0, UINT32 arg7 = 0, UINT32 arg8 = 0, UINT32 arg9 = 0);
+	bool Restart();
+	bool Stop();
+
+	bool IsReady();
+	bool IsSuspended();
+
+	bool Suspend();
+	bool Resume();
+
+	bool Verify();
+
+	INT32 GetPriority();
+	bool SetPriority(INT32 priority);
+	const char *GetName();
+	INT32 GetID();
+
+private:
+	static void *ThreadEntry(void *);
+
+	FUNCPTR m_function;
+	char *m_taskName;
+	INT32 m_priority;
+	UINT32 m_args[10];
+	pthread_t m_thread;
+	INT32 m_taskID;
+	volatile bool m_running;
+	volatile bool m_stopRequested;
+};
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file Timer.h
+ *
+ * @brief Host stand-in for WPILib's timing functions.
+ *
+ * @details
+ * All time on the host comes from Simulator::GetTime(), so the same
+ * robot code can run against the wall clock or a virtual one.
+ */
+
+#ifndef SIM_TIMER_H_
+#define SIM_TIMER_H_
+
+#include "vxWorks.h"
+
+void Wait(double seconds);
+double GetClock();
+double GetTime();
+
+/**
+ * @brief A stopwatch, in seconds.
+ */
+class Timer
+{
+public:
+	Timer();
+	virtual ~Timer();
+	double Get();
+	void Reset();
+	void Start();
+	void Stop();
+	bool HasPeriodPassed(double period);
+
+	static double GetFPGATimestamp();
+	static double GetPPCTimestamp();
+
+private:
+	double m_startTime;
+	double m_accumulatedTime;
+	bool m_running;
+};
+
+#endif
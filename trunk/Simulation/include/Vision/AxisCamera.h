@@ -0,0 +1,96 @@
+/**
+ * @file AxisCamera.h
+ *
+ * @brief Host stand-in for the Axis 206 camera.
+ *
+ * @details
+ * The simulated camera serves whatever was last handed to
+ * Simulator::SetCameraFrame, scaled to the configured resolution.
+ * Until a frame has been set, GetImage() fails and leaves the image
+ * empty, just like a camera that hasn't connected yet.  A new frame
+ * "arrives" every 1/MaxFPS seconds of simulator time (or whenever a
+ * new frame is set).
+ */
+
+#ifndef SIM_AXISCAMERA_H_
+#define SIM_AXISCAMERA_H_
+
+#include "vxWorks.h"
+#include "nivision.h"
+#include "ColorImage.h"
+#include "HSLImage.h"
+
+class Notifier;
+
+class AxisCameraParams
+{
+public:
+	typedef enum
+	{
+		kWhiteBalance_Automatic,
+		kWhiteBalance_Hold,
+		kWhiteBalance_FixedOutdoor1,
+		kWhiteBalance_FixedOutdoor2,
+		kWhiteBalance_FixedIndoor,
+		kWhiteBalance_FixedFlourescent1,
+		kWhiteBalance_FixedFlourescent2
+	} WhiteBalance_t;
+	typedef enum
+	{
+		kResolution_640x480,
+		kResolution_640x360,
+		kResolution_320x240,
+		kResolution_160x120
+	} Resolution_t;
+
+	void WriteBrightness(int brightness);
+	int GetBrightness();
+	void WriteWhiteBalance(WhiteBalance_t whiteBalance);
+	WhiteBalance_t GetWhiteBalance();
+	void WriteResolution(Resolution_t resolution);
+	Resolution_t GetResolution();
+	void WriteCompression(int compression);
+	int GetCompression();
+	void WriteMaxFPS(int maxFPS);
+	int GetMaxFPS();
+
+	UINT32 GetParameterWriteCount();
+
+protected:
+	AxisCameraParams();
+	virtual ~AxisCameraParams();
+
+	int m_brightness;
+	WhiteBalance_t m_whiteBalance;
+	Resolution_t m_resolution;
+	int m_compression;
+	int m_maxFPS;
+	UINT32 m_parameterWriteCount;
+};
+
+class AxisCamera : public AxisCameraParams
+{
+public:
+	static AxisCamera &GetInstance(const char *cameraIP = NULL);
+	static void DeleteInstance();
+
+	bool IsFreshImage();
+	SEM_ID GetNewImageSem();
+
+	int GetImage(Image *imaqImage);
+	int GetImage(ColorImage *image);
+	HSLImage *GetImage();
+
+private:
+	AxisCamera();
+	virtual ~AxisCamera();
+	int GetFrameNumber();
+	static void CheckForNewFrame(void *camera);
+
+	int m_lastFrameNumber;
+	int m_notifiedFrameNumber;
+	SEM_ID m_newImageSem;
+	Notifier *m_frameNotifier;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file BinaryImage.h
+ *
+ * @brief Host stand-in for WPILib's binary (0/1) image.
+ */
+
+#ifndef SIM_BINARYIMAGE_H_
+#define SIM_BINARYIMAGE_H_
+
+#include <vector>
+#include "MonoImage.h"
+
+typedef struct ParticleAnalysisReport_struct
+{
+	int imageHeight;
+	int imageWidth;
+	double imageTimestamp;
+	int particleIndex;
+	int center_mass_x;
+	int center_mass_y;
+	double center_mass_x_normalized;
+	double center_mass_y_normalized;
+	double particleArea;
+	Rect boundingRect;
+	double particleToImagePercent;
+	double particleQuality;
+} ParticleAnalysisReport;
+
+class BinaryImage : public MonoImage
+{
+public:
+	BinaryImage();
+	virtual ~BinaryImage();
+	int GetNumberParticles();
+	ParticleAnalysisReport GetParticleAnalysisReport(int particleNumber);
+	void GetParticleAnalysisReport(int particleNumber, ParticleAnalysisReport *par);
+	std::vector<ParticleAnalysisReport> *GetOrderedParticleAnalysisReports();
+	BinaryImage *RemoveSmallObjects(bool connectivity8, int erosions);
+	BinaryImage *RemoveLargeObjects(bool connectivity8, int erosions);
+	BinaryImage *ConvexHull(bool connectivity8);
+
+private:
+	double ParticleMeasurement(int particleNumber, MeasurementType whatToMeasure);
+};
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file HSLImage.h
+ *
+ * @brief Host stand-in for WPILib's HSL image.
+ *
+ * @details
+ * The simulated NI Vision keeps every color image as packed RGB;
+ * the image type only decides which threshold modes are "native".
+ */
+
+#ifndef SIM_HSLIMAGE_H_
+#define SIM_HSLIMAGE_H_
+
+#include "ColorImage.h"
+
+class HSLImage : public ColorImage
+{
+public:
+	HSLImage();
+	explicit HSLImage(const char *fileName);
+	virtual ~HSLImage();
+};
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file ImageBase.h
+ *
+ * @brief Host stand-in for WPILib's image wrapper.
+ */
+
+#ifndef SIM_IMAGEBASE_H_
+#define SIM_IMAGEBASE_H_
+
+#include "nivision.h"
+
+class ImageBase
+{
+public:
+	explicit ImageBase(ImageType type);
+	virtual ~ImageBase();
+	virtual void Write(const char *fileName);
+	int GetHeight();
+	int GetWidth();
+	Image *GetImaqImage();
+
+protected:
+	Image *m_imaqImage;
+};
+
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file MonoImage.h
+ *
+ * @brief Host stand-in for WPILib's 8-bit grayscale image.
+ */
+
+#ifndef SIM_MONOIMAGE_H_
+#define SIM_MONOIMAGE_H_
+
+#include "ImageBase.h"
+
+class MonoImage : public ImageBase
+{
+public:
+	MonoImage();
+	virtual ~MonoImage();
+};
+
+#endif
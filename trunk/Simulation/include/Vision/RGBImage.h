@@ -0,0 +1,20 @@
+/**
+ * @file RGBImage.h
+ *
+ * @brief Host stand-in for WPILib's RGB image.
+ */
+
+#ifndef SIM_RGBIMAGE_H_
+#define SIM_RGBIMAGE_H_
+
+#include "ColorImage.h"
+
+class RGBImage : public ColorImage
+{
+public:
+	RGBImage();
+	explicit RGBImage(const char *fileName);
+	virtual ~RGBImage();
+};
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file Threshold.h
+ *
+ * @brief Host stand-in for WPILib's color threshold description.
+ */
+
+#ifndef SIM_THRESHOLD_H_
+#define SIM_THRESHOLD_H_
+
+class Threshold
+{
+public:
+	int plane1Low;
+	int plane1High;
+	int plane2Low;
+	int plane2High;
+	int plane3Low;
+	int plane3High;
+
+	Threshold(int new_plane1Low, int new_plane1High, int new_plane2Low,
+			int new_plane2High, int new_plane3Low, int new_plane3High);
+};
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file WPILib.h
+ *
+ * @brief Host stand-in for the WPILib umbrella header.
+ *
+ * @details
+ * Pulls in the simulated classes in the same way the real header
+ * pulls in the cRIO ones, including the standard library pieces (and
+ * the `using namespace std`) that our code has always relied on
+ * picking up from here.
+ */
+
+#ifndef SIM_WPILIB_H_
+#define SIM_WPILIB_H_
+
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "vxWorks.h"
+#include "utility.h"
+#include "Synchronized.h"
+#include "Task.h"
+#include "Timer.h"
+#include "Notifier.h"
+#include "Watchdog.h"
+#include "DriverStation.h"
+#include "RobotBase.h"
+#include "SimpleRobot.h"
+#include "SpeedController.h"
+#include "RobotDrive.h"
+#include "GenericHID.h"
+#include "Joystick.h"
+#include "Encoder.h"
+#include "Gyro.h"
+#include "DigitalInput.h"
+#include "AnalogChannel.h"
+#include "Solenoid.h"
+#include "Relay.h"
+#include "Compressor.h"
+#include "Skeleton.h"
+#include "Kinect.h"
+#include "KinectStick.h"
+#include "SmartDashboard.h"
+#include "NetworkTables/NetworkTable.h"
+#include "nivision.h"
+#include "Vision/Threshold.h"
+#include "Vision/ImageBase.h"
+#include "Vision/MonoImage.h"
+#include "Vision/BinaryImage.h"
+#include "Vision/ColorImage.h"
+#include "Vision/HSLImage.h"
+#include "Vision/RGBImage.h"
+#include "Vision/AxisCamera.h"
+
+using namespace std;
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * @file Watchdog.h
+ *
+ * @brief Host stand-in for the user watchdog.
+ *
+ * @details
+ * The simulated watchdog never disables anything, but it does count
+ * how many times it would have starved so a run can be checked for
+ * loops that forget to feed it.
+ */
+
+#ifndef SIM_WATCHDOG_H_
+#define SIM_WATCHDOG_H_
+
+#include "vxWorks.h"
+
+class Watchdog
+{
+public:
+	static const double kDefaultWatchdogExpiration = 0.5;
+
+	Watchdog();
+	virtual ~Watchdog();
+	bool Feed();
+	void Kill();
+	double GetTimer();
+	double GetExpiration();
+	void SetExpiration(double expiration);
+	bool GetEnabled();
+	void SetEnabled(bool enabled);
+	bool IsAlive();
+	bool IsSystemActive();
+
+	UINT32 GetStarvedCount();
+
+private:
+	double m_expiration;
+	double m_lastFed;
+	bool m_enabled;
+	UINT32 m_starvedCount;
+};
+
+#endif
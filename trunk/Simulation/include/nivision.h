@@ -0,0 +1,235 @@
+/**
+ * @file nivision.h
+ *
+ * @brief Host stand-in for the subset of NI Vision used by WPILib and
+ * by our tracking code.
+ *
+ * @details
+ * The simulated functions are plain, unoptimized C++.  They are meant
+ * to behave close enough to NI Vision that the tracking code can run
+ * end-to-end on the host -- not to reproduce NI's results exactly.
+ * In particular imaqDetectRectangles() fits one rectangle per particle
+ * instead of doing real curve extraction and shape matching.
+ */
+
+#ifndef SIM_NIVISION_H_
+#define SIM_NIVISION_H_
+
+#include <stddef.h>
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+typedef struct Image_struct Image;
+typedef struct ROI_struct ROI;
+
+typedef enum ImageType_enum
+{
+	IMAQ_IMAGE_U8 = 0,
+	IMAQ_IMAGE_I16 = 1,
+	IMAQ_IMAGE_SGL = 2,
+	IMAQ_IMAGE_COMPLEX = 3,
+	IMAQ_IMAGE_RGB = 4,
+	IMAQ_IMAGE_HSL = 5,
+	IMAQ_IMAGE_RGB_U64 = 6,
+	IMAQ_IMAGE_U16 = 7
+} ImageType;
+
+typedef enum ImageUnit_enum
+{
+	IMAQ_UNDEFINED = 0
+} ImageUnit;
+
+typedef enum ColorMode_enum
+{
+	IMAQ_RGB = 0,
+	IMAQ_HSL = 1,
+	IMAQ_HSV = 2,
+	IMAQ_HSI = 3
+} ColorMode;
+
+typedef enum SizeType_enum
+{
+	IMAQ_KEEP_LARGE = 0,
+	IMAQ_KEEP_SMALL = 1
+} SizeType;
+
+typedef enum ExtractionMode_enum
+{
+	IMAQ_NORMAL_IMAGE = 0,
+	IMAQ_UNIFORM_REGIONS = 1
+} ExtractionMode;
+
+typedef enum EdgeFilterSize_enum
+{
+	IMAQ_FINE = 0,
+	IMAQ_NORMAL = 1,
+	IMAQ_CONTOUR_TRACING = 2
+} EdgeFilterSize;
+
+typedef enum GeometricMatchingMode_enum
+{
+	IMAQ_GEOMETRIC_MATCH_SHIFT_INVARIANT = 0,
+	IMAQ_GEOMETRIC_MATCH_ROTATION_INVARIANT = 1,
+	IMAQ_GEOMETRIC_MATCH_SCALE_INVARIANT = 2,
+	IMAQ_GEOMETRIC_MATCH_OCCLUSION_INVARIANT = 4
+} GeometricMatchingMode;
+
+typedef enum MeasurementType_enum
+{
+	IMAQ_MT_CENTER_OF_MASS_X = 0,
+	IMAQ_MT_CENTER_OF_MASS_Y = 1,
+	IMAQ_MT_BOUNDING_RECT_LEFT = 4,
+	IMAQ_MT_BOUNDING_RECT_TOP = 5,
+	IMAQ_MT_BOUNDING_RECT_RIGHT = 6,
+	IMAQ_MT_BOUNDING_RECT_BOTTOM = 7,
+	IMAQ_MT_BOUNDING_RECT_WIDTH = 16,
+	IMAQ_MT_BOUNDING_RECT_HEIGHT = 17,
+	IMAQ_MT_AREA = 35
+} MeasurementType;
+
+typedef struct Range_struct
+{
+	int minValue;
+	int maxValue;
+} Range;
+
+typedef struct RangeFloat_struct
+{
+	float minValue;
+	float maxValue;
+} RangeFloat;
+
+typedef struct Point_struct
+{
+	int x;
+	int y;
+} Point;
+
+typedef struct PointFloat_struct
+{
+	float x;
+	float y;
+} PointFloat;
+
+typedef struct Rect_struct
+{
+	int top;
+	int left;
+	int height;
+	int width;
+} Rect;
+
+typedef int ContourID;
+
+typedef struct RGBValue_struct
+{
+	unsigned char B;
+	unsigned char G;
+	unsigned char R;
+	unsigned char alpha;
+} RGBValue;
+
+typedef struct HSLValue_struct
+{
+	unsigned char L;
+	unsigned char S;
+	unsigned char H;
+	unsigned char alpha;
+} HSLValue;
+
+typedef struct ImageInfo_struct
+{
+	ImageUnit imageUnit;
+	float stepX;
+	float stepY;
+	ImageType imageType;
+	int xRes;
+	int yRes;
+	int xOffset;
+	int yOffset;
+	int border;
+	int pixelsPerLine;
+	void *reserved0;
+	void *reserved1;
+	void *imageStart;
+} ImageInfo;
+
+typedef struct StructuringElement_struct
+{
+	int matrixCols;
+	int matrixRows;
+	int hexa;
+	int *kernel;
+} StructuringElement;
+
+typedef struct RectangleDescriptor_struct
+{
+	double minWidth;
+	double maxWidth;
+	double minHeight;
+	double maxHeight;
+} RectangleDescriptor;
+
+typedef struct CurveOptions_struct
+{
+	ExtractionMode extractionMode;
+	int threshold;
+	EdgeFilterSize filterSize;
+	int minLength;
+	int rowStepSize;
+	int columnStepSize;
+	int maxEndPointGap;
+	int onlyClosed;
+	int subpixelAccuracy;
+} CurveOptions;
+
+typedef struct ShapeDetectionOptions_struct
+{
+	unsigned int mode;
+	RangeFloat *angleRanges;
+	int numAngleRanges;
+	RangeFloat scaleRange;
+	double minMatchScore;
+} ShapeDetectionOptions;
+
+typedef struct RectangleMatch_struct
+{
+	PointFloat corner[4];
+	double rotation;
+	double width;
+	double height;
+	double score;
+} RectangleMatch;
+
+Image *imaqCreateImage(ImageType type, int borderSize);
+int imaqDispose(void *object);
+int imaqSetImageSize(Image *image, int width, int height);
+int imaqGetImageSize(const Image *image, int *width, int *height);
+int imaqGetImageType(const Image *image, ImageType *type);
+int imaqGetImageInfo(const Image *image, ImageInfo *info);
+int imaqDuplicate(Image *dest, const Image *source);
+int imaqGetLastError(void);
+
+int imaqReadFile(Image *image, const char *fileName, RGBValue *colorTable, int *numColors);
+int imaqWriteFile(Image *image, const char *fileName, const RGBValue *colorTable);
+
+int imaqColorThreshold(Image *dest, const Image *source, int replaceValue, ColorMode mode,
+		const Range *plane1Range, const Range *plane2Range, const Range *plane3Range);
+int imaqSizeFilter(Image *dest, Image *source, int connectivity8, int erosions,
+		SizeType keepSize, const StructuringElement *structuringElement);
+int imaqConvexHull(Image *dest, Image *source, int connectivity8);
+int imaqCountParticles(Image *image, int connectivity8, int *numParticles);
+int imaqMeasureParticle(Image *image, int particleNumber, int calibrated,
+		MeasurementType measurement, double *value);
+
+RectangleMatch *imaqDetectRectangles(const Image *image, const RectangleDescriptor *rectangleDescriptor,
+		const CurveOptions *curveOptions, const ShapeDetectionOptions *shapeDetectionOptions,
+		const ROI *roi, int *numMatchesReturned);
+
+ROI *imaqCreateROI(void);
+ContourID imaqAddRectContour(ROI *roi, Rect rect);
+int imaqRemoveContour(ROI *roi, ContourID id);
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file utility.h
+ *
+ * @brief Host stand-in for WPILib's utility.h.
+ */
+
+#ifndef SIM_UTILITY_H_
+#define SIM_UTILITY_H_
+
+#include "vxWorks.h"
+
+#define wpi_assert(condition) wpi_assert_impl(condition, #condition, NULL, __FILE__, __LINE__, __FUNCTION__)
+#define wpi_assertWithMessage(condition, message) wpi_assert_impl(condition, #condition, message, __FILE__, __LINE__, __FUNCTION__)
+
+bool wpi_assert_impl(bool conditionValue, const char *conditionText, const char *message,
+		const char *fileName, UINT32 lineNumber, const char *funcName);
+
+UINT32 GetFPGATime();
+
+#endif
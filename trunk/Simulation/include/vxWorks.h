@@ -0,0 +1,64 @@
+/**
+ * @file vxWorks.h
+ *
+ * @brief Host stand-in for the handful of VxWorks types and semaphore
+ * calls that WPILib (and our code) relies on.
+ *
+ * @details
+ * Semaphores are implemented on top of pthreads.  Only the calls we
+ * actually use are provided -- this is not a VxWorks emulator.
+ */
+
+#ifndef SIM_VXWORKS_H_
+#define SIM_VXWORKS_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef signed char INT8;
+typedef unsigned char UINT8;
+typedef short INT16;
+typedef unsigned short UINT16;
+typedef int INT32;
+typedef unsigned int UINT32;
+typedef long long INT64;
+typedef unsigned long long UINT64;
+typedef int STATUS;
+typedef int (*FUNCPTR)(...);
+
+#ifndef OK
+#define OK 0
+#endif
+#ifndef ERROR
+#define ERROR (-1)
+#endif
+
+#define WAIT_FOREVER (-1)
+#define NO_WAIT 0
+
+#define SEM_Q_FIFO 0x0
+#define SEM_Q_PRIORITY 0x1
+#define SEM_DELETE_SAFE 0x4
+#define SEM_INVERSION_SAFE 0x8
+
+typedef enum
+{
+	SEM_EMPTY = 0,
+	SEM_FULL = 1
+} SEM_B_STATE;
+
+struct SimSemaphore;
+typedef SimSemaphore *SEM_ID;
+
+SEM_ID semMCreate(int options);
+SEM_ID semBCreate(int options, SEM_B_STATE initialState);
+STATUS semTake(SEM_ID semaphore, int timeout);
+STATUS semGive(SEM_ID semaphore);
+STATUS semFlush(SEM_ID semaphore);
+STATUS semDelete(SEM_ID semaphore);
+
+int sysClkRateGet(void);
+STATUS taskDelay(int ticks);
+
+#endif
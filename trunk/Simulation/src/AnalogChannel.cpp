@@ -0,0 +1,51 @@
+#include "AnalogChannel.h"
+#include "Simulator.h"
+
+namespace
+{
+	/**
+	 * The cRIO analog module is 12 bits over +/-10 volts.
+	 */
+	const float kVoltsPerLSB = 10.0 / 2048;
+}
+
+AnalogChannel::AnalogChannel(UINT8 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+}
+
+AnalogChannel::AnalogChannel(UINT32 channel)
+{
+	m_moduleNumber = 1;
+	m_channel = channel;
+}
+
+AnalogChannel::~AnalogChannel()
+{
+}
+
+INT16 AnalogChannel::GetValue()
+{
+	return (INT16) Simulator::GetAnalogValue(m_moduleNumber, m_channel);
+}
+
+INT32 AnalogChannel::GetAverageValue()
+{
+	return Simulator::GetAnalogValue(m_moduleNumber, m_channel);
+}
+
+float AnalogChannel::GetVoltage()
+{
+	return GetValue() * kVoltsPerLSB;
+}
+
+float AnalogChannel::GetAverageVoltage()
+{
+	return GetAverageValue() * kVoltsPerLSB;
+}
+
+UINT32 AnalogChannel::GetChannel()
+{
+	return m_channel;
+}
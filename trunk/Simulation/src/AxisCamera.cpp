@@ -0,0 +1,227 @@
+#include "Vision/AxisCamera.h"
+#include "Notifier.h"
+#include "Simulator.h"
+
+#include <math.h>
+#include <vector>
+
+namespace
+{
+	AxisCamera *sInstance = NULL;
+
+	const int kDefaultMaxFPS = 30;
+	const double kFramePollPeriod = 0.005;
+}
+
+AxisCameraParams::AxisCameraParams()
+{
+	m_brightness = 50;
+	m_whiteBalance = kWhiteBalance_Automatic;
+	m_resolution = kResolution_320x240;
+	m_compression = 50;
+	m_maxFPS = 0;
+	m_parameterWriteCount = 0;
+}
+
+AxisCameraParams::~AxisCameraParams()
+{
+}
+
+void AxisCameraParams::WriteBrightness(int brightness)
+{
+	m_brightness = brightness;
+	m_parameterWriteCount++;
+}
+
+int AxisCameraParams::GetBrightness()
+{
+	return m_brightness;
+}
+
+void AxisCameraParams::WriteWhiteBalance(WhiteBalance_t whiteBalance)
+{
+	m_whiteBalance = whiteBalance;
+	m_parameterWriteCount++;
+}
+
+AxisCameraParams::WhiteBalance_t AxisCameraParams::GetWhiteBalance()
+{
+	return m_whiteBalance;
+}
+
+void AxisCameraParams::WriteResolution(Resolution_t resolution)
+{
+	m_resolution = resolution;
+	m_parameterWriteCount++;
+}
+
+AxisCameraParams::Resolution_t AxisCameraParams::GetResolution()
+{
+	return m_resolution;
+}
+
+void AxisCameraParams::WriteCompression(int compression)
+{
+	m_compression = compression;
+	m_parameterWriteCount++;
+}
+
+int AxisCameraParams::GetCompression()
+{
+	return m_compression;
+}
+
+void AxisCameraParams::WriteMaxFPS(int maxFPS)
+{
+	m_maxFPS = maxFPS;
+	m_parameterWriteCount++;
+}
+
+int AxisCameraParams::GetMaxFPS()
+{
+	return m_maxFPS;
+}
+
+/**
+ * @brief How many times a parameter has been written.  On the robot
+ * every write is an HTTP request to the camera, so this is worth
+ * watching.
+ */
+UINT32 AxisCameraParams::GetParameterWriteCount()
+{
+	return m_parameterWriteCount;
+}
+
+AxisCamera::AxisCamera()
+{
+	m_lastFrameNumber = -1;
+	m_notifiedFrameNumber = -1;
+	m_newImageSem = semBCreate(SEM_Q_PRIORITY, SEM_EMPTY);
+	m_frameNotifier = new Notifier(AxisCamera::CheckForNewFrame, this);
+	m_frameNotifier->StartPeriodic(kFramePollPeriod);
+}
+
+AxisCamera::~AxisCamera()
+{
+	delete m_frameNotifier;
+	semDelete(m_newImageSem);
+}
+
+AxisCamera &AxisCamera::GetInstance(const char *cameraIP)
+{
+	if (sInstance == NULL) {
+		sInstance = new AxisCamera();
+	}
+	return *sInstance;
+}
+
+void AxisCamera::DeleteInstance()
+{
+	delete sInstance;
+	sInstance = NULL;
+}
+
+/**
+ * Frames are numbered by the simulated frame clock, bumped along
+ * whenever the host hands over a different picture.
+ */
+int AxisCamera::GetFrameNumber()
+{
+	int width, height;
+	Simulator::GetCameraFrameSize(width, height);
+	if ((width == 0) or (height == 0)) {
+		return -1;
+	}
+	int maxFPS = (m_maxFPS > 0) ? m_maxFPS : kDefaultMaxFPS;
+	int tick = (int) floor(Simulator::GetTime() * maxFPS);
+	return tick + (int) Simulator::GetCameraFrameNumber();
+}
+
+void AxisCamera::CheckForNewFrame(void *camera)
+{
+	AxisCamera *self = (AxisCamera *) camera;
+	int frameNumber = self->GetFrameNumber();
+	if ((frameNumber >= 0) and (frameNumber != self->m_notifiedFrameNumber)) {
+		self->m_notifiedFrameNumber = frameNumber;
+		semGive(self->m_newImageSem);
+	}
+}
+
+bool AxisCamera::IsFreshImage()
+{
+	int frameNumber = GetFrameNumber();
+	return (frameNumber >= 0) and (frameNumber != m_lastFrameNumber);
+}
+
+SEM_ID AxisCamera::GetNewImageSem()
+{
+	return m_newImageSem;
+}
+
+/**
+ * @brief Copies the current frame into an NI image, scaled (nearest
+ * neighbor) to the configured resolution.
+ *
+ * @returns 1 on success, 0 if no frame is available yet.
+ */
+int AxisCamera::GetImage(Image *imaqImage)
+{
+	int sourceWidth, sourceHeight;
+	Simulator::GetCameraFrameSize(sourceWidth, sourceHeight);
+	if ((sourceWidth == 0) or (sourceHeight == 0)) {
+		return 0;
+	}
+	std::vector<UINT8> source(sourceWidth * sourceHeight * 3);
+	if (!Simulator::GetCameraFrame(&source[0], sourceWidth, sourceHeight)) {
+		return 0;
+	}
+	m_lastFrameNumber = GetFrameNumber();
+
+	int width = 640;
+	int height = 480;
+	switch (m_resolution) {
+	case kResolution_640x360:
+		height = 360;
+		break;
+	case kResolution_320x240:
+		width = 320;
+		height = 240;
+		break;
+	case kResolution_160x120:
+		width = 160;
+		height = 120;
+		break;
+	default:
+		break;
+	}
+
+	imaqSetImageSize(imaqImage, width, height);
+	ImageInfo info;
+	imaqGetImageInfo(imaqImage, &info);
+	RGBValue *pixels = (RGBValue *) info.imageStart;
+	for (int y = 0; y < height; y++) {
+		int sourceY = y * sourceHeight / height;
+		for (int x = 0; x < width; x++) {
+			int sourceX = x * sourceWidth / width;
+			const UINT8 *p = &source[(sourceY * sourceWidth + sourceX) * 3];
+			RGBValue &pixel = pixels[y * info.pixelsPerLine + x];
+			pixel.R = p[0];
+			pixel.G = p[1];
+			pixel.B = p[2];
+			pixel.alpha = 0;
+		}
+	}
+	return 1;
+}
+
+int AxisCamera::GetImage(ColorImage *image)
+{
+	return GetImage(image->GetImaqImage());
+}
+
+HSLImage *AxisCamera::GetImage()
+{
+	HSLImage *image = new HSLImage();
+	GetImage(image);
+	return image;
+}
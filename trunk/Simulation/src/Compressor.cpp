@@ -0,0 +1,50 @@
+#include "Compressor.h"
+#include "Simulator.h"
+
+Compressor::Compressor(UINT8 pressureSwitchModuleNumber, UINT32 pressureSwitchChannel,
+		UINT8 compresssorRelayModuleNumber, UINT32 compressorRelayChannel) :
+		m_relay(compresssorRelayModuleNumber, compressorRelayChannel, Relay::kForwardOnly)
+{
+	m_pressureSwitchModule = pressureSwitchModuleNumber;
+	m_pressureSwitchChannel = pressureSwitchChannel;
+	m_enabled = false;
+}
+
+Compressor::Compressor(UINT32 pressureSwitchChannel, UINT32 compressorRelayChannel) :
+		m_relay(compressorRelayChannel, Relay::kForwardOnly)
+{
+	m_pressureSwitchModule = 1;
+	m_pressureSwitchChannel = pressureSwitchChannel;
+	m_enabled = false;
+}
+
+Compressor::~Compressor()
+{
+}
+
+void Compressor::Start()
+{
+	m_enabled = true;
+	SetRelayValue(Relay::kOn);
+}
+
+void Compressor::Stop()
+{
+	m_enabled = false;
+	SetRelayValue(Relay::kOff);
+}
+
+bool Compressor::Enabled()
+{
+	return m_enabled;
+}
+
+UINT32 Compressor::GetPressureSwitchValue()
+{
+	return Simulator::GetDigitalInput(m_pressureSwitchModule, m_pressureSwitchChannel) ? 1 : 0;
+}
+
+void Compressor::SetRelayValue(Relay::Value relayValue)
+{
+	m_relay.Set(relayValue);
+}
@@ -0,0 +1,28 @@
+#include "DigitalInput.h"
+#include "Simulator.h"
+
+DigitalInput::DigitalInput(UINT32 channel)
+{
+	m_moduleNumber = 1;
+	m_channel = channel;
+}
+
+DigitalInput::DigitalInput(UINT8 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+}
+
+DigitalInput::~DigitalInput()
+{
+}
+
+UINT32 DigitalInput::Get()
+{
+	return Simulator::GetDigitalInput(m_moduleNumber, m_channel) ? 1 : 0;
+}
+
+UINT32 DigitalInput::GetChannel()
+{
+	return m_channel;
+}
@@ -0,0 +1,62 @@
+#include "DriverStation.h"
+#include "Simulator.h"
+
+DriverStation::DriverStation()
+{
+}
+
+DriverStation *DriverStation::GetInstance()
+{
+	static DriverStation instance;
+	return &instance;
+}
+
+float DriverStation::GetStickAxis(UINT32 stick, UINT32 axis)
+{
+	return Simulator::GetStickAxis(stick, axis);
+}
+
+short DriverStation::GetStickButtons(UINT32 stick)
+{
+	return (short) Simulator::GetStickButtons(stick);
+}
+
+bool DriverStation::IsEnabled()
+{
+	return !Simulator::IsMatchOver();
+}
+
+bool DriverStation::IsDisabled()
+{
+	return !IsEnabled();
+}
+
+bool DriverStation::IsAutonomous()
+{
+	return Simulator::IsAutonomousPeriod();
+}
+
+bool DriverStation::IsOperatorControl()
+{
+	return Simulator::IsTeleopPeriod();
+}
+
+bool DriverStation::IsNewControlData()
+{
+	return true;
+}
+
+bool DriverStation::IsFMSAttached()
+{
+	return false;
+}
+
+double DriverStation::GetMatchTime()
+{
+	return Simulator::GetMatchTime();
+}
+
+float DriverStation::GetBatteryVoltage()
+{
+	return 12.5;
+}
@@ -0,0 +1,121 @@
+#include "Encoder.h"
+#include "Simulator.h"
+
+#include <math.h>
+
+Encoder::Encoder(UINT32 aChannel, UINT32 bChannel, bool reverseDirection, EncodingType encodingType)
+{
+	m_moduleNumber = 1;
+	m_channel = aChannel;
+	m_reverseDirection = reverseDirection;
+	m_counting = false;
+	m_offset = 0;
+	m_stoppedCount = 0;
+	m_maxPeriod = 0.5;
+	m_distancePerPulse = 1.0;
+}
+
+Encoder::Encoder(UINT8 aModuleNumber, UINT32 aChannel, UINT8 bModuleNumber, UINT32 bChannel,
+		bool reverseDirection, EncodingType encodingType)
+{
+	m_moduleNumber = aModuleNumber;
+	m_channel = aChannel;
+	m_reverseDirection = reverseDirection;
+	m_counting = false;
+	m_offset = 0;
+	m_stoppedCount = 0;
+	m_maxPeriod = 0.5;
+	m_distancePerPulse = 1.0;
+}
+
+Encoder::~Encoder()
+{
+}
+
+void Encoder::Start()
+{
+	if (!m_counting) {
+		m_offset += Simulator::GetEncoderCount(m_moduleNumber, m_channel) - m_stoppedCount;
+		m_counting = true;
+	}
+}
+
+/**
+ * @brief Counts since Reset(), ignoring anything that happened while
+ * the encoder was stopped.
+ */
+INT32 Encoder::GetRaw()
+{
+	INT32 count = m_counting ? Simulator::GetEncoderCount(m_moduleNumber, m_channel) : m_stoppedCount;
+	count -= m_offset;
+	return m_reverseDirection ? -count : count;
+}
+
+INT32 Encoder::Get()
+{
+	return GetRaw();
+}
+
+void Encoder::Reset()
+{
+	m_offset = m_counting ? Simulator::GetEncoderCount(m_moduleNumber, m_channel) : m_stoppedCount;
+}
+
+void Encoder::Stop()
+{
+	if (m_counting) {
+		m_stoppedCount = Simulator::GetEncoderCount(m_moduleNumber, m_channel);
+		m_counting = false;
+	}
+}
+
+double Encoder::GetPeriod()
+{
+	double rate = Simulator::GetEncoderRate(m_moduleNumber, m_channel);
+	return (rate == 0.0) ? m_maxPeriod : 1.0 / fabs(rate);
+}
+
+void Encoder::SetMaxPeriod(double maxPeriod)
+{
+	m_maxPeriod = maxPeriod;
+}
+
+bool Encoder::GetStopped()
+{
+	return GetPeriod() >= m_maxPeriod;
+}
+
+bool Encoder::GetDirection()
+{
+	double rate = Simulator::GetEncoderRate(m_moduleNumber, m_channel);
+	return m_reverseDirection ? (rate < 0) : (rate >= 0);
+}
+
+double Encoder::GetDistance()
+{
+	return GetRaw() * m_distancePerPulse;
+}
+
+double Encoder::GetRate()
+{
+	if (!m_counting) {
+		return 0.0;
+	}
+	double rate = Simulator::GetEncoderRate(m_moduleNumber, m_channel) * m_distancePerPulse;
+	return m_reverseDirection ? -rate : rate;
+}
+
+void Encoder::SetMinRate(double minRate)
+{
+	m_maxPeriod = m_distancePerPulse / minRate;
+}
+
+void Encoder::SetDistancePerPulse(double distancePerPulse)
+{
+	m_distancePerPulse = distancePerPulse;
+}
+
+void Encoder::SetReverseDirection(bool reverseDirection)
+{
+	m_reverseDirection = reverseDirection;
+}
@@ -0,0 +1,34 @@
+#include "Gyro.h"
+#include "Simulator.h"
+
+Gyro::Gyro(UINT32 channel)
+{
+	m_moduleNumber = 1;
+	m_channel = channel;
+	Reset();
+}
+
+Gyro::Gyro(UINT8 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+	Reset();
+}
+
+Gyro::~Gyro()
+{
+}
+
+float Gyro::GetAngle()
+{
+	return Simulator::GetGyroAngle(m_moduleNumber, m_channel) - m_offset;
+}
+
+void Gyro::SetSensitivity(float voltsPerDegreePerSecond)
+{
+}
+
+void Gyro::Reset()
+{
+	m_offset = Simulator::GetGyroAngle(m_moduleNumber, m_channel);
+}
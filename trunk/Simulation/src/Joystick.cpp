@@ -0,0 +1,148 @@
+#include "Joystick.h"
+#include "DriverStation.h"
+
+#include <math.h>
+
+Joystick::Joystick(UINT32 port)
+{
+	m_port = port;
+	InitJoystick(kNumAxisTypes, kNumButtonTypes);
+
+	m_axes[kXAxis] = kDefaultXAxis;
+	m_axes[kYAxis] = kDefaultYAxis;
+	m_axes[kZAxis] = kDefaultZAxis;
+	m_axes[kTwistAxis] = kDefaultTwistAxis;
+	m_axes[kThrottleAxis] = kDefaultThrottleAxis;
+
+	m_buttons[kTriggerButton] = kDefaultTriggerButton;
+	m_buttons[kTopButton] = kDefaultTopButton;
+}
+
+Joystick::Joystick(UINT32 port, UINT32 numAxisTypes, UINT32 numButtonTypes)
+{
+	m_port = port;
+	InitJoystick(numAxisTypes, numButtonTypes);
+}
+
+void Joystick::InitJoystick(UINT32 numAxisTypes, UINT32 numButtonTypes)
+{
+	m_ds = DriverStation::GetInstance();
+	m_axes = new UINT32[numAxisTypes];
+	m_buttons = new UINT32[numButtonTypes];
+	memset(m_axes, 0, sizeof(UINT32) * numAxisTypes);
+	memset(m_buttons, 0, sizeof(UINT32) * numButtonTypes);
+}
+
+Joystick::~Joystick()
+{
+	delete [] m_buttons;
+	delete [] m_axes;
+}
+
+UINT32 Joystick::GetAxisChannel(AxisType axis)
+{
+	return m_axes[axis];
+}
+
+void Joystick::SetAxisChannel(AxisType axis, UINT32 channel)
+{
+	m_axes[axis] = channel;
+}
+
+float Joystick::GetX(JoystickHand hand)
+{
+	return GetRawAxis(m_axes[kXAxis]);
+}
+
+float Joystick::GetY(JoystickHand hand)
+{
+	return GetRawAxis(m_axes[kYAxis]);
+}
+
+float Joystick::GetZ()
+{
+	return GetRawAxis(m_axes[kZAxis]);
+}
+
+float Joystick::GetTwist()
+{
+	return GetRawAxis(m_axes[kTwistAxis]);
+}
+
+float Joystick::GetThrottle()
+{
+	return GetRawAxis(m_axes[kThrottleAxis]);
+}
+
+float Joystick::GetAxis(AxisType axis)
+{
+	switch (axis) {
+	case kXAxis:
+		return GetX();
+	case kYAxis:
+		return GetY();
+	case kZAxis:
+		return GetZ();
+	case kTwistAxis:
+		return GetTwist();
+	case kThrottleAxis:
+		return GetThrottle();
+	default:
+		return 0.0;
+	}
+}
+
+float Joystick::GetRawAxis(UINT32 axis)
+{
+	return m_ds->GetStickAxis(m_port, axis);
+}
+
+bool Joystick::GetTrigger(JoystickHand hand)
+{
+	return GetRawButton(m_buttons[kTriggerButton]);
+}
+
+bool Joystick::GetTop(JoystickHand hand)
+{
+	return GetRawButton(m_buttons[kTopButton]);
+}
+
+bool Joystick::GetBumper(JoystickHand hand)
+{
+	return false;
+}
+
+bool Joystick::GetButton(ButtonType button)
+{
+	switch (button) {
+	case kTriggerButton:
+		return GetTrigger();
+	case kTopButton:
+		return GetTop();
+	default:
+		return false;
+	}
+}
+
+bool Joystick::GetRawButton(UINT32 button)
+{
+	if (button < 1) {
+		return false;
+	}
+	return ((0x1 << (button - 1)) & m_ds->GetStickButtons(m_port)) != 0;
+}
+
+float Joystick::GetMagnitude()
+{
+	return sqrt(pow(GetX(), 2) + pow(GetY(), 2));
+}
+
+float Joystick::GetDirectionRadians()
+{
+	return atan2(GetX(), -GetY());
+}
+
+float Joystick::GetDirectionDegrees()
+{
+	return (180 / acos(-1.0)) * GetDirectionRadians();
+}
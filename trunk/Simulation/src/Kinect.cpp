@@ -0,0 +1,92 @@
+#include "Kinect.h"
+#include "KinectStick.h"
+
+Skeleton::Skeleton()
+{
+	for (int i = 0; i < JointCount; i++) {
+		m_joints[i].x = 0.0;
+		m_joints[i].y = 0.0;
+		m_joints[i].z = 0.0;
+		m_joints[i].trackingState = kNonTracked;
+	}
+}
+
+Kinect::Kinect()
+{
+}
+
+Kinect *Kinect::GetInstance()
+{
+	static Kinect instance;
+	return &instance;
+}
+
+int Kinect::GetNumberOfPlayers()
+{
+	return 0;
+}
+
+Kinect::SkeletonTrackingState Kinect::GetTrackingState(int skeletonIndex)
+{
+	return kNotTracked;
+}
+
+Skeleton Kinect::GetSkeleton(int skeletonIndex)
+{
+	return m_skeleton;
+}
+
+KinectStick::KinectStick(int id)
+{
+	m_id = id;
+}
+
+float KinectStick::GetX(JoystickHand hand)
+{
+	return 0.0;
+}
+
+float KinectStick::GetY(JoystickHand hand)
+{
+	return 0.0;
+}
+
+float KinectStick::GetZ()
+{
+	return 0.0;
+}
+
+float KinectStick::GetTwist()
+{
+	return 0.0;
+}
+
+float KinectStick::GetThrottle()
+{
+	return 0.0;
+}
+
+float KinectStick::GetRawAxis(UINT32 axis)
+{
+	return 0.0;
+}
+
+bool KinectStick::GetTrigger(JoystickHand hand)
+{
+	return false;
+}
+
+bool KinectStick::GetTop(JoystickHand hand)
+{
+	return false;
+}
+
+bool KinectStick::GetBumper(JoystickHand hand)
+{
+	return false;
+}
+
+bool KinectStick::GetRawButton(UINT32 button)
+{
+	return false;
+}
@@ -0,0 +1,228 @@
+/**
+ * A match script is a text file of timed driver-station and sensor
+ * events, one per line:
+ *
+ *     # seconds into the match, command, arguments
+ *     0     dashboard  "(CONTROLLER) << " 1
+ *     15.0  axis       2 2 -1.0       # stick 2, Y axis full forward
+ *     15.0  axis       3 2 -1.0
+ *     18.5  button     4 1 1          # stick 4, trigger down
+ *     19.0  button     4 1 0
+ *     30    digital    1 3 1          # module 1, GPIO 3 closed
+ *     30    analog     1 1 600
+ *     40    gyro       1 1 90.0
+ *     45    frame      target.ppm
+ *
+ * Commands:
+ *     axis STICK AXIS VALUE
+ *     button STICK BUTTON 0|1
+ *     digital MODULE CHANNEL 0|1
+ *     analog MODULE CHANNEL VALUE
+ *     gyro MODULE CHANNEL DEGREES
+ *     encoder MODULE A_CHANNEL COUNT RATE
+ *     dashboard KEY VALUE     (a string; quote it if it has spaces)
+ *     frame FILE.ppm
+ *     camera connect|disconnect
+ *     expect pwm MODULE CHANNEL VALUE
+ *
+ * Events are applied in file order once the match clock reaches
+ * their time.  An expect line checks what the robot has done by
+ * then (to within kExpectTolerance); each one that doesn't hold is
+ * printed, and counted by GetScriptFailureCount.
+ */
+
+#include "Simulator.h"
+#include "SmartDashboard.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const double kScriptPeriod = 0.005;
+	const double kExpectTolerance = 0.005;
+
+	struct ScriptEvent
+	{
+		double Time;
+		std::string Command;
+		std::vector<std::string> Arguments;
+		int Line;
+	};
+
+	std::vector<ScriptEvent> sEvents;
+	unsigned int sNextEvent = 0;
+	int sFailureCount = 0;
+
+	/**
+	 * Splits a line on whitespace, honoring double quotes and
+	 * stopping at '#'.
+	 */
+	std::vector<std::string> Tokenize(const char *line)
+	{
+		std::vector<std::string> tokens;
+		const char *p = line;
+		while (*p != '\0') {
+			while ((*p == ' ') or (*p == '\t') or (*p == '\r') or (*p == '\n')) {
+				p++;
+			}
+			if ((*p == '\0') or (*p == '#')) {
+				break;
+			}
+			std::string token;
+			if (*p == '"') {
+				p++;
+				while ((*p != '\0') and (*p != '"')) {
+					token += *p++;
+				}
+				if (*p == '"') {
+					p++;
+				}
+			} else {
+				while ((*p != '\0') and (*p != ' ') and (*p != '\t') and (*p != '\r') and (*p != '\n')) {
+					token += *p++;
+				}
+			}
+			tokens.push_back(token);
+		}
+		return tokens;
+	}
+
+	unsigned int ArgumentCount(const std::string &command, const std::vector<std::string> &arguments)
+	{
+		if (command == "expect") {
+			return (!arguments.empty() and (arguments[0] == "pwm")) ? 4 : 0;
+		}
+		if ((command == "axis") or (command == "button") or (command == "digital")
+				or (command == "analog") or (command == "gyro")) {
+			return 3;
+		}
+		if (command == "encoder") {
+			return 4;
+		}
+		if (command == "dashboard") {
+			return 2;
+		}
+		if (command == "frame") {
+			return 1;
+		}
+		if (command == "camera") {
+			return 1;
+		}
+		return 0;
+	}
+
+	UINT32 ToIndex(const std::string &text)
+	{
+		return (UINT32) strtoul(text.c_str(), NULL, 10);
+	}
+
+	void Check(const ScriptEvent &event)
+	{
+		const std::vector<std::string> &a = event.Arguments;
+		float expected = atof(a[3].c_str());
+		float actual = Simulator::GetPwm(ToIndex(a[1]), ToIndex(a[2]));
+		if (fabs(actual - expected) > kExpectTolerance) {
+			fprintf(stderr, "script line %d: at %.2f s, expected pwm %s %s to be %.3f but it was %.3f\n",
+					event.Line, Simulator::GetMatchTime(), a[1].c_str(), a[2].c_str(), expected, actual);
+			sFailureCount++;
+		}
+	}
+
+	void Apply(const ScriptEvent &event)
+	{
+		const std::vector<std::string> &a = event.Arguments;
+		const std::string &command = event.Command;
+		if (command == "axis") {
+			Simulator::SetStickAxis(ToIndex(a[0]), ToIndex(a[1]), atof(a[2].c_str()));
+		} else if (command == "button") {
+			Simulator::SetStickButton(ToIndex(a[0]), ToIndex(a[1]), atoi(a[2].c_str()) != 0);
+		} else if (command == "digital") {
+			Simulator::SetDigitalInput(ToIndex(a[0]), ToIndex(a[1]), atoi(a[2].c_str()) != 0);
+		} else if (command == "analog") {
+			Simulator::SetAnalogValue(ToIndex(a[0]), ToIndex(a[1]), atoi(a[2].c_str()));
+		} else if (command == "gyro") {
+			Simulator::SetGyroAngle(ToIndex(a[0]), ToIndex(a[1]), atof(a[2].c_str()));
+		} else if (command == "encoder") {
+			Simulator::SetEncoder(ToIndex(a[0]), ToIndex(a[1]), atoi(a[2].c_str()), atof(a[3].c_str()));
+		} else if (command == "dashboard") {
+			SmartDashboard::PutString(a[0].c_str(), a[1].c_str());
+		} else if (command == "frame") {
+			if (!Simulator::LoadCameraFrame(a[0].c_str())) {
+				fprintf(stderr, "script line %d: could not read camera frame %s\n", event.Line, a[0].c_str());
+			}
+		} else if (command == "camera") {
+			Simulator::SetCameraConnected(a[0] != "disconnect");
+		} else if (command == "expect") {
+			Check(event);
+		}
+	}
+
+	void Play(void *)
+	{
+		double matchTime = Simulator::GetMatchTime();
+		while ((sNextEvent < sEvents.size()) and (sEvents[sNextEvent].Time <= matchTime)) {
+			Apply(sEvents[sNextEvent]);
+			sNextEvent++;
+		}
+	}
+}
+
+/**
+ * @brief Reads a match script and starts playing it.  Events are
+ * timed from the start of the match, so load the script before
+ * calling StartMatch().
+ *
+ * @returns false (after printing the problem) if the script can't be
+ * read.
+ */
+bool Simulator::LoadMatchScript(const char *fileName)
+{
+	FILE *file = fopen(fileName, "r");
+	if (file == NULL) {
+		fprintf(stderr, "could not open match script %s\n", fileName);
+		return false;
+	}
+	char line[512];
+	int lineNumber = 0;
+	bool ok = true;
+	while (ok and (fgets(line, sizeof(line), file) != NULL)) {
+		lineNumber++;
+		std::vector<std::string> tokens = Tokenize(line);
+		if (tokens.empty()) {
+			continue;
+		}
+		ScriptEvent event;
+		event.Line = lineNumber;
+		char *end = NULL;
+		event.Time = strtod(tokens[0].c_str(), &end);
+		ok = (tokens.size() >= 2) and (end != tokens[0].c_str()) and (*end == '\0');
+		if (ok) {
+			event.Command = tokens[1];
+			event.Arguments.assign(tokens.begin() + 2, tokens.end());
+			unsigned int count = ArgumentCount(event.Command, event.Arguments);
+			ok = (count > 0) and (event.Arguments.size() == count);
+		}
+		if (!ok) {
+			fprintf(stderr, "%s:%d: bad script line\n", fileName, lineNumber);
+			break;
+		}
+		sEvents.push_back(event);
+	}
+	fclose(file);
+	if (ok) {
+		Simulator::AddPeriodicCallback(Play, NULL, kScriptPeriod);
+	}
+	return ok;
+}
+
+/**
+ * @brief How many of the script's expect lines haven't held so far.
+ */
+int Simulator::GetScriptFailureCount()
+{
+	return sFailureCount;
+}
@@ -0,0 +1,287 @@
+#include "NetworkTables/NetworkTable.h"
+#include "Synchronized.h"
+
+#include <stdio.h>
+
+namespace
+{
+	typedef std::map<std::string, NetworkTable *> TableMap;
+
+	SEM_ID sTablesLock = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+	TableMap sTables;
+}
+
+NetworkTable::NetworkTable(std::string name)
+{
+	m_name = name;
+	m_dataLock = semMCreate(SEM_Q_PRIORITY | SEM_INVERSION_SAFE | SEM_DELETE_SAFE);
+}
+
+NetworkTable *NetworkTable::GetTable(const char *tableName)
+{
+	return GetTable(std::string(tableName));
+}
+
+NetworkTable *NetworkTable::GetTable(std::string tableName)
+{
+	Synchronized sync(sTablesLock);
+	TableMap::iterator found = sTables.find(tableName);
+	if (found != sTables.end()) {
+		return found->second;
+	}
+	NetworkTable *table = new NetworkTable(tableName);
+	sTables[tableName] = table;
+	return table;
+}
+
+/**
+ * @brief The key names.  The pointers stay valid as long as the keys
+ * exist, which (since keys are never removed) is forever.
+ */
+std::vector<const char *> NetworkTable::GetKeys()
+{
+	Synchronized sync(m_dataLock);
+	std::vector<const char *> keys;
+	for (std::map<std::string, Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+		keys.push_back(it->first.c_str());
+	}
+	return keys;
+}
+
+void NetworkTable::BeginTransaction()
+{
+}
+
+void NetworkTable::EndTransaction()
+{
+}
+
+void NetworkTable::AddChangeListener(const char *keyName, NetworkTableChangeListener *listener)
+{
+	Synchronized sync(m_dataLock);
+	m_listeners.insert(std::make_pair(std::string(keyName), listener));
+}
+
+void NetworkTable::AddChangeListenerAny(NetworkTableChangeListener *listener)
+{
+	Synchronized sync(m_dataLock);
+	m_anyListeners.push_back(listener);
+}
+
+void NetworkTable::RemoveChangeListener(const char *keyName, NetworkTableChangeListener *listener)
+{
+	Synchronized sync(m_dataLock);
+	typedef std::multimap<std::string, NetworkTableChangeListener *>::iterator Iterator;
+	std::pair<Iterator, Iterator> range = m_listeners.equal_range(std::string(keyName));
+	for (Iterator it = range.first; it != range.second; ++it) {
+		if (it->second == listener) {
+			m_listeners.erase(it);
+			return;
+		}
+	}
+}
+
+void NetworkTable::RemoveChangeListenerAny(NetworkTableChangeListener *listener)
+{
+	Synchronized sync(m_dataLock);
+	for (std::vector<NetworkTableChangeListener *>::iterator it = m_anyListeners.begin();
+			it != m_anyListeners.end(); ++it) {
+		if (*it == listener) {
+			m_anyListeners.erase(it);
+			return;
+		}
+	}
+}
+
+bool NetworkTable::ContainsKey(const char *keyName)
+{
+	return ContainsKey(std::string(keyName));
+}
+
+bool NetworkTable::ContainsKey(std::string keyName)
+{
+	Synchronized sync(m_dataLock);
+	return m_entries.find(keyName) != m_entries.end();
+}
+
+bool NetworkTable::Lookup(std::string keyName, Entry &entry)
+{
+	Synchronized sync(m_dataLock);
+	std::map<std::string, Entry>::iterator found = m_entries.find(keyName);
+	if (found == m_entries.end()) {
+		return false;
+	}
+	entry = found->second;
+	return true;
+}
+
+/**
+ * @brief Stores a value and, if it actually changed, tells the
+ * listeners.  Listeners are called without the table lock held so they
+ * are free to read the table back.
+ */
+void NetworkTable::Store(std::string keyName, Entry &entry)
+{
+	std::vector<NetworkTableChangeListener *> listeners;
+	{
+		Synchronized sync(m_dataLock);
+		std::map<std::string, Entry>::iterator found = m_entries.find(keyName);
+		if (found != m_entries.end()) {
+			Entry &old = found->second;
+			bool same = (old.Type == entry.Type)
+					and (old.StringValue == entry.StringValue)
+					and (old.IntValue == entry.IntValue)
+					and (old.DoubleValue == entry.DoubleValue)
+					and (old.BooleanValue == entry.BooleanValue);
+			if (same) {
+				return;
+			}
+		}
+		m_entries[keyName] = entry;
+
+		typedef std::multimap<std::string, NetworkTableChangeListener *>::iterator Iterator;
+		std::pair<Iterator, Iterator> range = m_listeners.equal_range(keyName);
+		for (Iterator it = range.first; it != range.second; ++it) {
+			listeners.push_back(it->second);
+		}
+		listeners.insert(listeners.end(), m_anyListeners.begin(), m_anyListeners.end());
+	}
+	for (unsigned int i = 0; i < listeners.size(); i++) {
+		listeners[i]->ValueChanged(this, keyName.c_str(), entry.Type);
+	}
+}
+
+int NetworkTable::GetInt(const char *keyName)
+{
+	return GetInt(std::string(keyName));
+}
+
+int NetworkTable::GetInt(std::string keyName)
+{
+	Entry entry;
+	if (!Lookup(keyName, entry) or entry.Type != kNetworkTables_Types_INT) {
+		return 0;
+	}
+	return entry.IntValue;
+}
+
+bool NetworkTable::GetBoolean(const char *keyName)
+{
+	return GetBoolean(std::string(keyName));
+}
+
+bool NetworkTable::GetBoolean(std::string keyName)
+{
+	Entry entry;
+	if (!Lookup(keyName, entry) or entry.Type != kNetworkTables_Types_BOOLEAN) {
+		return false;
+	}
+	return entry.BooleanValue;
+}
+
+double NetworkTable::GetDouble(const char *keyName)
+{
+	return GetDouble(std::string(keyName));
+}
+
+double NetworkTable::GetDouble(std::string keyName)
+{
+	Entry entry;
+	if (!Lookup(keyName, entry) or entry.Type != kNetworkTables_Types_DOUBLE) {
+		return 0.0;
+	}
+	return entry.DoubleValue;
+}
+
+std::string NetworkTable::GetString(const char *keyName)
+{
+	return GetString(std::string(keyName));
+}
+
+std::string NetworkTable::GetString(std::string keyName)
+{
+	Entry entry;
+	if (!Lookup(keyName, entry) or entry.Type != kNetworkTables_Types_STRING) {
+		return std::string();
+	}
+	return entry.StringValue;
+}
+
+int NetworkTable::GetString(const char *keyName, char *value, int len)
+{
+	std::string result = GetString(keyName);
+	if (len <= 0) {
+		return 0;
+	}
+	int copied = ((int) result.size() < len - 1) ? (int) result.size() : len - 1;
+	memcpy(value, result.c_str(), copied);
+	value[copied] = '\0';
+	return copied;
+}
+
+namespace
+{
+	void ClearEntryValues(std::string &stringValue, int &intValue, double &doubleValue, bool &booleanValue)
+	{
+		stringValue.clear();
+		intValue = 0;
+		doubleValue = 0.0;
+		booleanValue = false;
+	}
+}
+
+void NetworkTable::PutInt(const char *keyName, int value)
+{
+	PutInt(std::string(keyName), value);
+}
+
+void NetworkTable::PutInt(std::string keyName, int value)
+{
+	Entry entry;
+	ClearEntryValues(entry.StringValue, entry.IntValue, entry.DoubleValue, entry.BooleanValue);
+	entry.Type = kNetworkTables_Types_INT;
+	entry.IntValue = value;
+	Store(keyName, entry);
+}
+
+void NetworkTable::PutBoolean(const char *keyName, bool value)
+{
+	PutBoolean(std::string(keyName), value);
+}
+
+void NetworkTable::PutBoolean(std::string keyName, bool value)
+{
+	Entry entry;
+	ClearEntryValues(entry.StringValue, entry.IntValue, entry.DoubleValue, entry.BooleanValue);
+	entry.Type = kNetworkTables_Types_BOOLEAN;
+	entry.BooleanValue = value;
+	Store(keyName, entry);
+}
+
+void NetworkTable::PutDouble(const char *keyName, double value)
+{
+	PutDouble(std::string(keyName), value);
+}
+
+void NetworkTable::PutDouble(std::string keyName, double value)
+{
+	Entry entry;
+	ClearEntryValues(entry.StringValue, entry.IntValue, entry.DoubleValue, entry.BooleanValue);
+	entry.Type = kNetworkTables_Types_DOUBLE;
+	entry.DoubleValue = value;
+	Store(keyName, entry);
+}
+
+void NetworkTable::PutString(const char *keyName, const char *value)
+{
+	PutString(std::string(keyName), std::string(value));
+}
+
+void NetworkTable::PutString(std::string keyName, std::string value)
+{
+	Entry entry;
+	ClearEntryValues(entry.StringValue, entry.IntValue, entry.DoubleValue, entry.BooleanValue);
+	entry.Type = kNetworkTables_Types_STRING;
+	entry.StringValue = value;
+	Store(keyName, entry);
+}
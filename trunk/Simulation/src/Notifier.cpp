@@ -0,0 +1,103 @@
+#include "Notifier.h"
+#include "Simulator.h"
+
+Notifier::Notifier(TimerEventHandler handler, void *param)
+{
+	m_handler = handler;
+	m_param = param;
+	m_period = 0.0;
+	m_expirationTime = 0.0;
+	m_periodic = false;
+	m_queued = false;
+	m_destroying = false;
+	pthread_mutex_init(&m_mutex, NULL);
+	pthread_cond_init(&m_condition, NULL);
+	Simulator::AddThread();
+	m_threadStarted = (pthread_create(&m_thread, NULL, Notifier::ThreadEntry, this) == 0);
+	if (!m_threadStarted) {
+		Simulator::RemoveThread();
+	}
+}
+
+Notifier::~Notifier()
+{
+	m_destroying = true;
+	if (m_threadStarted) {
+		Simulator::BeginBlocking();
+		pthread_join(m_thread, NULL);
+		Simulator::EndBlocking();
+	}
+	pthread_mutex_destroy(&m_mutex);
+	pthread_cond_destroy(&m_condition);
+}
+
+void Notifier::StartSingle(double delay)
+{
+	pthread_mutex_lock(&m_mutex);
+	m_periodic = false;
+	m_period = delay;
+	m_expirationTime = Simulator::GetTime() + delay;
+	m_queued = true;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void Notifier::StartPeriodic(double period)
+{
+	pthread_mutex_lock(&m_mutex);
+	m_periodic = true;
+	m_period = period;
+	m_expirationTime = Simulator::GetTime() + period;
+	m_queued = true;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+/**
+ * @brief Stops future calls.  A handler that is already running is
+ * allowed to finish.
+ */
+void Notifier::Stop()
+{
+	pthread_mutex_lock(&m_mutex);
+	m_queued = false;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void *Notifier::ThreadEntry(void *notifier)
+{
+	((Notifier *) notifier)->Run();
+	Simulator::RemoveThread();
+	return NULL;
+}
+
+/**
+ * Sleeps until the next expiration, but never for longer than
+ * kPollPeriod so Stop(), restarts and the destructor are noticed
+ * promptly.
+ */
+void Notifier::Run()
+{
+	static const double kPollPeriod = 0.01;
+	while (!m_destroying) {
+		bool fire = false;
+		double sleep = kPollPeriod;
+		pthread_mutex_lock(&m_mutex);
+		double now = Simulator::GetTime();
+		if (m_queued and now >= m_expirationTime) {
+			fire = true;
+			if (m_periodic) {
+				m_expirationTime += m_period;
+			} else {
+				m_queued = false;
+			}
+		} else if (m_queued and (m_expirationTime - now < sleep)) {
+			sleep = m_expirationTime - now;
+		}
+		pthread_mutex_unlock(&m_mutex);
+
+		if (fire) {
+			m_handler(m_param);
+		} else {
+			Simulator::Sleep(sleep);
+		}
+	}
+}
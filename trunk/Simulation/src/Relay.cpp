@@ -0,0 +1,33 @@
+#include "Relay.h"
+#include "Simulator.h"
+
+Relay::Relay(UINT32 channel, Direction direction)
+{
+	m_moduleNumber = 1;
+	m_channel = channel;
+	m_direction = direction;
+	Set(kOff);
+}
+
+Relay::Relay(UINT8 moduleNumber, UINT32 channel, Direction direction)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+	m_direction = direction;
+	Set(kOff);
+}
+
+Relay::~Relay()
+{
+	Set(kOff);
+}
+
+void Relay::Set(Value value)
+{
+	Simulator::SetRelay(m_moduleNumber, m_channel, (INT32) value);
+}
+
+Relay::Value Relay::Get()
+{
+	return (Value) Simulator::GetRelay(m_moduleNumber, m_channel);
+}
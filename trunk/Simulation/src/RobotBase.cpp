@@ -0,0 +1,45 @@
+#include "RobotBase.h"
+
+RobotBase::RobotBase()
+{
+	m_ds = DriverStation::GetInstance();
+}
+
+RobotBase::~RobotBase()
+{
+}
+
+bool RobotBase::IsEnabled()
+{
+	return m_ds->IsEnabled();
+}
+
+bool RobotBase::IsDisabled()
+{
+	return m_ds->IsDisabled();
+}
+
+bool RobotBase::IsAutonomous()
+{
+	return m_ds->IsAutonomous();
+}
+
+bool RobotBase::IsOperatorControl()
+{
+	return m_ds->IsOperatorControl();
+}
+
+bool RobotBase::IsSystemActive()
+{
+	return m_watchdog.IsSystemActive();
+}
+
+bool RobotBase::IsNewDataAvailable()
+{
+	return m_ds->IsNewControlData();
+}
+
+Watchdog &RobotBase::GetWatchdog()
+{
+	return m_watchdog;
+}
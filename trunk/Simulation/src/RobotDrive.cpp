@@ -0,0 +1,214 @@
+#include "RobotDrive.h"
+
+#include <math.h>
+
+RobotDrive::RobotDrive(UINT32 leftMotorChannel, UINT32 rightMotorChannel)
+{
+	InitRobotDrive();
+	m_rearLeftMotor = new Jaguar(leftMotorChannel);
+	m_rearRightMotor = new Jaguar(rightMotorChannel);
+	m_deleteSpeedControllers = true;
+	StopMotor();
+}
+
+RobotDrive::RobotDrive(UINT32 frontLeftMotorChannel, UINT32 rearLeftMotorChannel,
+		UINT32 frontRightMotorChannel, UINT32 rearRightMotorChannel)
+{
+	InitRobotDrive();
+	m_frontLeftMotor = new Jaguar(frontLeftMotorChannel);
+	m_rearLeftMotor = new Jaguar(rearLeftMotorChannel);
+	m_frontRightMotor = new Jaguar(frontRightMotorChannel);
+	m_rearRightMotor = new Jaguar(rearRightMotorChannel);
+	m_deleteSpeedControllers = true;
+	StopMotor();
+}
+
+RobotDrive::RobotDrive(SpeedController *leftMotor, SpeedController *rightMotor)
+{
+	InitRobotDrive();
+	m_rearLeftMotor = leftMotor;
+	m_rearRightMotor = rightMotor;
+}
+
+RobotDrive::RobotDrive(SpeedController *frontLeftMotor, SpeedController *rearLeftMotor,
+		SpeedController *frontRightMotor, SpeedController *rearRightMotor)
+{
+	InitRobotDrive();
+	m_frontLeftMotor = frontLeftMotor;
+	m_rearLeftMotor = rearLeftMotor;
+	m_frontRightMotor = frontRightMotor;
+	m_rearRightMotor = rearRightMotor;
+}
+
+RobotDrive::~RobotDrive()
+{
+	if (m_deleteSpeedControllers) {
+		delete m_frontLeftMotor;
+		delete m_rearLeftMotor;
+		delete m_frontRightMotor;
+		delete m_rearRightMotor;
+	}
+}
+
+void RobotDrive::InitRobotDrive()
+{
+	m_frontLeftMotor = NULL;
+	m_frontRightMotor = NULL;
+	m_rearLeftMotor = NULL;
+	m_rearRightMotor = NULL;
+	m_sensitivity = 0.5;
+	m_maxOutput = 1.0;
+	m_deleteSpeedControllers = false;
+	for (INT32 i = 0; i < kMaxNumberOfMotors; i++) {
+		m_invertedMotors[i] = 1;
+	}
+}
+
+void RobotDrive::Drive(float outputMagnitude, float curve)
+{
+	float leftOutput, rightOutput;
+	if (curve < 0) {
+		float value = log(-curve);
+		float ratio = (value - m_sensitivity) / (value + m_sensitivity);
+		if (ratio == 0) {
+			ratio = .0000000001;
+		}
+		leftOutput = outputMagnitude / ratio;
+		rightOutput = outputMagnitude;
+	} else if (curve > 0) {
+		float value = log(curve);
+		float ratio = (value - m_sensitivity) / (value + m_sensitivity);
+		if (ratio == 0) {
+			ratio = .0000000001;
+		}
+		leftOutput = outputMagnitude;
+		rightOutput = outputMagnitude / ratio;
+	} else {
+		leftOutput = outputMagnitude;
+		rightOutput = outputMagnitude;
+	}
+	SetLeftRightMotorOutputs(leftOutput, rightOutput);
+}
+
+void RobotDrive::TankDrive(GenericHID *leftStick, GenericHID *rightStick)
+{
+	if ((leftStick == NULL) or (rightStick == NULL)) {
+		return;
+	}
+	TankDrive(leftStick->GetY(), rightStick->GetY());
+}
+
+void RobotDrive::TankDrive(float leftValue, float rightValue, bool squaredInputs)
+{
+	leftValue = Limit(leftValue);
+	rightValue = Limit(rightValue);
+	if (squaredInputs) {
+		leftValue = (leftValue >= 0.0) ? (leftValue * leftValue) : -(leftValue * leftValue);
+		rightValue = (rightValue >= 0.0) ? (rightValue * rightValue) : -(rightValue * rightValue);
+	}
+	SetLeftRightMotorOutputs(leftValue, rightValue);
+}
+
+void RobotDrive::ArcadeDrive(GenericHID *stick, bool squaredInputs)
+{
+	ArcadeDrive(stick->GetY(), stick->GetX(), squaredInputs);
+}
+
+void RobotDrive::ArcadeDrive(float moveValue, float rotateValue, bool squaredInputs)
+{
+	float leftMotorOutput;
+	float rightMotorOutput;
+
+	moveValue = Limit(moveValue);
+	rotateValue = Limit(rotateValue);
+
+	if (squaredInputs) {
+		moveValue = (moveValue >= 0.0) ? (moveValue * moveValue) : -(moveValue * moveValue);
+		rotateValue = (rotateValue >= 0.0) ? (rotateValue * rotateValue) : -(rotateValue * rotateValue);
+	}
+
+	if (moveValue > 0.0) {
+		if (rotateValue > 0.0) {
+			leftMotorOutput = moveValue - rotateValue;
+			rightMotorOutput = (moveValue > rotateValue) ? moveValue : rotateValue;
+		} else {
+			leftMotorOutput = (moveValue > -rotateValue) ? moveValue : -rotateValue;
+			rightMotorOutput = moveValue + rotateValue;
+		}
+	} else {
+		if (rotateValue > 0.0) {
+			leftMotorOutput = -((-moveValue > rotateValue) ? -moveValue : rotateValue);
+			rightMotorOutput = moveValue + rotateValue;
+		} else {
+			leftMotorOutput = moveValue - rotateValue;
+			rightMotorOutput = -((-moveValue > -rotateValue) ? -moveValue : -rotateValue);
+		}
+	}
+	SetLeftRightMotorOutputs(leftMotorOutput, rightMotorOutput);
+}
+
+void RobotDrive::SetLeftRightMotorOutputs(float leftOutput, float rightOutput)
+{
+	if (m_frontLeftMotor != NULL) {
+		m_frontLeftMotor->Set(Limit(leftOutput) * m_invertedMotors[kFrontLeftMotor] * m_maxOutput);
+	}
+	m_rearLeftMotor->Set(Limit(leftOutput) * m_invertedMotors[kRearLeftMotor] * m_maxOutput);
+
+	if (m_frontRightMotor != NULL) {
+		m_frontRightMotor->Set(-Limit(rightOutput) * m_invertedMotors[kFrontRightMotor] * m_maxOutput);
+	}
+	m_rearRightMotor->Set(-Limit(rightOutput) * m_invertedMotors[kRearRightMotor] * m_maxOutput);
+}
+
+void RobotDrive::SetInvertedMotor(MotorType motor, bool isInverted)
+{
+	if ((motor < 0) or (motor >= kMaxNumberOfMotors)) {
+		return;
+	}
+	m_invertedMotors[motor] = isInverted ? -1 : 1;
+}
+
+void RobotDrive::SetSensitivity(float sensitivity)
+{
+	m_sensitivity = sensitivity;
+}
+
+void RobotDrive::SetMaxOutput(double maxOutput)
+{
+	m_maxOutput = maxOutput;
+}
+
+void RobotDrive::StopMotor()
+{
+	if (m_frontLeftMotor != NULL) {
+		m_frontLeftMotor->Disable();
+	}
+	if (m_frontRightMotor != NULL) {
+		m_frontRightMotor->Disable();
+	}
+	if (m_rearLeftMotor != NULL) {
+		m_rearLeftMotor->Disable();
+	}
+	if (m_rearRightMotor != NULL) {
+		m_rearRightMotor->Disable();
+	}
+}
+
+void RobotDrive::SetSafetyEnabled(bool enabled)
+{
+}
+
+void RobotDrive::SetExpiration(float timeout)
+{
+}
+
+float RobotDrive::Limit(float num)
+{
+	if (num > 1.0) {
+		return 1.0;
+	}
+	if (num < -1.0) {
+		return -1.0;
+	}
+	return num;
+}
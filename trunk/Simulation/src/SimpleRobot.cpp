@@ -0,0 +1,69 @@
+#include "SimpleRobot.h"
+#include "Timer.h"
+
+SimpleRobot::SimpleRobot()
+{
+	m_robotMainOverridden = true;
+}
+
+SimpleRobot::~SimpleRobot()
+{
+}
+
+void SimpleRobot::RobotInit()
+{
+}
+
+void SimpleRobot::Disabled()
+{
+}
+
+void SimpleRobot::Autonomous()
+{
+}
+
+void SimpleRobot::OperatorControl()
+{
+}
+
+void SimpleRobot::RobotMain()
+{
+	m_robotMainOverridden = false;
+}
+
+/**
+ * @brief Runs the robot through the simulated match.
+ *
+ * @details
+ * Mirrors WPILib: each mode method is called once when its period
+ * starts and the robot is expected to return when the period ends.
+ * Unlike the cRIO, this returns once the match is over so the host
+ * executable can exit.
+ */
+void SimpleRobot::StartCompetition()
+{
+	static const double kModePollPeriod = 0.01;
+
+	RobotMain();
+	if (m_robotMainOverridden) {
+		return;
+	}
+	RobotInit();
+
+	while (IsEnabled()) {
+		if (IsAutonomous()) {
+			Autonomous();
+			while (IsAutonomous() and IsEnabled()) {
+				Wait(kModePollPeriod);
+			}
+		} else if (IsOperatorControl()) {
+			OperatorControl();
+			while (IsOperatorControl() and IsEnabled()) {
+				Wait(kModePollPeriod);
+			}
+		} else {
+			Wait(kModePollPeriod);
+		}
+	}
+	Disabled();
+}
@@ -0,0 +1,543 @@
+#include "Simulator.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+#include <set>
+#include <vector>
+
+namespace
+{
+	struct EncoderState
+	{
+		INT32 Count;
+		double Rate;
+	};
+
+	pthread_mutex_t sTableLock = PTHREAD_MUTEX_INITIALIZER;
+
+	float sPwm[Simulator::kNumModules][Simulator::kNumChannels];
+	bool sSolenoid[Simulator::kNumModules][Simulator::kNumChannels];
+	INT32 sRelay[Simulator::kNumModules][Simulator::kNumChannels];
+	bool sDigitalInput[Simulator::kNumModules][Simulator::kNumChannels];
+	INT32 sAnalogValue[Simulator::kNumModules][Simulator::kNumChannels];
+	float sGyroAngle[Simulator::kNumModules][Simulator::kNumChannels];
+	EncoderState sEncoder[Simulator::kNumModules][Simulator::kNumChannels];
+
+	float sStickAxes[Simulator::kNumSticks][Simulator::kNumStickAxes + 1];
+	UINT16 sStickButtons[Simulator::kNumSticks];
+
+	std::vector<UINT8> sCameraFrame;
+	int sCameraWidth = 0;
+	int sCameraHeight = 0;
+	UINT32 sCameraFrameNumber = 0;
+	bool sCameraConnected = true;
+
+	double sMatchStart = 0.0;
+	double sAutonomousLength = 0.0;
+	double sTeleopLength = 0.0;
+
+	double ReadMonotonicClock()
+	{
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec * 1e-9;
+	}
+
+	double sClockOrigin = ReadMonotonicClock();
+
+	/**
+	 * Modules and channels are 1-based on the robot; anything out of
+	 * range is quietly routed to slot zero so bad port numbers don't
+	 * crash the simulation.
+	 */
+	UINT32 Clamp(UINT32 index, UINT32 size)
+	{
+		return (index < size) ? index : 0;
+	}
+}
+
+/**
+ * Virtual clock bookkeeping.  Every simulated thread (the robot's main
+ * thread, each Task and each Notifier) is counted in sRunningThreads
+ * unless it is asleep or blocked.  When the count drops to zero, the
+ * clock jumps to the earliest wake-up time, running any host callbacks
+ * that fall due on the way.
+ */
+namespace
+{
+	struct Callback
+	{
+		Simulator::PeriodicCallback Function;
+		void *Param;
+		double Period;
+		double Next;
+	};
+
+	pthread_mutex_t sClockLock;
+	pthread_cond_t sClockChanged = PTHREAD_COND_INITIALIZER;
+	bool sVirtualClock = false;
+	double sVirtualTime = 0.0;
+	int sRunningThreads = 0;
+	std::multiset<double> sWakeTimes;
+	std::vector<Callback> sCallbacks;
+
+	/**
+	 * The clock lock is recursive so that host callbacks (which run
+	 * with it held) can still read the time.
+	 */
+	bool InitializeClockLock()
+	{
+		pthread_mutexattr_t attributes;
+		pthread_mutexattr_init(&attributes);
+		pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(&sClockLock, &attributes);
+		pthread_mutexattr_destroy(&attributes);
+		return true;
+	}
+
+	bool sClockLockInitialized = InitializeClockLock();
+
+	/**
+	 * Must be called with sClockLock held.
+	 */
+	void AdvanceIfIdle()
+	{
+		while (sRunningThreads == 0) {
+			double nextWake = sWakeTimes.empty() ? HUGE_VAL : *sWakeTimes.begin();
+			if (nextWake <= sVirtualTime) {
+				// Somebody is due (perhaps because a callback moved the
+				// clock) but hasn't run yet.
+				pthread_cond_broadcast(&sClockChanged);
+				return;
+			}
+			int due = -1;
+			for (unsigned int i = 0; i < sCallbacks.size(); i++) {
+				if ((sCallbacks[i].Next <= nextWake) and ((due < 0) or (sCallbacks[i].Next < sCallbacks[due].Next))) {
+					due = i;
+				}
+			}
+			if (due >= 0) {
+				if (sCallbacks[due].Next > sVirtualTime) {
+					sVirtualTime = sCallbacks[due].Next;
+				}
+				sCallbacks[due].Next += sCallbacks[due].Period;
+				sCallbacks[due].Function(sCallbacks[due].Param);
+				continue;
+			}
+			if (nextWake == HUGE_VAL) {
+				return;
+			}
+			sVirtualTime = nextWake;
+			pthread_cond_broadcast(&sClockChanged);
+			return;
+		}
+	}
+
+	void SleepWallClock(double seconds)
+	{
+		if (seconds <= 0) {
+			return;
+		}
+		struct timespec duration;
+		duration.tv_sec = (time_t) floor(seconds);
+		duration.tv_nsec = (long) ((seconds - floor(seconds)) * 1e9);
+		nanosleep(&duration, NULL);
+	}
+
+	struct WallClockCallback
+	{
+		Simulator::PeriodicCallback Function;
+		void *Param;
+		double Period;
+	};
+
+	void *RunWallClockCallback(void *param)
+	{
+		WallClockCallback *callback = (WallClockCallback *) param;
+		double next = Simulator::GetTime() + callback->Period;
+		while (true) {
+			SleepWallClock(next - Simulator::GetTime());
+			callback->Function(callback->Param);
+			next += callback->Period;
+		}
+		return NULL;
+	}
+}
+
+/**
+ * @brief Seconds since the simulator started.
+ */
+double Simulator::GetTime()
+{
+	if (!sVirtualClock) {
+		return ReadMonotonicClock() - sClockOrigin;
+	}
+	pthread_mutex_lock(&sClockLock);
+	double now = sVirtualTime;
+	pthread_mutex_unlock(&sClockLock);
+	return now;
+}
+
+/**
+ * @brief Blocks the calling thread for the given number of seconds of
+ * simulator time.
+ */
+void Simulator::Sleep(double seconds)
+{
+	if (!sVirtualClock) {
+		SleepWallClock(seconds);
+		return;
+	}
+	if (seconds < 0) {
+		seconds = 0;
+	}
+	pthread_mutex_lock(&sClockLock);
+	double wake = sVirtualTime + seconds;
+	std::multiset<double>::iterator entry = sWakeTimes.insert(wake);
+	sRunningThreads--;
+	AdvanceIfIdle();
+	while (sVirtualTime < wake) {
+		pthread_cond_wait(&sClockChanged, &sClockLock);
+	}
+	sWakeTimes.erase(entry);
+	sRunningThreads++;
+	pthread_mutex_unlock(&sClockLock);
+}
+
+/**
+ * @brief Switches to the virtual clock, starting at zero.  The calling
+ * thread counts as the first simulated thread.
+ */
+void Simulator::UseVirtualClock()
+{
+	pthread_mutex_lock(&sClockLock);
+	sVirtualClock = true;
+	sVirtualTime = 0.0;
+	sRunningThreads = 1;
+	pthread_mutex_unlock(&sClockLock);
+}
+
+bool Simulator::IsVirtualClock()
+{
+	return sVirtualClock;
+}
+
+/**
+ * @brief Counts a new thread.  Call this before the thread is created
+ * so the clock can't move on without it.
+ */
+void Simulator::AddThread()
+{
+	pthread_mutex_lock(&sClockLock);
+	sRunningThreads++;
+	pthread_mutex_unlock(&sClockLock);
+}
+
+/**
+ * @brief Stops counting the calling thread (call it as the thread
+ * exits).
+ */
+void Simulator::RemoveThread()
+{
+	pthread_mutex_lock(&sClockLock);
+	sRunningThreads--;
+	if (sVirtualClock) {
+		AdvanceIfIdle();
+	}
+	pthread_mutex_unlock(&sClockLock);
+}
+
+/**
+ * @brief Marks the calling thread as waiting on another simulated
+ * thread (for example, joining it) so time can move on meanwhile.
+ */
+void Simulator::BeginBlocking()
+{
+	RemoveThread();
+}
+
+void Simulator::EndBlocking()
+{
+	AddThread();
+}
+
+/**
+ * @brief Calls a host function every period seconds.  Used to play
+ * match scripts and to model the robot's physics.
+ */
+void Simulator::AddPeriodicCallback(PeriodicCallback function, void *param, double period)
+{
+	if (sVirtualClock) {
+		pthread_mutex_lock(&sClockLock);
+		Callback callback;
+		callback.Function = function;
+		callback.Param = param;
+		callback.Period = period;
+		callback.Next = sVirtualTime + period;
+		sCallbacks.push_back(callback);
+		pthread_mutex_unlock(&sClockLock);
+		return;
+	}
+	WallClockCallback *callback = new WallClockCallback;
+	callback->Function = function;
+	callback->Param = param;
+	callback->Period = period;
+	pthread_t thread;
+	pthread_create(&thread, NULL, RunWallClockCallback, callback);
+	pthread_detach(thread);
+}
+
+/**
+ * @brief Starts a match now.
+ *
+ * @param[in] autonomousLength Length of autonomous, in seconds.
+ * @param[in] teleopLength Length of teleop, in seconds.
+ */
+void Simulator::StartMatch(double autonomousLength, double teleopLength)
+{
+	sAutonomousLength = autonomousLength;
+	sTeleopLength = teleopLength;
+	sMatchStart = GetTime();
+}
+
+double Simulator::GetMatchTime()
+{
+	return GetTime() - sMatchStart;
+}
+
+bool Simulator::IsMatchOver()
+{
+	return GetMatchTime() >= sAutonomousLength + sTeleopLength;
+}
+
+bool Simulator::IsAutonomousPeriod()
+{
+	return GetMatchTime() < sAutonomousLength;
+}
+
+bool Simulator::IsTeleopPeriod()
+{
+	double matchTime = GetMatchTime();
+	return (sAutonomousLength <= matchTime) and (matchTime < sAutonomousLength + sTeleopLength);
+}
+
+void Simulator::SetStickAxis(UINT32 stick, UINT32 axis, float value)
+{
+	pthread_mutex_lock(&sTableLock);
+	sStickAxes[Clamp(stick, kNumSticks)][Clamp(axis, kNumStickAxes + 1)] = value;
+	pthread_mutex_unlock(&sTableLock);
+}
+
+float Simulator::GetStickAxis(UINT32 stick, UINT32 axis)
+{
+	pthread_mutex_lock(&sTableLock);
+	float value = sStickAxes[Clamp(stick, kNumSticks)][Clamp(axis, kNumStickAxes + 1)];
+	pthread_mutex_unlock(&sTableLock);
+	return value;
+}
+
+/**
+ * @brief Presses or releases a button (buttons are 1-based, like the
+ * robot code uses them).
+ */
+void Simulator::SetStickButton(UINT32 stick, UINT32 button, bool pressed)
+{
+	if ((button < 1) or (button > kNumStickButtons)) {
+		return;
+	}
+	pthread_mutex_lock(&sTableLock);
+	UINT16 mask = (UINT16) (1 << (button - 1));
+	if (pressed) {
+		sStickButtons[Clamp(stick, kNumSticks)] |= mask;
+	} else {
+		sStickButtons[Clamp(stick, kNumSticks)] &= (UINT16) ~mask;
+	}
+	pthread_mutex_unlock(&sTableLock);
+}
+
+UINT16 Simulator::GetStickButtons(UINT32 stick)
+{
+	pthread_mutex_lock(&sTableLock);
+	UINT16 buttons = sStickButtons[Clamp(stick, kNumSticks)];
+	pthread_mutex_unlock(&sTableLock);
+	return buttons;
+}
+
+void Simulator::SetPwm(UINT32 module, UINT32 channel, float value)
+{
+	sPwm[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = value;
+}
+
+float Simulator::GetPwm(UINT32 module, UINT32 channel)
+{
+	return sPwm[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+void Simulator::SetSolenoid(UINT32 module, UINT32 channel, bool on)
+{
+	sSolenoid[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = on;
+}
+
+bool Simulator::GetSolenoid(UINT32 module, UINT32 channel)
+{
+	return sSolenoid[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+void Simulator::SetRelay(UINT32 module, UINT32 channel, INT32 value)
+{
+	sRelay[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = value;
+}
+
+INT32 Simulator::GetRelay(UINT32 module, UINT32 channel)
+{
+	return sRelay[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+void Simulator::SetDigitalInput(UINT32 module, UINT32 channel, bool value)
+{
+	sDigitalInput[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = value;
+}
+
+bool Simulator::GetDigitalInput(UINT32 module, UINT32 channel)
+{
+	return sDigitalInput[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+void Simulator::SetAnalogValue(UINT32 module, UINT32 channel, INT32 value)
+{
+	sAnalogValue[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = value;
+}
+
+INT32 Simulator::GetAnalogValue(UINT32 module, UINT32 channel)
+{
+	return sAnalogValue[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+void Simulator::SetGyroAngle(UINT32 module, UINT32 channel, float angle)
+{
+	sGyroAngle[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)] = angle;
+}
+
+float Simulator::GetGyroAngle(UINT32 module, UINT32 channel)
+{
+	return sGyroAngle[Clamp(module, kNumModules)][Clamp(channel, kNumChannels)];
+}
+
+/**
+ * @brief Sets the count and rate (counts per second) an encoder
+ * reports.  The encoder is identified by its A channel.
+ */
+void Simulator::SetEncoder(UINT32 module, UINT32 aChannel, INT32 count, double rate)
+{
+	pthread_mutex_lock(&sTableLock);
+	EncoderState &state = sEncoder[Clamp(module, kNumModules)][Clamp(aChannel, kNumChannels)];
+	state.Count = count;
+	state.Rate = rate;
+	pthread_mutex_unlock(&sTableLock);
+}
+
+INT32 Simulator::GetEncoderCount(UINT32 module, UINT32 aChannel)
+{
+	pthread_mutex_lock(&sTableLock);
+	INT32 count = sEncoder[Clamp(module, kNumModules)][Clamp(aChannel, kNumChannels)].Count;
+	pthread_mutex_unlock(&sTableLock);
+	return count;
+}
+
+double Simulator::GetEncoderRate(UINT32 module, UINT32 aChannel)
+{
+	pthread_mutex_lock(&sTableLock);
+	double rate = sEncoder[Clamp(module, kNumModules)][Clamp(aChannel, kNumChannels)].Rate;
+	pthread_mutex_unlock(&sTableLock);
+	return rate;
+}
+
+/**
+ * @brief Hands the camera a new frame.
+ *
+ * @param[in] pixels Packed RGB bytes, three per pixel.
+ * @param[in] width Width in pixels.
+ * @param[in] height Height in pixels.
+ */
+void Simulator::SetCameraFrame(const UINT8 *pixels, int width, int height)
+{
+	pthread_mutex_lock(&sTableLock);
+	sCameraFrame.assign(pixels, pixels + width * height * 3);
+	sCameraWidth = width;
+	sCameraHeight = height;
+	sCameraFrameNumber++;
+	pthread_mutex_unlock(&sTableLock);
+}
+
+/**
+ * @brief Loads a binary (P6) PPM file and hands it to the camera.
+ */
+bool Simulator::LoadCameraFrame(const char *fileName)
+{
+	FILE *file = fopen(fileName, "rb");
+	if (file == NULL) {
+		return false;
+	}
+	int width = 0;
+	int height = 0;
+	int maxValue = 0;
+	bool ok = (fscanf(file, "P6 %d %d %d", &width, &height, &maxValue) == 3)
+			and (width > 0) and (height > 0) and (maxValue == 255);
+	std::vector<UINT8> pixels;
+	if (ok) {
+		fgetc(file);
+		pixels.resize(width * height * 3);
+		ok = (fread(&pixels[0], 1, pixels.size(), file) == pixels.size());
+	}
+	fclose(file);
+	if (ok) {
+		SetCameraFrame(&pixels[0], width, height);
+	}
+	return ok;
+}
+
+/**
+ * @brief Counts up every time a new frame is handed to the camera.
+ */
+UINT32 Simulator::GetCameraFrameNumber()
+{
+	pthread_mutex_lock(&sTableLock);
+	UINT32 frameNumber = sCameraFrameNumber;
+	pthread_mutex_unlock(&sTableLock);
+	return frameNumber;
+}
+
+void Simulator::GetCameraFrameSize(int &width, int &height)
+{
+	pthread_mutex_lock(&sTableLock);
+	width = sCameraConnected ? sCameraWidth : 0;
+	height = sCameraConnected ? sCameraHeight : 0;
+	pthread_mutex_unlock(&sTableLock);
+}
+
+/**
+ * @brief Unplugs (or plugs back in) the camera.  While unplugged,
+ * no frames arrive and GetImage fails, as if no frame had ever
+ * been set.
+ */
+void Simulator::SetCameraConnected(bool connected)
+{
+	pthread_mutex_lock(&sTableLock);
+	sCameraConnected = connected;
+	pthread_mutex_unlock(&sTableLock);
+}
+
+/**
+ * @brief Copies the current frame out, if it is the expected size.
+ */
+bool Simulator::GetCameraFrame(UINT8 *pixels, int width, int height)
+{
+	pthread_mutex_lock(&sTableLock);
+	bool ok = sCameraConnected and (width == sCameraWidth) and (height == sCameraHeight) and !sCameraFrame.empty();
+	if (ok) {
+		memcpy(pixels, &sCameraFrame[0], sCameraFrame.size());
+	}
+	pthread_mutex_unlock(&sTableLock);
+	return ok;
+}
@@ -0,0 +1,130 @@
+#include "SmartDashboard.h"
+#include "NetworkTables/NetworkTable.h"
+
+#include <stdio.h>
+
+namespace
+{
+	const char *kTableName = "SmartDashboard";
+}
+
+SmartDashboard::SmartDashboard()
+{
+}
+
+SmartDashboard *SmartDashboard::GetInstance()
+{
+	static SmartDashboard instance;
+	return &instance;
+}
+
+NetworkTable *SmartDashboard::GetTable()
+{
+	return NetworkTable::GetTable(kTableName);
+}
+
+void SmartDashboard::PutBoolean(const char *keyName, bool value)
+{
+	GetTable()->PutBoolean(keyName, value);
+}
+
+bool SmartDashboard::GetBoolean(const char *keyName)
+{
+	return GetTable()->GetBoolean(keyName);
+}
+
+void SmartDashboard::PutInt(const char *keyName, int value)
+{
+	GetTable()->PutInt(keyName, value);
+}
+
+int SmartDashboard::GetInt(const char *keyName)
+{
+	return GetTable()->GetInt(keyName);
+}
+
+void SmartDashboard::PutDouble(const char *keyName, double value)
+{
+	GetTable()->PutDouble(keyName, value);
+}
+
+double SmartDashboard::GetDouble(const char *keyName)
+{
+	return GetTable()->GetDouble(keyName);
+}
+
+void SmartDashboard::PutString(const char *keyName, const char *value)
+{
+	GetTable()->PutString(keyName, value);
+}
+
+void SmartDashboard::PutString(std::string keyName, std::string value)
+{
+	GetTable()->PutString(keyName, value);
+}
+
+std::string SmartDashboard::GetString(const char *keyName)
+{
+	return GetTable()->GetString(keyName);
+}
+
+std::string SmartDashboard::GetString(std::string keyName)
+{
+	return GetTable()->GetString(keyName);
+}
+
+int SmartDashboard::GetString(const char *keyName, char *value, int len)
+{
+	return GetTable()->GetString(keyName, value, len);
+}
+
+void SmartDashboard::Log(bool value, const char *name)
+{
+	PutBoolean(name, value);
+}
+
+void SmartDashboard::Log(char value, const char *name)
+{
+	char text[2] = {value, '\0'};
+	PutString(name, text);
+}
+
+void SmartDashboard::Log(UINT8 value, const char *name)
+{
+	PutInt(name, value);
+}
+
+void SmartDashboard::Log(INT16 value, const char *name)
+{
+	PutInt(name, value);
+}
+
+void SmartDashboard::Log(UINT16 value, const char *name)
+{
+	PutInt(name, value);
+}
+
+void SmartDashboard::Log(INT32 value, const char *name)
+{
+	PutInt(name, value);
+}
+
+void SmartDashboard::Log(UINT32 value, const char *name)
+{
+	PutInt(name, (int) value);
+}
+
+void SmartDashboard::Log(float value, const char *name)
+{
+	PutDouble(name, value);
+}
+
+void SmartDashboard::Log(double value, const char *name)
+{
+	PutDouble(name, value);
+}
+
+void SmartDashboard::Log(const char *value, const char *name)
+{
+	PutString(name, value);
+}
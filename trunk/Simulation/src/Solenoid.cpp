@@ -0,0 +1,28 @@
+#include "Solenoid.h"
+#include "Simulator.h"
+
+Solenoid::Solenoid(UINT32 channel)
+{
+	m_moduleNumber = 1;
+	m_channel = channel;
+}
+
+Solenoid::Solenoid(UINT8 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+}
+
+Solenoid::~Solenoid()
+{
+}
+
+void Solenoid::Set(bool on)
+{
+	Simulator::SetSolenoid(m_moduleNumber, m_channel, on);
+}
+
+bool Solenoid::Get()
+{
+	return Simulator::GetSolenoid(m_moduleNumber, m_channel);
+}
@@ -0,0 +1,119 @@
+#include "SpeedController.h"
+#include "Simulator.h"
+
+namespace
+{
+	const UINT32 kDefaultDigitalModule = 1;
+
+	float LimitOutput(float value)
+	{
+		if (value > 1.0) {
+			return 1.0;
+		}
+		if (value < -1.0) {
+			return -1.0;
+		}
+		return value;
+	}
+}
+
+PWMSpeedController::PWMSpeedController(UINT32 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+	Simulator::SetPwm(m_moduleNumber, m_channel, 0.0);
+}
+
+PWMSpeedController::~PWMSpeedController()
+{
+	Simulator::SetPwm(m_moduleNumber, m_channel, 0.0);
+}
+
+void PWMSpeedController::Set(float speed, UINT8 syncGroup)
+{
+	Simulator::SetPwm(m_moduleNumber, m_channel, LimitOutput(speed));
+}
+
+float PWMSpeedController::Get()
+{
+	return Simulator::GetPwm(m_moduleNumber, m_channel);
+}
+
+void PWMSpeedController::Disable()
+{
+	Simulator::SetPwm(m_moduleNumber, m_channel, 0.0);
+}
+
+UINT32 PWMSpeedController::GetModuleNumber()
+{
+	return m_moduleNumber;
+}
+
+UINT32 PWMSpeedController::GetChannel()
+{
+	return m_channel;
+}
+
+Jaguar::Jaguar(UINT32 channel) :
+		PWMSpeedController(kDefaultDigitalModule, channel)
+{
+}
+
+Jaguar::Jaguar(UINT8 moduleNumber, UINT32 channel) :
+		PWMSpeedController(moduleNumber, channel)
+{
+}
+
+Victor::Victor(UINT32 channel) :
+		PWMSpeedController(kDefaultDigitalModule, channel)
+{
+}
+
+Victor::Victor(UINT8 moduleNumber, UINT32 channel) :
+		PWMSpeedController(moduleNumber, channel)
+{
+}
+
+/**
+ * Servo positions are stored in the PWM table as 0.0 to 1.0.
+ */
+Servo::Servo(UINT32 channel)
+{
+	m_moduleNumber = kDefaultDigitalModule;
+	m_channel = channel;
+}
+
+Servo::Servo(UINT8 moduleNumber, UINT32 channel)
+{
+	m_moduleNumber = moduleNumber;
+	m_channel = channel;
+}
+
+Servo::~Servo()
+{
+}
+
+void Servo::Set(float value)
+{
+	if (value < 0.0) {
+		value = 0.0;
+	} else if (value > 1.0) {
+		value = 1.0;
+	}
+	Simulator::SetPwm(m_moduleNumber, m_channel, value);
+}
+
+float Servo::Get()
+{
+	return Simulator::GetPwm(m_moduleNumber, m_channel);
+}
+
+void Servo::SetAngle(float angle)
+{
+	Set(angle / 170.0);
+}
+
+float Servo::GetAngle()
+{
+	return Get() * 170.0;
+}
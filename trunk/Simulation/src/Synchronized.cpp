@@ -0,0 +1,12 @@
+#include "Synchronized.h"
+
+Synchronized::Synchronized(SEM_ID semaphore)
+{
+	m_semaphore = semaphore;
+	semTake(m_semaphore, WAIT_FOREVER);
+}
+
+Synchronized::~Synchronized()
+{
+	semGive(m_semaphore);
+}
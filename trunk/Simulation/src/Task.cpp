@@ -0,0 +1,131 @@
+#include "Task.h"
+#include "Simulator.h"
+
+namespace
+{
+	INT32 sNextTaskID = 1;
+}
+
+Task::Task(const char *name, FUNCPTR function, INT32 priority, UINT32 stackSize)
+{
+	m_function = function;
+	m_taskName = new char[strlen(name) + 1];
+	strcpy(m_taskName, name);
+	m_priority = priority;
+	m_taskID = kInvalidTaskID;
+	m_running = false;
+	m_stopRequested = false;
+	memset(m_args, 0, sizeof(m_args));
+}
+
+Task::~Task()
+{
+	if (m_taskID != kInvalidTaskID) {
+		Stop();
+	}
+	delete [] m_taskName;
+}
+
+bool Task::Start(UINT32 arg0, UINT32 arg1, UINT32 arg2, UINT32 arg3, UINT32 arg4,
+		UINT32 arg5, UINT32 arg6, UINT32 arg7, UINT32 arg8, UINT32 arg9)
+{
+	if (m_taskID != kInvalidTaskID) {
+		return false;
+	}
+	UINT32 args[10] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9};
+	memcpy(m_args, args, sizeof(m_args));
+	m_stopRequested = false;
+	m_running = true;
+	Simulator::AddThread();
+	if (pthread_create(&m_thread, NULL, Task::ThreadEntry, this) != 0) {
+		Simulator::RemoveThread();
+		m_running = false;
+		return false;
+	}
+	m_taskID = __sync_fetch_and_add(&sNextTaskID, 1);
+	return true;
+}
+
+bool Task::Restart()
+{
+	Stop();
+	return Start(m_args[0], m_args[1], m_args[2], m_args[3], m_args[4],
+			m_args[5], m_args[6], m_args[7], m_args[8], m_args[9]);
+}
+
+/**
+ * @brief Asks the task to finish and waits until it has.
+ */
+bool Task::Stop()
+{
+	if (m_taskID == kInvalidTaskID) {
+		return false;
+	}
+	m_stopRequested = true;
+	if (!pthread_equal(pthread_self(), m_thread)) {
+		Simulator::BeginBlocking();
+		pthread_join(m_thread, NULL);
+		Simulator::EndBlocking();
+	} else {
+		pthread_detach(m_thread);
+	}
+	m_taskID = kInvalidTaskID;
+	return true;
+}
+
+bool Task::IsReady()
+{
+	return m_running;
+}
+
+bool Task::IsSuspended()
+{
+	return false;
+}
+
+bool Task::Suspend()
+{
+	return false;
+}
+
+bool Task::Resume()
+{
+	return false;
+}
+
+bool Task::Verify()
+{
+	return (m_taskID != kInvalidTaskID) and m_running and !m_stopRequested;
+}
+
+INT32 Task::GetPriority()
+{
+	return m_priority;
+}
+
+bool Task::SetPriority(INT32 priority)
+{
+	m_priority = priority;
+	return true;
+}
+
+const char *Task::GetName()
+{
+	return m_taskName;
+}
+
+INT32 Task::GetID()
+{
+	return m_taskID;
+}
+
+void *Task::ThreadEntry(void *taskObject)
+{
+	Task *task = (Task *) taskObject;
+	task->m_function(task->m_args[0], task->m_args[1], task->m_args[2], task->m_args[3],
+			task->m_args[4], task->m_args[5], task->m_args[6], task->m_args[7],
+			task->m_args[8], task->m_args[9]);
+	task->m_running = false;
+	Simulator::RemoveThread();
+	return NULL;
+}
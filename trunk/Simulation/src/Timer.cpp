@@ -0,0 +1,88 @@
+#include "Timer.h"
+#include "Simulator.h"
+
+#include <time.h>
+
+void Wait(double seconds)
+{
+	Simulator::Sleep(seconds);
+}
+
+double GetClock()
+{
+	return Simulator::GetTime();
+}
+
+double GetTime()
+{
+	return Simulator::GetTime();
+}
+
+Timer::Timer()
+{
+	m_startTime = 0.0;
+	m_accumulatedTime = 0.0;
+	m_running = false;
+	Reset();
+}
+
+Timer::~Timer()
+{
+}
+
+double Timer::Get()
+{
+	double result = m_accumulatedTime;
+	if (m_running) {
+		result += GetFPGATimestamp() - m_startTime;
+	}
+	return result;
+}
+
+void Timer::Reset()
+{
+	m_accumulatedTime = 0.0;
+	m_startTime = GetFPGATimestamp();
+}
+
+void Timer::Start()
+{
+	if (!m_running) {
+		m_startTime = GetFPGATimestamp();
+		m_running = true;
+	}
+}
+
+void Timer::Stop()
+{
+	if (m_running) {
+		m_accumulatedTime += GetFPGATimestamp() - m_startTime;
+		m_running = false;
+	}
+}
+
+bool Timer::HasPeriodPassed(double period)
+{
+	if (Get() > period) {
+		m_startTime += period;
+		return true;
+	}
+	return false;
+}
+
+double Timer::GetFPGATimestamp()
+{
+	return Simulator::GetTime();
+}
+
+/**
+ * On the cRIO this is the processor's clock rather than the
+ * FPGA's; here it's the host's, so it can time code (see
+ * StageTimer) even though simulated time stands still meanwhile.
+ */
+double Timer::GetPPCTimestamp()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
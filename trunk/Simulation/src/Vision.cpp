@@ -0,0 +1,224 @@
+#include "Vision/BinaryImage.h"
+#include "Vision/ColorImage.h"
+#include "Vision/HSLImage.h"
+#include "Vision/ImageBase.h"
+#include "Vision/MonoImage.h"
+#include "Vision/RGBImage.h"
+#include "Vision/Threshold.h"
+
+#include <algorithm>
+
+Threshold::Threshold(int new_plane1Low, int new_plane1High, int new_plane2Low,
+		int new_plane2High, int new_plane3Low, int new_plane3High)
+{
+	plane1Low = new_plane1Low;
+	plane1High = new_plane1High;
+	plane2Low = new_plane2Low;
+	plane2High = new_plane2High;
+	plane3Low = new_plane3Low;
+	plane3High = new_plane3High;
+}
+
+ImageBase::ImageBase(ImageType type)
+{
+	m_imaqImage = imaqCreateImage(type, 0);
+}
+
+ImageBase::~ImageBase()
+{
+	if (m_imaqImage != NULL) {
+		imaqDispose(m_imaqImage);
+	}
+}
+
+void ImageBase::Write(const char *fileName)
+{
+	imaqWriteFile(m_imaqImage, fileName, NULL);
+}
+
+int ImageBase::GetHeight()
+{
+	int height = 0;
+	imaqGetImageSize(m_imaqImage, NULL, &height);
+	return height;
+}
+
+int ImageBase::GetWidth()
+{
+	int width = 0;
+	imaqGetImageSize(m_imaqImage, &width, NULL);
+	return width;
+}
+
+Image *ImageBase::GetImaqImage()
+{
+	return m_imaqImage;
+}
+
+MonoImage::MonoImage() :
+		ImageBase(IMAQ_IMAGE_U8)
+{
+}
+
+MonoImage::~MonoImage()
+{
+}
+
+BinaryImage::BinaryImage()
+{
+}
+
+BinaryImage::~BinaryImage()
+{
+}
+
+int BinaryImage::GetNumberParticles()
+{
+	int numParticles = 0;
+	imaqCountParticles(m_imaqImage, 1, &numParticles);
+	return numParticles;
+}
+
+ParticleAnalysisReport BinaryImage::GetParticleAnalysisReport(int particleNumber)
+{
+	ParticleAnalysisReport par;
+	GetParticleAnalysisReport(particleNumber, &par);
+	return par;
+}
+
+void BinaryImage::GetParticleAnalysisReport(int particleNumber, ParticleAnalysisReport *par)
+{
+	int width = GetWidth();
+	int height = GetHeight();
+	par->imageWidth = width;
+	par->imageHeight = height;
+	par->imageTimestamp = 0;
+	par->particleIndex = particleNumber;
+	par->center_mass_x = (int) ParticleMeasurement(particleNumber, IMAQ_MT_CENTER_OF_MASS_X);
+	par->center_mass_y = (int) ParticleMeasurement(particleNumber, IMAQ_MT_CENTER_OF_MASS_Y);
+	par->particleArea = ParticleMeasurement(particleNumber, IMAQ_MT_AREA);
+	par->boundingRect.top = (int) ParticleMeasurement(particleNumber, IMAQ_MT_BOUNDING_RECT_TOP);
+	par->boundingRect.left = (int) ParticleMeasurement(particleNumber, IMAQ_MT_BOUNDING_RECT_LEFT);
+	par->boundingRect.height = (int) ParticleMeasurement(particleNumber, IMAQ_MT_BOUNDING_RECT_HEIGHT);
+	par->boundingRect.width = (int) ParticleMeasurement(particleNumber, IMAQ_MT_BOUNDING_RECT_WIDTH);
+	par->particleToImagePercent = (width * height > 0) ? 100.0 * par->particleArea / (width * height) : 0;
+	par->particleQuality = 100.0;
+	par->center_mass_x_normalized = (width > 0) ? (2.0 * par->center_mass_x / width) - 1.0 : 0;
+	par->center_mass_y_normalized = (height > 0) ? (2.0 * par->center_mass_y / height) - 1.0 : 0;
+}
+
+namespace
+{
+	bool CompareParticleSizes(ParticleAnalysisReport particle1, ParticleAnalysisReport particle2)
+	{
+		return particle1.particleToImagePercent > particle2.particleToImagePercent;
+	}
+}
+
+std::vector<ParticleAnalysisReport> *BinaryImage::GetOrderedParticleAnalysisReports()
+{
+	std::vector<ParticleAnalysisReport> *particles = new std::vector<ParticleAnalysisReport>;
+	int particleCount = GetNumberParticles();
+	for (int particleIndex = 0; particleIndex < particleCount; particleIndex++) {
+		particles->push_back(GetParticleAnalysisReport(particleIndex));
+	}
+	std::sort(particles->begin(), particles->end(), CompareParticleSizes);
+	return particles;
+}
+
+double BinaryImage::ParticleMeasurement(int particleNumber, MeasurementType whatToMeasure)
+{
+	double result = 0;
+	imaqMeasureParticle(m_imaqImage, particleNumber, 0, whatToMeasure, &result);
+	return result;
+}
+
+BinaryImage *BinaryImage::RemoveSmallObjects(bool connectivity8, int erosions)
+{
+	BinaryImage *result = new BinaryImage();
+	imaqSizeFilter(result->GetImaqImage(), m_imaqImage, connectivity8, erosions, IMAQ_KEEP_LARGE, NULL);
+	return result;
+}
+
+BinaryImage *BinaryImage::RemoveLargeObjects(bool connectivity8, int erosions)
+{
+	BinaryImage *result = new BinaryImage();
+	imaqSizeFilter(result->GetImaqImage(), m_imaqImage, connectivity8, erosions, IMAQ_KEEP_SMALL, NULL);
+	return result;
+}
+
+BinaryImage *BinaryImage::ConvexHull(bool connectivity8)
+{
+	BinaryImage *result = new BinaryImage();
+	imaqConvexHull(result->GetImaqImage(), m_imaqImage, connectivity8);
+	return result;
+}
+
+ColorImage::ColorImage(ImageType type) :
+		ImageBase(type)
+{
+}
+
+ColorImage::~ColorImage()
+{
+}
+
+BinaryImage *ColorImage::ComputeThreshold(ColorMode colorMode, int low1, int high1, int low2, int high2, int low3, int high3)
+{
+	BinaryImage *result = new BinaryImage();
+	Range range1 = {low1, high1};
+	Range range2 = {low2, high2};
+	Range range3 = {low3, high3};
+	imaqColorThreshold(result->GetImaqImage(), m_imaqImage, 1, colorMode, &range1, &range2, &range3);
+	return result;
+}
+
+BinaryImage *ColorImage::ThresholdRGB(int redLow, int redHigh, int greenLow, int greenHigh, int blueLow, int blueHigh)
+{
+	return ComputeThreshold(IMAQ_RGB, redLow, redHigh, greenLow, greenHigh, blueLow, blueHigh);
+}
+
+BinaryImage *ColorImage::ThresholdHSL(int hueLow, int hueHigh, int saturationLow, int saturationHigh, int luminenceLow, int luminenceHigh)
+{
+	return ComputeThreshold(IMAQ_HSL, hueLow, hueHigh, saturationLow, saturationHigh, luminenceLow, luminenceHigh);
+}
+
+BinaryImage *ColorImage::ThresholdRGB(Threshold &t)
+{
+	return ThresholdRGB(t.plane1Low, t.plane1High, t.plane2Low, t.plane2High, t.plane3Low, t.plane3High);
+}
+
+BinaryImage *ColorImage::ThresholdHSL(Threshold &t)
+{
+	return ThresholdHSL(t.plane1Low, t.plane1High, t.plane2Low, t.plane2High, t.plane3Low, t.plane3High);
+}
+
+HSLImage::HSLImage() :
+		ColorImage(IMAQ_IMAGE_HSL)
+{
+}
+
+HSLImage::HSLImage(const char *fileName) :
+		ColorImage(IMAQ_IMAGE_HSL)
+{
+	imaqReadFile(m_imaqImage, fileName, NULL, NULL);
+}
+
+HSLImage::~HSLImage()
+{
+}
+
+RGBImage::RGBImage() :
+		ColorImage(IMAQ_IMAGE_RGB)
+{
+}
+
+RGBImage::RGBImage(const char *fileName) :
+		ColorImage(IMAQ_IMAGE_RGB)
+{
+	imaqReadFile(m_imaqImage, fileName, NULL, NULL);
+}
+
+RGBImage::~RGBImage()
+{
+}
@@ -0,0 +1,73 @@
+#include "Watchdog.h"
+#include "Simulator.h"
+
+Watchdog::Watchdog()
+{
+	m_expiration = kDefaultWatchdogExpiration;
+	m_lastFed = Simulator::GetTime();
+	m_enabled = true;
+	m_starvedCount = 0;
+}
+
+Watchdog::~Watchdog()
+{
+}
+
+/**
+ * @brief Feeds the watchdog, counting it as starved if it was fed too
+ * late.
+ */
+bool Watchdog::Feed()
+{
+	double now = Simulator::GetTime();
+	if (m_enabled and (now - m_lastFed > m_expiration)) {
+		m_starvedCount++;
+	}
+	m_lastFed = now;
+	return true;
+}
+
+void Watchdog::Kill()
+{
+}
+
+double Watchdog::GetTimer()
+{
+	return Simulator::GetTime() - m_lastFed;
+}
+
+double Watchdog::GetExpiration()
+{
+	return m_expiration;
+}
+
+void Watchdog::SetExpiration(double expiration)
+{
+	m_expiration = expiration;
+}
+
+bool Watchdog::GetEnabled()
+{
+	return m_enabled;
+}
+
+void Watchdog::SetEnabled(bool enabled)
+{
+	m_enabled = enabled;
+	m_lastFed = Simulator::GetTime();
+}
+
+bool Watchdog::IsAlive()
+{
+	return !m_enabled or (GetTimer() <= m_expiration);
+}
+
+bool Watchdog::IsSystemActive()
+{
+	return true;
+}
+
+UINT32 Watchdog::GetStarvedCount()
+{
+	return m_starvedCount;
+}
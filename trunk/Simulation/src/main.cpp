@@ -0,0 +1,105 @@
+/**
+ * @file main.cpp
+ *
+ * @brief Host entry point: plays one simulated match against whichever
+ * robot profile this executable was built with.
+ *
+ * @details
+ * Usage:
+ *
+ *     mainrobot [--auto SECONDS] [--teleop SECONDS] [--frame FILE.ppm]
+ *               [--script FILE] [--realtime]
+ *
+ * By default the match runs on a virtual clock, which jumps ahead
+ * whenever every robot thread is waiting, so a full 2:15 match plays
+ * in a fraction of a second.  --realtime uses the wall clock instead
+ * (handy with a live dashboard).  --script plays a match script (see
+ * MatchScript.cpp).
+ *
+ * The exit status is nonzero if the robot let the watchdog starve,
+ * or if any of the script's expect lines didn't hold.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "RobotBase.h"
+#include "Simulator.h"
+
+namespace
+{
+	const double kDefaultAutonomousLength = 15.0;
+	const double kDefaultTeleopLength = 120.0;
+
+	void PrintUsage(const char *program)
+	{
+		fprintf(stderr, "usage: %s [--auto SECONDS] [--teleop SECONDS] [--frame FILE.ppm]"
+				" [--script FILE] [--realtime]\n", program);
+	}
+
+	double ReadWallClock()
+	{
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec * 1e-9;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	double autonomousLength = kDefaultAutonomousLength;
+	double teleopLength = kDefaultTeleopLength;
+	bool realtime = false;
+	const char *scriptName = NULL;
+
+	for (int i = 1; i < argc; i++) {
+		bool hasValue = (i + 1 < argc);
+		if ((strcmp(argv[i], "--auto") == 0) and hasValue) {
+			autonomousLength = atof(argv[++i]);
+		} else if ((strcmp(argv[i], "--teleop") == 0) and hasValue) {
+			teleopLength = atof(argv[++i]);
+		} else if ((strcmp(argv[i], "--frame") == 0) and hasValue) {
+			const char *fileName = argv[++i];
+			if (!Simulator::LoadCameraFrame(fileName)) {
+				fprintf(stderr, "could not read camera frame %s\n", fileName);
+				return 2;
+			}
+		} else if ((strcmp(argv[i], "--script") == 0) and hasValue) {
+			scriptName = argv[++i];
+		} else if (strcmp(argv[i], "--realtime") == 0) {
+			realtime = true;
+		} else {
+			PrintUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	double wallStart = ReadWallClock();
+	if (!realtime) {
+		Simulator::UseVirtualClock();
+	}
+	if ((scriptName != NULL) and !Simulator::LoadMatchScript(scriptName)) {
+		return 2;
+	}
+
+	RobotBase *robot = FRC_userClassFactory();
+	Simulator::StartMatch(autonomousLength, teleopLength);
+	robot->StartCompetition();
+
+	UINT32 starved = robot->GetWatchdog().GetStarvedCount();
+	printf("match over after %.2f s in %.2f s of wall time (%u watchdog starvations)\n",
+			Simulator::GetMatchTime(), ReadWallClock() - wallStart, starved);
+
+	// Background tasks and notifiers are still running, so skip the
+	// static destructors they may depend on.
+	fflush(stdout);
+	fflush(stderr);
+	int failures = Simulator::GetScriptFailureCount();
+	if (failures > 0) {
+		printf("%d script expectations failed\n", failures);
+	}
+	_exit(((starved == 0) and (failures == 0)) ? 0 : 1);
+}
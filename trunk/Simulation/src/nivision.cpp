@@ -0,0 +1,788 @@
+#include "nivision.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+/**
+ * Color images (RGB and HSL alike) are stored as RGBValue, the same
+ * layout NI uses for RGB images.  Every other type is stored one byte
+ * per pixel.
+ */
+struct Image_struct
+{
+	ImageType Type;
+	int Width;
+	int Height;
+	unsigned char *Pixels;
+};
+
+struct ROI_struct
+{
+	std::vector<Rect> Rects;
+	std::vector<ContourID> Ids;
+	ContourID NextId;
+};
+
+namespace
+{
+	pthread_mutex_t sObjectsLock = PTHREAD_MUTEX_INITIALIZER;
+	std::set<void *> sImages;
+	std::set<void *> sRois;
+	int sLastError = 0;
+
+	const int kErrorNone = 0;
+	const int kErrorNullPointer = -1074395269;
+	const int kErrorBadImageType = -1074396080;
+	const int kErrorFile = -1074395991;
+
+	int Fail(int error)
+	{
+		sLastError = error;
+		return 0;
+	}
+
+	bool IsColor(ImageType type)
+	{
+		return (type == IMAQ_IMAGE_RGB) or (type == IMAQ_IMAGE_HSL);
+	}
+
+	int BytesPerPixel(ImageType type)
+	{
+		return IsColor(type) ? (int) sizeof(RGBValue) : 1;
+	}
+
+	void Resize(Image *image, int width, int height)
+	{
+		if ((image->Width == width) and (image->Height == height)) {
+			return;
+		}
+		free(image->Pixels);
+		image->Width = width;
+		image->Height = height;
+		size_t bytes = (size_t) width * height * BytesPerPixel(image->Type);
+		image->Pixels = (bytes > 0) ? (unsigned char *) calloc(bytes, 1) : NULL;
+	}
+
+	RGBValue *ColorPixels(const Image *image)
+	{
+		return (RGBValue *) image->Pixels;
+	}
+
+	/**
+	 * Standard RGB to HSL, with every plane scaled to 0-255 the way NI
+	 * reports them.
+	 */
+	void ToHSL(const RGBValue &rgb, int &hue, int &saturation, int &luminance)
+	{
+		int maxValue = std::max(rgb.R, std::max(rgb.G, rgb.B));
+		int minValue = std::min(rgb.R, std::min(rgb.G, rgb.B));
+		int delta = maxValue - minValue;
+		luminance = (maxValue + minValue) / 2;
+		if (delta == 0) {
+			hue = 0;
+			saturation = 0;
+			return;
+		}
+		int sum = maxValue + minValue;
+		saturation = (luminance < 128) ? (255 * delta / sum) : (255 * delta / (510 - sum));
+		double h;
+		if (maxValue == rgb.R) {
+			h = (double) (rgb.G - rgb.B) / delta;
+		} else if (maxValue == rgb.G) {
+			h = 2.0 + (double) (rgb.B - rgb.R) / delta;
+		} else {
+			h = 4.0 + (double) (rgb.R - rgb.G) / delta;
+		}
+		h *= 256.0 / 6.0;
+		if (h < 0) {
+			h += 256.0;
+		}
+		hue = ((int) h) & 0xFF;
+	}
+
+	bool InRange(int value, const Range *range)
+	{
+		return (range == NULL) or ((range->minValue <= value) and (value <= range->maxValue));
+	}
+
+	/**
+	 * @brief Labels the nonzero pixels of a one-byte image.
+	 *
+	 * Particles are numbered from 1 in the order their first pixel
+	 * is met scanning row by row, which matches NI's numbering.
+	 */
+	int LabelParticles(const Image *image, bool connectivity8, std::vector<int> &labels)
+	{
+		int width = image->Width;
+		int height = image->Height;
+		labels.assign((size_t) width * height, 0);
+		std::vector<int> stack;
+		int count = 0;
+		for (int start = 0; start < width * height; start++) {
+			if ((image->Pixels[start] == 0) or (labels[start] != 0)) {
+				continue;
+			}
+			count++;
+			labels[start] = count;
+			stack.push_back(start);
+			while (!stack.empty()) {
+				int index = stack.back();
+				stack.pop_back();
+				int x = index % width;
+				int y = index / width;
+				for (int dy = -1; dy <= 1; dy++) {
+					for (int dx = -1; dx <= 1; dx++) {
+						if ((dx == 0) and (dy == 0)) {
+							continue;
+						}
+						if (!connectivity8 and (dx != 0) and (dy != 0)) {
+							continue;
+						}
+						int nx = x + dx;
+						int ny = y + dy;
+						if ((nx < 0) or (ny < 0) or (nx >= width) or (ny >= height)) {
+							continue;
+						}
+						int neighbor = ny * width + nx;
+						if ((image->Pixels[neighbor] != 0) and (labels[neighbor] == 0)) {
+							labels[neighbor] = count;
+							stack.push_back(neighbor);
+						}
+					}
+				}
+			}
+		}
+		return count;
+	}
+
+	struct ParticleStats
+	{
+		double Area;
+		double SumX;
+		double SumY;
+		int Left;
+		int Top;
+		int Right;
+		int Bottom;
+	};
+
+	void MeasureAll(const Image *image, const std::vector<int> &labels, int count, std::vector<ParticleStats> &stats)
+	{
+		ParticleStats empty = {0, 0, 0, image->Width, image->Height, -1, -1};
+		stats.assign(count + 1, empty);
+		for (int y = 0; y < image->Height; y++) {
+			for (int x = 0; x < image->Width; x++) {
+				int label = labels[y * image->Width + x];
+				if (label == 0) {
+					continue;
+				}
+				ParticleStats &s = stats[label];
+				s.Area += 1;
+				s.SumX += x;
+				s.SumY += y;
+				s.Left = std::min(s.Left, x);
+				s.Top = std::min(s.Top, y);
+				s.Right = std::max(s.Right, x);
+				s.Bottom = std::max(s.Bottom, y);
+			}
+		}
+	}
+
+	bool IsValidMask(const Image *image)
+	{
+		return (image != NULL) and !IsColor(image->Type);
+	}
+
+	double Cross(const Point &o, const Point &a, const Point &b)
+	{
+		return (double) (a.x - o.x) * (b.y - o.y) - (double) (a.y - o.y) * (b.x - o.x);
+	}
+
+	bool ComparePoints(const Point &a, const Point &b)
+	{
+		return (a.x < b.x) or ((a.x == b.x) and (a.y < b.y));
+	}
+
+	/**
+	 * Andrew's monotone chain; returns the hull counter-clockwise
+	 * (in image coordinates, where y points down).
+	 */
+	std::vector<Point> Hull(std::vector<Point> points)
+	{
+		std::sort(points.begin(), points.end(), ComparePoints);
+		if (points.size() < 3) {
+			return points;
+		}
+		std::vector<Point> hull(2 * points.size());
+		int k = 0;
+		for (size_t i = 0; i < points.size(); i++) {
+			while ((k >= 2) and (Cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) {
+				k--;
+			}
+			hull[k++] = points[i];
+		}
+		for (int i = (int) points.size() - 2, t = k + 1; i >= 0; i--) {
+			while ((k >= t) and (Cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) {
+				k--;
+			}
+			hull[k++] = points[i];
+		}
+		hull.resize(k - 1);
+		return hull;
+	}
+
+	bool InsideHull(const std::vector<Point> &hull, const Point &p)
+	{
+		if (hull.size() < 3) {
+			return true;
+		}
+		for (size_t i = 0; i < hull.size(); i++) {
+			if (Cross(hull[i], hull[(i + 1) % hull.size()], p) < 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	double Distance(const PointFloat &a, const PointFloat &b)
+	{
+		return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+	}
+
+	bool InsideRoi(const ROI *roi, double x, double y)
+	{
+		if ((roi == NULL) or roi->Rects.empty()) {
+			return true;
+		}
+		for (size_t i = 0; i < roi->Rects.size(); i++) {
+			const Rect &r = roi->Rects[i];
+			if ((x >= r.left) and (x < r.left + r.width) and (y >= r.top) and (y < r.top + r.height)) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+Image *imaqCreateImage(ImageType type, int borderSize)
+{
+	Image *image = new Image;
+	image->Type = type;
+	image->Width = 0;
+	image->Height = 0;
+	image->Pixels = NULL;
+	pthread_mutex_lock(&sObjectsLock);
+	sImages.insert(image);
+	pthread_mutex_unlock(&sObjectsLock);
+	return image;
+}
+
+/**
+ * @brief Frees anything handed out by the simulated NI Vision.
+ */
+int imaqDispose(void *object)
+{
+	if (object == NULL) {
+		return Fail(kErrorNullPointer);
+	}
+	pthread_mutex_lock(&sObjectsLock);
+	bool isImage = (sImages.erase(object) > 0);
+	bool isRoi = !isImage and (sRois.erase(object) > 0);
+	pthread_mutex_unlock(&sObjectsLock);
+	if (isImage) {
+		Image *image = (Image *) object;
+		free(image->Pixels);
+		delete image;
+	} else if (isRoi) {
+		delete (ROI *) object;
+	} else {
+		free(object);
+	}
+	return 1;
+}
+
+int imaqSetImageSize(Image *image, int width, int height)
+{
+	if (image == NULL) {
+		return Fail(kErrorNullPointer);
+	}
+	Resize(image, width, height);
+	return 1;
+}
+
+int imaqGetImageSize(const Image *image, int *width, int *height)
+{
+	if (image == NULL) {
+		return Fail(kErrorNullPointer);
+	}
+	if (width != NULL) {
+		*width = image->Width;
+	}
+	if (height != NULL) {
+		*height = image->Height;
+	}
+	return 1;
+}
+
+int imaqGetImageType(const Image *image, ImageType *type)
+{
+	if ((image == NULL) or (type == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	*type = image->Type;
+	return 1;
+}
+
+int imaqGetImageInfo(const Image *image, ImageInfo *info)
+{
+	if ((image == NULL) or (info == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	memset(info, 0, sizeof(ImageInfo));
+	info->imageUnit = IMAQ_UNDEFINED;
+	info->stepX = 1;
+	info->stepY = 1;
+	info->imageType = image->Type;
+	info->xRes = image->Width;
+	info->yRes = image->Height;
+	info->pixelsPerLine = image->Width;
+	info->imageStart = image->Pixels;
+	return 1;
+}
+
+int imaqDuplicate(Image *dest, const Image *source)
+{
+	if ((dest == NULL) or (source == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	if (dest == source) {
+		return 1;
+	}
+	free(dest->Pixels);
+	dest->Pixels = NULL;
+	dest->Width = 0;
+	dest->Height = 0;
+	dest->Type = source->Type;
+	Resize(dest, source->Width, source->Height);
+	if (dest->Pixels != NULL) {
+		memcpy(dest->Pixels, source->Pixels, (size_t) source->Width * source->Height * BytesPerPixel(source->Type));
+	}
+	return 1;
+}
+
+int imaqGetLastError(void)
+{
+	return sLastError;
+}
+
+/**
+ * @brief Reads a binary PPM (P6) into a color image or a binary PGM
+ * (P5) into a grayscale one.  JPEG and the other formats NI supports
+ * are not available on the host.
+ */
+int imaqReadFile(Image *image, const char *fileName, RGBValue *colorTable, int *numColors)
+{
+	if ((image == NULL) or (fileName == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	FILE *file = fopen(fileName, "rb");
+	if (file == NULL) {
+		return Fail(kErrorFile);
+	}
+	char magic[3] = {0, 0, 0};
+	int width = 0;
+	int height = 0;
+	int maxValue = 0;
+	bool ok = (fscanf(file, "%2s %d %d %d", magic, &width, &height, &maxValue) == 4)
+			and (width > 0) and (height > 0) and (maxValue == 255);
+	bool color = (strcmp(magic, "P6") == 0);
+	ok = ok and (color or (strcmp(magic, "P5") == 0)) and (color == IsColor(image->Type));
+	if (ok) {
+		fgetc(file);
+		Resize(image, width, height);
+		if (color) {
+			std::vector<unsigned char> row(width * 3);
+			RGBValue *pixels = ColorPixels(image);
+			for (int y = 0; ok and (y < height); y++) {
+				ok = (fread(&row[0], 1, row.size(), file) == row.size());
+				for (int x = 0; x < width; x++) {
+					RGBValue &p = pixels[y * width + x];
+					p.R = row[x * 3];
+					p.G = row[x * 3 + 1];
+					p.B = row[x * 3 + 2];
+					p.alpha = 0;
+				}
+			}
+		} else {
+			ok = (fread(image->Pixels, 1, (size_t) width * height, file) == (size_t) width * height);
+		}
+	}
+	fclose(file);
+	if (numColors != NULL) {
+		*numColors = 0;
+	}
+	return ok ? 1 : Fail(kErrorFile);
+}
+
+/**
+ * @brief Writes color images as PPM and everything else as PGM.
+ * Binary images are stretched so that particles show up white.
+ */
+int imaqWriteFile(Image *image, const char *fileName, const RGBValue *colorTable)
+{
+	if ((image == NULL) or (fileName == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	FILE *file = fopen(fileName, "wb");
+	if (file == NULL) {
+		return Fail(kErrorFile);
+	}
+	int pixelCount = image->Width * image->Height;
+	if (IsColor(image->Type)) {
+		fprintf(file, "P6\n%d %d\n255\n", image->Width, image->Height);
+		RGBValue *pixels = ColorPixels(image);
+		for (int i = 0; i < pixelCount; i++) {
+			unsigned char rgb[3] = {pixels[i].R, pixels[i].G, pixels[i].B};
+			fwrite(rgb, 1, 3, file);
+		}
+	} else {
+		fprintf(file, "P5\n%d %d\n255\n", image->Width, image->Height);
+		unsigned char maxValue = 0;
+		for (int i = 0; i < pixelCount; i++) {
+			maxValue = std::max(maxValue, image->Pixels[i]);
+		}
+		for (int i = 0; i < pixelCount; i++) {
+			unsigned char value = image->Pixels[i];
+			fputc((maxValue == 1) ? value * 255 : value, file);
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+int imaqColorThreshold(Image *dest, const Image *source, int replaceValue, ColorMode mode,
+		const Range *plane1Range, const Range *plane2Range, const Range *plane3Range)
+{
+	if ((dest == NULL) or (source == NULL)) {
+		return Fail(kErrorNullPointer);
+	}
+	if (!IsColor(source->Type) or IsColor(dest->Type)) {
+		return Fail(kErrorBadImageType);
+	}
+	Resize(dest, source->Width, source->Height);
+	const RGBValue *pixels = ColorPixels(source);
+	int pixelCount = source->Width * source->Height;
+	for (int i = 0; i < pixelCount; i++) {
+		const RGBValue &p = pixels[i];
+		bool inside;
+		if (mode == IMAQ_RGB) {
+			inside = InRange(p.R, plane1Range) and InRange(p.G, plane2Range) and InRange(p.B, plane3Range);
+		} else {
+			int hue, saturation, luminance;
+			ToHSL(p, hue, saturation, luminance);
+			inside = InRange(hue, plane1Range) and InRange(saturation, plane2Range) and InRange(luminance, plane3Range);
+		}
+		dest->Pixels[i] = inside ? (unsigned char) replaceValue : 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Keeps (or removes) the particles that survive the given
+ * number of 3x3 erosions.
+ */
+int imaqSizeFilter(Image *dest, Image *source, int connectivity8, int erosions,
+		SizeType keepSize, const StructuringElement *structuringElement)
+{
+	if (!IsValidMask(dest) or !IsValidMask(source)) {
+		return Fail(kErrorBadImageType);
+	}
+	int width = source->Width;
+	int height = source->Height;
+	std::vector<int> labels;
+	int count = LabelParticles(source, connectivity8 != 0, labels);
+
+	std::vector<unsigned char> eroded(source->Pixels, source->Pixels + width * height);
+	std::vector<unsigned char> next(width * height);
+	for (int pass = 0; pass < erosions; pass++) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				bool keep = eroded[y * width + x] != 0;
+				for (int dy = -1; keep and (dy <= 1); dy++) {
+					for (int dx = -1; keep and (dx <= 1); dx++) {
+						int nx = x + dx;
+						int ny = y + dy;
+						keep = (nx >= 0) and (ny >= 0) and (nx < width) and (ny < height)
+								and (eroded[ny * width + nx] != 0);
+					}
+				}
+				next[y * width + x] = keep ? 1 : 0;
+			}
+		}
+		eroded.swap(next);
+	}
+
+	std::vector<bool> survived(count + 1, false);
+	for (int i = 0; i < width * height; i++) {
+		if (eroded[i] != 0) {
+			survived[labels[i]] = true;
+		}
+	}
+	std::vector<unsigned char> result(width * height, 0);
+	for (int i = 0; i < width * height; i++) {
+		int label = labels[i];
+		if ((label != 0) and (survived[label] == (keepSize == IMAQ_KEEP_LARGE))) {
+			result[i] = source->Pixels[i];
+		}
+	}
+	Resize(dest, width, height);
+	if (!result.empty()) {
+		memcpy(dest->Pixels, &result[0], result.size());
+	}
+	return 1;
+}
+
+int imaqConvexHull(Image *dest, Image *source, int connectivity8)
+{
+	if (!IsValidMask(dest) or !IsValidMask(source)) {
+		return Fail(kErrorBadImageType);
+	}
+	int width = source->Width;
+	int height = source->Height;
+	std::vector<int> labels;
+	int count = LabelParticles(source, connectivity8 != 0, labels);
+
+	// The outline of each particle is enough to find its hull: the
+	// leftmost and rightmost pixel on every row.
+	std::vector<std::vector<Point> > outlines(count + 1);
+	for (int y = 0; y < height; y++) {
+		int x = 0;
+		while (x < width) {
+			int label = labels[y * width + x];
+			if (label == 0) {
+				x++;
+				continue;
+			}
+			int end = x;
+			while ((end + 1 < width) and (labels[y * width + end + 1] == label)) {
+				end++;
+			}
+			Point left = {x, y};
+			Point right = {end, y};
+			outlines[label].push_back(left);
+			outlines[label].push_back(right);
+			x = end + 1;
+		}
+	}
+
+	std::vector<unsigned char> result(source->Pixels, source->Pixels + width * height);
+	for (int label = 1; label <= count; label++) {
+		std::vector<Point> hull = Hull(outlines[label]);
+		int left = width, top = height, right = -1, bottom = -1;
+		for (size_t i = 0; i < hull.size(); i++) {
+			left = std::min(left, hull[i].x);
+			right = std::max(right, hull[i].x);
+			top = std::min(top, hull[i].y);
+			bottom = std::max(bottom, hull[i].y);
+		}
+		for (int y = top; y <= bottom; y++) {
+			for (int x = left; x <= right; x++) {
+				Point p = {x, y};
+				if (InsideHull(hull, p)) {
+					result[y * width + x] = 1;
+				}
+			}
+		}
+	}
+	Resize(dest, width, height);
+	if (!result.empty()) {
+		memcpy(dest->Pixels, &result[0], result.size());
+	}
+	return 1;
+}
+
+int imaqCountParticles(Image *image, int connectivity8, int *numParticles)
+{
+	if (!IsValidMask(image) or (numParticles == NULL)) {
+		return Fail(kErrorBadImageType);
+	}
+	std::vector<int> labels;
+	*numParticles = LabelParticles(image, connectivity8 != 0, labels);
+	return 1;
+}
+
+/**
+ * @brief Measures one particle.  Particles are always labeled with
+ * 8-connectivity, as NI does after imaqCountParticles(image, TRUE).
+ */
+int imaqMeasureParticle(Image *image, int particleNumber, int calibrated,
+		MeasurementType measurement, double *value)
+{
+	if (!IsValidMask(image) or (value == NULL)) {
+		return Fail(kErrorBadImageType);
+	}
+	std::vector<int> labels;
+	int count = LabelParticles(image, true, labels);
+	if ((particleNumber < 0) or (particleNumber >= count)) {
+		return Fail(kErrorNullPointer);
+	}
+	std::vector<ParticleStats> stats;
+	MeasureAll(image, labels, count, stats);
+	const ParticleStats &s = stats[particleNumber + 1];
+	switch (measurement) {
+	case IMAQ_MT_CENTER_OF_MASS_X:
+		*value = s.SumX / s.Area;
+		break;
+	case IMAQ_MT_CENTER_OF_MASS_Y:
+		*value = s.SumY / s.Area;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_LEFT:
+		*value = s.Left;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_TOP:
+		*value = s.Top;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_RIGHT:
+		*value = s.Right + 1;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_BOTTOM:
+		*value = s.Bottom + 1;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_WIDTH:
+		*value = s.Right - s.Left + 1;
+		break;
+	case IMAQ_MT_BOUNDING_RECT_HEIGHT:
+		*value = s.Bottom - s.Top + 1;
+		break;
+	case IMAQ_MT_AREA:
+		*value = s.Area;
+		break;
+	default:
+		return Fail(kErrorBadImageType);
+	}
+	return 1;
+}
+
+/**
+ * @brief Fits one rectangle to every particle.
+ *
+ * @details
+ * The corners are the particle's extreme pixels along the two
+ * diagonals, so a rotated rectangle gets sensible corners.  The score
+ * is how much of the fitted rectangle the particle fills (0-100).
+ * Curve and shape options other than minMatchScore are ignored.
+ */
+RectangleMatch *imaqDetectRectangles(const Image *image, const RectangleDescriptor *rectangleDescriptor,
+		const CurveOptions *curveOptions, const ShapeDetectionOptions *shapeDetectionOptions,
+		const ROI *roi, int *numMatchesReturned)
+{
+	if (numMatchesReturned != NULL) {
+		*numMatchesReturned = 0;
+	}
+	if (!IsValidMask(image) or (rectangleDescriptor == NULL) or (numMatchesReturned == NULL)) {
+		Fail(kErrorNullPointer);
+		return NULL;
+	}
+	int width = image->Width;
+	std::vector<int> labels;
+	int count = LabelParticles(image, true, labels);
+	std::vector<ParticleStats> stats;
+	MeasureAll(image, labels, count, stats);
+
+	std::vector<PointFloat> corners(4 * (count + 1));
+	std::vector<double> best(4 * (count + 1), 0);
+	std::vector<bool> seen(count + 1, false);
+	for (int y = 0; y < image->Height; y++) {
+		for (int x = 0; x < width; x++) {
+			int label = labels[y * width + x];
+			if (label == 0) {
+				continue;
+			}
+			// Scores for top-left, top-right, bottom-right, bottom-left.
+			int scores[4] = {-(x + y), x - y, x + y, y - x};
+			for (int c = 0; c < 4; c++) {
+				int slot = label * 4 + c;
+				if (!seen[label] or (scores[c] > best[slot])) {
+					best[slot] = scores[c];
+					corners[slot].x = x;
+					corners[slot].y = y;
+				}
+			}
+			seen[label] = true;
+		}
+	}
+
+	double minScore = (shapeDetectionOptions != NULL) ? shapeDetectionOptions->minMatchScore : 0;
+	std::vector<RectangleMatch> matches;
+	for (int label = 1; label <= count; label++) {
+		const ParticleStats &s = stats[label];
+		if (!InsideRoi(roi, s.SumX / s.Area, s.SumY / s.Area)) {
+			continue;
+		}
+		RectangleMatch match;
+		for (int c = 0; c < 4; c++) {
+			match.corner[c] = corners[label * 4 + c];
+		}
+		match.width = (Distance(match.corner[0], match.corner[1]) + Distance(match.corner[3], match.corner[2])) / 2 + 1;
+		match.height = (Distance(match.corner[0], match.corner[3]) + Distance(match.corner[1], match.corner[2])) / 2 + 1;
+		match.rotation = atan2(match.corner[1].y - match.corner[0].y, match.corner[1].x - match.corner[0].x) * 180.0 / acos(-1.0);
+		match.score = std::min(100.0, 100.0 * s.Area / (match.width * match.height));
+		if ((match.width < rectangleDescriptor->minWidth) or (match.width > rectangleDescriptor->maxWidth)
+				or (match.height < rectangleDescriptor->minHeight) or (match.height > rectangleDescriptor->maxHeight)
+				or (match.score < minScore)) {
+			continue;
+		}
+		matches.push_back(match);
+	}
+
+	*numMatchesReturned = (int) matches.size();
+	RectangleMatch *result = (RectangleMatch *) malloc(sizeof(RectangleMatch) * (matches.size() + 1));
+	if (!matches.empty()) {
+		memcpy(result, &matches[0], sizeof(RectangleMatch) * matches.size());
+	}
+	return result;
+}
+
+ROI *imaqCreateROI(void)
+{
+	ROI *roi = new ROI;
+	roi->NextId = 1;
+	pthread_mutex_lock(&sObjectsLock);
+	sRois.insert(roi);
+	pthread_mutex_unlock(&sObjectsLock);
+	return roi;
+}
+
+/**
+ * @returns An ID for imaqRemoveContour, or 0 on failure.
+ */
+ContourID imaqAddRectContour(ROI *roi, Rect rect)
+{
+	if (roi == NULL) {
+		return Fail(kErrorNullPointer);
+	}
+	roi->Rects.push_back(rect);
+	roi->Ids.push_back(roi->NextId);
+	return roi->NextId++;
+}
+
+int imaqRemoveContour(ROI *roi, ContourID id)
+{
+	if (roi == NULL) {
+		return Fail(kErrorNullPointer);
+	}
+	for (size_t i = 0; i < roi->Ids.size(); i++) {
+		if (roi->Ids[i] == id) {
+			roi->Rects.erase(roi->Rects.begin() + i);
+			roi->Ids.erase(roi->Ids.begin() + i);
+			return 1;
+		}
+	}
+	return Fail(kErrorNullPointer);
+}
@@ -0,0 +1,21 @@
+#include "utility.h"
+#include "Simulator.h"
+
+bool wpi_assert_impl(bool conditionValue, const char *conditionText, const char *message,
+		const char *fileName, UINT32 lineNumber, const char *funcName)
+{
+	if (!conditionValue) {
+		fprintf(stderr, "Assertion \"%s\" failed in %s() at %s:%u%s%s\n",
+				conditionText, funcName, fileName, lineNumber,
+				(message != NULL) ? ": " : "", (message != NULL) ? message : "");
+	}
+	return conditionValue;
+}
+
+/**
+ * @brief The FPGA clock, in microseconds.
+ */
+UINT32 GetFPGATime()
+{
+	return (UINT32) (Simulator::GetTime() * 1e6);
+}
@@ -0,0 +1,122 @@
+#include "vxWorks.h"
+#include "Simulator.h"
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * Mutual-exclusion semaphores are recursive, like VxWorks ones.
+ * Binary semaphores are a flag guarded by a condition variable.
+ */
+struct SimSemaphore
+{
+	bool IsMutex;
+	bool Full;
+	pthread_mutex_t Mutex;
+	pthread_cond_t Condition;
+};
+
+SEM_ID semMCreate(int options)
+{
+	SimSemaphore *semaphore = new SimSemaphore;
+	semaphore->IsMutex = true;
+	semaphore->Full = true;
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&semaphore->Mutex, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+	pthread_cond_init(&semaphore->Condition, NULL);
+	return semaphore;
+}
+
+SEM_ID semBCreate(int options, SEM_B_STATE initialState)
+{
+	SimSemaphore *semaphore = new SimSemaphore;
+	semaphore->IsMutex = false;
+	semaphore->Full = (initialState == SEM_FULL);
+	pthread_mutex_init(&semaphore->Mutex, NULL);
+	pthread_cond_init(&semaphore->Condition, NULL);
+	return semaphore;
+}
+
+/**
+ * Timeouts are in clock ticks (see sysClkRateGet).  Waiting on a
+ * binary semaphore polls in simulator time so that it keeps working
+ * when the simulator runs on a virtual clock.
+ */
+STATUS semTake(SEM_ID semaphore, int timeout)
+{
+	if (semaphore == NULL) {
+		return ERROR;
+	}
+	if (semaphore->IsMutex) {
+		if (timeout == NO_WAIT) {
+			return (pthread_mutex_trylock(&semaphore->Mutex) == 0) ? OK : ERROR;
+		}
+		pthread_mutex_lock(&semaphore->Mutex);
+		return OK;
+	}
+
+	double deadline = Simulator::GetTime() + (double) timeout / sysClkRateGet();
+	pthread_mutex_lock(&semaphore->Mutex);
+	while (!semaphore->Full) {
+		if (timeout == NO_WAIT) {
+			break;
+		}
+		if ((timeout != WAIT_FOREVER) and (Simulator::GetTime() >= deadline)) {
+			break;
+		}
+		pthread_mutex_unlock(&semaphore->Mutex);
+		Simulator::Sleep(0.001);
+		pthread_mutex_lock(&semaphore->Mutex);
+	}
+	bool taken = semaphore->Full;
+	semaphore->Full = false;
+	pthread_mutex_unlock(&semaphore->Mutex);
+	return taken ? OK : ERROR;
+}
+
+STATUS semGive(SEM_ID semaphore)
+{
+	if (semaphore == NULL) {
+		return ERROR;
+	}
+	if (semaphore->IsMutex) {
+		pthread_mutex_unlock(&semaphore->Mutex);
+		return OK;
+	}
+	pthread_mutex_lock(&semaphore->Mutex);
+	semaphore->Full = true;
+	pthread_mutex_unlock(&semaphore->Mutex);
+	return OK;
+}
+
+STATUS semFlush(SEM_ID semaphore)
+{
+	return semGive(semaphore);
+}
+
+STATUS semDelete(SEM_ID semaphore)
+{
+	if (semaphore == NULL) {
+		return ERROR;
+	}
+	pthread_mutex_destroy(&semaphore->Mutex);
+	pthread_cond_destroy(&semaphore->Condition);
+	delete semaphore;
+	return OK;
+}
+
+int sysClkRateGet(void)
+{
+	return 1000;
+}
+
+STATUS taskDelay(int ticks)
+{
+	Simulator::Sleep((double) ticks / sysClkRateGet());
+	return OK;
+}
@@ -0,0 +1,1314 @@
+/**
+ * @file camera_calibrate.cpp
+ *
+ * @brief Works out the camera's intrinsics (see Tracking/lens.h)
+ * from pictures of a checkerboard.
+ *
+ * @details
+ * Usage:
+ *
+ *     camera_calibrate [--board COLUMNSxROWS] [--out FILE] [--tables FILE] [--check]
+ *                      DIR | FRAME.ppm ...
+ *     camera_calibrate --make-frames DIR
+ *
+ * Print a checkerboard, tape it to something flat and take ten or
+ * so pictures of it with the robot's camera at 640x480, from
+ * different angles and with the board in different parts of the
+ * picture -- especially near the edges and corners, where the lens
+ * bends things most.  The whole board has to be in every picture.
+ * --board is the number of inner corners (where four squares
+ * meet) across and down; the default is 9x6, which is a board of
+ * 10x7 squares.
+ *
+ * The lens is written to --out (camera_lens.txt by default), which
+ * goes in the root of the cRIO's drive, next to the flight
+ * recordings.  --tables also writes the angle to every column and
+ * row, as CSV, to look at or plot.
+ *
+ * How it works:
+ *   - The inner corners are saddle points of the (slightly
+ *     blurred) brightness, found where the Hessian's determinant
+ *     is most negative, then placed to a fraction of a pixel by
+ *     fitting a quadratic around each.
+ *   - The corners are put in order by finding the board's four
+ *     outer corners (the biggest quadrilateral on their convex
+ *     hull) and mapping every corner onto the grid through a
+ *     homography.
+ *   - A first guess at the intrinsics comes from Zhang's method
+ *     (one homography per picture, no distortion), which is then
+ *     refined, with distortion and every picture's pose, by
+ *     Levenberg-Marquardt on the reprojection error.
+ *
+ * --make-frames writes made-up pictures of a board, seen through
+ * a known lens, and that lens as true_lens.txt.  Calibrating with
+ * --check on such a directory exits with an error if the angles
+ * come out more than kAngleTolerance degrees from the true lens's
+ * anywhere in the picture, or the reprojection error is over
+ * kMaxRmsError pixels.  `make check` runs it that way.
+ */
+
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "WPILib.h"
+#include "../../Code/Tracking/lens.h"
+
+namespace
+{
+	const int kWidth = 640;
+	const int kHeight = 480;
+	const double kSmoothing = 1.5;			// Standard deviation of the blur, in pixels
+	const double kResponseFraction = 0.1;	// Of the strongest saddle, to count as a corner
+	const int kSuppressRadius = 5;			// In pixels
+	const int kFitRadius = 2;				// Of the window the quadratic is fitted over
+	const double kGridTolerance = 0.3;		// In squares, for a corner to be placed on the grid
+	const int kMinViews = 3;
+	const int kMaxIterations = 100;
+	const double kAngleTolerance = 0.1;		// In degrees
+	const double kMaxRmsError = 0.5;		// In pixels
+	const char *kTrueLensFile = "true_lens.txt";
+
+	struct Point
+	{
+		double X;
+		double Y;
+	};
+
+	/**
+	 * A picture's brightness, 0 to 255.
+	 */
+	struct Gray
+	{
+		int Width;
+		int Height;
+		std::vector<float> Pixels;
+
+		float At(int x, int y) const
+		{
+			return Pixels[y * Width + x];
+		}
+	};
+
+	/**
+	 * One picture of the board: where each corner is in it (in
+	 * grid order, a row at a time) and, once calibrated, the
+	 * board's rotation (as a Rodrigues vector) and position.
+	 */
+	struct View
+	{
+		std::string Name;
+		std::vector<Point> Corners;
+		double Pose[6];
+	};
+
+	typedef std::vector<double> Vector;
+	typedef std::vector<Vector> Matrix;
+
+	Matrix MakeMatrix(int rows, int columns)
+	{
+		return Matrix(rows, Vector(columns, 0.0));
+	}
+
+	/**
+	 * The eigenvector of a symmetric matrix with the smallest
+	 * eigenvalue, by Jacobi rotations.  Plenty for the 6x6 and 9x9
+	 * matrices this is used on.
+	 */
+	Vector SmallestEigenvector(Matrix a)
+	{
+		int n = (int) a.size();
+		Matrix v = MakeMatrix(n, n);
+		for (int i = 0; i < n; i++) {
+			v[i][i] = 1;
+		}
+		for (int sweep = 0; sweep < 100; sweep++) {
+			double off = 0;
+			for (int p = 0; p < n; p++) {
+				for (int q = p + 1; q < n; q++) {
+					off += a[p][q] * a[p][q];
+				}
+			}
+			if (off < 1e-30) {
+				break;
+			}
+			for (int p = 0; p < n; p++) {
+				for (int q = p + 1; q < n; q++) {
+					if (fabs(a[p][q]) < 1e-300) {
+						continue;
+					}
+					double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+					double t = ((theta >= 0) ? 1 : -1) / (fabs(theta) + sqrt(theta * theta + 1));
+					double c = 1 / sqrt(t * t + 1);
+					double s = t * c;
+					for (int k = 0; k < n; k++) {
+						double akp = a[k][p];
+						double akq = a[k][q];
+						a[k][p] = c * akp - s * akq;
+						a[k][q] = s * akp + c * akq;
+					}
+					for (int k = 0; k < n; k++) {
+						double apk = a[p][k];
+						double aqk = a[q][k];
+						a[p][k] = c * apk - s * aqk;
+						a[q][k] = s * apk + c * aqk;
+					}
+					for (int k = 0; k < n; k++) {
+						double vkp = v[k][p];
+						double vkq = v[k][q];
+						v[k][p] = c * vkp - s * vkq;
+						v[k][q] = s * vkp + c * vkq;
+					}
+				}
+			}
+		}
+		int smallest = 0;
+		for (int i = 1; i < n; i++) {
+			if (a[i][i] < a[smallest][smallest]) {
+				smallest = i;
+			}
+		}
+		Vector result(n);
+		for (int i = 0; i < n; i++) {
+			result[i] = v[i][smallest];
+		}
+		return result;
+	}
+
+	/**
+	 * Solves a x = b by Gaussian elimination with partial pivoting.
+	 * Returns false if a is singular.
+	 */
+	bool Solve(Matrix a, Vector b, Vector &x)
+	{
+		int n = (int) a.size();
+		for (int column = 0; column < n; column++) {
+			int pivot = column;
+			for (int row = column + 1; row < n; row++) {
+				if (fabs(a[row][column]) > fabs(a[pivot][column])) {
+					pivot = row;
+				}
+			}
+			if (fabs(a[pivot][column]) < 1e-300) {
+				return false;
+			}
+			std::swap(a[pivot], a[column]);
+			std::swap(b[pivot], b[column]);
+			for (int row = column + 1; row < n; row++) {
+				double factor = a[row][column] / a[column][column];
+				for (int k = column; k < n; k++) {
+					a[row][k] -= factor * a[column][k];
+				}
+				b[row] -= factor * b[column];
+			}
+		}
+		x.assign(n, 0);
+		for (int row = n - 1; row >= 0; row--) {
+			double sum = b[row];
+			for (int k = row + 1; k < n; k++) {
+				sum -= a[row][k] * x[k];
+			}
+			x[row] = sum / a[row][row];
+		}
+		return true;
+	}
+
+	/**
+	 * Turns a Rodrigues vector (axis times angle) into a rotation
+	 * matrix, row by row.
+	 */
+	void ToRotation(const double *r, double m[9])
+	{
+		double angle = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+		if (angle < 1e-12) {
+			double identity[9] = {1, -r[2], r[1], r[2], 1, -r[0], -r[1], r[0], 1};
+			memcpy(m, identity, sizeof(identity));
+			return;
+		}
+		double x = r[0] / angle;
+		double y = r[1] / angle;
+		double z = r[2] / angle;
+		double c = cos(angle);
+		double s = sin(angle);
+		double t = 1 - c;
+		m[0] = t * x * x + c;		m[1] = t * x * y - s * z;	m[2] = t * x * z + s * y;
+		m[3] = t * x * y + s * z;	m[4] = t * y * y + c;		m[5] = t * y * z - s * x;
+		m[6] = t * x * z - s * y;	m[7] = t * y * z + s * x;	m[8] = t * z * z + c;
+	}
+
+	/**
+	 * The other way.  The matrix must be a rotation.
+	 */
+	void FromRotation(const double m[9], double *r)
+	{
+		double c = (m[0] + m[4] + m[8] - 1) / 2;
+		c = std::max(-1.0, std::min(1.0, c));
+		double angle = acos(c);
+		double x = m[7] - m[5];
+		double y = m[2] - m[6];
+		double z = m[3] - m[1];
+		double length = sqrt(x * x + y * y + z * z);
+		if (length < 1e-12) {
+			r[0] = r[1] = r[2] = 0;
+			return;
+		}
+		r[0] = x / length * angle;
+		r[1] = y / length * angle;
+		r[2] = z / length * angle;
+	}
+
+	Point Transform(const double h[9], double x, double y)
+	{
+		double w = h[6] * x + h[7] * y + h[8];
+		Point p;
+		p.X = (h[0] * x + h[1] * y + h[2]) / w;
+		p.Y = (h[3] * x + h[4] * y + h[5]) / w;
+		return p;
+	}
+
+	/**
+	 * Shifts and scales points to have their middle at 0 and an
+	 * average distance of sqrt(2) from it, which keeps the DLT
+	 * well conditioned.  Returns the 3x3 matrix that does it.
+	 */
+	void Normalise(const std::vector<Point> &points, double t[9])
+	{
+		double mx = 0;
+		double my = 0;
+		for (size_t i = 0; i < points.size(); i++) {
+			mx += points[i].X;
+			my += points[i].Y;
+		}
+		mx /= points.size();
+		my /= points.size();
+		double d = 0;
+		for (size_t i = 0; i < points.size(); i++) {
+			d += sqrt((points[i].X - mx) * (points[i].X - mx) + (points[i].Y - my) * (points[i].Y - my));
+		}
+		double s = sqrt(2.0) / std::max(d / points.size(), 1e-12);
+		double result[9] = {s, 0, -s * mx, 0, s, -s * my, 0, 0, 1};
+		memcpy(t, result, sizeof(result));
+	}
+
+	void Multiply(const double a[9], const double b[9], double out[9])
+	{
+		double m[9];
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				m[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] + a[i * 3 + 2] * b[6 + j];
+			}
+		}
+		memcpy(out, m, sizeof(m));
+	}
+
+	bool Invert(const double m[9], double out[9])
+	{
+		double d = m[0] * (m[4] * m[8] - m[5] * m[7]) - m[1] * (m[3] * m[8] - m[5] * m[6])
+				+ m[2] * (m[3] * m[7] - m[4] * m[6]);
+		if (fabs(d) < 1e-300) {
+			return false;
+		}
+		out[0] = (m[4] * m[8] - m[5] * m[7]) / d;
+		out[1] = (m[2] * m[7] - m[1] * m[8]) / d;
+		out[2] = (m[1] * m[5] - m[2] * m[4]) / d;
+		out[3] = (m[5] * m[6] - m[3] * m[8]) / d;
+		out[4] = (m[0] * m[8] - m[2] * m[6]) / d;
+		out[5] = (m[2] * m[3] - m[0] * m[5]) / d;
+		out[6] = (m[3] * m[7] - m[4] * m[6]) / d;
+		out[7] = (m[1] * m[6] - m[0] * m[7]) / d;
+		out[8] = (m[0] * m[4] - m[1] * m[3]) / d;
+		return true;
+	}
+
+	/**
+	 * The homography taking each "from" point to its "to" point,
+	 * by the normalised DLT.  Needs at least four points.
+	 */
+	bool FindHomography(const std::vector<Point> &from, const std::vector<Point> &to, double h[9])
+	{
+		double tf[9];
+		double tt[9];
+		Normalise(from, tf);
+		Normalise(to, tt);
+		Matrix ata = MakeMatrix(9, 9);
+		for (size_t i = 0; i < from.size(); i++) {
+			Point a = Transform(tf, from[i].X, from[i].Y);
+			Point b = Transform(tt, to[i].X, to[i].Y);
+			double rows[2][9] = {
+				{a.X, a.Y, 1, 0, 0, 0, -b.X * a.X, -b.X * a.Y, -b.X},
+				{0, 0, 0, a.X, a.Y, 1, -b.Y * a.X, -b.Y * a.Y, -b.Y}
+			};
+			for (int r = 0; r < 2; r++) {
+				for (int j = 0; j < 9; j++) {
+					for (int k = 0; k < 9; k++) {
+						ata[j][k] += rows[r][j] * rows[r][k];
+					}
+				}
+			}
+		}
+		Vector n = SmallestEigenvector(ata);
+		double hn[9];
+		for (int i = 0; i < 9; i++) {
+			hn[i] = n[i];
+		}
+		double ttInverse[9];
+		if (!Invert(tt, ttInverse)) {
+			return false;
+		}
+		Multiply(ttInverse, hn, h);
+		Multiply(h, tf, h);
+		if (fabs(h[8]) < 1e-300) {
+			return false;
+		}
+		for (int i = 0; i < 9; i++) {
+			h[i] /= h[8];
+		}
+		return true;
+	}
+
+	bool LoadGray(const std::string &path, Gray &gray)
+	{
+		RGBImage image(path.c_str());
+		if (image.GetWidth() == 0) {
+			fprintf(stderr, "could not read %s\n", path.c_str());
+			return false;
+		}
+		ImageInfo info;
+		imaqGetImageInfo(image.GetImaqImage(), &info);
+		const RGBValue *pixels = (const RGBValue *) info.imageStart;
+		gray.Width = info.xRes;
+		gray.Height = info.yRes;
+		gray.Pixels.resize(gray.Width * gray.Height);
+		for (int y = 0; y < gray.Height; y++) {
+			for (int x = 0; x < gray.Width; x++) {
+				const RGBValue &p = pixels[y * info.pixelsPerLine + x];
+				gray.Pixels[y * gray.Width + x] = 0.299f * p.R + 0.587f * p.G + 0.114f * p.B;
+			}
+		}
+		return true;
+	}
+
+	Gray Blur(const Gray &image, double sigma)
+	{
+		int radius = (int) ceil(3 * sigma);
+		std::vector<float> kernel(2 * radius + 1);
+		double sum = 0;
+		for (int i = -radius; i <= radius; i++) {
+			kernel[i + radius] = (float) exp(-i * i / (2 * sigma * sigma));
+			sum += kernel[i + radius];
+		}
+		for (size_t i = 0; i < kernel.size(); i++) {
+			kernel[i] /= (float) sum;
+		}
+		Gray across = image;
+		for (int y = 0; y < image.Height; y++) {
+			for (int x = 0; x < image.Width; x++) {
+				double total = 0;
+				for (int i = -radius; i <= radius; i++) {
+					int xi = std::max(0, std::min(image.Width - 1, x + i));
+					total += kernel[i + radius] * image.At(xi, y);
+				}
+				across.Pixels[y * image.Width + x] = (float) total;
+			}
+		}
+		Gray result = across;
+		for (int y = 0; y < image.Height; y++) {
+			for (int x = 0; x < image.Width; x++) {
+				double total = 0;
+				for (int i = -radius; i <= radius; i++) {
+					int yi = std::max(0, std::min(image.Height - 1, y + i));
+					total += kernel[i + radius] * across.At(x, yi);
+				}
+				result.Pixels[y * image.Width + x] = (float) total;
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Places a saddle point to a fraction of a pixel, by fitting
+	 * a quadratic to the blurred brightness around it.  Returns
+	 * false if the fit isn't a saddle near there.
+	 */
+	bool RefineCorner(const Gray &smooth, Point &corner)
+	{
+		for (int pass = 0; pass < 3; pass++) {
+			int cx = (int) floor(corner.X + 0.5);
+			int cy = (int) floor(corner.Y + 0.5);
+			if ((cx < kFitRadius) or (cy < kFitRadius)
+					or (cx >= smooth.Width - kFitRadius) or (cy >= smooth.Height - kFitRadius)) {
+				return false;
+			}
+			Matrix ata = MakeMatrix(6, 6);
+			Vector atb(6, 0.0);
+			for (int dy = -kFitRadius; dy <= kFitRadius; dy++) {
+				for (int dx = -kFitRadius; dx <= kFitRadius; dx++) {
+					double x = dx;
+					double y = dy;
+					double row[6] = {x * x, x * y, y * y, x, y, 1};
+					double value = smooth.At(cx + dx, cy + dy);
+					for (int j = 0; j < 6; j++) {
+						for (int k = 0; k < 6; k++) {
+							ata[j][k] += row[j] * row[k];
+						}
+						atb[j] += row[j] * value;
+					}
+				}
+			}
+			Vector q;
+			if (!Solve(ata, atb, q)) {
+				return false;
+			}
+			// Where the gradient of a x^2 + b xy + c y^2 + d x + e y is zero
+			double det = 4 * q[0] * q[2] - q[1] * q[1];
+			if (det >= 0) {
+				return false;
+			}
+			double ox = (-2 * q[2] * q[3] + q[1] * q[4]) / det;
+			double oy = (-2 * q[0] * q[4] + q[1] * q[3]) / det;
+			if ((fabs(ox) > kFitRadius) or (fabs(oy) > kFitRadius)) {
+				return false;
+			}
+			corner.X = cx + ox;
+			corner.Y = cy + oy;
+			if ((fabs(ox) <= 0.5) and (fabs(oy) <= 0.5)) {
+				break;
+			}
+		}
+		return true;
+	}
+
+	struct Candidate
+	{
+		double Response;
+		Point Where;
+
+		bool operator<(const Candidate &other) const
+		{
+			return Response > other.Response;
+		}
+	};
+
+	/**
+	 * Finds up to count of the strongest saddle points.
+	 */
+	std::vector<Point> FindSaddles(const Gray &smooth, int count)
+	{
+		int w = smooth.Width;
+		int h = smooth.Height;
+		std::vector<float> response(w * h, 0.0f);
+		float strongest = 0;
+		for (int y = 1; y < h - 1; y++) {
+			for (int x = 1; x < w - 1; x++) {
+				double fxx = smooth.At(x + 1, y) - 2 * smooth.At(x, y) + smooth.At(x - 1, y);
+				double fyy = smooth.At(x, y + 1) - 2 * smooth.At(x, y) + smooth.At(x, y - 1);
+				double fxy = (smooth.At(x + 1, y + 1) - smooth.At(x + 1, y - 1)
+						- smooth.At(x - 1, y + 1) + smooth.At(x - 1, y - 1)) / 4;
+				float r = (float) (fxy * fxy - fxx * fyy);
+				response[y * w + x] = r;
+				strongest = std::max(strongest, r);
+			}
+		}
+
+		std::vector<Candidate> candidates;
+		float threshold = (float) (strongest * kResponseFraction);
+		for (int y = kSuppressRadius; y < h - kSuppressRadius; y++) {
+			for (int x = kSuppressRadius; x < w - kSuppressRadius; x++) {
+				float r = response[y * w + x];
+				if (r <= threshold) {
+					continue;
+				}
+				bool isPeak = true;
+				for (int dy = -kSuppressRadius; isPeak and (dy <= kSuppressRadius); dy++) {
+					for (int dx = -kSuppressRadius; dx <= kSuppressRadius; dx++) {
+						float other = response[(y + dy) * w + x + dx];
+						if ((other > r) or ((other == r) and ((dy < 0) or ((dy == 0) and (dx < 0))))) {
+							isPeak = false;
+							break;
+						}
+					}
+				}
+				if (isPeak) {
+					Candidate c;
+					c.Response = r;
+					c.Where.X = x;
+					c.Where.Y = y;
+					candidates.push_back(c);
+				}
+			}
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		std::vector<Point> saddles;
+		for (size_t i = 0; (i < candidates.size()) and ((int) saddles.size() < count); i++) {
+			Point p = candidates[i].Where;
+			if (RefineCorner(smooth, p)) {
+				saddles.push_back(p);
+			}
+		}
+		return saddles;
+	}
+
+	double Cross(const Point &o, const Point &a, const Point &b)
+	{
+		return (a.X - o.X) * (b.Y - o.Y) - (a.Y - o.Y) * (b.X - o.X);
+	}
+
+	bool IsLeftOf(const Point &a, const Point &b)
+	{
+		return (a.X < b.X) or ((a.X == b.X) and (a.Y < b.Y));
+	}
+
+	/**
+	 * The convex hull, by Andrew's monotone chain, in order.
+	 */
+	std::vector<Point> Hull(std::vector<Point> points)
+	{
+		std::sort(points.begin(), points.end(), IsLeftOf);
+		std::vector<Point> hull(2 * points.size());
+		int k = 0;
+		for (size_t i = 0; i < points.size(); i++) {
+			while ((k >= 2) and (Cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) {
+				k--;
+			}
+			hull[k++] = points[i];
+		}
+		for (int i = (int) points.size() - 2, lower = k + 1; i >= 0; i--) {
+			while ((k >= lower) and (Cross(hull[k - 2], hull[k - 1], points[i]) <= 0)) {
+				k--;
+			}
+			hull[k++] = points[i];
+		}
+		hull.resize(std::max(0, k - 1));
+		return hull;
+	}
+
+	/**
+	 * The four hull points making the biggest quadrilateral, which
+	 * are the board's outer corners however it's turned.
+	 */
+	bool FindOuterCorners(const std::vector<Point> &points, Point quad[4])
+	{
+		std::vector<Point> hull = Hull(points);
+		int n = (int) hull.size();
+		if (n < 4) {
+			return false;
+		}
+		double best = -1;
+		for (int a = 0; a < n; a++) {
+			for (int b = a + 1; b < n; b++) {
+				for (int c = b + 1; c < n; c++) {
+					for (int d = c + 1; d < n; d++) {
+						double area = Cross(hull[a], hull[b], hull[c]) + Cross(hull[a], hull[c], hull[d]);
+						if (area > best) {
+							best = area;
+							quad[0] = hull[a];
+							quad[1] = hull[b];
+							quad[2] = hull[c];
+							quad[3] = hull[d];
+						}
+					}
+				}
+			}
+		}
+		return best > 0;
+	}
+
+	/**
+	 * Puts the corners in grid order, given which of the outer
+	 * corners are which.  Returns the mean distance (in squares)
+	 * from each corner to its place on the grid, or -1 if they
+	 * don't fit the grid.
+	 */
+	double OrderCorners(const std::vector<Point> &points, const Point quad[4], const Point grid[4],
+			int columns, int rows, std::vector<Point> &ordered)
+	{
+		std::vector<Point> from(quad, quad + 4);
+		std::vector<Point> to(grid, grid + 4);
+		double error = -1;
+		for (int pass = 0; pass < 3; pass++) {
+			double h[9];
+			if (!FindHomography(from, to, h)) {
+				return -1;
+			}
+			std::vector<int> owner(columns * rows, -1);
+			from.clear();
+			to.clear();
+			error = 0;
+			for (size_t i = 0; i < points.size(); i++) {
+				Point g = Transform(h, points[i].X, points[i].Y);
+				int column = (int) floor(g.X + 0.5);
+				int row = (int) floor(g.Y + 0.5);
+				double distance = sqrt((g.X - column) * (g.X - column) + (g.Y - row) * (g.Y - row));
+				if ((column < 0) or (column >= columns) or (row < 0) or (row >= rows)
+						or (distance > kGridTolerance) or (owner[row * columns + column] >= 0)) {
+					continue;
+				}
+				owner[row * columns + column] = (int) i;
+				Point place;
+				place.X = column;
+				place.Y = row;
+				from.push_back(points[i]);
+				to.push_back(place);
+				error += distance;
+			}
+			if ((int) from.size() < 4) {
+				return -1;
+			}
+			if ((int) from.size() == columns * rows) {
+				ordered.resize(columns * rows);
+				for (int j = 0; j < columns * rows; j++) {
+					ordered[j] = points[owner[j]];
+				}
+				error /= from.size();
+				if (pass > 0) {
+					return error;
+				}
+			}
+		}
+		return ((int) ordered.size() == columns * rows) ? error : -1;
+	}
+
+	/**
+	 * Finds the board's inner corners in a picture, in grid order.
+	 */
+	bool FindCorners(const Gray &image, int columns, int rows, std::vector<Point> &corners)
+	{
+		Gray smooth = Blur(image, kSmoothing);
+		std::vector<Point> saddles = FindSaddles(smooth, columns * rows);
+		if ((int) saddles.size() < columns * rows) {
+			printf("  found %d of %d corners\n", (int) saddles.size(), columns * rows);
+			return false;
+		}
+		Point quad[4];
+		if (!FindOuterCorners(saddles, quad)) {
+			return false;
+		}
+		// The first outer corner is the grid's origin; the board runs
+		// either across or down from there.
+		double c = columns - 1;
+		double r = rows - 1;
+		Point across[4] = {{0, 0}, {c, 0}, {c, r}, {0, r}};
+		Point down[4] = {{0, 0}, {0, r}, {c, r}, {c, 0}};
+		std::vector<Point> a;
+		std::vector<Point> b;
+		double errorA = OrderCorners(saddles, quad, across, columns, rows, a);
+		double errorB = OrderCorners(saddles, quad, down, columns, rows, b);
+		if ((errorA < 0) and (errorB < 0)) {
+			printf("  the corners don't make a %dx%d grid\n", columns, rows);
+			return false;
+		}
+		corners = ((errorB < 0) or ((errorA >= 0) and (errorA <= errorB))) ? a : b;
+		return true;
+	}
+
+	/**
+	 * Where the lens puts a point on the board, given the board's
+	 * pose.
+	 */
+	Point Project(const LensModel &lens, const double *pose, double bx, double by)
+	{
+		double m[9];
+		ToRotation(pose, m);
+		double x = m[0] * bx + m[1] * by + pose[3];
+		double y = m[3] * bx + m[4] * by + pose[4];
+		double z = m[6] * bx + m[7] * by + pose[5];
+		double dx;
+		double dy;
+		lens.Distort(x / z, y / z, dx, dy);
+		Point p;
+		p.X = lens.CenterX + lens.FocalX * dx;
+		p.Y = lens.CenterY + lens.FocalY * dy;
+		return p;
+	}
+
+	/**
+	 * Zhang's closed-form intrinsics (no skew, no distortion) and
+	 * each view's pose, from the board-to-picture homographies.
+	 */
+	bool InitialGuess(std::vector<View> &views, int columns, LensModel &lens)
+	{
+		std::vector<Point> board(views[0].Corners.size());
+		for (size_t i = 0; i < board.size(); i++) {
+			board[i].X = (double) (i % columns);
+			board[i].Y = (double) (i / columns);
+		}
+		std::vector<double> homographies(9 * views.size());
+		Matrix vtv = MakeMatrix(6, 6);
+		for (size_t v = 0; v < views.size(); v++) {
+			double *h = &homographies[9 * v];
+			if (!FindHomography(board, views[v].Corners, h)) {
+				return false;
+			}
+			// Column i of H is (h[i], h[3 + i], h[6 + i]).
+			double rows[2][6];
+			for (int pair = 0; pair < 3; pair++) {
+				int i = (pair == 2) ? 1 : 0;
+				int j = (pair == 0) ? 1 : i;
+				double hi[3] = {h[i], h[3 + i], h[6 + i]};
+				double hj[3] = {h[j], h[3 + j], h[6 + j]};
+				double vij[6] = {
+					hi[0] * hj[0],
+					hi[0] * hj[1] + hi[1] * hj[0],
+					hi[1] * hj[1],
+					hi[2] * hj[0] + hi[0] * hj[2],
+					hi[2] * hj[1] + hi[1] * hj[2],
+					hi[2] * hj[2]
+				};
+				if (pair == 0) {
+					memcpy(rows[0], vij, sizeof(vij));
+				} else if (pair == 1) {
+					memcpy(rows[1], vij, sizeof(vij));
+				} else {
+					for (int k = 0; k < 6; k++) {
+						rows[1][k] -= vij[k];	// v11 - v22
+					}
+				}
+			}
+			for (int r = 0; r < 2; r++) {
+				for (int j = 0; j < 6; j++) {
+					for (int k = 0; k < 6; k++) {
+						vtv[j][k] += rows[r][j] * rows[r][k];
+					}
+				}
+			}
+		}
+
+		Vector b = SmallestEigenvector(vtv);
+		if (b[0] < 0) {
+			for (int i = 0; i < 6; i++) {
+				b[i] = -b[i];
+			}
+		}
+		double b11 = b[0], b12 = b[1], b22 = b[2], b13 = b[3], b23 = b[4], b33 = b[5];
+		double d = b11 * b22 - b12 * b12;
+		double v0 = (b12 * b13 - b11 * b23) / d;
+		double lambda = b33 - (b13 * b13 + v0 * (b12 * b13 - b11 * b23)) / b11;
+		if ((d <= 0) or (lambda / b11 <= 0)) {
+			return false;
+		}
+		double alpha = sqrt(lambda / b11);
+		double beta = sqrt(lambda * b11 / d);
+		double gamma = -b12 * alpha * alpha * beta / lambda;
+		double u0 = gamma * v0 / beta - b13 * alpha * alpha / lambda;
+		lens.FocalX = alpha;
+		lens.FocalY = beta;
+		lens.CenterX = u0;
+		lens.CenterY = v0;
+		lens.K1 = 0;
+		lens.K2 = 0;
+
+		double k[9] = {alpha, 0, u0, 0, beta, v0, 0, 0, 1};
+		double kInverse[9];
+		Invert(k, kInverse);
+		for (size_t v = 0; v < views.size(); v++) {
+			double kh[9];
+			Multiply(kInverse, &homographies[9 * v], kh);
+			double r1[3] = {kh[0], kh[3], kh[6]};
+			double r2[3] = {kh[1], kh[4], kh[7]};
+			double t[3] = {kh[2], kh[5], kh[8]};
+			double scale = 1 / sqrt(r1[0] * r1[0] + r1[1] * r1[1] + r1[2] * r1[2]);
+			if (t[2] < 0) {
+				scale = -scale;		// The board is in front of the camera
+			}
+			for (int i = 0; i < 3; i++) {
+				r1[i] *= scale;
+				r2[i] *= scale;
+				t[i] *= scale;
+			}
+			// Make r2 exactly at right angles to r1, then r3 = r1 x r2.
+			double dot = r1[0] * r2[0] + r1[1] * r2[1] + r1[2] * r2[2];
+			for (int i = 0; i < 3; i++) {
+				r2[i] -= dot * r1[i];
+			}
+			double length = sqrt(r2[0] * r2[0] + r2[1] * r2[1] + r2[2] * r2[2]);
+			for (int i = 0; i < 3; i++) {
+				r2[i] /= length;
+			}
+			double r3[3] = {r1[1] * r2[2] - r1[2] * r2[1], r1[2] * r2[0] - r1[0] * r2[2], r1[0] * r2[1] - r1[1] * r2[0]};
+			double m[9] = {r1[0], r2[0], r3[0], r1[1], r2[1], r3[1], r1[2], r2[2], r3[2]};
+			FromRotation(m, views[v].Pose);
+			views[v].Pose[3] = t[0];
+			views[v].Pose[4] = t[1];
+			views[v].Pose[5] = t[2];
+		}
+		return true;
+	}
+
+	const int kLensParameters = 6;		// Focal x and y, centre x and y, K1, K2
+
+	void Unpack(const Vector &p, LensModel &lens)
+	{
+		lens.FocalX = p[0];
+		lens.FocalY = p[1];
+		lens.CenterX = p[2];
+		lens.CenterY = p[3];
+		lens.K1 = p[4];
+		lens.K2 = p[5];
+	}
+
+	/**
+	 * The reprojection errors of one view, x and y for each corner.
+	 */
+	void ViewResiduals(const Vector &p, const View &view, int v, int columns, double *out)
+	{
+		LensModel lens;
+		Unpack(p, lens);
+		const double *pose = &p[kLensParameters + 6 * v];
+		for (size_t i = 0; i < view.Corners.size(); i++) {
+			Point q = Project(lens, pose, (double) (i % columns), (double) (i / columns));
+			out[2 * i] = q.X - view.Corners[i].X;
+			out[2 * i + 1] = q.Y - view.Corners[i].Y;
+		}
+	}
+
+	void Residuals(const Vector &p, const std::vector<View> &views, int columns, Vector &out)
+	{
+		size_t offset = 0;
+		for (size_t v = 0; v < views.size(); v++) {
+			ViewResiduals(p, views[v], (int) v, columns, &out[offset]);
+			offset += 2 * views[v].Corners.size();
+		}
+	}
+
+	double SumOfSquares(const Vector &r)
+	{
+		double sum = 0;
+		for (size_t i = 0; i < r.size(); i++) {
+			sum += r[i] * r[i];
+		}
+		return sum;
+	}
+
+	/**
+	 * Levenberg-Marquardt over the lens and every pose, with a
+	 * numerical Jacobian (each pose only moves its own view's
+	 * corners, so only those are worked out again).  Returns the
+	 * RMS reprojection error, in pixels.
+	 */
+	double Refine(std::vector<View> &views, int columns, LensModel &lens)
+	{
+		int parameterCount = kLensParameters + 6 * (int) views.size();
+		int residualCount = 0;
+		std::vector<int> offsets;
+		for (size_t v = 0; v < views.size(); v++) {
+			offsets.push_back(residualCount);
+			residualCount += 2 * (int) views[v].Corners.size();
+		}
+
+		Vector p(parameterCount);
+		p[0] = lens.FocalX;
+		p[1] = lens.FocalY;
+		p[2] = lens.CenterX;
+		p[3] = lens.CenterY;
+		p[4] = lens.K1;
+		p[5] = lens.K2;
+		for (size_t v = 0; v < views.size(); v++) {
+			for (int i = 0; i < 6; i++) {
+				p[kLensParameters + 6 * v + i] = views[v].Pose[i];
+			}
+		}
+
+		Vector r(residualCount);
+		Residuals(p, views, columns, r);
+		double cost = SumOfSquares(r);
+		double damping = 1e-3;
+		Matrix jacobian = MakeMatrix(residualCount, parameterCount);
+		Vector plus(residualCount);
+		Vector minus(residualCount);
+		for (int iteration = 0; iteration < kMaxIterations; iteration++) {
+			for (int j = 0; j < parameterCount; j++) {
+				double step = 1e-6 * std::max(1.0, fabs(p[j]));
+				double saved = p[j];
+				int firstView = 0;
+				int lastView = (int) views.size();
+				if (j >= kLensParameters) {
+					firstView = (j - kLensParameters) / 6;
+					lastView = firstView + 1;
+				}
+				for (int i = 0; i < residualCount; i++) {
+					jacobian[i][j] = 0;
+				}
+				for (int v = firstView; v < lastView; v++) {
+					p[j] = saved + step;
+					ViewResiduals(p, views[v], v, columns, &plus[offsets[v]]);
+					p[j] = saved - step;
+					ViewResiduals(p, views[v], v, columns, &minus[offsets[v]]);
+					for (int i = offsets[v]; i < offsets[v] + 2 * (int) views[v].Corners.size(); i++) {
+						jacobian[i][j] = (plus[i] - minus[i]) / (2 * step);
+					}
+				}
+				p[j] = saved;
+			}
+
+			Matrix jtj = MakeMatrix(parameterCount, parameterCount);
+			Vector jtr(parameterCount, 0.0);
+			for (int i = 0; i < residualCount; i++) {
+				const Vector &row = jacobian[i];
+				for (int j = 0; j < parameterCount; j++) {
+					if (row[j] == 0) {
+						continue;
+					}
+					jtr[j] -= row[j] * r[i];
+					for (int k = j; k < parameterCount; k++) {
+						jtj[j][k] += row[j] * row[k];
+					}
+				}
+			}
+			for (int j = 0; j < parameterCount; j++) {
+				for (int k = 0; k < j; k++) {
+					jtj[j][k] = jtj[k][j];
+				}
+			}
+
+			bool isImproved = false;
+			while (!isImproved and (damping < 1e10)) {
+				Matrix a = jtj;
+				for (int j = 0; j < parameterCount; j++) {
+					a[j][j] *= 1 + damping;
+				}
+				Vector delta;
+				if (Solve(a, jtr, delta)) {
+					Vector next = p;
+					for (int j = 0; j < parameterCount; j++) {
+						next[j] += delta[j];
+					}
+					Vector nextR(residualCount);
+					Residuals(next, views, columns, nextR);
+					double nextCost = SumOfSquares(nextR);
+					if (nextCost < cost) {
+						bool isDone = (cost - nextCost) < 1e-12 * cost;
+						p = next;
+						r = nextR;
+						cost = nextCost;
+						damping = std::max(damping / 10, 1e-12);
+						isImproved = true;
+						if (isDone) {
+							iteration = kMaxIterations;
+						}
+						continue;
+					}
+				}
+				damping *= 10;
+			}
+			if (!isImproved) {
+				break;
+			}
+		}
+
+		Unpack(p, lens);
+		for (size_t v = 0; v < views.size(); v++) {
+			for (int i = 0; i < 6; i++) {
+				views[v].Pose[i] = p[kLensParameters + 6 * v + i];
+			}
+		}
+		return sqrt(cost / (residualCount / 2));
+	}
+
+	/**
+	 * Writes the angle to every column and row as CSV.
+	 */
+	bool WriteTables(const char *path, const LensModel &lens)
+	{
+		FILE *file = fopen(path, "w");
+		if (file == NULL) {
+			fprintf(stderr, "could not write %s\n", path);
+			return false;
+		}
+		CameraAngles angles;
+		angles.Build(lens, lens.Width, lens.Height);
+		fprintf(file, "axis,pixel,degrees\n");
+		for (int x = 0; x < angles.GetWidth(); x++) {
+			fprintf(file, "x,%d,%.4f\n", x, angles.GetXAngle(x));
+		}
+		for (int y = 0; y < angles.GetHeight(); y++) {
+			fprintf(file, "y,%d,%.4f\n", y, angles.GetYAngle(y));
+		}
+		fclose(file);
+		return true;
+	}
+
+	/**
+	 * The furthest apart two lenses' angles get, in degrees.
+	 */
+	double CompareAngles(const LensModel &a, const LensModel &b)
+	{
+		CameraAngles first;
+		CameraAngles second;
+		first.Build(a, kWidth, kHeight);
+		second.Build(b, kWidth, kHeight);
+		double worst = 0;
+		for (int x = 0; x < kWidth; x++) {
+			worst = std::max(worst, fabs(first.GetXAngle(x) - second.GetXAngle(x)));
+		}
+		for (int y = 0; y < kHeight; y++) {
+			worst = std::max(worst, fabs(first.GetYAngle(y) - second.GetYAngle(y)));
+		}
+		return worst;
+	}
+
+	/**
+	 * The lens the made-up pictures are taken through: about an
+	 * Axis 206, with rather more barrel distortion than it has, so
+	 * there is something to find.
+	 */
+	LensModel MadeUpLens()
+	{
+		LensModel lens;
+		lens.FocalX = 600;
+		lens.FocalY = 604;
+		lens.CenterX = 326;
+		lens.CenterY = 236;
+		lens.K1 = -0.28;
+		lens.K2 = 0.1;
+		return lens;
+	}
+
+	/**
+	 * Draws a board of (columns + 1) x (rows + 1) squares with a
+	 * white border, posed as given, as seen through a lens.  Each
+	 * pixel is the average of 3x3 samples.
+	 */
+	void DrawBoard(RGBValue *pixels, const LensModel &lens, const double *pose, int columns, int rows, int seed)
+	{
+		double m[9];
+		ToRotation(pose, m);
+		const double *t = &pose[3];
+		double normal[3] = {m[2], m[5], m[8]};
+		double planeDistance = normal[0] * t[0] + normal[1] * t[1] + normal[2] * t[2];
+		srand(seed);
+		for (int py = 0; py < kHeight; py++) {
+			for (int px = 0; px < kWidth; px++) {
+				double total = 0;
+				for (int sy = -1; sy <= 1; sy++) {
+					for (int sx = -1; sx <= 1; sx++) {
+						double x;
+						double y;
+						lens.Undistort((px + sx / 3.0 - lens.CenterX) / lens.FocalX,
+								(py + sy / 3.0 - lens.CenterY) / lens.FocalY, x, y);
+						double along = normal[0] * x + normal[1] * y + normal[2];
+						double value = 110;
+						if (along > 1e-9) {
+							double s = planeDistance / along;
+							double d[3] = {s * x - t[0], s * y - t[1], s - t[2]};
+							double bx = m[0] * d[0] + m[3] * d[1] + m[6] * d[2];	// Rotated back onto the board
+							double by = m[1] * d[0] + m[4] * d[1] + m[7] * d[2];
+							if ((bx >= -2) and (bx <= columns + 1) and (by >= -2) and (by <= rows + 1)) {
+								value = 225;
+								if ((bx >= -1) and (bx < columns) and (by >= -1) and (by < rows)) {
+									int square = (int) floor(bx) + (int) floor(by);
+									value = (square & 1) ? 225 : 30;
+								}
+							}
+						}
+						total += value;
+					}
+				}
+				int v = (int) (total / 9 + (rand() % 9) - 4);
+				v = std::max(0, std::min(255, v));
+				RGBValue &p = pixels[py * kWidth + px];
+				p.R = p.G = p.B = (unsigned char) v;
+				p.alpha = 0;
+			}
+		}
+	}
+
+	/**
+	 * Writes made-up pictures of a 9x6 board and the lens they were
+	 * taken through.
+	 */
+	bool WriteFrames(const std::string &directory)
+	{
+		const int columns = 9;
+		const int rows = 6;
+		// Where the board's middle is (as a fraction of the distance
+		// to it), how far away it is, and its tilt, in degrees.
+		const double kPoses[][6] = {
+			{0, 0, 16, 0, 0, 0},
+			{-0.22, -0.15, 19, 15, -20, 5},
+			{0.22, -0.15, 19, -15, 20, -5},
+			{-0.22, 0.15, 19, -10, 25, 10},
+			{0.22, 0.15, 19, 20, -15, -10},
+			{0, -0.2, 20, 30, 0, 0},
+			{0, 0.2, 20, -30, 0, 0},
+			{-0.25, 0, 19, 0, 30, 40},
+			{0.25, 0, 19, 0, -30, -35},
+			{0, 0, 14, 10, 10, 20},
+			{-0.3, -0.22, 24, 10, -10, 0},
+			{0.3, 0.22, 24, -10, 10, 0}
+		};
+		LensModel lens = MadeUpLens();
+		std::string path = directory + "/" + kTrueLensFile;
+		if (!lens.Save(path.c_str())) {
+			fprintf(stderr, "could not write %s (does the directory exist?)\n", path.c_str());
+			return false;
+		}
+		int count = (int) (sizeof(kPoses) / sizeof(kPoses[0]));
+		for (int i = 0; i < count; i++) {
+			const double *p = kPoses[i];
+			double degrees = acos(-1.0) / 180;
+			double tilt[3] = {p[3] * degrees, p[4] * degrees, 0};
+			double spin[3] = {0, 0, p[5] * degrees};
+			double a[9];
+			double b[9];
+			double m[9];
+			ToRotation(tilt, a);
+			ToRotation(spin, b);
+			Multiply(a, b, m);
+			double pose[6];
+			FromRotation(m, pose);
+			// Put the board's middle corner where it was asked for.
+			double mx = (columns - 1) / 2.0;
+			double my = (rows - 1) / 2.0;
+			pose[3] = p[0] * p[2] - (m[0] * mx + m[1] * my);
+			pose[4] = p[1] * p[2] - (m[3] * mx + m[4] * my);
+			pose[5] = p[2] - (m[6] * mx + m[7] * my);
+
+			RGBImage image;
+			Image *imaq = image.GetImaqImage();
+			imaqSetImageSize(imaq, kWidth, kHeight);
+			ImageInfo info;
+			imaqGetImageInfo(imaq, &info);
+			DrawBoard((RGBValue *) info.imageStart, lens, pose, columns, rows, i);
+			char name[32];
+			sprintf(name, "board%03d.ppm", i);
+			image.Write((directory + "/" + name).c_str());
+		}
+		printf("wrote %d frames and %s to %s\n", count, kTrueLensFile, directory.c_str());
+		return true;
+	}
+
+	/**
+	 * Adds the PPMs in a directory, in name order.
+	 */
+	bool AddDirectory(const char *path, std::vector<std::string> &files)
+	{
+		DIR *directory = opendir(path);
+		if (directory == NULL) {
+			return false;
+		}
+		std::vector<std::string> names;
+		struct dirent *entry;
+		while ((entry = readdir(directory)) != NULL) {
+			std::string name = entry->d_name;
+			if ((name.size() > 4) and (name.compare(name.size() - 4, 4, ".ppm") == 0)) {
+				names.push_back(std::string(path) + "/" + name);
+			}
+		}
+		closedir(directory);
+		std::sort(names.begin(), names.end());
+		files.insert(files.end(), names.begin(), names.end());
+		return true;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int columns = 9;
+	int rows = 6;
+	const char *outPath = LensModel::kLensFile;
+	const char *tablesPath = NULL;
+	bool check = false;
+	std::string trueLensPath;
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "--board") == 0) and (i + 1 < argc)) {
+			if ((sscanf(argv[++i], "%dx%d", &columns, &rows) != 2) or (columns < 2) or (rows < 2)) {
+				fprintf(stderr, "--board wants the inner corners across and down, e.g. 9x6\n");
+				return 2;
+			}
+		} else if ((strcmp(argv[i], "--out") == 0) and (i + 1 < argc)) {
+			outPath = argv[++i];
+		} else if ((strcmp(argv[i], "--tables") == 0) and (i + 1 < argc)) {
+			tablesPath = argv[++i];
+		} else if (strcmp(argv[i], "--check") == 0) {
+			check = true;
+		} else if ((strcmp(argv[i], "--make-frames") == 0) and (i + 1 < argc)) {
+			return WriteFrames(argv[++i]) ? 0 : 2;
+		} else if (argv[i][0] == '-') {
+			fprintf(stderr, "usage: %s [--board COLUMNSxROWS] [--out FILE] [--tables FILE] [--check] DIR | FRAME.ppm ...\n"
+					"       %s --make-frames DIR\n", argv[0], argv[0]);
+			return 2;
+		} else if (AddDirectory(argv[i], files)) {
+			trueLensPath = std::string(argv[i]) + "/" + kTrueLensFile;
+		} else {
+			files.push_back(argv[i]);
+		}
+	}
+
+	std::vector<View> views;
+	int width = 0;
+	int height = 0;
+	for (size_t i = 0; i < files.size(); i++) {
+		Gray image;
+		if (!LoadGray(files[i], image)) {
+			return 2;
+		}
+		if ((width != 0) and ((image.Width != width) or (image.Height != height))) {
+			fprintf(stderr, "%s isn't the same size as the others\n", files[i].c_str());
+			return 2;
+		}
+		width = image.Width;
+		height = image.Height;
+		printf("%s\n", files[i].c_str());
+		View view;
+		view.Name = files[i];
+		if (FindCorners(image, columns, rows, view.Corners)) {
+			views.push_back(view);
+		} else {
+			printf("  skipped\n");
+		}
+	}
+	if ((int) views.size() < kMinViews) {
+		fprintf(stderr, "need the whole board in at least %d pictures, but only found it in %d\n",
+				kMinViews, (int) views.size());
+		return 1;
+	}
+
+	LensModel lens;
+	lens.Width = width;
+	lens.Height = height;
+	if (!InitialGuess(views, columns, lens)) {
+		fprintf(stderr, "the pictures don't pin the lens down; try more angles\n");
+		return 1;
+	}
+	printf("\nfirst guess: focal %.1f x %.1f, centre %.1f, %.1f\n", lens.FocalX, lens.FocalY, lens.CenterX, lens.CenterY);
+	double rms = Refine(views, columns, lens);
+	printf("calibrated from %d pictures: focal %.1f x %.1f, centre %.1f, %.1f, k1 %.4f, k2 %.4f\n",
+			(int) views.size(), lens.FocalX, lens.FocalY, lens.CenterX, lens.CenterY, lens.K1, lens.K2);
+	printf("reprojection error %.3f pixels RMS\n", rms);
+
+	CameraAngles angles;
+	angles.Build(lens, width, height);
+	printf("angle at the left edge %.2f, right edge %.2f, top %.2f, bottom %.2f degrees\n",
+			angles.GetXAngle(0), angles.GetXAngle(width - 1), angles.GetYAngle(0), angles.GetYAngle(height - 1));
+
+	if (!lens.Save(outPath)) {
+		fprintf(stderr, "could not write %s\n", outPath);
+		return 2;
+	}
+	printf("wrote %s\n", outPath);
+	if ((tablesPath != NULL) and !WriteTables(tablesPath, lens)) {
+		return 2;
+	}
+
+	if (check) {
+		bool ok = rms <= kMaxRmsError;
+		LensModel truth;
+		if (!trueLensPath.empty() and truth.Load(trueLensPath.c_str())) {
+			double worst = CompareAngles(lens.Scaled(kWidth, kHeight), truth.Scaled(kWidth, kHeight));
+			printf("worst angle error against %s: %.3f degrees\n", kTrueLensFile, worst);
+			ok = ok and (worst <= kAngleTolerance);
+		}
+		if (!ok) {
+			fprintf(stderr, "the calibration is off\n");
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file flight2csv.cpp
+ *
+ * @brief Converts a flight recording (see Code/recorder.h) to CSV.
+ *
+ * @details
+ * Usage:
+ *
+ *     flight2csv flight000.rec > flight000.csv
+ *
+ * Each sample becomes one row per named value:
+ *
+ *     time,channel,field,value
+ *     0.010000,Drive,left,0.5
+ *     0.010000,Drive,right,0.5
+ *
+ * which is easy to filter or pivot in a spreadsheet.  Recordings
+ * made on the cRIO are big-endian; the header says so, and values
+ * are swapped as needed.
+ *
+ * Sample times are 32 bits of microseconds, which wrap after about
+ * 71.6 minutes (a robot left on in the pits).  Samples are written
+ * nearly in order, so each one's time is taken to be the closest
+ * to the sample before's that ends in the same 32 bits, and the
+ * times in the CSV keep counting up.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "../../Code/recorder.h"
+
+namespace
+{
+	bool sSwap = false;
+
+	UINT32 Swap32(UINT32 value)
+	{
+		if (!sSwap) {
+			return value;
+		}
+		return ((value & 0xff) << 24) | ((value & 0xff00) << 8)
+				| ((value >> 8) & 0xff00) | (value >> 24);
+	}
+
+	UINT16 Swap16(UINT16 value)
+	{
+		if (!sSwap) {
+			return value;
+		}
+		return (UINT16) ((value << 8) | (value >> 8));
+	}
+
+	float SwapFloat(float value)
+	{
+		UINT32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		bits = Swap32(bits);
+		memcpy(&value, &bits, sizeof(bits));
+		return value;
+	}
+
+	void PrintField(double time, const FlightChannelInfo &channel, const char *field, float value)
+	{
+		if (field[0] == '\0') {
+			return;
+		}
+		printf("%.6f,%s,%s,%g\n", time, channel.Name, field, value);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc != 2) {
+		fprintf(stderr, "usage: %s RECORDING\n", argv[0]);
+		return 2;
+	}
+	FILE *file = fopen(argv[1], "rb");
+	if (file == NULL) {
+		fprintf(stderr, "could not open %s\n", argv[1]);
+		return 2;
+	}
+
+	FlightFileHeader header;
+	if ((fread(&header, sizeof(header), 1, file) != 1) or (memcmp(header.Magic, "FREC", 4) != 0)) {
+		fprintf(stderr, "%s is not a flight recording\n", argv[1]);
+		return 1;
+	}
+	sSwap = (header.ByteOrder != 0x01020304);
+	if (Swap32(header.ByteOrder) != 0x01020304) {
+		fprintf(stderr, "%s has a bad byte-order marker\n", argv[1]);
+		return 1;
+	}
+	if (Swap32(header.Version) != FlightRecorder::kVersion) {
+		fprintf(stderr, "%s is version %u; this tool reads version %u\n",
+				argv[1], Swap32(header.Version), FlightRecorder::kVersion);
+		return 1;
+	}
+
+	std::vector<FlightChannelInfo> channels(Swap32(header.ChannelCount));
+	if (!channels.empty() and (fread(&channels[0], sizeof(FlightChannelInfo), channels.size(), file) != channels.size())) {
+		fprintf(stderr, "%s is truncated\n", argv[1]);
+		return 1;
+	}
+
+	printf("time,channel,field,value\n");
+	FlightSample sample;
+	unsigned long count = 0;
+	UINT32 lastTime = 0;
+	long long elapsed = 0;		// In microseconds, unwrapped
+	while (fread(&sample, sizeof(sample), 1, file) == 1) {
+		UINT32 sampleTime = Swap32(sample.Time);
+		elapsed += (INT32) (sampleTime - lastTime);
+		lastTime = sampleTime;
+		
+		UINT16 index = Swap16(sample.Channel);
+		if (index >= channels.size()) {
+			fprintf(stderr, "sample %lu has unknown channel %u\n", count, index);
+			continue;
+		}
+		double time = elapsed * 1e-6;
+		PrintField(time, channels[index], channels[index].FieldA, SwapFloat(sample.A));
+		PrintField(time, channels[index], channels[index].FieldB, SwapFloat(sample.B));
+		count++;
+	}
+	fclose(file);
+	fprintf(stderr, "%lu samples\n", count);
+	return 0;
+}
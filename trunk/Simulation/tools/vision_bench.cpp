@@ -0,0 +1,636 @@
+/**
+ * @file vision_bench.cpp
+ *
+ * @brief Measures the vision code on a set of labelled pictures:
+ * how fast it is, where the time goes, how much it allocates and
+ * how close it gets to the right answer.
+ *
+ * @details
+ * Usage:
+ *
+ *     vision_bench [--repeat N] [--check] [CORPUS_DIR | FRAME.ppm ...]
+ *     vision_bench --make-corpus DIR
+ *
+ * A corpus is a directory of 640x480 binary PPMs (e.g. saved from
+ * the camera) and a labels.txt, with one line per target:
+ *
+ *     # frame  distance  top-left  top-right  bottom-right  bottom-left
+ *     frame000.ppm  120.5  100 80  160 80  160 125  100 125
+ *
+ * The distance is in inches and each corner is an x and a y in
+ * pixels.  A frame with no targets is listed with "-" and nothing
+ * else.  Loose PPMs can be given instead, without labels; they are
+ * then only timed and compared between engines.  With no arguments
+ * a few made-up frames, labelled exactly, are used.  --make-corpus
+ * writes those out as a corpus, to start a real one from.
+ *
+ * Each frame is run through:
+ *   - TargetFinder with NI Vision (here, the simulated version),
+ *   - TargetFinder's in-tree engine at full size only,
+ *   - the in-tree engine with its coarse first look (the default),
+ *   - SilverImageTarget, which is only timed: there are no labels
+ *     for what it finds.
+ * Every run searches the whole picture (tracking is reset first).
+ * Each is an ImagePipeline, and the time it spends in each of its
+ * stages is shown too.
+ *
+ * Allocations are counted by wrapping malloc, so NI Vision's and
+ * the standard library's count too.  That only works with glibc;
+ * elsewhere only C++ new is counted.
+ *
+ * --check exits with an error if any TargetFinder run misses a
+ * target, finds an extra one, or puts a corner more than
+ * kCornerTolerance pixels from its label (or, without labels, from
+ * where NI Vision put it).  `make check` runs it that way.
+ */
+
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "WPILib.h"
+#include "../../Code/Tracking/target.h"
+#include "../../Code/Tracking/track_silver.h"
+
+namespace
+{
+	volatile unsigned long sAllocations = 0;
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+	void *__libc_malloc(size_t);
+	void *__libc_calloc(size_t, size_t);
+	void *__libc_realloc(void *, size_t);
+
+	void *malloc(size_t size)
+	{
+		sAllocations++;
+		return __libc_malloc(size);
+	}
+
+	void *calloc(size_t count, size_t size)
+	{
+		sAllocations++;
+		return __libc_calloc(count, size);
+	}
+
+	void *realloc(void *pointer, size_t size)
+	{
+		sAllocations++;
+		return __libc_realloc(pointer, size);
+	}
+}
+#else
+void *operator new(size_t size) throw(std::bad_alloc)
+{
+	sAllocations++;
+	void *pointer = malloc(size == 0 ? 1 : size);
+	if (pointer == NULL) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void operator delete(void *pointer) throw()
+{
+	free(pointer);
+}
+#endif
+
+namespace
+{
+	const int kWidth = 640;
+	const int kHeight = 480;
+	const double kCornerTolerance = 2.0;	// In pixels
+
+	/**
+	 * Where a target really is.
+	 */
+	struct Label
+	{
+		double Distance;	// In inches
+		double CornerX[4];	// Top left, top right, bottom right, bottom left
+		double CornerY[4];
+	};
+
+	/**
+	 * A picture to test with, where it came from and, if known,
+	 * what's in it.
+	 */
+	struct Frame
+	{
+		std::string Name;
+		RGBImage *Image;
+		HSLImage *HSL;		// A copy, for SilverImageTarget
+		bool IsLabelled;
+		std::vector<Label> Labels;
+	};
+
+	/**
+	 * How one way of finding targets did over every frame.
+	 */
+	struct Result
+	{
+		std::string Name;
+		bool IsChecked;			// False if nothing comes out to check
+		double Milliseconds;		// Per frame
+		double Allocations;		// Per frame
+		std::vector<std::string> StageNames;
+		std::vector<double> StageMilliseconds;		// Per frame
+		std::vector<std::vector<TargetUtils::Target> > Targets;		// For each frame
+
+		int Found;			// Against the labels
+		int Missed;
+		int Extra;
+		double CornerErrorSum;
+		double CornerErrorWorst;
+		int CornerCount;
+		double DistanceErrorSum;
+		double DistanceErrorWorst;
+	};
+
+	double Now()
+	{
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec * 1e-9;
+	}
+
+	/**
+	 * The same empirical formula as the robot uses, so made-up
+	 * labels agree with it when the width is right.
+	 */
+	double DistanceForWidth(double widthPixels)
+	{
+		return 17490 / widthPixels - 6.97;
+	}
+
+	/**
+	 * Draws a hollow rectangle of retroreflective tape, as lit up by
+	 * the ring light: 24x18 outside, with 2 inch wide tape.  Returns
+	 * its label.
+	 */
+	Label DrawTarget(RGBValue *pixels, double middleX, double middleY, double widthPixels, double degrees)
+	{
+		double inch = widthPixels / 24.0;
+		double radians = degrees * acos(-1.0) / 180;
+		double c = cos(radians);
+		double s = sin(radians);
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				double dx = x - middleX;
+				double dy = y - middleY;
+				double u = fabs(dx * c + dy * s) / inch;	// In inches from the middle
+				double v = fabs(-dx * s + dy * c) / inch;
+				bool inOuter = (u <= 12) and (v <= 9);
+				bool inInner = (u < 10) and (v < 7);
+				if (inOuter and !inInner) {
+					RGBValue &p = pixels[y * kWidth + x];
+					p.R = 250;
+					p.G = 245;
+					p.B = 250;
+				}
+			}
+		}
+
+		Label label;
+		label.Distance = DistanceForWidth(widthPixels);
+		const double u[4] = {-12, 12, 12, -12};
+		const double v[4] = {-9, -9, 9, 9};
+		for (int i = 0; i < 4; i++) {
+			label.CornerX[i] = middleX + (u[i] * c - v[i] * s) * inch;
+			label.CornerY[i] = middleY + (u[i] * s + v[i] * c) * inch;
+		}
+		return label;
+	}
+
+	/**
+	 * Makes up a picture of the four backboard targets, seen from
+	 * some distance and angle, with a little noise.  A scale of 0
+	 * leaves the targets out.
+	 */
+	Frame MakeFrame(const char *name, int seed, double scale, double shiftX, double degrees)
+	{
+		Frame frame;
+		frame.Name = name;
+		frame.Image = new RGBImage();
+		frame.IsLabelled = true;
+		Image *imaq = frame.Image->GetImaqImage();
+		imaqSetImageSize(imaq, kWidth, kHeight);
+		ImageInfo info;
+		imaqGetImageInfo(imaq, &info);
+		RGBValue *pixels = (RGBValue *) info.imageStart;
+		srand(seed);
+		for (int i = 0; i < kWidth * kHeight; i++) {
+			pixels[i].R = 20 + rand() % 40;
+			pixels[i].G = 20 + rand() % 40;
+			pixels[i].B = 30 + rand() % 40;
+			pixels[i].alpha = 0;
+		}
+		if (scale > 0) {
+			double middleX = kWidth / 2 + shiftX;
+			double middleY = kHeight / 2;
+			double width = 60 * scale;
+			frame.Labels.push_back(DrawTarget(pixels, middleX, middleY - 1.1 * width, width, degrees));
+			frame.Labels.push_back(DrawTarget(pixels, middleX - 1.2 * width, middleY, width, degrees));
+			frame.Labels.push_back(DrawTarget(pixels, middleX + 1.2 * width, middleY, width, degrees));
+			frame.Labels.push_back(DrawTarget(pixels, middleX, middleY + 1.1 * width, width, degrees));
+		}
+		return frame;
+	}
+
+	std::vector<Frame> MakeFrames()
+	{
+		const double kMadeUp[][3] = {{1.0, 0, 0}, {0.7, -80, 0}, {1.3, 60, 0}, {1.0, 30, 4}, {0.6, 120, -6}, {0, 0, 0}};
+		std::vector<Frame> frames;
+		for (int i = 0; i < 6; i++) {
+			char name[32];
+			sprintf(name, "made-up%03d.ppm", i);
+			frames.push_back(MakeFrame(name, i, kMadeUp[i][0], kMadeUp[i][1], kMadeUp[i][2]));
+		}
+		return frames;
+	}
+
+	bool LoadImage(Frame &frame, const std::string &path)
+	{
+		frame.Image = new RGBImage(path.c_str());
+		if (frame.Image->GetWidth() == 0) {
+			fprintf(stderr, "could not read %s\n", path.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Reads DIR/labels.txt and the frames it lists.
+	 */
+	bool LoadCorpus(const std::string &directory, std::vector<Frame> &frames)
+	{
+		std::string path = directory + "/labels.txt";
+		FILE *file = fopen(path.c_str(), "r");
+		if (file == NULL) {
+			fprintf(stderr, "could not read %s\n", path.c_str());
+			return false;
+		}
+		char line[512];
+		int lineNumber = 0;
+		bool ok = true;
+		while (ok and (fgets(line, sizeof(line), file) != NULL)) {
+			lineNumber++;
+			char name[256];
+			char rest[256];
+			if ((line[0] == '#') or (sscanf(line, "%255s", name) != 1)) {
+				continue;
+			}
+			if ((frames.empty()) or (frames.back().Name != name)) {
+				Frame frame;
+				frame.Name = name;
+				frame.IsLabelled = true;
+				ok = LoadImage(frame, directory + "/" + name);
+				frames.push_back(frame);
+			}
+			if ((sscanf(line, "%*s %255s", rest) == 1) and (strcmp(rest, "-") == 0)) {
+				continue;
+			}
+			Label label;
+			double *x = label.CornerX;
+			double *y = label.CornerY;
+			if (sscanf(line, "%*s %lf %lf %lf %lf %lf %lf %lf %lf %lf", &label.Distance,
+					&x[0], &y[0], &x[1], &y[1], &x[2], &y[2], &x[3], &y[3]) != 9) {
+				fprintf(stderr, "%s:%d: expected a frame, a distance and 4 corners\n", path.c_str(), lineNumber);
+				ok = false;
+				break;
+			}
+			frames.back().Labels.push_back(label);
+		}
+		fclose(file);
+		return ok and !frames.empty();
+	}
+
+	/**
+	 * Writes the made-up frames and their labels to a directory.
+	 */
+	bool WriteCorpus(const std::string &directory)
+	{
+		std::string path = directory + "/labels.txt";
+		FILE *file = fopen(path.c_str(), "w");
+		if (file == NULL) {
+			fprintf(stderr, "could not write %s (does the directory exist?)\n", path.c_str());
+			return false;
+		}
+		fprintf(file, "# frame  distance  top-left  top-right  bottom-right  bottom-left\n");
+		std::vector<Frame> frames = MakeFrames();
+		for (size_t i = 0; i < frames.size(); i++) {
+			frames[i].Image->Write((directory + "/" + frames[i].Name).c_str());
+			if (frames[i].Labels.empty()) {
+				fprintf(file, "%s  -\n", frames[i].Name.c_str());
+			}
+			for (size_t j = 0; j < frames[i].Labels.size(); j++) {
+				const Label &l = frames[i].Labels[j];
+				fprintf(file, "%s  %.1f  %.1f %.1f  %.1f %.1f  %.1f %.1f  %.1f %.1f\n", frames[i].Name.c_str(), l.Distance,
+						l.CornerX[0], l.CornerY[0], l.CornerX[1], l.CornerY[1],
+						l.CornerX[2], l.CornerY[2], l.CornerX[3], l.CornerY[3]);
+			}
+		}
+		fclose(file);
+		printf("wrote %d frames to %s\n", (int) frames.size(), directory.c_str());
+		return true;
+	}
+
+	bool IsDirectory(const char *path)
+	{
+		DIR *directory = opendir(path);
+		if (directory == NULL) {
+			return false;
+		}
+		closedir(directory);
+		return true;
+	}
+
+	/**
+	 * Copies the time per frame spent in each stage.
+	 */
+	void AddStageTimes(Result &result, const StageTimer &stages)
+	{
+		for (int s = 0; s < stages.GetStageCount(); s++) {
+			result.StageNames.push_back(stages.GetStageName(s));
+			result.StageMilliseconds.push_back(stages.GetAverage(s) * 1000);
+		}
+	}
+
+	/**
+	 * Runs a TargetFinder over every frame.
+	 */
+	Result RunFinder(const char *name, TargetFinder &finder, TargetFinder::Engine engine, int step,
+			std::vector<Frame> &frames, int repeat)
+	{
+		Result result;
+		result.Name = name;
+		result.IsChecked = true;
+		result.Targets.resize(frames.size());
+		finder.SetEngine(engine);
+		finder.SetPyramidStep(step);
+
+		// Once untimed, so buffers growing to fit isn't counted
+		for (size_t i = 0; i < frames.size(); i++) {
+			finder.ResetTracking();
+			finder.ProcessImage(frames[i].Image, result.Targets[i]);
+		}
+
+		StageTimer &stages = finder.GetStageTimer();
+		stages.Reset();
+		unsigned long allocations = sAllocations;
+		double total = 0;
+		for (size_t i = 0; i < frames.size(); i++) {
+			for (int r = 0; r < repeat; r++) {
+				finder.ResetTracking();
+				double start = Now();
+				finder.ProcessImage(frames[i].Image, result.Targets[i]);
+				total += Now() - start;
+			}
+		}
+		int runs = (int) frames.size() * repeat;
+		result.Milliseconds = total * 1000 / runs;
+		result.Allocations = (double) (sAllocations - allocations) / runs;
+		AddStageTimes(result, stages);
+		return result;
+	}
+
+	/**
+	 * Times SilverImageTarget over every frame.
+	 */
+	Result RunSilver(std::vector<Frame> &frames, int repeat)
+	{
+		Result result;
+		result.Name = "silver";
+		result.IsChecked = false;
+		result.Targets.resize(frames.size());
+		SilverImageTarget silver;
+
+		// Once untimed, as for TargetFinder
+		for (size_t i = 0; i < frames.size(); i++) {
+			silver.ProcessImage(frames[i].HSL, result.Targets[i]);
+		}
+
+		StageTimer &stages = silver.GetStageTimer();
+		stages.Reset();
+		unsigned long allocations = sAllocations;
+		double total = 0;
+		for (size_t i = 0; i < frames.size(); i++) {
+			for (int r = 0; r < repeat; r++) {
+				double start = Now();
+				silver.ProcessImage(frames[i].HSL, result.Targets[i]);
+				total += Now() - start;
+			}
+		}
+		int runs = (int) frames.size() * repeat;
+		result.Milliseconds = total * 1000 / runs;
+		result.Allocations = (double) (sAllocations - allocations) / runs;
+		AddStageTimes(result, stages);
+		return result;
+	}
+
+	double Distance(double x1, double y1, double x2, double y2)
+	{
+		return sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+	}
+
+	/**
+	 * Turns a target found by the other engine into a label, for
+	 * frames that don't have any.
+	 */
+	Label ToLabel(const TargetUtils::Target &t)
+	{
+		Label label;
+		label.Distance = t.DistanceFromCamera;
+		const TargetUtils::Coordinate *corners[4] = {&t.TopLeft, &t.TopRight, &t.BottomRight, &t.BottomLeft};
+		for (int i = 0; i < 4; i++) {
+			label.CornerX[i] = corners[i]->X;
+			label.CornerY[i] = corners[i]->Y;
+		}
+		return label;
+	}
+
+	/**
+	 * Matches each label to the target with the nearest middle (if
+	 * it's inside the label) and adds up the errors.
+	 */
+	void Score(Result &result, const std::vector<Label> &labels, const std::vector<TargetUtils::Target> &targets)
+	{
+		std::vector<bool> isUsed(targets.size(), false);
+		for (size_t i = 0; i < labels.size(); i++) {
+			const Label &l = labels[i];
+			double middleX = (l.CornerX[0] + l.CornerX[1] + l.CornerX[2] + l.CornerX[3]) / 4;
+			double middleY = (l.CornerY[0] + l.CornerY[1] + l.CornerY[2] + l.CornerY[3]) / 4;
+			double reach = Distance(l.CornerX[0], l.CornerY[0], l.CornerX[2], l.CornerY[2]) / 2;
+			int nearest = -1;
+			for (size_t j = 0; j < targets.size(); j++) {
+				double d = Distance(middleX, middleY, targets[j].Middle.X, targets[j].Middle.Y);
+				if (!isUsed[j] and (d < reach) and ((nearest < 0)
+						or (d < Distance(middleX, middleY, targets[nearest].Middle.X, targets[nearest].Middle.Y)))) {
+					nearest = (int) j;
+				}
+			}
+			if (nearest < 0) {
+				result.Missed++;
+				continue;
+			}
+			isUsed[nearest] = true;
+			result.Found++;
+			Label found = ToLabel(targets[nearest]);
+			for (int c = 0; c < 4; c++) {
+				double error = Distance(l.CornerX[c], l.CornerY[c], found.CornerX[c], found.CornerY[c]);
+				result.CornerErrorSum += error;
+				result.CornerErrorWorst = std::max(result.CornerErrorWorst, error);
+				result.CornerCount++;
+			}
+			double error = fabs(l.Distance - found.Distance);
+			result.DistanceErrorSum += error;
+			result.DistanceErrorWorst = std::max(result.DistanceErrorWorst, error);
+		}
+		result.Extra += (int) targets.size() - (int) std::count(isUsed.begin(), isUsed.end(), true);
+	}
+
+	/**
+	 * Scores every run against the labels, or against the first
+	 * run (NI Vision) for frames without any.
+	 */
+	void ScoreAll(std::vector<Result> &results, const std::vector<Frame> &frames)
+	{
+		for (size_t r = 0; r < results.size(); r++) {
+			Result &result = results[r];
+			result.Found = 0;
+			result.Missed = 0;
+			result.Extra = 0;
+			result.CornerErrorSum = 0;
+			result.CornerErrorWorst = 0;
+			result.CornerCount = 0;
+			result.DistanceErrorSum = 0;
+			result.DistanceErrorWorst = 0;
+			if (!result.IsChecked) {
+				continue;
+			}
+			for (size_t i = 0; i < frames.size(); i++) {
+				std::vector<Label> labels = frames[i].Labels;
+				if (!frames[i].IsLabelled) {
+					labels.clear();
+					for (size_t t = 0; t < results[0].Targets[i].size(); t++) {
+						labels.push_back(ToLabel(results[0].Targets[i][t]));
+					}
+				}
+				Score(result, labels, result.Targets[i]);
+			}
+		}
+	}
+
+	void Print(const std::vector<Result> &results, bool isLabelled)
+	{
+		printf("%-10s %8s %9s %9s\n", "", "frames/s", "ms/frame", "allocs");
+		for (size_t r = 0; r < results.size(); r++) {
+			const Result &result = results[r];
+			printf("%-10s %8.1f %9.2f %9.1f\n", result.Name.c_str(), 1000 / result.Milliseconds,
+					result.Milliseconds, result.Allocations);
+		}
+
+		printf("\nms/frame in each stage:\n");
+		for (size_t r = 0; r < results.size(); r++) {
+			const Result &result = results[r];
+			printf("%-10s", result.Name.c_str());
+			for (size_t s = 0; s < result.StageNames.size(); s++) {
+				printf(" %s %.3f", result.StageNames[s].c_str(), result.StageMilliseconds[s]);
+			}
+			printf("\n");
+		}
+
+		printf("\nagainst %s:\n", isLabelled ? "the labels" : "NI Vision");
+		printf("%-10s %6s %6s %6s %20s %22s\n", "", "found", "missed", "extra",
+				"corner px mean/worst", "distance in mean/worst");
+		for (size_t r = 0; r < results.size(); r++) {
+			const Result &result = results[r];
+			if (!result.IsChecked) {
+				printf("%-10s %6s %6s %6s %20s %22s\n", result.Name.c_str(), "-", "-", "-", "-", "-");
+				continue;
+			}
+			double cornerMean = (result.CornerCount > 0) ? result.CornerErrorSum / result.CornerCount : 0;
+			double distanceMean = (result.Found > 0) ? result.DistanceErrorSum / result.Found : 0;
+			printf("%-10s %6d %6d %6d %13.2f / %4.2f %15.2f / %4.2f\n", result.Name.c_str(),
+					result.Found, result.Missed, result.Extra,
+					cornerMean, result.CornerErrorWorst, distanceMean, result.DistanceErrorWorst);
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	int repeat = 10;
+	bool check = false;
+	std::vector<Frame> frames;
+	for (int i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "--repeat") == 0) and (i + 1 < argc)) {
+			repeat = std::max(1, atoi(argv[++i]));
+		} else if (strcmp(argv[i], "--check") == 0) {
+			check = true;
+		} else if ((strcmp(argv[i], "--make-corpus") == 0) and (i + 1 < argc)) {
+			return WriteCorpus(argv[++i]) ? 0 : 2;
+		} else if (argv[i][0] == '-') {
+			fprintf(stderr, "usage: %s [--repeat N] [--check] [CORPUS_DIR | FRAME.ppm ...]\n"
+					"       %s --make-corpus DIR\n", argv[0], argv[0]);
+			return 2;
+		} else if (IsDirectory(argv[i])) {
+			if (!LoadCorpus(argv[i], frames)) {
+				return 2;
+			}
+		} else {
+			Frame frame;
+			frame.Name = argv[i];
+			frame.IsLabelled = false;
+			if (!LoadImage(frame, argv[i])) {
+				return 2;
+			}
+			frames.push_back(frame);
+		}
+	}
+	if (frames.empty()) {
+		frames = MakeFrames();
+	}
+	bool isLabelled = true;
+	for (size_t i = 0; i < frames.size(); i++) {
+		isLabelled = isLabelled and frames[i].IsLabelled;
+		frames[i].HSL = new HSLImage();
+		imaqDuplicate(frames[i].HSL->GetImaqImage(), frames[i].Image->GetImaqImage());
+	}
+
+	TargetFinder finder;
+	std::vector<Result> results;
+	results.push_back(RunFinder("NI", finder, TargetFinder::kNIVision, 1, frames, repeat));
+	results.push_back(RunFinder("in-tree", finder, TargetFinder::kInTree, 1, frames, repeat));
+	int step = TargetFinder().GetPyramidStep();
+	results.push_back(RunFinder("pyramid", finder, TargetFinder::kInTree, step, frames, repeat));
+	results.push_back(RunSilver(frames, repeat));
+	ScoreAll(results, frames);
+
+	printf("%d frames, %d runs each, threshold: %s, pyramid step %d\n\n", (int) frames.size(), repeat,
+			Masking::GetImplementationName(), step);
+	Print(results, isLabelled);
+
+	bool ok = true;
+	for (size_t r = 0; r < results.size(); r++) {
+		const Result &result = results[r];
+		ok = ok and (!result.IsChecked or ((result.Missed == 0) and (result.Extra == 0)
+				and (result.CornerErrorWorst <= kCornerTolerance)));
+	}
+	if (check and !ok) {
+		fprintf(stderr, "some targets were missed, extra or misplaced\n");
+		return 1;
+	}
+	return 0;
+}